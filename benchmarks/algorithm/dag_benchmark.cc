@@ -0,0 +1,106 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for the algorithms in sneaker/algorithm/dag.h */
+
+#include "algorithm/csr_graph.h"
+#include "algorithm/dag.h"
+
+#include "benchmark.h"
+#include "graph_generator.h"
+
+#include <cstdint>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t VERTICES = 1000000;
+
+const size_t EDGES_PER_VERTEX = 4;
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(dag, CondensationSchedule)
+{
+  using sneaker::algorithm::csr_graph;
+
+  const csr_graph graph = sneaker::benchmark::generate_power_law_graph(
+    VERTICES, VERTICES * EDGES_PER_VERTEX, 0.8, 1);
+
+  std::vector<csr_graph::vertex_id> labels;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  const csr_graph dag = sneaker::algorithm::condensation(graph, &labels);
+
+  sneaker::benchmark::report_throughput("condensation", graph.edge_count(),
+    stopwatch.elapsed_seconds());
+
+  std::vector<csr_graph::vertex_id> order;
+
+  stopwatch.reset();
+
+  const bool sorted = sneaker::algorithm::topological_sort(dag, &order);
+
+  sneaker::benchmark::report_throughput("topological_sort", dag.edge_count(),
+    stopwatch.elapsed_seconds());
+
+  stopwatch.reset();
+
+  const uint64_t length = sneaker::algorithm::critical_path_length(dag,
+    std::vector<uint64_t>());
+
+  sneaker::benchmark::report_throughput("critical_path_length",
+    dag.edge_count(), stopwatch.elapsed_seconds());
+
+  sneaker::benchmark::do_not_optimize(sorted);
+  sneaker::benchmark::do_not_optimize(length);
+}
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(dag, TransitiveReduction)
+{
+  using sneaker::algorithm::csr_graph;
+
+  // Short spans keep the reachable sets, and thus the searches, small.
+  const csr_graph dag = sneaker::benchmark::generate_dag(VERTICES / 10,
+    VERTICES / 10 * EDGES_PER_VERTEX, 16, 1);
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  const csr_graph reduction = sneaker::algorithm::transitive_reduction(dag);
+
+  sneaker::benchmark::report_throughput("transitive_reduction",
+    dag.edge_count(), stopwatch.elapsed_seconds());
+  sneaker::benchmark::report_ratio("transitive_reduction edges kept",
+    static_cast<double>(reduction.edge_count()) /
+    static_cast<double>(dag.edge_count()));
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,133 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `incremental_scc` in sneaker/algorithm/incremental_scc.h */
+
+#include "algorithm/csr_graph.h"
+#include "algorithm/incremental_scc.h"
+#include "algorithm/iterative_tarjan.h"
+
+#include "benchmark.h"
+
+#include <random>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t VERTICES = 100000;
+
+const size_t EDGES = 200000;
+
+/**
+ * The number of edges between two decompositions from scratch.
+ */
+const size_t RECOMPUTE_INTERVAL = 1000;
+
+/**
+ * Generates the edges of a dependency graph, which mostly point from lower
+ * to higher identifiers, with the specified fraction of back edges.
+ */
+std::vector<sneaker::algorithm::csr_graph::edge>
+generate_dependency_edges(double back_edge_fraction, uint64_t seed)
+{
+  typedef sneaker::algorithm::csr_graph::vertex_id vertex_id;
+
+  std::mt19937_64 engine(seed);
+  std::uniform_int_distribution<vertex_id> vertices(0, VERTICES - 1);
+  std::bernoulli_distribution back_edge(back_edge_fraction);
+
+  std::vector<sneaker::algorithm::csr_graph::edge> edges(EDGES);
+  for (auto& edge : edges)
+  {
+    vertex_id source = vertices(engine);
+    vertex_id target = vertices(engine);
+
+    if ((source > target) != back_edge(engine))
+    {
+      std::swap(source, target);
+    }
+
+    edge.first = source;
+    edge.second = target;
+  }
+
+  return edges;
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(incremental_scc, AddEdges)
+{
+  using sneaker::algorithm::csr_graph;
+
+  const std::vector<csr_graph::edge> edges =
+    generate_dependency_edges(0.0001, 1);
+
+  size_t cycles = 0;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  sneaker::algorithm::incremental_scc graph(VERTICES);
+  for (const csr_graph::edge& edge : edges)
+  {
+    cycles += graph.add_edge(edge.first, edge.second) ? 1 : 0;
+  }
+
+  sneaker::benchmark::report_throughput("incremental_scc add_edge",
+    edges.size(), stopwatch.elapsed_seconds());
+
+  // Decomposing from scratch after every edge is out of reach, so the graph
+  // is only decomposed every `RECOMPUTE_INTERVAL` edges, which still detects
+  // cycles far later than `add_edge()`.
+  stopwatch.reset();
+
+  std::vector<csr_graph::edge> prefix;
+  std::vector<csr_graph::vertex_id> labels;
+  size_t count = 0;
+
+  for (const csr_graph::edge& edge : edges)
+  {
+    prefix.push_back(edge);
+
+    if (prefix.size() % RECOMPUTE_INTERVAL == 0)
+    {
+      sneaker::algorithm::iterative_tarjan algo;
+      count += algo.label_components(
+        csr_graph::from_edges(VERTICES, prefix), &labels);
+    }
+  }
+
+  sneaker::benchmark::report_throughput(
+    "iterative_tarjan every 1000 edges", edges.size(),
+    stopwatch.elapsed_seconds());
+
+  sneaker::benchmark::do_not_optimize(cycles);
+  sneaker::benchmark::do_not_optimize(count);
+}
+
+// -----------------------------------------------------------------------------
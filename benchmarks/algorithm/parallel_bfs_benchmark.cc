@@ -0,0 +1,98 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `parallel_bfs` in sneaker/algorithm/parallel_bfs.h */
+
+#include "algorithm/csr_graph.h"
+#include "algorithm/parallel_bfs.h"
+
+#include "benchmark.h"
+#include "graph_generator.h"
+
+#include <sstream>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t VERTICES = 1000000;
+
+const size_t EDGES_PER_VERTEX = 16;
+
+const size_t THREAD_COUNTS[] = { 1, 2, 4, 8 };
+
+/**
+ * Searches from a vertex of the highest out-degree, so that the search
+ * covers the bulk of the graph.
+ */
+void
+run_scaling(const char* name, const sneaker::algorithm::csr_graph& graph)
+{
+  typedef sneaker::algorithm::csr_graph::vertex_id vertex_id;
+
+  const sneaker::algorithm::csr_graph transpose = graph.transpose();
+
+  vertex_id source = 0;
+  for (vertex_id vertex = 0; vertex < graph.vertex_count(); ++vertex)
+  {
+    if (graph.degree(vertex) > graph.degree(source))
+    {
+      source = vertex;
+    }
+  }
+
+  std::vector<vertex_id> distances;
+  size_t reached = 0;
+
+  for (size_t thread_count : THREAD_COUNTS)
+  {
+    sneaker::benchmark::stopwatch stopwatch;
+
+    sneaker::algorithm::parallel_bfs bfs(thread_count);
+    reached += bfs.run(graph, transpose, source, &distances);
+
+    std::ostringstream label;
+    label << name << " parallel_bfs threads=" << thread_count
+      << " bottom-up levels=" << bfs.bottom_up_levels();
+    sneaker::benchmark::report_throughput(label.str(), graph.edge_count(),
+      stopwatch.elapsed_seconds());
+  }
+
+  sneaker::benchmark::do_not_optimize(reached);
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(parallel_bfs, Scaling)
+{
+  run_scaling("uniform", sneaker::benchmark::generate_uniform_graph(VERTICES,
+    VERTICES * EDGES_PER_VERTEX, 1));
+  run_scaling("power-law", sneaker::benchmark::generate_power_law_graph(
+    VERTICES, VERTICES * EDGES_PER_VERTEX, 0.8, 1));
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,92 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `parallel_scc` in sneaker/algorithm/parallel_scc.h */
+
+#include "algorithm/csr_graph.h"
+#include "algorithm/iterative_tarjan.h"
+#include "algorithm/parallel_scc.h"
+
+#include "benchmark.h"
+#include "graph_generator.h"
+
+#include <sstream>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t VERTICES = 1000000;
+
+const size_t EDGES_PER_VERTEX = 8;
+
+const size_t THREAD_COUNTS[] = { 1, 2, 4, 8 };
+
+void
+run_scaling(const char* name, const sneaker::algorithm::csr_graph& graph)
+{
+  std::vector<sneaker::algorithm::csr_graph::vertex_id> labels;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  sneaker::algorithm::iterative_tarjan sequential;
+  size_t count = sequential.label_components(graph, &labels);
+
+  std::ostringstream label;
+  label << name << " iterative_tarjan";
+  sneaker::benchmark::report_throughput(label.str(), graph.edge_count(),
+    stopwatch.elapsed_seconds());
+
+  for (size_t thread_count : THREAD_COUNTS)
+  {
+    stopwatch.reset();
+
+    sneaker::algorithm::parallel_scc algo(thread_count, 0);
+    count += algo.label_components(graph, &labels);
+
+    label.str("");
+    label << name << " parallel_scc threads=" << thread_count;
+    sneaker::benchmark::report_throughput(label.str(), graph.edge_count(),
+      stopwatch.elapsed_seconds());
+  }
+
+  sneaker::benchmark::do_not_optimize(count);
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(parallel_scc, PowerLawScaling)
+{
+  run_scaling("skew=0.6",
+    sneaker::benchmark::generate_power_law_graph(
+      VERTICES, VERTICES * EDGES_PER_VERTEX, 0.6, 1));
+  run_scaling("skew=0.9",
+    sneaker::benchmark::generate_power_law_graph(
+      VERTICES, VERTICES * EDGES_PER_VERTEX, 0.9, 1));
+}
+
+// -----------------------------------------------------------------------------
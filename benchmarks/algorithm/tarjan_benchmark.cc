@@ -0,0 +1,132 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `tarjan` in sneaker/algorithm/tarjan.h and
+ * `iterative_tarjan` in sneaker/algorithm/iterative_tarjan.h */
+
+#include "algorithm/csr_graph.h"
+#include "algorithm/iterative_tarjan.h"
+#include "algorithm/tarjan.h"
+
+#include "benchmark.h"
+#include "graph_generator.h"
+
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t VERTICES = 1000000;
+
+const size_t EDGES_PER_VERTEX = 4;
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(tarjan, RandomGraph)
+{
+  using sneaker::algorithm::csr_graph;
+
+  typedef sneaker::algorithm::tarjan<int> tarjan_type;
+
+  const csr_graph graph = sneaker::benchmark::generate_uniform_graph(VERTICES,
+    VERTICES * EDGES_PER_VERTEX, 1);
+
+  std::vector<tarjan_type::vertex> storage;
+  storage.reserve(VERTICES);
+  for (size_t i = 0; i < VERTICES; ++i)
+  {
+    storage.push_back(tarjan_type::vertex(static_cast<int>(i)));
+  }
+
+  for (csr_graph::vertex_id source = 0; source < VERTICES; ++source)
+  {
+    for (auto itr = graph.neighbors_begin(source);
+      itr != graph.neighbors_end(source); ++itr)
+    {
+      storage[source].dependencies().push_back(&storage[*itr]);
+    }
+  }
+
+  tarjan_type::VerticesSet vertices;
+  vertices.reserve(VERTICES);
+  for (auto& vertex : storage)
+  {
+    vertices.push_back(&vertex);
+  }
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  tarjan_type algo;
+  const size_t count = algo.get_components(vertices).size();
+
+  sneaker::benchmark::report_throughput("tarjan vertices", graph.edge_count(),
+    stopwatch.elapsed_seconds());
+
+  std::vector<csr_graph::vertex_id> labels;
+
+  stopwatch.reset();
+
+  sneaker::algorithm::iterative_tarjan iterative_algo;
+  const size_t csr_count = iterative_algo.label_components(graph, &labels);
+
+  sneaker::benchmark::report_throughput("iterative_tarjan csr_graph",
+    graph.edge_count(), stopwatch.elapsed_seconds());
+
+  sneaker::benchmark::do_not_optimize(count);
+  sneaker::benchmark::do_not_optimize(csr_count);
+}
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(tarjan, DeepChain)
+{
+  using sneaker::algorithm::csr_graph;
+
+  std::vector<csr_graph::edge> edges;
+  edges.reserve(VERTICES * 10);
+  for (size_t i = 0; i + 1 < VERTICES * 10; ++i)
+  {
+    edges.push_back(csr_graph::edge(static_cast<csr_graph::vertex_id>(i),
+      static_cast<csr_graph::vertex_id>(i + 1)));
+  }
+
+  const csr_graph graph = csr_graph::from_edges(VERTICES * 10, edges);
+
+  std::vector<csr_graph::vertex_id> labels;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  sneaker::algorithm::iterative_tarjan algo;
+  const size_t count = algo.label_components(graph, &labels);
+
+  sneaker::benchmark::report_throughput("iterative_tarjan chain",
+    graph.vertex_count(), stopwatch.elapsed_seconds());
+
+  sneaker::benchmark::do_not_optimize(count);
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,146 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+
+namespace sneaker {
+
+
+namespace benchmark {
+
+
+// -----------------------------------------------------------------------------
+
+std::vector<benchmark_case>&
+registry()
+{
+  static std::vector<benchmark_case> cases;
+  return cases;
+}
+
+// -----------------------------------------------------------------------------
+
+registrar::registrar(const char* name, benchmark_fn fn)
+{
+  registry().push_back(benchmark_case{name, fn});
+}
+
+// -----------------------------------------------------------------------------
+
+stopwatch::stopwatch()
+  :
+  m_start(std::chrono::steady_clock::now())
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void
+stopwatch::reset()
+{
+  m_start = std::chrono::steady_clock::now();
+}
+
+// -----------------------------------------------------------------------------
+
+double
+stopwatch::elapsed_seconds() const
+{
+  const auto elapsed = std::chrono::steady_clock::now() - m_start;
+  return std::chrono::duration<double>(elapsed).count();
+}
+
+// -----------------------------------------------------------------------------
+
+void
+report_throughput(const std::string& label, uint64_t ops, double seconds)
+{
+  const double ops_per_sec = seconds > 0 ? static_cast<double>(ops) / seconds : 0;
+
+  printf("  %-56s %12.3f Mops/s  (%.3f s)\n",
+    label.c_str(), ops_per_sec / 1e6, seconds);
+}
+
+// -----------------------------------------------------------------------------
+
+void
+report_bandwidth(const std::string& label, uint64_t bytes, double seconds)
+{
+  const double bytes_per_sec =
+    seconds > 0 ? static_cast<double>(bytes) / seconds : 0;
+
+  printf("  %-56s %12.3f MB/s    (%.3f s)\n",
+    label.c_str(), bytes_per_sec / 1e6, seconds);
+}
+
+// -----------------------------------------------------------------------------
+
+void
+report_ratio(const std::string& label, double ratio)
+{
+  printf("  %-56s %11.2f %%\n", label.c_str(), ratio * 100.0);
+}
+
+// -----------------------------------------------------------------------------
+
+zipf_generator::zipf_generator(uint64_t n, double skew, uint64_t seed)
+  :
+  m_cdf(n),
+  m_engine(seed),
+  m_distribution(0.0, 1.0)
+{
+  double sum = 0;
+  for (uint64_t i = 0; i < n; ++i)
+  {
+    sum += 1.0 / std::pow(static_cast<double>(i + 1), skew);
+    m_cdf[i] = sum;
+  }
+
+  for (uint64_t i = 0; i < n; ++i)
+  {
+    m_cdf[i] /= sum;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+uint64_t
+zipf_generator::operator()()
+{
+  const double u = m_distribution(m_engine);
+  const auto itr = std::lower_bound(m_cdf.begin(), m_cdf.end(), u);
+  const auto index = static_cast<uint64_t>(itr - m_cdf.begin());
+  return std::min<uint64_t>(index, m_cdf.size() - 1);
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace benchmark */
+
+
+} /* end namespace sneaker */
@@ -0,0 +1,150 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/*
+ * Minimal benchmark harness shared by all benchmarks under `benchmarks/`.
+ *
+ * Benchmarks are registered with the `SNEAKER_BENCHMARK(group, name)` macro
+ * and are run by the `run_benchmarks` executable, which optionally takes a
+ * substring filter of the benchmark names as its only argument.
+ */
+
+#ifndef SNEAKER_BENCHMARK_H_
+#define SNEAKER_BENCHMARK_H_
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace sneaker {
+namespace benchmark {
+
+// -----------------------------------------------------------------------------
+
+typedef void(*benchmark_fn)();
+
+// -----------------------------------------------------------------------------
+
+struct benchmark_case
+{
+  std::string name;
+  benchmark_fn fn;
+};
+
+// -----------------------------------------------------------------------------
+
+std::vector<benchmark_case>& registry();
+
+// -----------------------------------------------------------------------------
+
+class registrar
+{
+public:
+  registrar(const char* name, benchmark_fn fn);
+};
+
+// -----------------------------------------------------------------------------
+
+class stopwatch
+{
+public:
+  stopwatch();
+
+  void reset();
+
+  double elapsed_seconds() const;
+
+private:
+  std::chrono::steady_clock::time_point m_start;
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Prints the throughput of `ops` operations that took `seconds` to complete.
+ */
+void report_throughput(const std::string& label, uint64_t ops, double seconds);
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Prints the rate at which `bytes` bytes were processed in `seconds`.
+ */
+void report_bandwidth(const std::string& label, uint64_t bytes, double seconds);
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Prints a named ratio, such as cache hit ratios, as a percentage.
+ */
+void report_ratio(const std::string& label, double ratio);
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Generates integers in `[0, n)` following a Zipf distribution with the given
+ * skew, where smaller values are more popular. Sequences are deterministic for
+ * a given seed.
+ */
+class zipf_generator
+{
+public:
+  zipf_generator(uint64_t n, double skew, uint64_t seed=0);
+
+  uint64_t operator()();
+
+private:
+  std::vector<double> m_cdf;
+  std::mt19937_64 m_engine;
+  std::uniform_real_distribution<double> m_distribution;
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Prevents the compiler from optimizing away computations whose results are
+ * otherwise unused.
+ */
+template<class T>
+inline void do_not_optimize(const T& value)
+{
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace benchmark */
+} /* end namespace sneaker */
+
+
+#define SNEAKER_BENCHMARK(group, name)                                      \
+  static void group##_##name##_benchmark();                                 \
+  static ::sneaker::benchmark::registrar group##_##name##_registrar(        \
+    #group "." #name, &group##_##name##_benchmark);                         \
+  static void group##_##name##_benchmark()
+
+
+#endif /* SNEAKER_BENCHMARK_H_ */
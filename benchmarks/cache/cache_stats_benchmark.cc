@@ -0,0 +1,159 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `cache_stats_recorder` in sneaker/cache/cache_stats.h */
+
+#include "cache/cache_interface.h"
+#include "cache/cache_stats.h"
+#include "cache/clock_cache.h"
+
+#include "benchmark.h"
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t CAPACITY = 8192;
+
+const double SKEW = 0.99;
+
+const size_t OPS = 4000000;
+
+const size_t OPS_PER_THREAD = 2000000;
+
+const size_t THREAD_COUNTS[] = { 1, 2, 4, 8 };
+
+struct noop_handler
+{
+  void operator()(uint64_t, const uint64_t&) const
+  {
+  }
+};
+
+typedef sneaker::cache::cache_interface<
+  sneaker::cache::clock_cache<uint64_t, uint64_t, CAPACITY>,
+  noop_handler, noop_handler> cache_type;
+
+void
+run_hits(const std::string& name, sneaker::cache::cache_stats_recorder* recorder)
+{
+  const noop_handler handler;
+  cache_type cache(handler, handler);
+  cache.set_stats_recorder(recorder);
+
+  for (uint64_t key = 0; key < CAPACITY; ++key)
+  {
+    cache.insert(key, key);
+  }
+
+  sneaker::benchmark::zipf_generator generator(CAPACITY, SKEW, 1);
+
+  std::vector<uint64_t> keys(OPS);
+  for (auto& key : keys)
+  {
+    key = generator();
+  }
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (const uint64_t key : keys)
+  {
+    uint64_t value = 0;
+    cache.get(key, value);
+    sneaker::benchmark::do_not_optimize(value);
+  }
+
+  sneaker::benchmark::report_throughput(name, OPS, stopwatch.elapsed_seconds());
+}
+
+template<class Func>
+void
+run_threads(const std::string& name, size_t thread_count, Func func)
+{
+  std::vector<std::thread> threads;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (size_t i = 0; i < thread_count; ++i)
+  {
+    threads.push_back(std::thread(func));
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  std::ostringstream label;
+  label << name << " (" << thread_count << " threads)";
+
+  sneaker::benchmark::report_throughput(label.str(),
+    OPS_PER_THREAD * thread_count, stopwatch.elapsed_seconds());
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(cache_stats, HitsOverhead)
+{
+  run_hits("without stats", NULL);
+
+  sneaker::cache::cache_stats_recorder recorder;
+  run_hits("with stats", &recorder);
+}
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(cache_stats, ConcurrentRecording)
+{
+  for (const size_t thread_count : THREAD_COUNTS)
+  {
+    std::atomic<uint64_t> counter(0);
+
+    run_threads("shared atomic counter", thread_count, [&counter]() {
+      for (size_t i = 0; i < OPS_PER_THREAD; ++i)
+      {
+        counter.fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+
+    sneaker::cache::cache_stats_recorder recorder;
+
+    run_threads("cache_stats_recorder", thread_count, [&recorder]() {
+      for (size_t i = 0; i < OPS_PER_THREAD; ++i)
+      {
+        recorder.record_hit();
+      }
+    });
+  }
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,142 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `clock_cache` in sneaker/cache/clock_cache.h */
+
+#include "cache/clock_cache.h"
+#include "cache/lru_cache.h"
+
+#include "benchmark.h"
+
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t CAPACITY = 8192;
+
+const uint64_t KEY_SPACE = 100000;
+
+const double SKEW = 0.99;
+
+const size_t OPS = 4000000;
+
+std::vector<uint64_t>
+generate_keys(uint64_t key_space)
+{
+  sneaker::benchmark::zipf_generator generator(key_space, SKEW, 1);
+
+  std::vector<uint64_t> keys(OPS);
+  for (auto& key : keys)
+  {
+    key = generator();
+  }
+
+  return keys;
+}
+
+template<class CacheType>
+void
+run_read_mostly(const std::string& name)
+{
+  CacheType cache;
+  const std::vector<uint64_t> keys = generate_keys(KEY_SPACE);
+
+  uint64_t hits = 0;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (const uint64_t key : keys)
+  {
+    uint64_t value = 0;
+
+    if (cache.get(key, value))
+    {
+      ++hits;
+    }
+    else
+    {
+      cache.insert(key, key);
+    }
+
+    sneaker::benchmark::do_not_optimize(value);
+  }
+
+  const double seconds = stopwatch.elapsed_seconds();
+
+  sneaker::benchmark::report_throughput(name, OPS, seconds);
+  sneaker::benchmark::report_ratio(name + " hit ratio",
+    static_cast<double>(hits) / static_cast<double>(OPS));
+}
+
+template<class CacheType>
+void
+run_hits_only(const std::string& name)
+{
+  CacheType cache;
+
+  for (uint64_t key = 0; key < CAPACITY; ++key)
+  {
+    cache.insert(key, key);
+  }
+
+  const std::vector<uint64_t> keys = generate_keys(CAPACITY);
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (const uint64_t key : keys)
+  {
+    uint64_t value = 0;
+    cache.get(key, value);
+    sneaker::benchmark::do_not_optimize(value);
+  }
+
+  sneaker::benchmark::report_throughput(name, OPS, stopwatch.elapsed_seconds());
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(clock_cache, ZipfReadThrough)
+{
+  run_read_mostly<sneaker::cache::lru_cache<uint64_t, uint64_t, CAPACITY>>(
+    "lru_cache");
+  run_read_mostly<sneaker::cache::clock_cache<uint64_t, uint64_t, CAPACITY>>(
+    "clock_cache");
+}
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(clock_cache, HitsOnly)
+{
+  run_hits_only<sneaker::cache::lru_cache<uint64_t, uint64_t, CAPACITY>>(
+    "lru_cache");
+  run_hits_only<sneaker::cache::clock_cache<uint64_t, uint64_t, CAPACITY>>(
+    "clock_cache");
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,172 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `sharded_cache` in sneaker/cache/sharded_cache.h */
+
+#include "cache/cache_interface.h"
+#include "cache/lru_cache.h"
+#include "cache/sharded_cache.h"
+
+#include "benchmark.h"
+
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t CAPACITY = 8192;
+
+const size_t SHARDS = 16;
+
+const uint64_t KEY_SPACE = 100000;
+
+const double SKEW = 0.99;
+
+const size_t OPS_PER_THREAD = 1000000;
+
+const size_t THREAD_COUNTS[] = { 1, 2, 4, 8 };
+
+struct noop_handler
+{
+  void operator()(uint64_t, const uint64_t&) const
+  {
+  }
+};
+
+typedef sneaker::cache::cache_interface<
+  sneaker::cache::lru_cache<uint64_t, uint64_t, CAPACITY>,
+  noop_handler, noop_handler> lru_cache_type;
+
+typedef sneaker::cache::sharded_cache<
+  sneaker::cache::lru_cache<uint64_t, uint64_t, CAPACITY / SHARDS>,
+  noop_handler, noop_handler, SHARDS> sharded_cache_type;
+
+/**
+ * `lru_cache` behind a single mutex, which is what users of the unsharded
+ * cache have to resort to.
+ */
+class locked_lru_cache
+{
+public:
+  locked_lru_cache()
+    :
+    m_mutex(),
+    m_cache(noop_handler(), noop_handler())
+  {
+  }
+
+  bool get(uint64_t key, uint64_t& value)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cache.get(key, value);
+  }
+
+  void insert(uint64_t key, const uint64_t& value)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache.insert(key, value);
+  }
+
+private:
+  std::mutex m_mutex;
+  lru_cache_type m_cache;
+};
+
+template<class CacheType>
+void
+run_read_through(const char* name, CacheType& cache, size_t thread_count)
+{
+  std::atomic<uint64_t> hits(0);
+  std::vector<std::thread> threads;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (size_t t = 0; t < thread_count; ++t)
+  {
+    threads.push_back(std::thread([&cache, &hits, t]() {
+      sneaker::benchmark::zipf_generator generator(KEY_SPACE, SKEW, t + 1);
+      uint64_t local_hits = 0;
+
+      for (size_t i = 0; i < OPS_PER_THREAD; ++i)
+      {
+        const uint64_t key = generator();
+        uint64_t value = 0;
+
+        if (cache.get(key, value))
+        {
+          ++local_hits;
+        }
+        else
+        {
+          cache.insert(key, key);
+        }
+      }
+
+      hits += local_hits;
+    }));
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  const double seconds = stopwatch.elapsed_seconds();
+  const uint64_t ops = OPS_PER_THREAD * thread_count;
+
+  std::stringstream label;
+  label << name << " threads=" << thread_count;
+
+  sneaker::benchmark::report_throughput(label.str(), ops, seconds);
+  sneaker::benchmark::report_ratio(label.str() + " hit ratio",
+    static_cast<double>(hits.load()) / static_cast<double>(ops));
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(sharded_cache, ZipfReadThrough)
+{
+  for (size_t thread_count : THREAD_COUNTS)
+  {
+    locked_lru_cache cache;
+    run_read_through("lru_cache + mutex", cache, thread_count);
+  }
+
+  const noop_handler handler;
+
+  for (size_t thread_count : THREAD_COUNTS)
+  {
+    sharded_cache_type cache(handler, handler);
+    run_read_through("sharded_cache<16>", cache, thread_count);
+  }
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,181 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Hit ratio benchmark for `tinylfu_cache` in sneaker/cache/tinylfu_cache.h */
+
+#include "cache/clock_cache.h"
+#include "cache/lru_cache.h"
+#include "cache/tinylfu_cache.h"
+
+#include "benchmark.h"
+
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t CAPACITY = 2000;
+
+const size_t TRACE_LENGTH = 2000000;
+
+typedef std::vector<uint64_t> trace_type;
+
+/**
+ * Skewed accesses over a key space 50 times larger than the cache.
+ */
+trace_type
+zipf_trace()
+{
+  sneaker::benchmark::zipf_generator generator(CAPACITY * 50, 0.9, 1);
+
+  trace_type trace(TRACE_LENGTH);
+  for (auto& key : trace)
+  {
+    key = generator();
+  }
+
+  return trace;
+}
+
+/**
+ * Skewed accesses interleaved with sequential scans over keys that are never
+ * accessed again. Every scan is twice as long as the capacity of the cache.
+ */
+trace_type
+scan_mixed_trace()
+{
+  sneaker::benchmark::zipf_generator generator(CAPACITY * 50, 0.9, 2);
+
+  const size_t scan_length = CAPACITY * 2;
+  const size_t scan_interval = CAPACITY * 10;
+
+  uint64_t next_scan_key = CAPACITY * 50;
+
+  trace_type trace;
+  trace.reserve(TRACE_LENGTH);
+
+  while (trace.size() < TRACE_LENGTH)
+  {
+    for (size_t i = 0; i < scan_interval && trace.size() < TRACE_LENGTH; ++i)
+    {
+      trace.push_back(generator());
+    }
+
+    for (size_t i = 0; i < scan_length && trace.size() < TRACE_LENGTH; ++i)
+    {
+      trace.push_back(next_scan_key++);
+    }
+  }
+
+  return trace;
+}
+
+/**
+ * Cyclic accesses over a key space slightly larger than the cache, which is
+ * the worst case of LRU.
+ */
+trace_type
+loop_trace()
+{
+  const uint64_t loop_length = CAPACITY + CAPACITY / 4;
+
+  trace_type trace(TRACE_LENGTH);
+  for (size_t i = 0; i < TRACE_LENGTH; ++i)
+  {
+    trace[i] = i % loop_length;
+  }
+
+  return trace;
+}
+
+template<class CacheType>
+void
+run_trace(const std::string& name, const trace_type& trace)
+{
+  CacheType cache;
+
+  uint64_t hits = 0;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (const uint64_t key : trace)
+  {
+    uint64_t value = 0;
+
+    if (cache.get(key, value))
+    {
+      ++hits;
+    }
+    else
+    {
+      cache.insert(key, key);
+    }
+  }
+
+  const double seconds = stopwatch.elapsed_seconds();
+
+  sneaker::benchmark::report_ratio(name + " hit ratio",
+    static_cast<double>(hits) / static_cast<double>(trace.size()));
+  sneaker::benchmark::report_throughput(name, trace.size(), seconds);
+}
+
+void
+run_all(const std::string& trace_name, const trace_type& trace)
+{
+  using namespace sneaker::cache;
+
+  run_trace<lru_cache<uint64_t, uint64_t, CAPACITY>>(
+    trace_name + " lru_cache", trace);
+  run_trace<clock_cache<uint64_t, uint64_t, CAPACITY>>(
+    trace_name + " clock_cache", trace);
+  run_trace<tinylfu_cache<uint64_t, uint64_t, CAPACITY>>(
+    trace_name + " tinylfu_cache", trace);
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(tinylfu_cache, Zipf)
+{
+  run_all("zipf", zipf_trace());
+}
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(tinylfu_cache, ScanMixed)
+{
+  run_all("scan-mixed", scan_mixed_trace());
+}
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(tinylfu_cache, Loop)
+{
+  run_all("loop", loop_trace());
+}
+
+// -----------------------------------------------------------------------------
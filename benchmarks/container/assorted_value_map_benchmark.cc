@@ -0,0 +1,205 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `assorted_value_map` in sneaker/container/assorted_value_map.h,
+ * `flat_assorted_value_map` in sneaker/container/flat_assorted_value_map.h and
+ * `columnar_assorted_value_map` in
+ * sneaker/container/columnar_assorted_value_map.h */
+
+#include "container/assorted_value_map.h"
+#include "container/columnar_assorted_value_map.h"
+#include "container/flat_assorted_value_map.h"
+
+#include "benchmark.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t SIZE = 1000000;
+
+const size_t OPS = 4000000;
+
+std::vector<uint64_t>
+generate_keys(size_t count, uint64_t seed)
+{
+  std::mt19937_64 engine(seed);
+  std::uniform_int_distribution<uint64_t> distribution(0, SIZE * 4);
+
+  std::vector<uint64_t> keys(count);
+  for (auto& key : keys)
+  {
+    key = distribution(engine);
+  }
+
+  return keys;
+}
+
+template<class MapType>
+void
+run_lookups(const std::string& name, const MapType& map)
+{
+  const std::vector<uint64_t> keys = generate_keys(OPS, 2);
+
+  uint64_t found = 0;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (const uint64_t key : keys)
+  {
+    if (map.find(key) != map.end())
+    {
+      ++found;
+    }
+  }
+
+  sneaker::benchmark::report_throughput(name, OPS, stopwatch.elapsed_seconds());
+  sneaker::benchmark::do_not_optimize(found);
+}
+
+template<class MapType>
+void
+run_scan(const std::string& name, const MapType& map)
+{
+  uint64_t sum = 0;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (auto itr = map.begin(); itr != map.end(); ++itr)
+  {
+    sum += boost::get<0>(itr->second);
+  }
+
+  sneaker::benchmark::report_throughput(name, map.size(),
+    stopwatch.elapsed_seconds());
+  sneaker::benchmark::do_not_optimize(sum);
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(assorted_value_map, LookupsAndScans)
+{
+  typedef sneaker::container::assorted_value_map<uint64_t, uint64_t, double>
+    map_type;
+  typedef sneaker::container::flat_assorted_value_map<uint64_t, uint64_t,
+    double> flat_map_type;
+
+  const std::vector<uint64_t> keys = generate_keys(SIZE, 1);
+
+  map_type map;
+  for (const uint64_t key : keys)
+  {
+    map.insert(key, key, 0.0);
+  }
+
+  std::vector<flat_map_type::value_type> pairs;
+  pairs.reserve(keys.size());
+  for (const uint64_t key : keys)
+  {
+    pairs.push_back(
+      flat_map_type::value_type(key, flat_map_type::mapped_type(key, 0.0)));
+  }
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  flat_map_type flat_map;
+  flat_map.build_from(pairs.begin(), pairs.end());
+
+  sneaker::benchmark::report_throughput("flat_assorted_value_map build_from",
+    SIZE, stopwatch.elapsed_seconds());
+
+  run_lookups("assorted_value_map find", map);
+  run_lookups("flat_assorted_value_map find", flat_map);
+
+  run_scan("assorted_value_map scan", map);
+  run_scan("flat_assorted_value_map scan", flat_map);
+}
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(assorted_value_map, ColumnScan)
+{
+  typedef sneaker::container::flat_assorted_value_map<uint64_t, double,
+    std::string, uint64_t> flat_map_type;
+  typedef sneaker::container::columnar_assorted_value_map<uint64_t, double,
+    std::string, uint64_t> columnar_map_type;
+
+  const std::vector<uint64_t> keys = generate_keys(SIZE, 1);
+
+  std::vector<flat_map_type::value_type> pairs;
+  pairs.reserve(keys.size());
+  for (const uint64_t key : keys)
+  {
+    pairs.push_back(flat_map_type::value_type(key,
+      flat_map_type::mapped_type(static_cast<double>(key), "value", key)));
+  }
+
+  flat_map_type flat_map;
+  flat_map.build_from(pairs.begin(), pairs.end());
+
+  columnar_map_type columnar_map;
+  columnar_map.build_from(pairs.begin(), pairs.end());
+
+  const size_t PASSES = 20;
+
+  double sum = 0;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (size_t i = 0; i < PASSES; ++i)
+  {
+    for (auto itr = flat_map.begin(); itr != flat_map.end(); ++itr)
+    {
+      sum += boost::get<0>(itr->second);
+    }
+  }
+
+  sneaker::benchmark::report_throughput("flat_assorted_value_map column scan",
+    PASSES * flat_map.size(), stopwatch.elapsed_seconds());
+
+  stopwatch.reset();
+
+  for (size_t i = 0; i < PASSES; ++i)
+  {
+    for (auto itr = columnar_map.column_begin<0>();
+      itr != columnar_map.column_end<0>(); ++itr)
+    {
+      sum += *itr;
+    }
+  }
+
+  sneaker::benchmark::report_throughput(
+    "columnar_assorted_value_map column scan",
+    PASSES * columnar_map.size(), stopwatch.elapsed_seconds());
+
+  sneaker::benchmark::do_not_optimize(sum);
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,203 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `reservation_map` in sneaker/container/reservation_map.h,
+ * `slot_map` in sneaker/container/slot_map.h and `concurrent_reservation_map`
+ * in sneaker/container/concurrent_reservation_map.h */
+
+#include "container/concurrent_reservation_map.h"
+#include "container/reservation_map.h"
+#include "container/slot_map.h"
+
+#include "benchmark.h"
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t LIVE = 10000;
+
+const size_t OPS = 200000;
+
+/**
+ * Keeps `LIVE` reservations alive, and replaces the oldest one with a new
+ * reservation that is stored into and read from, `OPS` times.
+ */
+template<class MapType>
+void
+run_churn(const std::string& name, size_t ops)
+{
+  typedef typename MapType::token_t token_t;
+
+  MapType map;
+  std::vector<token_t> tokens;
+
+  for (size_t i = 0; i < LIVE; ++i)
+  {
+    tokens.push_back(map.reserve());
+    map.put(tokens.back(), i);
+  }
+
+  uint64_t sum = 0;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (size_t i = 0; i < ops; ++i)
+  {
+    token_t& token = tokens[i % LIVE];
+    map.unreserve(token);
+
+    token = map.reserve();
+    map.put(token, i);
+
+    uint64_t value = 0;
+    map.get(token, &value);
+    sum += value;
+  }
+
+  sneaker::benchmark::report_throughput(name, ops,
+    stopwatch.elapsed_seconds());
+  sneaker::benchmark::do_not_optimize(sum);
+}
+
+const size_t THREADS = 4;
+
+/**
+ * A container guarded by a single mutex, as handle tables shared between
+ * threads are without `concurrent_reservation_map`.
+ */
+template<class MapType>
+class locked_map
+{
+public:
+  typedef typename MapType::token_t token_t;
+
+  explicit locked_map(size_t)
+  {
+  }
+
+  token_t reserve()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_map.reserve();
+  }
+
+  bool put(token_t id, uint64_t value)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_map.put(id, value);
+  }
+
+  bool get(token_t id, uint64_t* ptr)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_map.get(id, ptr);
+  }
+
+  bool unreserve(token_t id)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_map.unreserve(id);
+  }
+
+private:
+  std::mutex m_mutex;
+  MapType m_map;
+};
+
+/**
+ * Every thread repeatedly reserves a token, puts a value for it, reads the
+ * value back and unreserves the token.
+ */
+template<class MapType>
+void
+run_concurrent_cycles(const std::string& name, size_t ops_per_thread)
+{
+  MapType map(THREADS * 16);
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < THREADS; ++t)
+  {
+    threads.push_back(std::thread([&map, ops_per_thread]() {
+      uint64_t sum = 0;
+
+      for (size_t i = 0; i < ops_per_thread; ++i)
+      {
+        const typename MapType::token_t token = map.reserve();
+        map.put(token, i);
+
+        uint64_t value = 0;
+        map.get(token, &value);
+        sum += value;
+
+        map.unreserve(token);
+      }
+
+      sneaker::benchmark::do_not_optimize(sum);
+    }));
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  sneaker::benchmark::report_throughput(name, THREADS * ops_per_thread,
+    stopwatch.elapsed_seconds());
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(reservation_map, Churn)
+{
+  run_churn<sneaker::container::reservation_map<uint64_t>>(
+    "reservation_map churn", OPS);
+  run_churn<sneaker::container::slot_map<uint64_t>>(
+    "slot_map churn", OPS * 50);
+}
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(reservation_map, ConcurrentCycles)
+{
+  run_concurrent_cycles<
+    locked_map<sneaker::container::reservation_map<uint64_t>>>(
+      "locked reservation_map cycles", OPS / 4);
+  run_concurrent_cycles<locked_map<sneaker::container::slot_map<uint64_t>>>(
+    "locked slot_map cycles", OPS * 10);
+  run_concurrent_cycles<
+    sneaker::container::concurrent_reservation_map<uint64_t>>(
+      "concurrent_reservation_map cycles", OPS * 10);
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,129 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `unordered_assorted_value_map` and
+ * `flat_unordered_assorted_value_map` in
+ * sneaker/container/unordered_assorted_value_map.h */
+
+#include "container/unordered_assorted_value_map.h"
+
+#include "benchmark.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t SIZE = 1000000;
+
+std::vector<uint64_t>
+generate_keys(size_t count, uint64_t seed)
+{
+  std::mt19937_64 engine(seed);
+
+  std::vector<uint64_t> keys(count);
+  for (auto& key : keys)
+  {
+    key = engine();
+  }
+
+  return keys;
+}
+
+template<class MapType>
+void
+run_operations(const std::string& name, const std::vector<uint64_t>& keys,
+  const std::vector<uint64_t>& missing_keys)
+{
+  MapType map;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (const uint64_t key : keys)
+  {
+    map.insert(key, key, 0.0);
+  }
+
+  sneaker::benchmark::report_throughput(name + " insert", keys.size(),
+    stopwatch.elapsed_seconds());
+
+  uint64_t found = 0;
+
+  stopwatch.reset();
+
+  for (const uint64_t key : keys)
+  {
+    found += map.find(key) != map.end();
+  }
+
+  sneaker::benchmark::report_throughput(name + " lookup hit", keys.size(),
+    stopwatch.elapsed_seconds());
+
+  stopwatch.reset();
+
+  for (const uint64_t key : missing_keys)
+  {
+    found += map.find(key) != map.end();
+  }
+
+  sneaker::benchmark::report_throughput(name + " lookup miss",
+    missing_keys.size(), stopwatch.elapsed_seconds());
+
+  stopwatch.reset();
+
+  for (const uint64_t key : keys)
+  {
+    found += map.erase(key);
+  }
+
+  sneaker::benchmark::report_throughput(name + " erase", keys.size(),
+    stopwatch.elapsed_seconds());
+
+  sneaker::benchmark::do_not_optimize(found);
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(unordered_assorted_value_map, Operations)
+{
+  typedef sneaker::container::unordered_assorted_value_map<uint64_t, uint64_t,
+    double> map_type;
+  typedef sneaker::container::flat_unordered_assorted_value_map<uint64_t,
+    uint64_t, double> flat_map_type;
+
+  const std::vector<uint64_t> keys = generate_keys(SIZE, 1);
+  const std::vector<uint64_t> missing_keys = generate_keys(SIZE, 2);
+
+  run_operations<map_type>("unordered_assorted_value_map", keys,
+    missing_keys);
+  run_operations<flat_map_type>("flat_unordered_assorted_value_map", keys,
+    missing_keys);
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,133 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "graph_generator.h"
+
+#include "algorithm/csr_graph.h"
+#include "benchmark.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+
+namespace sneaker {
+
+
+namespace benchmark {
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+typedef sneaker::algorithm::csr_graph csr_graph;
+
+std::vector<csr_graph::vertex_id>
+random_permutation(size_t vertex_count, uint64_t seed)
+{
+  std::vector<csr_graph::vertex_id> permutation(vertex_count);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::shuffle(permutation.begin(), permutation.end(), std::mt19937_64(seed));
+
+  return permutation;
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+csr_graph
+generate_uniform_graph(size_t vertex_count, size_t edge_count, uint64_t seed)
+{
+  std::mt19937_64 engine(seed);
+  std::uniform_int_distribution<csr_graph::vertex_id> distribution(0,
+    static_cast<csr_graph::vertex_id>(vertex_count - 1));
+
+  std::vector<csr_graph::edge> edges(edge_count);
+  for (auto& edge : edges)
+  {
+    edge.first = distribution(engine);
+    edge.second = distribution(engine);
+  }
+
+  return csr_graph::from_edges(vertex_count, edges);
+}
+
+// -----------------------------------------------------------------------------
+
+csr_graph
+generate_power_law_graph(size_t vertex_count, size_t edge_count, double skew,
+  uint64_t seed)
+{
+  const std::vector<csr_graph::vertex_id> permutation =
+    random_permutation(vertex_count, seed);
+
+  zipf_generator sources(vertex_count, skew, seed + 1);
+  zipf_generator targets(vertex_count, skew, seed + 2);
+
+  std::vector<csr_graph::edge> edges(edge_count);
+  for (auto& edge : edges)
+  {
+    edge.first = permutation[sources()];
+    edge.second = permutation[targets()];
+  }
+
+  return csr_graph::from_edges(vertex_count, edges);
+}
+
+// -----------------------------------------------------------------------------
+
+csr_graph
+generate_dag(size_t vertex_count, size_t edge_count, size_t span,
+  uint64_t seed)
+{
+  const std::vector<csr_graph::vertex_id> permutation =
+    random_permutation(vertex_count, seed);
+
+  std::mt19937_64 engine(seed + 1);
+  std::uniform_int_distribution<size_t> sources(0, vertex_count - 2);
+  std::uniform_int_distribution<size_t> distances(1,
+    std::max<size_t>(span, 1));
+
+  std::vector<csr_graph::edge> edges(edge_count);
+  for (auto& edge : edges)
+  {
+    const size_t source = sources(engine);
+    const size_t target = std::min(source + distances(engine),
+      vertex_count - 1);
+
+    edge.first = permutation[source];
+    edge.second = permutation[target];
+  }
+
+  return csr_graph::from_edges(vertex_count, edges);
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace benchmark */
+
+
+} /* end namespace sneaker */
@@ -0,0 +1,79 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/*
+ * Synthetic graphs shared by the benchmarks of `sneaker::algorithm`.
+ *
+ * Every generator is deterministic for a given seed, and relabels the
+ * vertices through a random permutation, so that no benchmark benefits from
+ * vertex identifiers that happen to follow the structure of the graph.
+ */
+
+#ifndef SNEAKER_BENCHMARK_GRAPH_GENERATOR_H_
+#define SNEAKER_BENCHMARK_GRAPH_GENERATOR_H_
+
+#include "algorithm/csr_graph.h"
+
+#include <cstdint>
+#include <cstdlib>
+
+
+namespace sneaker {
+namespace benchmark {
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Generates a graph whose edges join vertices drawn uniformly at random.
+ */
+sneaker::algorithm::csr_graph generate_uniform_graph(size_t vertex_count,
+  size_t edge_count, uint64_t seed);
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Generates a graph whose in-degrees and out-degrees follow a power law, by
+ * drawing both ends of every edge from a Zipf distribution of the specified
+ * skew.
+ */
+sneaker::algorithm::csr_graph generate_power_law_graph(size_t vertex_count,
+  size_t edge_count, double skew, uint64_t seed);
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Generates a DAG whose edges each join two vertices drawn uniformly at
+ * random, directed along a hidden topological order. `span` bounds the
+ * distance between the ends of an edge in that order, where smaller spans
+ * make for longer paths.
+ */
+sneaker::algorithm::csr_graph generate_dag(size_t vertex_count,
+  size_t edge_count, size_t span, uint64_t seed);
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace benchmark */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_BENCHMARK_GRAPH_GENERATOR_H_ */
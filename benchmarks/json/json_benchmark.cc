@@ -0,0 +1,188 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `sneaker::json::parse()` in sneaker/json/json.h and
+ * `json_writer` in sneaker/json/json_writer.h */
+
+#include "io/output_stream.h"
+#include "json/json.h"
+#include "json/json_writer.h"
+
+#include "benchmark.h"
+#include "json_generator.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t DOCUMENT_SIZE = 32 * 1024 * 1024;
+
+const size_t DOUBLE_COUNT = 1024 * 1024;
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(json, SharedParse)
+{
+  const auto str = std::make_shared<const std::string>(
+    sneaker::benchmark::generate_json_document(DOCUMENT_SIZE, 1));
+
+  const size_t PASSES = 4;
+
+  size_t size = 0;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (size_t i = 0; i < PASSES; ++i) {
+    const sneaker::json::JSON json = sneaker::json::parse(*str);
+    for (const auto& record : json.array_items()) {
+      size += record["user"]["name"].string_value().size();
+    }
+  }
+
+  sneaker::benchmark::report_bandwidth("parse and read strings",
+    PASSES * str->size(), stopwatch.elapsed_seconds());
+
+  stopwatch.reset();
+
+  for (size_t i = 0; i < PASSES; ++i) {
+    const sneaker::json::JSON json = sneaker::json::parse(str);
+    for (const auto& record : json.array_items()) {
+      size += record["user"]["name"].string_view_value().size();
+    }
+  }
+
+  sneaker::benchmark::report_bandwidth("shared parse and read string views",
+    PASSES * str->size(), stopwatch.elapsed_seconds());
+
+  sneaker::benchmark::do_not_optimize(size);
+}
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(json, Serialize)
+{
+  const sneaker::json::JSON json = sneaker::json::parse(
+    sneaker::benchmark::generate_json_document(DOCUMENT_SIZE, 1));
+
+  const size_t PASSES = 4;
+
+  size_t size = 0;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (size_t i = 0; i < PASSES; ++i) {
+    size += json.dump().size();
+  }
+
+  sneaker::benchmark::report_bandwidth("JSON dump", size,
+    stopwatch.elapsed_seconds());
+
+  const sneaker::json::json_writer compact;
+  const sneaker::json::json_writer pretty(
+    sneaker::json::json_writer::style::PRETTY);
+
+  size = 0;
+  stopwatch.reset();
+
+  for (size_t i = 0; i < PASSES; ++i) {
+    size += compact.write(json).size();
+  }
+
+  sneaker::benchmark::report_bandwidth("json_writer compact", size,
+    stopwatch.elapsed_seconds());
+
+  size = 0;
+  stopwatch.reset();
+
+  for (size_t i = 0; i < PASSES; ++i) {
+    size += pretty.write(json).size();
+  }
+
+  sneaker::benchmark::report_bandwidth("json_writer pretty", size,
+    stopwatch.elapsed_seconds());
+
+  std::ofstream null_file("/dev/null");
+  std::unique_ptr<sneaker::io::output_stream> stream =
+    sneaker::io::ostream_output_stream(null_file, 64 * 1024);
+
+  stopwatch.reset();
+
+  for (size_t i = 0; i < PASSES; ++i) {
+    compact.write(json, stream.get());
+  }
+  stream->flush();
+
+  sneaker::benchmark::report_bandwidth("json_writer compact to stream",
+    stream->bytes_written(), stopwatch.elapsed_seconds());
+
+  // Numbers that are not integers, with random bits, which mostly need 16 or
+  // 17 significant digits.
+  std::mt19937_64 random(1);
+  sneaker::json::JSON::array numbers;
+  numbers.reserve(DOUBLE_COUNT);
+
+  while (numbers.size() < DOUBLE_COUNT) {
+    const uint64_t bits = random();
+    double value;
+    memcpy(&value, &bits, sizeof value);
+
+    if (std::isfinite(value)) {
+      numbers.push_back(value);
+    }
+  }
+
+  const sneaker::json::JSON doubles(numbers);
+
+  stopwatch.reset();
+
+  for (size_t i = 0; i < PASSES; ++i) {
+    size += doubles.dump().size();
+  }
+
+  sneaker::benchmark::report_throughput("JSON dump doubles",
+    PASSES * DOUBLE_COUNT, stopwatch.elapsed_seconds());
+
+  stopwatch.reset();
+
+  for (size_t i = 0; i < PASSES; ++i) {
+    size += compact.write(doubles).size();
+  }
+
+  sneaker::benchmark::report_throughput("json_writer compact doubles",
+    PASSES * DOUBLE_COUNT, stopwatch.elapsed_seconds());
+
+  sneaker::benchmark::do_not_optimize(size);
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,146 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `json_document` in sneaker/json/json_document.h and
+ * `json_structural_index` in sneaker/json/json_structural_index.h, against
+ * `JSON` in sneaker/json/json.h */
+
+#include "json/json.h"
+#include "json/json_document.h"
+#include "json/json_structural_index.h"
+
+#include "benchmark.h"
+#include "json_generator.h"
+
+#include <string>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t DOCUMENT_SIZE = 32 * 1024 * 1024;
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(json_document, ParseAndTraverse)
+{
+  const std::string str =
+    sneaker::benchmark::generate_json_document(DOCUMENT_SIZE, 1);
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  const sneaker::json::JSON json = sneaker::json::parse(str);
+
+  sneaker::benchmark::report_bandwidth("JSON parse", str.size(),
+    stopwatch.elapsed_seconds());
+
+  stopwatch.reset();
+
+  const sneaker::json::json_document document =
+    sneaker::json::parse_document(str);
+
+  sneaker::benchmark::report_bandwidth("json_document parse", str.size(),
+    stopwatch.elapsed_seconds());
+
+  stopwatch.reset();
+
+  double sum = 0;
+  for (const auto& record : json.array_items()) {
+    sum += record["score"].number_value();
+    sum += static_cast<double>(record["user"]["name"].string_value().size());
+  }
+
+  sneaker::benchmark::report_throughput("JSON traverse records",
+    json.array_items().size(), stopwatch.elapsed_seconds());
+
+  stopwatch.reset();
+
+  for (const sneaker::json::json_view record :
+    document.root().array_items())
+  {
+    sum += record["score"].number_value();
+    sum += static_cast<double>(record["user"]["name"].string_size());
+  }
+
+  sneaker::benchmark::report_throughput("json_document traverse records",
+    document.root().size(), stopwatch.elapsed_seconds());
+
+  sneaker::benchmark::do_not_optimize(sum);
+}
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(json_document, TwoStageParse)
+{
+  const std::string str =
+    sneaker::benchmark::generate_json_document(DOCUMENT_SIZE, 1);
+
+  const size_t PASSES = 4;
+
+  sneaker::json::json_structural_index index;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  for (size_t i = 0; i < PASSES; ++i) {
+    index.build(str.data(), str.size(), false);
+  }
+
+  sneaker::benchmark::report_bandwidth("json_structural_index scalar",
+    PASSES * str.size(), stopwatch.elapsed_seconds());
+
+  stopwatch.reset();
+
+  for (size_t i = 0; i < PASSES; ++i) {
+    index.build(str.data(), str.size(), true);
+  }
+
+  sneaker::benchmark::report_bandwidth("json_structural_index SIMD",
+    PASSES * str.size(), stopwatch.elapsed_seconds());
+
+  size_t count = 0;
+
+  stopwatch.reset();
+
+  for (size_t i = 0; i < PASSES; ++i) {
+    count += sneaker::json::parse_document(str).value_count();
+  }
+
+  sneaker::benchmark::report_bandwidth("parse_document",
+    PASSES * str.size(), stopwatch.elapsed_seconds());
+
+  stopwatch.reset();
+
+  for (size_t i = 0; i < PASSES; ++i) {
+    count += sneaker::json::parse_indexed_document(str).value_count();
+  }
+
+  sneaker::benchmark::report_bandwidth("parse_indexed_document",
+    PASSES * str.size(), stopwatch.elapsed_seconds());
+
+  sneaker::benchmark::do_not_optimize(count);
+}
+
+// -----------------------------------------------------------------------------
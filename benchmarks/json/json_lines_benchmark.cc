@@ -0,0 +1,121 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `json_lines_reader` in sneaker/json/json_lines.h, against
+ * parsing every line with `parse()` in sneaker/json/json.h */
+
+#include "json/json.h"
+#include "json/json_lines.h"
+
+#include "benchmark.h"
+#include "json_generator.h"
+
+#include "io/input_stream.h"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t RECORD_COUNT = 200000;
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(json_lines, ReadRecords)
+{
+  const std::vector<std::string> records =
+    sneaker::benchmark::generate_json_records(RECORD_COUNT, 1);
+
+  std::string str;
+  for (const auto& record : records) {
+    str += record;
+    str += '\n';
+  }
+
+  size_t count = 0;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  // Splits and parses the lines one by one, as a baseline.
+  std::string line;
+  for (const char* begin = str.data(); begin != str.data() + str.size(); ) {
+    const char* newline = static_cast<const char*>(memchr(begin, '\n',
+      static_cast<size_t>(str.data() + str.size() - begin)));
+    line.assign(begin, newline);
+    count += sneaker::json::parse(line).object_items().size();
+    begin = newline + 1;
+  }
+
+  sneaker::benchmark::report_throughput("parse per line", RECORD_COUNT,
+    stopwatch.elapsed_seconds());
+
+  std::vector<size_t> thread_counts { 1 };
+  if (std::thread::hardware_concurrency() > 1) {
+    thread_counts.push_back(std::thread::hardware_concurrency());
+  }
+
+  for (size_t thread_count : thread_counts) {
+    for (auto order : { sneaker::json::json_lines_reader::delivery::ORDERED,
+      sneaker::json::json_lines_reader::delivery::UNORDERED })
+    {
+      const sneaker::json::json_lines_reader reader(thread_count, order);
+
+      std::unique_ptr<sneaker::io::input_stream> stream =
+        sneaker::io::memory_input_stream(
+          reinterpret_cast<const uint8_t*>(str.data()), str.size());
+
+      std::atomic<size_t> members(0);
+
+      stopwatch.reset();
+
+      reader.read(stream.get(),
+        [&members](size_t, sneaker::json::JSON& record) {
+          members.fetch_add(record.object_items().size(),
+            std::memory_order_relaxed);
+        },
+        [](size_t, const std::string&) {}
+      );
+
+      sneaker::benchmark::report_throughput(
+        "json_lines_reader " + std::to_string(thread_count) + " threads " +
+          (order == sneaker::json::json_lines_reader::delivery::ORDERED ?
+            "ordered" : "unordered"),
+        RECORD_COUNT, stopwatch.elapsed_seconds());
+
+      count += members.load();
+    }
+  }
+
+  sneaker::benchmark::do_not_optimize(count);
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,138 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Benchmark for `json_sax_parser` in sneaker/json/json_sax.h, against
+ * `json_document` in sneaker/json/json_document.h */
+
+#include "json/json_document.h"
+#include "json/json_sax.h"
+
+#include "benchmark.h"
+#include "json_generator.h"
+
+#include "io/input_stream.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t DOCUMENT_SIZE = 32 * 1024 * 1024;
+
+// -----------------------------------------------------------------------------
+
+class counting_handler : public sneaker::json::json_sax_handler
+{
+public:
+  counting_handler()
+    :
+    events(0)
+  {
+    // Do nothing here.
+  }
+
+  virtual void start_object() { ++events; }
+  virtual void key(const char*, size_t) { ++events; }
+  virtual void string_value(const char*, size_t) { ++events; }
+  virtual void int_value(int64_t) { ++events; }
+  virtual void number_value(double) { ++events; }
+
+  size_t events;
+};
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(json_sax, ParseStream)
+{
+  const std::string str =
+    sneaker::benchmark::generate_json_document(DOCUMENT_SIZE, 1);
+
+  size_t count = 0;
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  count += sneaker::json::parse_document(str).value_count();
+
+  sneaker::benchmark::report_bandwidth("parse_document", str.size(),
+    stopwatch.elapsed_seconds());
+
+  for (size_t chunk_size : { 4 * 1024, 64 * 1024 }) {
+    counting_handler handler;
+
+    stopwatch.reset();
+
+    // Feeds the document in chunks as a file stream would, without the cost
+    // of reading a file.
+    sneaker::json::json_sax_parser parser(&handler);
+    for (size_t i = 0; i < str.size(); i += chunk_size) {
+      parser.feed(str.data() + i, std::min(chunk_size, str.size() - i));
+    }
+    parser.finish();
+
+    sneaker::benchmark::report_bandwidth(
+      "json_sax_parser " + std::to_string(chunk_size / 1024) + "KB chunks",
+      str.size(), stopwatch.elapsed_seconds());
+
+    count += handler.events;
+  }
+
+  sneaker::benchmark::do_not_optimize(count);
+}
+
+// -----------------------------------------------------------------------------
+
+SNEAKER_BENCHMARK(json_sax, ParseNewlineDelimited)
+{
+  const std::vector<std::string> records =
+    sneaker::benchmark::generate_json_records(200000, 1);
+
+  std::string str;
+  for (const auto& record : records) {
+    str += record;
+    str += '\n';
+  }
+
+  counting_handler handler;
+
+  std::unique_ptr<sneaker::io::input_stream> stream =
+    sneaker::io::memory_input_stream(
+      reinterpret_cast<const uint8_t*>(str.data()), str.size());
+
+  sneaker::benchmark::stopwatch stopwatch;
+
+  sneaker::json::parse_sax(stream.get(), &handler, true);
+
+  sneaker::benchmark::report_bandwidth("parse_sax newline-delimited",
+    str.size(), stopwatch.elapsed_seconds());
+
+  sneaker::benchmark::do_not_optimize(handler.events);
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,139 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "json_generator.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace sneaker {
+
+
+namespace benchmark {
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const char* const WORDS[] = {
+  "request", "completed", "user", "session", "timeout", "cache", "miss",
+  "upstream", "latency", "retry", "payload", "accepted", "rejected", "shard",
+  "replica", "commit"
+};
+
+const size_t WORD_COUNT = sizeof(WORDS) / sizeof(WORDS[0]);
+
+// -----------------------------------------------------------------------------
+
+std::string
+generate_words(std::mt19937_64& engine, size_t count, bool escaped)
+{
+  std::string out;
+
+  for (size_t i = 0; i < count; ++i) {
+    if (i) {
+      out += (escaped && engine() % 4 == 0) ? "\\n" : " ";
+    }
+    out += WORDS[engine() % WORD_COUNT];
+  }
+
+  if (escaped) {
+    out += " \\\"quoted\\\" \\u00e9";
+  }
+
+  return out;
+}
+
+// -----------------------------------------------------------------------------
+
+std::string
+generate_json_record(std::mt19937_64& engine, uint64_t id)
+{
+  std::uniform_real_distribution<double> scores(0.0, 1000.0);
+
+  std::string out = "{\"id\": " + std::to_string(id);
+
+  out += ", \"timestamp\": " + std::to_string(1500000000000 + id * 37);
+  out += ", \"level\": \"" + std::string(WORDS[engine() % 4]) + "\"";
+  out += ", \"user\": {\"name\": \"" + generate_words(engine, 2, false) +
+    "\", \"id\": " + std::to_string(engine() % 100000) +
+    ", \"verified\": " + ((engine() % 2) ? "true" : "false") + "}";
+  out += ", \"tags\": [";
+
+  const size_t tag_count = engine() % 5;
+  for (size_t i = 0; i < tag_count; ++i) {
+    out += (i ? ", \"" : "\"") + std::string(WORDS[engine() % WORD_COUNT]) + "\"";
+  }
+
+  out += "], \"score\": " + std::to_string(scores(engine));
+  out += ", \"parent\": null";
+  out += ", \"message\": \"" +
+    generate_words(engine, 4 + engine() % 12, engine() % 8 == 0) + "\"}";
+
+  return out;
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+std::vector<std::string>
+generate_json_records(size_t record_count, uint64_t seed)
+{
+  std::mt19937_64 engine(seed);
+
+  std::vector<std::string> records;
+  records.reserve(record_count);
+
+  for (size_t i = 0; i < record_count; ++i) {
+    records.push_back(generate_json_record(engine, i));
+  }
+
+  return records;
+}
+
+// -----------------------------------------------------------------------------
+
+std::string
+generate_json_document(size_t min_size, uint64_t seed)
+{
+  std::mt19937_64 engine(seed);
+
+  std::string out = "[";
+
+  for (uint64_t id = 0; out.size() < min_size; ++id) {
+    out += (id ? ",\n" : "\n") + generate_json_record(engine, id);
+  }
+
+  return out + "\n]";
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace benchmark */
+
+
+} /* end namespace sneaker */
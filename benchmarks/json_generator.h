@@ -0,0 +1,67 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/*
+ * Synthetic JSON shared by the benchmarks of `sneaker::json`.
+ *
+ * Records resemble structured log entries: flat objects with a nested
+ * object, an array of tags, numbers of both kinds, and strings of which a
+ * fraction carry escape sequences. Every generator is deterministic for a
+ * given seed.
+ */
+
+#ifndef SNEAKER_BENCHMARK_JSON_GENERATOR_H_
+#define SNEAKER_BENCHMARK_JSON_GENERATOR_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+
+namespace sneaker {
+namespace benchmark {
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Generates the specified number of records, each a JSON object on a single
+ * line.
+ */
+std::vector<std::string> generate_json_records(size_t record_count,
+  uint64_t seed);
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Generates a JSON array of records whose size is at least `min_size` bytes.
+ */
+std::string generate_json_document(size_t min_size, uint64_t seed);
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace benchmark */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_BENCHMARK_JSON_GENERATOR_H_ */
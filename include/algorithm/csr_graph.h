@@ -0,0 +1,202 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::algorithm::csr_graph` is an immutable directed graph in the
+ * compressed sparse row (CSR) representation, shared by the graph algorithms
+ * in `sneaker::algorithm`.
+ *
+ * Vertices are identified by consecutive 32-bit integers. The targets of the
+ * out-edges of all the vertices are stored contiguously in a single array,
+ * ordered by source vertex, and the out-edges of the vertex `v` are the
+ * targets in the range `[offsets()[v], offsets()[v + 1])`. Traversals thus
+ * read two flat arrays instead of chasing pointers between vertex objects.
+ *
+ * Example:
+ *
+ *  using sneaker::algorithm::csr_graph;
+ *
+ *  std::vector<csr_graph::edge> edges;
+ *  edges.push_back(csr_graph::edge(0, 1));
+ *  edges.push_back(csr_graph::edge(1, 2));
+ *  edges.push_back(csr_graph::edge(2, 0));
+ *
+ *  csr_graph graph = csr_graph::from_edges(3, edges);
+ *
+ *  for (const csr_graph::vertex_id* itr = graph.neighbors_begin(1);
+ *       itr != graph.neighbors_end(1); ++itr)
+ *  {
+ *    ...
+ *  }
+ */
+
+#ifndef SNEAKER_ALGORITHM_CSR_GRAPH_H_
+#define SNEAKER_ALGORITHM_CSR_GRAPH_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace sneaker {
+namespace algorithm {
+
+class csr_graph
+{
+public:
+  typedef uint32_t vertex_id;
+  typedef std::pair<vertex_id, vertex_id> edge;
+
+  csr_graph();
+
+  /**
+   * Constructs a graph from its CSR arrays. `offsets` has one more element
+   * than the number of vertices, starts with `0` and ends with the number of
+   * edges.
+   *
+   * Throws `std::invalid_argument` if the arrays are inconsistent.
+   */
+  csr_graph(std::vector<size_t> offsets, std::vector<vertex_id> targets);
+
+  /**
+   * Builds a graph with the specified number of vertices from a list of
+   * edges, with a counting sort by source vertex that keeps the relative
+   * order of the out-edges of each vertex.
+   *
+   * Throws `std::out_of_range` if an edge refers to a vertex out of range.
+   */
+  static csr_graph from_edges(size_t vertex_count,
+    const std::vector<edge>& edges);
+
+  /**
+   * Builds a graph from objects that expose their out-edges through
+   * `dependencies()`, such as `sneaker::algorithm::tarjan<T>::vertex`. The
+   * specified vertices get the first identifiers in order, followed by the
+   * vertices only reachable through dependencies. `mapping` receives the
+   * object of each vertex identifier.
+   */
+  template<class Vertex>
+  static csr_graph from_vertices(const std::vector<Vertex*>& vertices,
+    std::vector<Vertex*>* mapping);
+
+  size_t vertex_count() const
+  {
+    return m_offsets.size() - 1;
+  }
+
+  size_t edge_count() const
+  {
+    return m_targets.size();
+  }
+
+  size_t degree(vertex_id vertex) const
+  {
+    return m_offsets[vertex + 1] - m_offsets[vertex];
+  }
+
+  const vertex_id* neighbors_begin(vertex_id vertex) const
+  {
+    return m_targets.data() + m_offsets[vertex];
+  }
+
+  const vertex_id* neighbors_end(vertex_id vertex) const
+  {
+    return m_targets.data() + m_offsets[vertex + 1];
+  }
+
+  const std::vector<size_t>& offsets() const
+  {
+    return m_offsets;
+  }
+
+  const std::vector<vertex_id>& targets() const
+  {
+    return m_targets;
+  }
+
+  /**
+   * Builds the graph with the same vertices and all the edges reversed.
+   */
+  csr_graph transpose() const;
+
+private:
+  std::vector<size_t> m_offsets;
+  std::vector<vertex_id> m_targets;
+};
+
+// -----------------------------------------------------------------------------
+
+template<class Vertex>
+csr_graph
+csr_graph::from_vertices(const std::vector<Vertex*>& vertices,
+  std::vector<Vertex*>* mapping)
+{
+  std::unordered_map<const Vertex*, vertex_id> ids;
+  ids.reserve(vertices.size());
+
+  mapping->clear();
+
+  auto id_of = [&ids, mapping](Vertex* vertex) -> vertex_id {
+    auto result = ids.insert(
+      std::make_pair(vertex, static_cast<vertex_id>(mapping->size())));
+
+    if (result.second)
+    {
+      mapping->push_back(vertex);
+    }
+
+    return result.first->second;
+  };
+
+  for (Vertex* vertex : vertices)
+  {
+    id_of(vertex);
+  }
+
+  std::vector<size_t> offsets(1, 0);
+  std::vector<vertex_id> targets;
+
+  // The mapping grows as dependencies are discovered, so it is walked by
+  // position.
+  for (size_t i = 0; i < mapping->size(); ++i)
+  {
+    for (Vertex* dependency : (*mapping)[i]->dependencies())
+    {
+      targets.push_back(id_of(dependency));
+    }
+
+    offsets.push_back(targets.size());
+  }
+
+  return csr_graph(std::move(offsets), std::move(targets));
+}
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace algorithm */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_ALGORITHM_CSR_GRAPH_H_ */
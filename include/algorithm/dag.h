@@ -0,0 +1,101 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * Algorithms on directed acyclic graphs in the representation of
+ * `sneaker::algorithm::csr_graph`, such as the condensation of an arbitrary
+ * graph into the DAG of its strongly connected components.
+ *
+ * Example:
+ *
+ *  using namespace sneaker::algorithm;
+ *
+ *  std::vector<csr_graph::vertex_id> labels;
+ *  csr_graph dag = condensation(graph, &labels);
+ *
+ *  // Tasks in the same component are scheduled together, and cost the sum
+ *  // of their durations.
+ *  std::vector<uint64_t> weights(dag.vertex_count(), 0);
+ *  for (size_t task = 0; task < labels.size(); ++task)
+ *  {
+ *    weights[labels[task]] += durations[task];
+ *  }
+ *
+ *  uint64_t makespan = critical_path_length(dag, weights);
+ */
+
+#ifndef SNEAKER_ALGORITHM_DAG_H_
+#define SNEAKER_ALGORITHM_DAG_H_
+
+#include "algorithm/csr_graph.h"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace sneaker {
+namespace algorithm {
+
+/**
+ * Builds the condensation of a graph, whose vertices are its strongly
+ * connected components numbered in topological order, so that every edge
+ * goes from a lower number to a higher one. `labels` receives the number of
+ * the component of each vertex.
+ */
+csr_graph condensation(const csr_graph& graph,
+  std::vector<csr_graph::vertex_id>* labels);
+
+/**
+ * Orders the vertices of a graph such that every edge goes from an earlier
+ * vertex to a later one, and returns `false` if the graph has a cycle, in
+ * which case `order` only holds the vertices that are not on or after one.
+ */
+bool topological_sort(const csr_graph& graph,
+  std::vector<csr_graph::vertex_id>* order);
+
+/**
+ * Gets the greatest total weight of the vertices along any path of a DAG,
+ * or the number of vertices on the longest path if `weights` is empty.
+ * `path`, if not `NULL`, receives the vertices of such a path.
+ *
+ * Throws `std::invalid_argument` if the graph has a cycle, or if the number
+ * of weights does not match the number of vertices.
+ */
+uint64_t critical_path_length(const csr_graph& dag,
+  const std::vector<uint64_t>& weights,
+  std::vector<csr_graph::vertex_id>* path=NULL);
+
+/**
+ * Builds the transitive reduction of a DAG, which is the graph with the
+ * fewest edges that has the same reachability. Duplicate edges are dropped,
+ * and the remaining edges keep their relative order.
+ *
+ * Throws `std::invalid_argument` if the graph has a cycle.
+ */
+csr_graph transitive_reduction(const csr_graph& dag);
+
+} /* end namespace algorithm */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_ALGORITHM_DAG_H_ */
@@ -0,0 +1,204 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::algorithm::incremental_scc` maintains the strongly connected
+ * components of a directed graph, and a topological order of its
+ * condensation, as edges are added one at a time.
+ *
+ * The topological order is maintained with the algorithm of Pearce and
+ * Kelly: an edge that agrees with the current order is recorded as is, and
+ * an edge that disagrees triggers a forward search from its target and a
+ * backward search from its source, both confined to the components between
+ * the two in the order, after which only the components visited are
+ * reordered. When the forward search reaches the source of the edge, the
+ * edge closes a cycle, and the components found by both searches, which are
+ * exactly those on a path from the target back to the source, are merged
+ * into one.
+ *
+ * Components are identified by one of their vertices, their representative,
+ * which may change as components are merged.
+ *
+ * Example:
+ *
+ *  using sneaker::algorithm::incremental_scc;
+ *
+ *  incremental_scc graph(3);
+ *
+ *  assert(!graph.add_edge(0, 1));
+ *  assert(!graph.add_edge(1, 2));
+ *
+ *  // Closes the cycle (0) -> (1) -> (2) -> (0).
+ *  assert(graph.add_edge(2, 0));
+ *
+ *  assert(1 == graph.component_count());
+ *  assert(3 == graph.members(0).size());
+ */
+
+#ifndef SNEAKER_ALGORITHM_INCREMENTAL_SCC_H_
+#define SNEAKER_ALGORITHM_INCREMENTAL_SCC_H_
+
+#include "algorithm/csr_graph.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+
+namespace sneaker {
+namespace algorithm {
+
+class incremental_scc
+{
+public:
+  typedef csr_graph::vertex_id vertex_id;
+
+  incremental_scc();
+
+  /**
+   * Constructs a graph with the specified number of vertices and no edges.
+   */
+  explicit incremental_scc(size_t vertex_count);
+
+  /**
+   * Adds a vertex with no edges, and returns its identifier.
+   */
+  vertex_id add_vertex();
+
+  /**
+   * Adds an edge, and returns whether it closes a cycle, in which case the
+   * components on the cycle are merged. Edges within a component, including
+   * self-loops, do not change the components and return `false`.
+   *
+   * Throws `std::out_of_range` if either vertex does not exist.
+   */
+  bool add_edge(vertex_id source, vertex_id target);
+
+  size_t vertex_count() const
+  {
+    return m_parents.size();
+  }
+
+  size_t component_count() const
+  {
+    return m_component_count;
+  }
+
+  /**
+   * Gets the representative of the component of the specified vertex.
+   */
+  vertex_id component(vertex_id vertex) const;
+
+  bool same_component(vertex_id u, vertex_id v) const
+  {
+    return component(u) == component(v);
+  }
+
+  /**
+   * Gets the vertices in the component of the specified vertex.
+   */
+  const std::vector<vertex_id>& members(vertex_id vertex) const
+  {
+    return m_members[component(vertex)];
+  }
+
+  /**
+   * Gets the representatives of all the components in topological order,
+   * such that every edge between two components goes from an earlier
+   * component to a later one.
+   */
+  std::vector<vertex_id> topological_order() const;
+
+  /**
+   * Builds the condensation of the graph, whose vertices are the components
+   * numbered in topological order, so that every edge goes from a lower
+   * number to a higher one. `labels` receives the number of the component of
+   * each vertex.
+   */
+  csr_graph condensation(std::vector<vertex_id>* labels) const;
+
+private:
+  void check_vertex(vertex_id vertex) const;
+
+  void search(vertex_id start, const std::vector<std::vector<vertex_id>>& edges,
+    uint8_t mark, size_t lower, size_t upper, std::vector<vertex_id>* visited);
+
+  vertex_id merge(const std::vector<vertex_id>& components);
+
+  static void absorb(std::vector<vertex_id>* into,
+    std::vector<vertex_id>* from);
+
+  /**
+   * Resolves the edges of the specified component to the components they
+   * lead to, without duplicates or the component itself. Returns the number
+   * of edges left.
+   */
+  size_t compact_edges(vertex_id root, std::vector<vertex_id>* edges);
+
+  void reorder(std::vector<vertex_id>* backward, vertex_id merged,
+    std::vector<vertex_id>* forward);
+
+  void compact_order();
+
+  /**
+   * Parents of the vertices in the union-find forest of the components,
+   * compressed on lookup.
+   */
+  mutable std::vector<vertex_id> m_parents;
+
+  /**
+   * Members, out-edges and in-edges of each component, indexed by its
+   * representative. Edges hold the vertices they were added with, which are
+   * resolved to their components when traversed.
+   */
+  std::vector<std::vector<vertex_id>> m_members;
+  std::vector<std::vector<vertex_id>> m_out_edges;
+  std::vector<std::vector<vertex_id>> m_in_edges;
+
+  /**
+   * Sizes of the out-edges and in-edges of each component after they were
+   * last compacted, which is repeated once they have doubled.
+   */
+  std::vector<size_t> m_compacted_out;
+  std::vector<size_t> m_compacted_in;
+
+  /**
+   * Position of each component in `m_order`, indexed by its representative.
+   */
+  std::vector<size_t> m_positions;
+
+  /**
+   * Components in topological order, with holes left by merged components.
+   */
+  std::vector<vertex_id> m_order;
+
+  std::vector<uint8_t> m_marks;
+  size_t m_component_count;
+  size_t m_holes;
+};
+
+} /* end namespace algorithm */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_ALGORITHM_INCREMENTAL_SCC_H_ */
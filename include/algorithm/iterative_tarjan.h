@@ -0,0 +1,243 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::algorithm::iterative_tarjan` finds the strongly connected
+ * components of a `sneaker::algorithm::csr_graph` with Tarjan's algorithm.
+ *
+ * The depth-first search is driven by an explicit stack of frames, each
+ * holding a vertex and the position of its next out-edge, so the depth of the
+ * graph is bounded by the heap rather than by the call stack. Membership in
+ * the component stack is kept in a bit array, which makes the test of each
+ * edge constant time. The whole run is thus linear in the number of vertices
+ * and edges.
+ *
+ * Components are reported in the order they are completed, which is a reverse
+ * topological order of the condensation of the graph: a component is always
+ * reported after every component it has edges to.
+ *
+ * Example:
+ *
+ *  using namespace sneaker::algorithm;
+ *
+ *  std::vector<csr_graph::edge> edges;
+ *  edges.push_back(csr_graph::edge(0, 1));
+ *  edges.push_back(csr_graph::edge(1, 0));
+ *  edges.push_back(csr_graph::edge(1, 2));
+ *
+ *  csr_graph graph = csr_graph::from_edges(3, edges);
+ *
+ *  std::vector<csr_graph::vertex_id> labels;
+ *
+ *  iterative_tarjan algo;
+ *  size_t count = algo.label_components(graph, &labels);
+ *
+ *  // Vertex 2 forms the first component, and vertices 0 and 1 the second.
+ *  assert(2 == count);
+ *  assert(0 == labels[2]);
+ *  assert(1 == labels[0] && 1 == labels[1]);
+ */
+
+#ifndef SNEAKER_ALGORITHM_ITERATIVE_TARJAN_H_
+#define SNEAKER_ALGORITHM_ITERATIVE_TARJAN_H_
+
+#include "algorithm/csr_graph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+
+namespace sneaker {
+namespace algorithm {
+
+class iterative_tarjan
+{
+public:
+  typedef csr_graph::vertex_id vertex_id;
+
+  /**
+   * Index of the vertices not visited by the search.
+   */
+  static constexpr vertex_id UNVISITED = UINT32_MAX;
+
+  iterative_tarjan();
+
+  /**
+   * Invokes `callback(component)` on every strongly connected component of
+   * the graph, in the order they are completed, and returns the number of
+   * components. `component` holds the vertices of the component in the order
+   * they are popped off the component stack, and is only valid for the
+   * duration of the call.
+   *
+   * The search starts from the vertices in increasing order of identifiers.
+   */
+  template<class Callback>
+  size_t for_each_component(const csr_graph& graph, Callback callback);
+
+  /**
+   * Labels every vertex of the graph with the ordinal of its component,
+   * in the order the components are completed, and returns the number of
+   * components.
+   */
+  size_t label_components(const csr_graph& graph,
+    std::vector<vertex_id>* labels);
+
+  /**
+   * The discovery index of each vertex during the last run.
+   */
+  const std::vector<vertex_id>& index() const
+  {
+    return m_index;
+  }
+
+  /**
+   * The lowest discovery index reachable from each vertex within its
+   * component during the last run.
+   */
+  const std::vector<vertex_id>& lowlink() const
+  {
+    return m_lowlink;
+  }
+
+private:
+  struct frame
+  {
+    vertex_id vertex;
+    size_t edge;
+  };
+
+  void reset(size_t vertex_count);
+
+  void visit(const csr_graph& graph, vertex_id vertex);
+
+  bool on_stack(vertex_id vertex) const
+  {
+    return (m_on_stack[vertex >> 6] >> (vertex & 63)) & 1;
+  }
+
+  void set_on_stack(vertex_id vertex)
+  {
+    m_on_stack[vertex >> 6] |= uint64_t(1) << (vertex & 63);
+  }
+
+  void clear_on_stack(vertex_id vertex)
+  {
+    m_on_stack[vertex >> 6] &= ~(uint64_t(1) << (vertex & 63));
+  }
+
+  vertex_id m_next_index;
+  std::vector<vertex_id> m_index;
+  std::vector<vertex_id> m_lowlink;
+  std::vector<uint64_t> m_on_stack;
+  std::vector<vertex_id> m_stack;
+  std::vector<frame> m_frames;
+  std::vector<vertex_id> m_component;
+};
+
+// -----------------------------------------------------------------------------
+
+template<class Callback>
+size_t
+iterative_tarjan::for_each_component(const csr_graph& graph, Callback callback)
+{
+  const size_t vertex_count = graph.vertex_count();
+
+  reset(vertex_count);
+
+  const std::vector<size_t>& offsets = graph.offsets();
+  const std::vector<vertex_id>& targets = graph.targets();
+
+  size_t count = 0;
+
+  for (size_t root = 0; root < vertex_count; ++root)
+  {
+    if (m_index[root] != UNVISITED)
+    {
+      continue;
+    }
+
+    visit(graph, static_cast<vertex_id>(root));
+
+    while (!m_frames.empty())
+    {
+      frame& top = m_frames.back();
+      const vertex_id vertex = top.vertex;
+
+      if (top.edge < offsets[vertex + 1])
+      {
+        const vertex_id target = targets[top.edge++];
+
+        if (m_index[target] == UNVISITED)
+        {
+          // Invalidates `top`.
+          visit(graph, target);
+        }
+        else if (on_stack(target))
+        {
+          m_lowlink[vertex] = std::min(m_lowlink[vertex], m_index[target]);
+        }
+
+        continue;
+      }
+
+      m_frames.pop_back();
+
+      if (!m_frames.empty())
+      {
+        const vertex_id parent = m_frames.back().vertex;
+        m_lowlink[parent] = std::min(m_lowlink[parent], m_lowlink[vertex]);
+      }
+
+      if (m_lowlink[vertex] == m_index[vertex])
+      {
+        m_component.clear();
+
+        vertex_id member = 0;
+
+        do
+        {
+          member = m_stack.back();
+          m_stack.pop_back();
+          clear_on_stack(member);
+          m_component.push_back(member);
+        } while (member != vertex);
+
+        callback(static_cast<const std::vector<vertex_id>&>(m_component));
+
+        ++count;
+      }
+    }
+  }
+
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace algorithm */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_ALGORITHM_ITERATIVE_TARJAN_H_ */
@@ -0,0 +1,124 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::algorithm::parallel_bfs` computes the distances from a source
+ * vertex in a `sneaker::algorithm::csr_graph` with a level-synchronous
+ * breadth-first search on multiple threads.
+ *
+ * The search is direction-optimizing: while the frontier is small, each
+ * level is expanded top-down, from the frontier along the out-edges, with
+ * the frontier held in a queue. Once the out-edges of the frontier outnumber
+ * a fraction of the edges left to explore, which happens on the few middle
+ * levels of graphs with a small diameter, each level is instead expanded
+ * bottom-up: every unvisited vertex looks for a parent among its in-edges,
+ * with the frontier held in a bitset, and stops at the first one found. The
+ * search switches back to top-down once the frontier shrinks again.
+ *
+ * Example:
+ *
+ *  using namespace sneaker::algorithm;
+ *
+ *  std::vector<csr_graph::vertex_id> distances;
+ *
+ *  parallel_bfs bfs(8);
+ *  size_t reached = bfs.run(graph, graph.transpose(), 0, &distances);
+ *
+ *  if (distances[target] != parallel_bfs::UNREACHED)
+ *  {
+ *    ...
+ *  }
+ */
+
+#ifndef SNEAKER_ALGORITHM_PARALLEL_BFS_H_
+#define SNEAKER_ALGORITHM_PARALLEL_BFS_H_
+
+#include "algorithm/csr_graph.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+
+namespace sneaker {
+namespace algorithm {
+
+class parallel_bfs
+{
+public:
+  typedef csr_graph::vertex_id vertex_id;
+
+  /**
+   * Distance of the vertices not reachable from the source.
+   */
+  static constexpr vertex_id UNREACHED = UINT32_MAX;
+
+  /**
+   * The search turns bottom-up once the out-edges of the frontier exceed
+   * `1 / ALPHA` of the edges left to explore, and back top-down once the
+   * frontier holds fewer than `1 / BETA` of the vertices.
+   */
+  static constexpr size_t ALPHA = 14;
+  static constexpr size_t BETA = 24;
+
+  /**
+   * Constructs an instance that runs on the specified number of threads,
+   * or on as many threads as the hardware supports if `0`.
+   */
+  explicit parallel_bfs(size_t thread_count=0);
+
+  size_t thread_count() const
+  {
+    return m_thread_count;
+  }
+
+  /**
+   * Computes the distance of every vertex from the source, and returns the
+   * number of vertices reached, the source included. `transpose` is the
+   * graph with its edges reversed, as built by `csr_graph::transpose()`,
+   * and is passed in so that it can be shared by successive searches.
+   *
+   * Throws `std::out_of_range` if the source does not exist.
+   */
+  size_t run(const csr_graph& graph, const csr_graph& transpose,
+    vertex_id source, std::vector<vertex_id>* distances);
+
+  /**
+   * Returns the number of levels that were expanded bottom-up during the
+   * last search.
+   */
+  size_t bottom_up_levels() const
+  {
+    return m_bottom_up_levels;
+  }
+
+private:
+  size_t m_thread_count;
+  size_t m_bottom_up_levels;
+};
+
+} /* end namespace algorithm */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_ALGORITHM_PARALLEL_BFS_H_ */
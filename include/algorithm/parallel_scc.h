@@ -0,0 +1,147 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::algorithm::parallel_scc` finds the strongly connected components
+ * of a `sneaker::algorithm::csr_graph` on multiple threads.
+ *
+ * The decomposition runs in three phases, each of which is parallelized over
+ * the vertices or over the frontier of a breadth-first search:
+ *
+ *  1. Trimming repeatedly removes the vertices with no remaining in-edges or
+ *     no remaining out-edges, which are components by themselves.
+ *  2. A forward-backward search from the vertex of highest degree extracts
+ *     its component, which in graphs with a skewed degree distribution is
+ *     usually the giant component, in a single pass.
+ *  3. Coloring propagates the highest vertex identifier reaching each
+ *     vertex, after which every vertex whose color is its own identifier
+ *     roots a component, collected by a backward search within its color.
+ *     This repeats over the remaining vertices until none is left.
+ *
+ * Unlike `sneaker::algorithm::iterative_tarjan`, the components are not
+ * numbered in any topological order. Graphs smaller than the sequential
+ * threshold are delegated to `sneaker::algorithm::iterative_tarjan`, as the
+ * coordination between threads outweighs the work on them.
+ *
+ * Example:
+ *
+ *  using namespace sneaker::algorithm;
+ *
+ *  csr_graph graph = csr_graph::from_edges(vertex_count, edges);
+ *
+ *  parallel_scc algo(8);
+ *  auto components = algo.get_components<int>(graph);
+ *
+ *  auto cycles = components.cycles();
+ */
+
+#ifndef SNEAKER_ALGORITHM_PARALLEL_SCC_H_
+#define SNEAKER_ALGORITHM_PARALLEL_SCC_H_
+
+#include "algorithm/csr_graph.h"
+#include "algorithm/tarjan.h"
+
+#include <cstdlib>
+#include <vector>
+
+
+namespace sneaker {
+namespace algorithm {
+
+class parallel_scc
+{
+public:
+  typedef csr_graph::vertex_id vertex_id;
+
+  /**
+   * The number of vertices under which graphs are decomposed sequentially
+   * by default.
+   */
+  static constexpr size_t DEFAULT_SEQUENTIAL_THRESHOLD = 1 << 16;
+
+  /**
+   * Constructs an instance that runs on the specified number of threads,
+   * or on as many threads as the hardware supports if `0`.
+   */
+  explicit parallel_scc(size_t thread_count=0,
+    size_t sequential_threshold=DEFAULT_SEQUENTIAL_THRESHOLD);
+
+  size_t thread_count() const
+  {
+    return m_thread_count;
+  }
+
+  /**
+   * Labels every vertex of the graph with the ordinal of its component,
+   * and returns the number of components.
+   */
+  size_t label_components(const csr_graph& graph,
+    std::vector<vertex_id>* labels) const;
+
+  /**
+   * Finds the strongly connected components of the graph, with vertex
+   * identifiers converted to `T`, in the same shape as
+   * `sneaker::algorithm::tarjan<T>::get_components`.
+   */
+  template<class T>
+  typename tarjan<T>::strongly_connected_component_list get_components(
+    const csr_graph& graph) const;
+
+private:
+  size_t m_thread_count;
+  size_t m_sequential_threshold;
+};
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+typename tarjan<T>::strongly_connected_component_list
+parallel_scc::get_components(const csr_graph& graph) const
+{
+  std::vector<vertex_id> labels;
+  const size_t count = label_components(graph, &labels);
+
+  std::vector<typename tarjan<T>::Enumerable> components(count);
+
+  for (size_t vertex = 0; vertex < labels.size(); ++vertex)
+  {
+    components[labels[vertex]].push_back(static_cast<T>(vertex));
+  }
+
+  typename tarjan<T>::strongly_connected_component_list list;
+
+  for (const auto& component : components)
+  {
+    list.add(component);
+  }
+
+  return list;
+}
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace algorithm */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_ALGORITHM_PARALLEL_SCC_H_ */
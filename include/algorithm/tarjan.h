@@ -34,6 +34,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  * of `strongly_connected_component_list`, which has information on the
  * independent components as well as cycles in the entire graph.
  *
+ * The vertices are first flattened into a `sneaker::algorithm::csr_graph`,
+ * which is then searched by `sneaker::algorithm::iterative_tarjan`, so that
+ * arbitrarily deep graphs do not exhaust the call stack. Graphs already in
+ * the CSR representation can be passed to `get_components` directly.
+ *
  * NOTE: An instance of the class can only perform cycle detection once.
  *       Running the method on the same instance more than once will result
  *       in inaccurate results.
@@ -75,6 +80,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef SNEAKER_ALGORITHM_TARJAN_H_
 #define SNEAKER_ALGORITHM_TARJAN_H_
 
+#include "algorithm/csr_graph.h"
+#include "algorithm/iterative_tarjan.h"
+
 #include <algorithm>
 #include <vector>
 
@@ -213,19 +221,24 @@ public:
 
   tarjan()
     :
-    m_index(0),
-    m_stack(),
     m_components()
   {
   }
 
+  /**
+   * Finds the strongly connected components of the graph formed by the
+   * specified vertices and their dependencies, and sets the index and
+   * lowlink of every vertex visited.
+   */
   strongly_connected_component_list get_components(const VerticesSet& graph);
 
-private:
-  void strong_connect(vertex* vtx);
+  /**
+   * Finds the strongly connected components of a graph in the CSR
+   * representation, whose vertex identifiers are converted to `T`.
+   */
+  strongly_connected_component_list get_components(const csr_graph& graph);
 
-  int m_index;
-  std::vector<vertex*> m_stack;
+private:
   strongly_connected_component_list m_components;
 };
 
@@ -235,10 +248,26 @@ template<class T>
 typename tarjan<T>::strongly_connected_component_list
 tarjan<T>::get_components(const VerticesSet& graph)
 {
-  for (vertex* vtx : graph) {
-    if (vtx->index() < 0) {
-      strong_connect(vtx);
+  std::vector<vertex*> mapping;
+  const csr_graph csr = csr_graph::from_vertices(graph, &mapping);
+
+  iterative_tarjan algo;
+  algo.for_each_component(csr,
+    [this, &mapping](const std::vector<csr_graph::vertex_id>& component) {
+      Enumerable scc;
+      scc.reserve(component.size());
+
+      for (const csr_graph::vertex_id id : component) {
+        scc.push_back(mapping[id]->value());
+      }
+
+      m_components.add(scc);
     }
+  );
+
+  for (size_t id = 0; id < mapping.size(); ++id) {
+    mapping[id]->set_index(static_cast<int>(algo.index()[id]));
+    mapping[id]->set_lowlink(static_cast<int>(algo.lowlink()[id]));
   }
 
   return m_components;
@@ -247,45 +276,24 @@ tarjan<T>::get_components(const VerticesSet& graph)
 // -----------------------------------------------------------------------------
 
 template<class T>
-void
-tarjan<T>::strong_connect(vertex* vtx)
+typename tarjan<T>::strongly_connected_component_list
+tarjan<T>::get_components(const csr_graph& graph)
 {
-  vtx->set_index(m_index);
-  vtx->set_lowlink(m_index);
-
-  ++m_index;
-
-  m_stack.push_back(vtx);
-
-  for (vertex* w : *vtx) {
-    if (w->index() < 0) {
-      strong_connect(w);
-      vtx->set_lowlink(std::min(vtx->lowlink(), w->lowlink()));
-    } else {
-      auto itr = std::find_if(m_stack.begin(), m_stack.end(),
-        [&w](vertex* vtx_) {
-          return *vtx_ == *w;
-        }
-      );
-
-      if (itr != m_stack.end()) {
-        vtx->set_lowlink(std::min(vtx->lowlink(), w->index()));
+  iterative_tarjan algo;
+  algo.for_each_component(graph,
+    [this](const std::vector<csr_graph::vertex_id>& component) {
+      Enumerable scc;
+      scc.reserve(component.size());
+
+      for (const csr_graph::vertex_id id : component) {
+        scc.push_back(static_cast<T>(id));
       }
-    }
-  };
-
-  if (vtx->lowlink() == vtx->index()) {
-    Enumerable scc;
-    vertex *w = nullptr;
 
-    do {
-      w = m_stack.back();
-      scc.push_back(w->value());
-      m_stack.pop_back();
-    } while (*vtx != *w);
+      m_components.add(scc);
+    }
+  );
 
-    m_components.add(scc);
-  }
+  return m_components;
 }
 
 // -----------------------------------------------------------------------------
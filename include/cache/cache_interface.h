@@ -23,25 +23,75 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef SNEAKER_CACHE_INTERFACE_H_
 #define SNEAKER_CACHE_INTERFACE_H_
 
+#include "cache/cache_stats.h"
+
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <type_traits>
+#include <utility>
 
 
 namespace sneaker {
 namespace cache {
 
+/**
+ * Traits of cache schemes. Schemes whose entries can expire, such as
+ * `sneaker::cache::expiring_cache`, specialize it with `expires` being
+ * `true`, in which case they also provide `expired()` and
+ * `next_expired_key()`. Schemes whose capacity is measured in the weight of
+ * their entries, such as `sneaker::cache::weighted_lru_cache`, specialize it
+ * with `weighted` being `true`, in which case they also provide `weigh()`,
+ * and `next_erasure_pair()` yields an entry whenever they are not empty.
+ */
+template<class CacheScheme>
+struct cache_scheme_traits
+{
+  static constexpr bool expires = false;
+  static constexpr bool weighted = false;
+};
+
+// -----------------------------------------------------------------------------
+
 template<class CacheScheme, class OnInsert, class OnErase>
 class cache_interface
 {
 public:
   typedef typename CacheScheme::key_type key_type;
   typedef typename CacheScheme::value_type value_type;
+  typedef CacheScheme scheme_type;
+
+  /**
+   * The maximum number of entries evicted by a single insertion. Bounding
+   * the evictions keeps insertions cheap after the capacity of a scheme has
+   * been shrunk through `resize()`, in which case the remaining excess is
+   * reclaimed over subsequent insertions or through `evict()`.
+   */
+  static constexpr size_t MAX_EVICTIONS_PER_INSERT = 16;
 
-  cache_interface(const OnInsert& on_insert, const OnErase& on_erase)
+  /**
+   * Any arguments after the handlers are forwarded to the constructor of the
+   * cache scheme, such as the capacity of schemes sized at runtime.
+   */
+  template<class... Args>
+  cache_interface(const OnInsert& on_insert, const OnErase& on_erase,
+    Args&&... args)
     :
     m_on_insert(on_insert),
     m_on_erase(on_erase),
-    m_scheme()
+    m_scheme(std::forward<Args>(args)...),
+    m_stats(NULL)
+  {
+  }
+
+  /**
+   * Attaches a recorder of statistics to the cache, or detaches the current
+   * one if `NULL`. The recorder is not owned by the cache, and can be shared
+   * with other caches.
+   */
+  void set_stats_recorder(cache_stats_recorder* recorder)
   {
+    m_stats = recorder;
   }
 
   bool empty() const
@@ -61,49 +111,310 @@ public:
 
   bool find(key_type key) const
   {
-    return m_scheme.find(key);
+    return m_scheme.find(key) && !expired(key, expiry_tag());
   }
 
   bool get(key_type key, value_type& value)
   {
-    return m_scheme.get(key, value);
+    const bool hit =
+      !erase_if_expired(key, expiry_tag()) && m_scheme.get(key, value);
+
+    if (m_stats)
+    {
+      if (hit)
+      {
+        m_stats->record_hit();
+      }
+      else
+      {
+        m_stats->record_miss();
+      }
+    }
+
+    return hit;
   }
 
   void insert(key_type key, const value_type& value)
   {
-    if (m_scheme.full())
+    insert_entry(key, value);
+  }
+
+  /**
+   * Inserts a key-value pair that expires after the specified duration,
+   * for cache schemes whose entries can expire.
+   */
+  template<class Rep, class Period>
+  void insert(key_type key, const value_type& value,
+    const std::chrono::duration<Rep, Period>& ttl)
+  {
+    insert_entry(key, value, ttl);
+  }
+
+  bool erase(key_type key)
+  {
+    if (!remove(key))
+    {
+      return false;
+    }
+
+    if (m_stats)
+    {
+      m_stats->record_removal();
+    }
+
+    return true;
+  }
+
+  void clear()
+  {
+    if (m_stats)
+    {
+      m_stats->record_size_change(-static_cast<int64_t>(m_scheme.size()));
+    }
+
+    m_scheme.clear();
+  }
+
+  /**
+   * Evicts up to `max_count` entries while the cache scheme is full, and
+   * returns the number of entries evicted.
+   */
+  size_t evict(size_t max_count)
+  {
+    return evict_while(max_count, [this]() { return m_scheme.full(); });
+  }
+
+  /**
+   * Erases up to `max_count` entries that have expired, for cache schemes
+   * whose entries can expire, and returns the number of entries erased.
+   */
+  size_t expire(size_t max_count)
+  {
+    size_t count = 0;
+    key_type key = key_type();
+
+    while (count < max_count && m_scheme.next_expired_key(key))
+    {
+      if (remove(key))
+      {
+        if (m_stats)
+        {
+          m_stats->record_expiration();
+        }
+
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
+  /**
+   * Gets the remaining time before the entry associated with the specified
+   * key expires, for cache schemes whose entries can expire.
+   */
+  std::chrono::milliseconds time_to_live(key_type key) const
+  {
+    return m_scheme.time_to_live(key);
+  }
+
+  /**
+   * Changes the capacity of cache schemes sized at runtime. Shrinking does
+   * not evict any entry immediately; see `evict()`.
+   */
+  void resize(size_t capacity)
+  {
+    m_scheme.resize(capacity);
+  }
+
+  size_t capacity() const
+  {
+    return m_scheme.capacity();
+  }
+
+  size_t weight() const
+  {
+    return m_scheme.weight();
+  }
+
+  /**
+   * Invokes `visitor(key, value)` on every entry, in the order defined by
+   * cache schemes that support iteration, such as recency for `lru_cache`.
+   */
+  template<class Visitor>
+  void for_each(Visitor visitor) const
+  {
+    m_scheme.for_each(visitor);
+  }
+
+private:
+  typedef std::integral_constant<bool,
+    cache_scheme_traits<CacheScheme>::expires> expiry_tag;
+
+  typedef std::integral_constant<bool,
+    cache_scheme_traits<CacheScheme>::weighted> weight_tag;
+
+  bool expired(const key_type& /* key */, std::false_type) const
+  {
+    return false;
+  }
+
+  bool expired(const key_type& key, std::true_type) const
+  {
+    return m_scheme.expired(key);
+  }
+
+  bool erase_if_expired(const key_type& key, expiry_tag tag)
+  {
+    if (!expired(key, tag) || !remove(key))
+    {
+      return false;
+    }
+
+    if (m_stats)
+    {
+      m_stats->record_expiration();
+    }
+
+    return true;
+  }
+
+  /**
+   * Evicts up to `max_count` entries while the cache scheme is not empty and
+   * `condition()` holds, and returns the number of entries evicted.
+   */
+  template<class Condition>
+  size_t evict_while(size_t max_count, const Condition& condition)
+  {
+    size_t count = 0;
+
+    while (count < max_count && !m_scheme.empty() && condition())
     {
       key_type *key_ptr = NULL;
       value_type* value_ptr = NULL;
       m_scheme.next_erasure_pair(&key_ptr, &value_ptr);
-      m_on_erase(*key_ptr, *value_ptr);
+
+      // The pair is owned by the scheme, and does not survive the erasure.
+      const key_type key = *key_ptr;
+      m_on_erase(key, *value_ptr);
+      m_scheme.erase(key);
+
+      if (m_stats)
+      {
+        m_stats->record_eviction();
+        m_stats->record_size_change(-1);
+      }
+
+      ++count;
     }
 
-    m_scheme.insert(key, value);
+    return count;
+  }
 
-    m_on_insert(key, value);
+  /**
+   * Makes room for a new entry, and returns whether it is admitted. Weighted
+   * schemes evict until the entry fits within the capacity, and reject
+   * entries heavier than the capacity, which would evict every other entry
+   * and still exceed it. The evictions are only bounded while the scheme is
+   * still over a capacity that has been shrunk, in which case the entry is
+   * admitted once the bound is reached, as with the other schemes.
+   */
+  bool make_room(const key_type& /* key */, const value_type& /* value */,
+    std::false_type)
+  {
+    evict(MAX_EVICTIONS_PER_INSERT);
+
+    return true;
   }
 
-  bool erase(key_type key)
+  bool make_room(const key_type& key, const value_type& value, std::true_type)
+  {
+    if (m_scheme.find(key))
+    {
+      evict(MAX_EVICTIONS_PER_INSERT);
+
+      return true;
+    }
+
+    const size_t weight = m_scheme.weigh(key, value);
+
+    if (weight > m_scheme.capacity())
+    {
+      return false;
+    }
+
+    const size_t max_count = m_scheme.weight() > m_scheme.capacity() ?
+      MAX_EVICTIONS_PER_INSERT : m_scheme.size();
+
+    evict_while(max_count, [this, weight]() {
+      return m_scheme.weight() + weight > m_scheme.capacity();
+    });
+
+    return true;
+  }
+
+  template<class... Args>
+  void insert_entry(key_type key, const value_type& value,
+    const Args&... args)
   {
-    bool erased = m_scheme.erase(key);
-    if (erased)
+    erase_if_expired(key, expiry_tag());
+
+    if (!make_room(key, value, weight_tag()))
+    {
+      return;
+    }
+
+    const size_t size = m_scheme.size();
+
+    m_scheme.insert(key, value, args...);
+
+    if (m_stats)
     {
-      m_on_erase(key);
+      m_stats->record_insertion();
+      m_stats->record_size_change(
+        static_cast<int64_t>(m_scheme.size()) - static_cast<int64_t>(size));
     }
+
+    m_on_insert(key, value);
   }
 
-  void clear()
+  /**
+   * Erases the entry associated with the specified key, and invokes the
+   * erase handler with it.
+   */
+  bool remove(const key_type& key)
   {
-    m_scheme.clear();
+    // The value is looked up without touching the order of eviction, and is
+    // owned by the scheme, so the handler is invoked before the erasure.
+    const value_type* value = m_scheme.peek(key);
+    if (!value)
+    {
+      return false;
+    }
+
+    m_on_erase(key, *value);
+    m_scheme.erase(key);
+
+    if (m_stats)
+    {
+      m_stats->record_size_change(-1);
+    }
+
+    return true;
   }
 
-private:
   OnInsert m_on_insert;
   OnErase m_on_erase;
   CacheScheme m_scheme;
+  cache_stats_recorder* m_stats;
 };
 
+// -----------------------------------------------------------------------------
+
+template<class CacheScheme, class OnInsert, class OnErase>
+constexpr size_t
+cache_interface<CacheScheme, OnInsert, OnErase>::MAX_EVICTIONS_PER_INSERT;
+
 } /* end namespace cache */
 } /* end namespace sneaker */
 
@@ -0,0 +1,128 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::cache::cache_reaper<Cache>` periodically erases expired entries
+ * from a cache on a background thread, using a
+ * `sneaker::threading::fixed_time_interval_daemon_service`.
+ *
+ * On every tick, the reaper calls `expire()` on the cache with a bounded
+ * batch size, which erases up to that many expired entries and invokes the
+ * erase handler of the cache for each of them. Bounding the batches keeps the
+ * time the cache is held by the reaper short.
+ *
+ * Since the cache is accessed from the background thread, it must be safe to
+ * be used from multiple threads, such as a `sneaker::cache::sharded_cache`
+ * with an `sneaker::cache::expiring_cache` scheme. The cache must outlive the
+ * reaper, and the background thread is stopped when the reaper is destroyed.
+ *
+ * Example:
+ *
+ *  typedef sneaker::cache::sharded_cache<
+ *    sneaker::cache::expiring_cache<sneaker::cache::lru_cache<int, int, 1024>>,
+ *    InsertHandler, EraseHandler> CacheType;
+ *
+ *  CacheType cache(InsertHandler(), EraseHandler(), std::hash<int>(),
+ *    std::chrono::seconds(30));
+ *
+ *  // Erases up to 256 expired entries every 100 milliseconds.
+ *  sneaker::cache::cache_reaper<CacheType> reaper(cache, 100, 256);
+ *  reaper.start();
+ */
+
+#ifndef SNEAKER_CACHE_CACHE_REAPER_H_
+#define SNEAKER_CACHE_CACHE_REAPER_H_
+
+#include "threading/fixed_time_interval_daemon_service.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+
+namespace sneaker {
+namespace cache {
+
+template<class Cache>
+class cache_reaper
+{
+public:
+  cache_reaper(Cache& cache, uint32_t interval, size_t batch_size)
+    :
+    m_cache(cache),
+    m_batch_size(batch_size),
+    m_reaped(0),
+    m_daemon_service(interval, &cache_reaper::reap, this, false, -1)
+  {
+  }
+
+  /**
+   * Starts reaping on the background thread. Returns `true` if the
+   * background thread has been started successfully, `false` otherwise.
+   */
+  bool start()
+  {
+    return m_daemon_service.start();
+  }
+
+  size_t interval() const
+  {
+    return m_daemon_service.interval();
+  }
+
+  size_t batch_size() const
+  {
+    return m_batch_size;
+  }
+
+  /**
+   * Gets the total number of entries erased by the reaper so far.
+   */
+  size_t reaped() const
+  {
+    return m_reaped.load(std::memory_order_relaxed);
+  }
+
+private:
+  static void reap(void* arg)
+  {
+    cache_reaper* reaper = static_cast<cache_reaper*>(arg);
+
+    const size_t count = reaper->m_cache.expire(reaper->m_batch_size);
+    reaper->m_reaped.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  Cache& m_cache;
+  size_t m_batch_size;
+  std::atomic<size_t> m_reaped;
+
+  // Declared last, so that the background thread is stopped before any other
+  // member is destroyed.
+  sneaker::threading::fixed_time_interval_daemon_service m_daemon_service;
+};
+
+} /* end namespace cache */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CACHE_CACHE_REAPER_H_ */
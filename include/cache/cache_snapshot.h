@@ -0,0 +1,360 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * Snapshot and restore of the entries of caches, for warming caches up across
+ * restarts of a process.
+ *
+ * A snapshot is written through a `sneaker::io::output_stream` in a compact
+ * binary format: a header made of a magic number and a format version,
+ * followed by the entries, each preceded by a marker byte, and terminated by
+ * an end marker. Entries are written in the iteration order of the cache
+ * scheme, which is from the least to the most recently used for
+ * `lru_cache` and `weighted_lru_cache`, so that restoring them by insertion
+ * in the same order reproduces their recency.
+ *
+ * Keys and values are encoded by serializers, which are pluggable through the
+ * `KeySerializer` and `ValueSerializer` template arguments. A serializer
+ * provides the following static member functions:
+ *
+ *  static bool write(sneaker::io::stream_writer& writer, const T& value);
+ *  static bool read(sneaker::io::stream_reader& reader, T& value);
+ *
+ * The default `snapshot_serializer<T>` supports trivially copyable types,
+ * encoded in the native byte order, as well as `std::string`.
+ *
+ * Example:
+ *
+ *  // Before shutting down.
+ *  sneaker::cache::save_snapshot_file(cache, "/var/cache/app/lru.snapshot");
+ *
+ *  // At startup.
+ *  sneaker::cache::load_snapshot_file(cache, "/var/cache/app/lru.snapshot");
+ */
+
+#ifndef SNEAKER_CACHE_SNAPSHOT_H_
+#define SNEAKER_CACHE_SNAPSHOT_H_
+
+#include "io/input_stream.h"
+#include "io/output_stream.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ios>
+#include <string>
+#include <type_traits>
+
+
+namespace sneaker {
+namespace cache {
+
+/**
+ * Serializer of trivially copyable types, in the native byte order.
+ */
+template<typename T>
+struct snapshot_serializer
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+    "Type must be trivially copyable, or have a dedicated serializer");
+
+  static bool write(io::stream_writer& writer, const T& value)
+  {
+    return writer.write_bytes(
+      reinterpret_cast<const uint8_t*>(&value), sizeof(T));
+  }
+
+  static bool read(io::stream_reader& reader, T& value)
+  {
+    return reader.read_bytes(reinterpret_cast<uint8_t*>(&value), sizeof(T));
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Serializer of strings, encoded as their lengths in base-128 varints
+ * followed by their bytes.
+ */
+template<>
+struct snapshot_serializer<std::string>
+{
+  static bool write(io::stream_writer& writer, const std::string& value)
+  {
+    uint64_t len = value.size();
+
+    while (len >= 0x80)
+    {
+      if (!writer.write(static_cast<uint8_t>(len | 0x80)))
+      {
+        return false;
+      }
+
+      len >>= 7;
+    }
+
+    return writer.write(static_cast<uint8_t>(len)) &&
+      writer.write_bytes(
+        reinterpret_cast<const uint8_t*>(value.data()), value.size());
+  }
+
+  static bool read(io::stream_reader& reader, std::string& value)
+  {
+    uint64_t len = 0;
+    uint8_t byte = 0;
+
+    for (unsigned int shift = 0; ; shift += 7)
+    {
+      if (shift > 63 || !reader.read(&byte))
+      {
+        return false;
+      }
+
+      // The tenth byte only holds the most significant bit.
+      if (shift == 63 && (byte & 0x7e))
+      {
+        return false;
+      }
+
+      len |= static_cast<uint64_t>(byte & 0x7f) << shift;
+
+      if (!(byte & 0x80))
+      {
+        break;
+      }
+    }
+
+    if (len > value.max_size())
+    {
+      return false;
+    }
+
+    // The length is not trusted, so the value is read in bounded pieces,
+    // and grows no further than the bytes actually present in the stream.
+    const uint64_t max_read_size = 64 * 1024;
+
+    value.clear();
+
+    while (len)
+    {
+      const size_t size = static_cast<size_t>(
+        len < max_read_size ? len : max_read_size);
+      const size_t offset = value.size();
+
+      value.resize(offset + size);
+
+      if (!reader.read_bytes(reinterpret_cast<uint8_t*>(&value[offset]), size))
+      {
+        return false;
+      }
+
+      len -= size;
+    }
+
+    return true;
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+static const uint8_t SNAPSHOT_MAGIC[4] = { 'S', 'N', 'K', 'C' };
+
+static const uint8_t SNAPSHOT_VERSION = 1;
+
+static const uint8_t SNAPSHOT_ENTRY_MARKER = 1;
+
+static const uint8_t SNAPSHOT_END_MARKER = 0;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Visitor that writes every entry it is invoked on to a snapshot.
+ */
+template<class KeySerializer, class ValueSerializer>
+class snapshot_entry_writer
+{
+public:
+  snapshot_entry_writer(io::stream_writer* writer, size_t* count)
+    :
+    m_writer(writer),
+    m_count(count)
+  {
+  }
+
+  template<typename K, typename V>
+  void operator()(const K& key, const V& value) const
+  {
+    if (!m_writer->write(SNAPSHOT_ENTRY_MARKER) ||
+      !KeySerializer::write(*m_writer, key) ||
+      !ValueSerializer::write(*m_writer, value))
+    {
+      throw std::ios_base::failure("Cannot write cache snapshot");
+    }
+
+    ++(*m_count);
+  }
+
+private:
+  io::stream_writer* m_writer;
+  size_t* m_count;
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Writes a snapshot of the entries of the specified cache to the stream, and
+ * returns the number of entries written. The cache is either a
+ * `cache_interface` or a `sharded_cache` whose scheme supports iteration.
+ *
+ * Throws `std::ios_base::failure` if the snapshot cannot be written.
+ */
+template<class Cache,
+  class KeySerializer=snapshot_serializer<typename Cache::key_type>,
+  class ValueSerializer=snapshot_serializer<typename Cache::value_type>>
+size_t
+save_snapshot(const Cache& cache, io::output_stream& stream)
+{
+  io::stream_writer writer(&stream);
+
+  if (!writer.write_bytes(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) ||
+    !writer.write(SNAPSHOT_VERSION))
+  {
+    throw std::ios_base::failure("Cannot write cache snapshot");
+  }
+
+  size_t count = 0;
+
+  cache.for_each(
+    snapshot_entry_writer<KeySerializer, ValueSerializer>(&writer, &count));
+
+  if (!writer.write(SNAPSHOT_END_MARKER))
+  {
+    throw std::ios_base::failure("Cannot write cache snapshot");
+  }
+
+  writer.flush();
+
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Restores the entries of a snapshot read from the stream by inserting them
+ * into the specified cache, and returns the number of entries restored.
+ *
+ * Throws `std::ios_base::failure` if the stream does not contain a valid
+ * snapshot, in which case the entries preceding the invalid data remain
+ * restored.
+ */
+template<class Cache,
+  class KeySerializer=snapshot_serializer<typename Cache::key_type>,
+  class ValueSerializer=snapshot_serializer<typename Cache::value_type>>
+size_t
+load_snapshot(Cache& cache, io::input_stream& stream)
+{
+  io::stream_reader reader(&stream);
+
+  uint8_t magic[sizeof(SNAPSHOT_MAGIC)] = {0};
+  uint8_t version = 0;
+
+  if (!reader.read_bytes(magic, sizeof(magic)) ||
+    memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0 ||
+    !reader.read(&version) || version != SNAPSHOT_VERSION)
+  {
+    throw std::ios_base::failure("Invalid cache snapshot header");
+  }
+
+  size_t count = 0;
+
+  while (true)
+  {
+    uint8_t marker = 0;
+
+    if (!reader.read(&marker))
+    {
+      throw std::ios_base::failure("Truncated cache snapshot");
+    }
+
+    if (marker == SNAPSHOT_END_MARKER)
+    {
+      break;
+    }
+
+    typename Cache::key_type key = typename Cache::key_type();
+    typename Cache::value_type value = typename Cache::value_type();
+
+    if (marker != SNAPSHOT_ENTRY_MARKER ||
+      !KeySerializer::read(reader, key) ||
+      !ValueSerializer::read(reader, value))
+    {
+      throw std::ios_base::failure("Invalid cache snapshot entry");
+    }
+
+    cache.insert(key, value);
+    ++count;
+  }
+
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Writes a snapshot of the entries of the specified cache to a file, which is
+ * truncated if it exists. See `save_snapshot()`.
+ */
+template<class Cache,
+  class KeySerializer=snapshot_serializer<typename Cache::key_type>,
+  class ValueSerializer=snapshot_serializer<typename Cache::value_type>>
+size_t
+save_snapshot_file(const Cache& cache, const char* path,
+  size_t buffer_size=64 * 1024)
+{
+  auto stream = io::file_output_stream(path, buffer_size);
+  return save_snapshot<Cache, KeySerializer, ValueSerializer>(cache, *stream);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Restores the entries of a snapshot file into the specified cache. The file
+ * is memory-mapped rather than read through a buffer. See `load_snapshot()`.
+ */
+template<class Cache,
+  class KeySerializer=snapshot_serializer<typename Cache::key_type>,
+  class ValueSerializer=snapshot_serializer<typename Cache::value_type>>
+size_t
+load_snapshot_file(Cache& cache, const char* path)
+{
+  auto stream = io::mmap_input_stream(path);
+  return load_snapshot<Cache, KeySerializer, ValueSerializer>(cache, *stream);
+}
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace cache */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CACHE_SNAPSHOT_H_ */
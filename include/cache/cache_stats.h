@@ -0,0 +1,257 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * Statistics of caches.
+ *
+ * `sneaker::cache::cache_stats_recorder` collects counters of the activities
+ * of one or more caches, such as hits, misses and evictions by their causes,
+ * as well as a histogram of the latencies of loading values. A recorder is
+ * attached to a cache through `set_stats_recorder()`, and caches without a
+ * recorder attached do not pay for any statistics.
+ *
+ * To keep recording cheap when a cache is used from many threads, counters
+ * are kept in a number of cache-line aligned stripes. Each thread records
+ * into its own stripe, and the stripes are only aggregated when a snapshot is
+ * taken through `snapshot()`, which returns a `sneaker::cache::cache_stats`.
+ *
+ * Snapshots are not atomic with respect to concurrent recording, hence
+ * counters taken while the cache is in use are estimates.
+ *
+ * Example:
+ *
+ *  sneaker::cache::cache_stats_recorder recorder;
+ *  cache.set_stats_recorder(&recorder);
+ *
+ *  ...
+ *
+ *  const sneaker::cache::cache_stats stats = recorder.snapshot();
+ *  std::cout << stats.to_json().dump() << std::endl;
+ */
+
+#ifndef SNEAKER_CACHE_CACHE_STATS_H_
+#define SNEAKER_CACHE_CACHE_STATS_H_
+
+#include "json/json.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+
+namespace sneaker {
+namespace cache {
+
+struct cache_stats
+{
+  /**
+   * Number of buckets in the histogram of load latencies. Bucket `i` counts
+   * the loads that took less than 2^i microseconds, and not less than the
+   * upper bound of the previous bucket. The last bucket counts all loads
+   * that took longer.
+   */
+  static constexpr size_t LOAD_LATENCY_BUCKETS = 24;
+
+  cache_stats();
+
+  /**
+   * Gets the total number of lookups.
+   */
+  uint64_t requests() const;
+
+  /**
+   * Gets the ratio of lookups that hit, or 1.0 if there was no lookup.
+   */
+  double hit_ratio() const;
+
+  /**
+   * Gets the total number of loads, successful or not.
+   */
+  uint64_t loads() const;
+
+  sneaker::json::JSON to_json() const;
+
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t insertions;
+
+  // Entries evicted to make room for others.
+  uint64_t evictions;
+
+  // Entries erased because they expired.
+  uint64_t expirations;
+
+  // Entries erased explicitly through `erase()`.
+  uint64_t removals;
+
+  uint64_t load_successes;
+  uint64_t load_failures;
+
+  // Estimate of the number of entries in the cache.
+  int64_t size;
+
+  uint64_t load_latencies[LOAD_LATENCY_BUCKETS];
+};
+
+// -----------------------------------------------------------------------------
+
+class cache_stats_recorder
+{
+public:
+  cache_stats_recorder();
+
+  cache_stats_recorder(const cache_stats_recorder&) = delete;
+  cache_stats_recorder& operator=(const cache_stats_recorder&) = delete;
+
+  /**
+   * Allocations are aligned to the cache line size, which `operator new` does
+   * not guarantee for over-aligned types before C++17.
+   */
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
+  void record_hit()
+  {
+    increment(HITS, 1);
+  }
+
+  void record_miss()
+  {
+    increment(MISSES, 1);
+  }
+
+  void record_insertion()
+  {
+    increment(INSERTIONS, 1);
+  }
+
+  void record_eviction()
+  {
+    increment(EVICTIONS, 1);
+  }
+
+  void record_expiration()
+  {
+    increment(EXPIRATIONS, 1);
+  }
+
+  void record_removal()
+  {
+    increment(REMOVALS, 1);
+  }
+
+  void record_size_change(int64_t delta)
+  {
+    increment(SIZE, static_cast<uint64_t>(delta));
+  }
+
+  void record_load_success(uint64_t nanoseconds)
+  {
+    increment(LOAD_SUCCESSES, 1);
+    increment(LOAD_LATENCIES + load_latency_bucket(nanoseconds), 1);
+  }
+
+  void record_load_failure(uint64_t nanoseconds)
+  {
+    increment(LOAD_FAILURES, 1);
+    increment(LOAD_LATENCIES + load_latency_bucket(nanoseconds), 1);
+  }
+
+  /**
+   * Aggregates the counters of all threads.
+   */
+  cache_stats snapshot() const;
+
+  void reset();
+
+private:
+  enum counter_type
+  {
+    HITS,
+    MISSES,
+    INSERTIONS,
+    EVICTIONS,
+    EXPIRATIONS,
+    REMOVALS,
+    LOAD_SUCCESSES,
+    LOAD_FAILURES,
+    SIZE,
+    LOAD_LATENCIES
+  };
+
+  static constexpr size_t COUNTERS =
+    LOAD_LATENCIES + cache_stats::LOAD_LATENCY_BUCKETS;
+
+  static constexpr size_t STRIPES = 16;
+
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  // The alignment also rounds the size of each stripe up to a multiple of
+  // the cache line size, so that no two stripes share a line.
+  struct alignas(CACHE_LINE_SIZE) stripe
+  {
+    std::atomic<uint64_t> counters[COUNTERS];
+  };
+
+  static size_t load_latency_bucket(uint64_t nanoseconds)
+  {
+    uint64_t microseconds = nanoseconds / 1000;
+
+    size_t bucket = 0;
+    while (microseconds && bucket + 1 < cache_stats::LOAD_LATENCY_BUCKETS)
+    {
+      microseconds >>= 1;
+      ++bucket;
+    }
+
+    return bucket;
+  }
+
+  /**
+   * Gets the index of the stripe of the calling thread. Threads are assigned
+   * to stripes in a round-robin fashion upon their first use of any recorder.
+   */
+  static size_t stripe_index()
+  {
+    static std::atomic<size_t> next_index(0);
+    static thread_local size_t index =
+      next_index.fetch_add(1, std::memory_order_relaxed) % STRIPES;
+    return index;
+  }
+
+  void increment(size_t counter, uint64_t delta)
+  {
+    // Each stripe is mostly written by a single thread, so the atomic
+    // addition is normally uncontended.
+    m_stripes[stripe_index()].counters[counter].fetch_add(
+      delta, std::memory_order_relaxed);
+  }
+
+  stripe m_stripes[STRIPES];
+};
+
+} /* end namespace cache */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CACHE_CACHE_STATS_H_ */
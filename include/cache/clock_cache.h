@@ -0,0 +1,251 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::cache::clock_cache<K, V, N>` implements the CLOCK caching scheme,
+ * an approximation of LRU that is well suited for read-mostly workloads.
+ *
+ * Entries are stored in a flat array of `N` slots, each of which carries a
+ * reference bit. A hit only sets the reference bit of the slot with a relaxed
+ * atomic store, instead of reordering a recency list as `lru_cache` does.
+ * When the cache is full, a hand sweeps over the slots, clearing reference
+ * bits until it finds an unreferenced slot, whose entry is then evicted.
+ *
+ * Since `find()` and `get()` do not modify the structure of the cache, they
+ * can be invoked concurrently with each other, as long as they are not
+ * concurrent with any of the mutating operations.
+ */
+
+#ifndef SNEAKER_CACHE_CLOCK_CACHE_H_
+#define SNEAKER_CACHE_CLOCK_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+
+namespace sneaker {
+namespace cache {
+
+template<typename K, typename V, size_t N>
+class clock_cache
+{
+public:
+  typedef K key_type;
+  typedef V value_type;
+
+  static_assert(N > 0, "Capacity of the cache must be positive");
+
+  clock_cache()
+    :
+    m_index(),
+    m_keys(N),
+    m_values(N),
+    m_referenced(N),
+    m_occupied(N, 0),
+    m_free_slots(),
+    m_hand(0)
+  {
+    m_index.reserve(N);
+    reset_free_slots();
+  }
+
+  bool empty() const
+  {
+    return m_index.empty();
+  }
+
+  bool full() const
+  {
+    return m_index.size() == N;
+  }
+
+  size_t size() const
+  {
+    return m_index.size();
+  }
+
+  bool find(key_type key) const
+  {
+    return m_index.find(key) != m_index.end();
+  }
+
+  /**
+   * Gets the value associated with the specified key without updating the
+   * reference bit of the entry, or `NULL` if there is none. The value remains valid
+   * until the cache is modified.
+   */
+  const value_type* peek(const key_type& key)
+  {
+    const auto itr = m_index.find(key);
+
+    return itr != m_index.end() ? &m_values[itr->second] : NULL;
+  }
+
+  bool get(const key_type& key, value_type& res)
+  {
+    const auto itr = m_index.find(key);
+
+    if (itr != m_index.end())
+    {
+      m_referenced[itr->second].store(true, std::memory_order_relaxed);
+
+      res = m_values[itr->second];
+
+      return true;
+    }
+
+    return false;
+  }
+
+  void next_erasure_pair(key_type** key_ptr, value_type** value_ptr)
+  {
+    if (full())
+    {
+      const size_t slot = advance_hand();
+      *key_ptr = &m_keys[slot];
+      *value_ptr = &m_values[slot];
+    }
+  }
+
+  void insert(key_type key, const value_type& value)
+  {
+    const auto res = m_index.insert(std::make_pair(key, static_cast<size_t>(0)));
+
+    if (!res.second)
+    {
+      return;
+    }
+
+    size_t slot = 0;
+
+    if (m_free_slots.empty())
+    {
+      slot = advance_hand();
+      m_index.erase(m_keys[slot]);
+      m_hand = (slot + 1) % N;
+    }
+    else
+    {
+      slot = m_free_slots.back();
+      m_free_slots.pop_back();
+    }
+
+    res.first->second = slot;
+
+    m_keys[slot] = key;
+    m_values[slot] = value;
+    m_referenced[slot].store(false, std::memory_order_relaxed);
+    m_occupied[slot] = 1;
+  }
+
+  bool erase(key_type key)
+  {
+    const auto itr = m_index.find(key);
+
+    if (itr == m_index.end())
+    {
+      return false;
+    }
+
+    const size_t slot = itr->second;
+
+    m_index.erase(itr);
+
+    m_keys[slot] = key_type();
+    m_values[slot] = value_type();
+    m_occupied[slot] = 0;
+    m_free_slots.push_back(slot);
+
+    // Move the hand past the slot freed, as an insertion would have done
+    // had it evicted the entry.
+    if (slot == m_hand)
+    {
+      m_hand = (m_hand + 1) % N;
+    }
+
+    return true;
+  }
+
+  void clear()
+  {
+    m_index.clear();
+
+    for (size_t i = 0; i < N; ++i)
+    {
+      m_keys[i] = key_type();
+      m_values[i] = value_type();
+      m_referenced[i].store(false, std::memory_order_relaxed);
+      m_occupied[i] = 0;
+    }
+
+    reset_free_slots();
+    m_hand = 0;
+  }
+
+private:
+  /**
+   * Sweeps the hand over the occupied slots, giving every referenced slot a
+   * second chance by clearing its reference bit, until the hand rests on an
+   * unreferenced slot, which is the next slot to evict.
+   */
+  size_t advance_hand()
+  {
+    while (!m_occupied[m_hand] ||
+      m_referenced[m_hand].load(std::memory_order_relaxed))
+    {
+      m_referenced[m_hand].store(false, std::memory_order_relaxed);
+      m_hand = (m_hand + 1) % N;
+    }
+
+    return m_hand;
+  }
+
+  void reset_free_slots()
+  {
+    m_free_slots.clear();
+    m_free_slots.reserve(N);
+
+    // Slots are handed out in ascending order.
+    for (size_t i = N; i > 0; --i)
+    {
+      m_free_slots.push_back(i - 1);
+    }
+  }
+
+  std::unordered_map<key_type, size_t> m_index;
+  std::vector<key_type> m_keys;
+  std::vector<value_type> m_values;
+  std::vector<std::atomic<bool>> m_referenced;
+  std::vector<uint8_t> m_occupied;
+  std::vector<size_t> m_free_slots;
+  size_t m_hand;
+};
+
+} /* end namespace cache */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CACHE_CLOCK_CACHE_H_ */
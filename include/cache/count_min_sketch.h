@@ -0,0 +1,263 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::cache::count_min_sketch<T, Hash>` is a probabilistic frequency
+ * counter that estimates how many times each element has been seen, using a
+ * fixed amount of memory regardless of the number of distinct elements.
+ *
+ * The sketch consists of four rows of small saturating counters. An element is
+ * hashed into one counter per row, and its estimated frequency is the minimum
+ * of those counters. Once the number of recorded increments reaches the sample
+ * size, all counters are halved, so that the estimates favor recent history
+ * over elements that were popular long ago.
+ *
+ * As in TinyLFU, the counters are guarded by a doorkeeper, a Bloom filter that
+ * records the first occurrence of each element within a sample. Elements only
+ * seen once, which make up most of the elements of a long tail, then never
+ * reach the counters and do not inflate the estimates of the others. The
+ * doorkeeper is cleared whenever the counters are halved.
+ */
+
+#ifndef SNEAKER_CACHE_COUNT_MIN_SKETCH_H_
+#define SNEAKER_CACHE_COUNT_MIN_SKETCH_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+
+namespace sneaker {
+namespace cache {
+
+template<class T, class Hash=std::hash<T>>
+class count_min_sketch
+{
+public:
+  /**
+   * Creates a sketch suitable for tracking the frequencies of approximately
+   * `capacity` hot elements. The counters are halved every `10 * capacity`
+   * increments.
+   */
+  explicit count_min_sketch(size_t capacity, const Hash& hash=Hash())
+    :
+    m_hash(hash),
+    m_width(table_width(capacity)),
+    m_table(m_width * DEPTH, 0),
+    m_additions(0),
+    m_sample_size(std::max<size_t>(capacity, 1) * 10),
+    m_doorkeeper_bits(doorkeeper_size(m_sample_size)),
+    m_doorkeeper(m_doorkeeper_bits / 64, 0)
+  {
+  }
+
+  void increment(const T& value)
+  {
+    const uint64_t h = static_cast<uint64_t>(m_hash(value));
+
+    if (!admit(h))
+    {
+      if (++m_additions >= m_sample_size)
+      {
+        age();
+      }
+      return;
+    }
+
+    bool incremented = false;
+
+    for (size_t row = 0; row < DEPTH; ++row)
+    {
+      uint8_t& counter = m_table[index_of(h, row)];
+      if (counter < MAX_COUNT)
+      {
+        ++counter;
+        incremented = true;
+      }
+    }
+
+    if (incremented && ++m_additions >= m_sample_size)
+    {
+      age();
+    }
+  }
+
+  uint8_t frequency(const T& value) const
+  {
+    const uint64_t h = static_cast<uint64_t>(m_hash(value));
+
+    uint8_t res = MAX_COUNT;
+
+    for (size_t row = 0; row < DEPTH; ++row)
+    {
+      res = std::min(res, m_table[index_of(h, row)]);
+    }
+
+    // The occurrence recorded by the doorkeeper counts as one.
+    if (admitted(h) && res < MAX_COUNT)
+    {
+      ++res;
+    }
+
+    return res;
+  }
+
+  void clear()
+  {
+    std::fill(m_table.begin(), m_table.end(), 0);
+    std::fill(m_doorkeeper.begin(), m_doorkeeper.end(), 0);
+    m_additions = 0;
+  }
+
+private:
+  static constexpr size_t DEPTH = 4;
+  static constexpr uint8_t MAX_COUNT = 15;
+
+  /**
+   * The number of bits of the doorkeeper set for each element.
+   */
+  static constexpr size_t DOORKEEPER_HASHES = 2;
+
+  static size_t table_width(size_t capacity)
+  {
+    // Four counters per row for every tracked element keeps the collisions
+    // low enough for the estimates to be useful.
+    size_t width = 16;
+    while (width < capacity * 4)
+    {
+      width <<= 1;
+    }
+    return width;
+  }
+
+  static size_t doorkeeper_size(size_t sample_size)
+  {
+    // One bit per increment of a sample keeps the false positives of the
+    // doorkeeper rare, as many of the increments are of the same elements.
+    size_t bits = 64;
+    while (bits < sample_size)
+    {
+      bits <<= 1;
+    }
+    return bits;
+  }
+
+  /**
+   * Records an occurrence of the element with the specified hash in the
+   * doorkeeper. Returns whether it had already been recorded.
+   */
+  bool admit(uint64_t h)
+  {
+    bool seen = true;
+
+    for (size_t k = 0; k < DOORKEEPER_HASHES; ++k)
+    {
+      const size_t bit = doorkeeper_bit_of(h, k);
+      uint64_t& word = m_doorkeeper[bit / 64];
+      const uint64_t mask = uint64_t(1) << (bit % 64);
+
+      seen = seen && (word & mask);
+      word |= mask;
+    }
+
+    return seen;
+  }
+
+  bool admitted(uint64_t h) const
+  {
+    for (size_t k = 0; k < DOORKEEPER_HASHES; ++k)
+    {
+      const size_t bit = doorkeeper_bit_of(h, k);
+
+      if (!(m_doorkeeper[bit / 64] & (uint64_t(1) << (bit % 64))))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  size_t doorkeeper_bit_of(uint64_t h, size_t k) const
+  {
+    // The high half of the mixed hash is independent of the counter indices,
+    // which take the low bits.
+    return static_cast<size_t>(mix(h, k) >> 32) & (m_doorkeeper_bits - 1);
+  }
+
+  size_t index_of(uint64_t h, size_t row) const
+  {
+    return row * m_width + static_cast<size_t>(mix(h, row) & (m_width - 1));
+  }
+
+  static uint64_t mix(uint64_t h, size_t row)
+  {
+    static const uint64_t SEEDS[DEPTH] = {
+      0x9e3779b97f4a7c15ULL,
+      0xc2b2ae3d27d4eb4fULL,
+      0x165667b19e3779f9ULL,
+      0xd6e8feb86659fd93ULL
+    };
+
+    uint64_t x = h ^ SEEDS[row];
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+
+    return x;
+  }
+
+  /**
+   * Halves all counters and clears the doorkeeper, which makes the sketch
+   * forget old history.
+   */
+  void age()
+  {
+    for (auto& counter : m_table)
+    {
+      counter = static_cast<uint8_t>(counter >> 1);
+    }
+
+    std::fill(m_doorkeeper.begin(), m_doorkeeper.end(), 0);
+
+    m_additions /= 2;
+  }
+
+  Hash m_hash;
+  size_t m_width;
+  std::vector<uint8_t> m_table;
+  size_t m_additions;
+  size_t m_sample_size;
+  size_t m_doorkeeper_bits;
+  std::vector<uint64_t> m_doorkeeper;
+};
+
+} /* end namespace cache */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CACHE_COUNT_MIN_SKETCH_H_ */
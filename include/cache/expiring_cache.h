@@ -0,0 +1,284 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::cache::expiring_cache<CacheScheme, Clock>` is a cache scheme that
+ * adds per-entry time-to-live (TTL) to another cache scheme.
+ *
+ * Entries are inserted with either the default TTL of the cache or a TTL of
+ * their own, and a TTL of zero means the entry never expires. The expiry of
+ * each entry is tracked by a `sneaker::cache::timing_wheel` with a resolution
+ * of one millisecond, and entries are never considered expired before their
+ * TTL has elapsed.
+ *
+ * The scheme does not remove expired entries by itself. When used with
+ * `sneaker::cache::cache_interface`, expired entries are erased, and the
+ * erase handler invoked, when they are looked up or overwritten, as well as
+ * in bounded batches through `cache_interface::expire()`, which can be called
+ * periodically by a `sneaker::cache::cache_reaper`.
+ */
+
+#ifndef SNEAKER_CACHE_EXPIRING_CACHE_H_
+#define SNEAKER_CACHE_EXPIRING_CACHE_H_
+
+#include "cache/cache_interface.h"
+#include "cache/timing_wheel.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <unordered_map>
+#include <utility>
+
+
+namespace sneaker {
+namespace cache {
+
+template<class CacheScheme, class Clock=std::chrono::steady_clock>
+class expiring_cache
+{
+public:
+  typedef typename CacheScheme::key_type key_type;
+  typedef typename CacheScheme::value_type value_type;
+  typedef typename Clock::duration duration;
+
+  /**
+   * Any arguments after the default TTL are forwarded to the constructor of
+   * the underlying cache scheme.
+   */
+  template<class... Args>
+  explicit expiring_cache(duration default_ttl, Args&&... args)
+    :
+    m_scheme(std::forward<Args>(args)...),
+    m_default_ttl(default_ttl),
+    m_epoch(Clock::now()),
+    m_wheel(),
+    m_timers()
+  {
+  }
+
+  bool empty() const
+  {
+    return m_scheme.empty();
+  }
+
+  bool full() const
+  {
+    return m_scheme.full();
+  }
+
+  size_t size() const
+  {
+    return m_scheme.size();
+  }
+
+  size_t capacity() const
+  {
+    return m_scheme.capacity();
+  }
+
+  size_t weight() const
+  {
+    return m_scheme.weight();
+  }
+
+  void resize(size_t capacity)
+  {
+    m_scheme.resize(capacity);
+  }
+
+  size_t weigh(const key_type& key, const value_type& value) const
+  {
+    return m_scheme.weigh(key, value);
+  }
+
+  duration default_ttl() const
+  {
+    return m_default_ttl;
+  }
+
+  bool find(key_type key) const
+  {
+    return m_scheme.find(key);
+  }
+
+  /**
+   * Determines whether the entry associated with the specified key has
+   * expired.
+   */
+  bool expired(const key_type& key) const
+  {
+    const auto itr = m_timers.find(key);
+
+    if (itr == m_timers.end())
+    {
+      return false;
+    }
+
+    return m_wheel.expiry(itr->second) <= current_tick();
+  }
+
+  /**
+   * Gets the remaining time before the entry associated with the specified
+   * key expires, which is zero if it has expired, and
+   * `std::chrono::milliseconds::max()` if it never expires or is absent.
+   */
+  std::chrono::milliseconds time_to_live(const key_type& key) const
+  {
+    const auto itr = m_timers.find(key);
+
+    if (itr == m_timers.end())
+    {
+      return std::chrono::milliseconds::max();
+    }
+
+    const tick_type expiry = m_wheel.expiry(itr->second);
+    const tick_type now = current_tick();
+
+    return std::chrono::milliseconds(
+      expiry > now ? static_cast<std::chrono::milliseconds::rep>(expiry - now) : 0);
+  }
+
+  const value_type* peek(const key_type& key)
+  {
+    return m_scheme.peek(key);
+  }
+
+  bool get(const key_type& key, value_type& res)
+  {
+    return m_scheme.get(key, res);
+  }
+
+  void next_erasure_pair(key_type** key_ptr, value_type** value_ptr)
+  {
+    m_scheme.next_erasure_pair(key_ptr, value_ptr);
+  }
+
+  /**
+   * Gets the key of the next entry that has expired, if any. Entries that
+   * have expired are reported at most once.
+   */
+  bool next_expired_key(key_type& key)
+  {
+    m_wheel.advance(current_tick());
+
+    if (!m_wheel.next_expired(&key))
+    {
+      return false;
+    }
+
+    m_timers.erase(key);
+
+    return true;
+  }
+
+  void insert(key_type key, const value_type& value)
+  {
+    insert(key, value, m_default_ttl);
+  }
+
+  void insert(key_type key, const value_type& value, duration ttl)
+  {
+    if (m_scheme.find(key))
+    {
+      return;
+    }
+
+    m_scheme.insert(key, value);
+
+    // The underlying scheme may have dropped the entry previously associated
+    // with the key on its own.
+    cancel_timer(key);
+
+    if (ttl > duration::zero())
+    {
+      m_timers[key] = m_wheel.schedule(key, expiry_tick(ttl));
+    }
+  }
+
+  bool erase(key_type key)
+  {
+    cancel_timer(key);
+    return m_scheme.erase(key);
+  }
+
+  void clear()
+  {
+    m_scheme.clear();
+    m_wheel.clear();
+    m_timers.clear();
+  }
+
+private:
+  typedef timing_wheel<key_type> wheel_type;
+  typedef typename wheel_type::tick_type tick_type;
+
+  tick_type current_tick() const
+  {
+    return static_cast<tick_type>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+        Clock::now() - m_epoch).count());
+  }
+
+  tick_type expiry_tick(duration ttl) const
+  {
+    const duration elapsed = Clock::now() - m_epoch + ttl;
+    const std::chrono::milliseconds ticks =
+      std::chrono::duration_cast<std::chrono::milliseconds>(elapsed);
+
+    // Round up, so that entries never expire early.
+    return static_cast<tick_type>(ticks.count()) + (ticks < elapsed ? 1 : 0);
+  }
+
+  void cancel_timer(const key_type& key)
+  {
+    const auto itr = m_timers.find(key);
+
+    if (itr != m_timers.end())
+    {
+      m_wheel.cancel(itr->second);
+      m_timers.erase(itr);
+    }
+  }
+
+  CacheScheme m_scheme;
+  duration m_default_ttl;
+  typename Clock::time_point m_epoch;
+  wheel_type m_wheel;
+  std::unordered_map<key_type, typename wheel_type::handle_type> m_timers;
+};
+
+// -----------------------------------------------------------------------------
+
+template<class CacheScheme, class Clock>
+struct cache_scheme_traits<expiring_cache<CacheScheme, Clock>>
+{
+  static constexpr bool expires = true;
+  static constexpr bool weighted =
+    cache_scheme_traits<CacheScheme>::weighted;
+};
+
+} /* end namespace cache */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CACHE_EXPIRING_CACHE_H_ */
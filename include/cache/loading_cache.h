@@ -0,0 +1,497 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::cache::loading_cache<Cache, Loader>` populates a cache on misses
+ * by invoking a loader, and coalesces concurrent misses on the same key into
+ * a single load.
+ *
+ * `Cache` is either a `sneaker::cache::cache_interface` or a
+ * `sneaker::cache::sharded_cache`, and the loading cache refers to it without
+ * owning it. Unless `Cache` is only used by a single thread, it must be safe
+ * to be used from multiple threads, such as a `sharded_cache`.
+ *
+ * `Loader` is invoked as `bool(const key_type&, value_type&)`, and returns
+ * `true` if it has loaded the value associated with the key. Values that
+ * failed to load are not cached. Exceptions thrown by the loader propagate to
+ * the caller that invoked the loader, while the callers waiting on the same
+ * load see it as failed.
+ *
+ * When the entries of the cache can expire, i.e. its scheme is a
+ * `sneaker::cache::expiring_cache`, entries can optionally be refreshed ahead
+ * of their expiry. Accessing an entry whose remaining time-to-live is within
+ * the refresh-ahead window schedules a reload on a background thread, while
+ * the current value continues to be served. The refreshed value replaces the
+ * current one, whose erasure is reported to the erase handler of the cache.
+ *
+ * Example:
+ *
+ *  typedef sneaker::cache::sharded_cache<
+ *    sneaker::cache::expiring_cache<
+ *      sneaker::cache::lru_cache<std::string, Profile, 1024>>,
+ *    InsertHandler, EraseHandler> CacheType;
+ *
+ *  CacheType cache(InsertHandler(), EraseHandler(), std::hash<std::string>(),
+ *    std::chrono::minutes(5));
+ *
+ *  // Refreshes entries accessed within the last minute before they expire.
+ *  sneaker::cache::loading_cache<CacheType, ProfileLoader> profiles(
+ *    cache, ProfileLoader(), std::chrono::minutes(1));
+ *
+ *  Profile profile;
+ *  profiles.get("user", profile);
+ */
+
+#ifndef SNEAKER_CACHE_LOADING_CACHE_H_
+#define SNEAKER_CACHE_LOADING_CACHE_H_
+
+#include "cache/cache_interface.h"
+#include "cache/cache_stats.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+
+namespace sneaker {
+namespace cache {
+
+template<class Cache, class Loader>
+class loading_cache
+{
+public:
+  typedef typename Cache::key_type key_type;
+  typedef typename Cache::value_type value_type;
+
+  /**
+   * The refresh-ahead window is only applicable when the entries of `Cache`
+   * can expire, and is disabled if zero.
+   */
+  loading_cache(Cache& cache, const Loader& loader,
+    std::chrono::milliseconds refresh_ahead=std::chrono::milliseconds::zero());
+
+  ~loading_cache();
+
+  loading_cache(const loading_cache&) = delete;
+  loading_cache& operator=(const loading_cache&) = delete;
+
+  /**
+   * Gets the value associated with the specified key, loading it into the
+   * cache if it is absent. If a load of the key is already in flight, waits
+   * for it instead of loading again. Returns `true` if the value is found or
+   * loaded, `false` otherwise.
+   */
+  bool get(const key_type& key, value_type& value);
+
+  /**
+   * Schedules a reload of the value associated with the specified key on the
+   * background thread, unless a load of the key is already in flight. Only
+   * applicable when refresh-ahead is enabled.
+   */
+  void refresh(const key_type& key);
+
+  /**
+   * Gets the number of loads in flight.
+   */
+  size_t in_flight() const;
+
+  /**
+   * Attaches a recorder of load statistics, or detaches the current one if
+   * `NULL`. Must not be called while the cache is in use.
+   */
+  void set_stats_recorder(cache_stats_recorder* recorder);
+
+private:
+  typedef std::integral_constant<bool,
+    cache_scheme_traits<typename Cache::scheme_type>::expires> expiry_tag;
+
+  struct flight
+  {
+    flight()
+      :
+      done(false),
+      loaded(false),
+      value()
+    {
+    }
+
+    std::condition_variable condition;
+    bool done;
+    bool loaded;
+    value_type value;
+  };
+
+  bool load(const key_type& key, value_type& value, bool refresh);
+
+  bool invoke_loader(const key_type& key, value_type& value);
+
+  void complete(const key_type& key, flight& flight_, bool loaded,
+    const value_type& value);
+
+  void refresh_if_expiring(const key_type& key, std::false_type);
+
+  void refresh_if_expiring(const key_type& key, std::true_type);
+
+  void run_refresher();
+
+  Cache& m_cache;
+  Loader m_loader;
+  std::chrono::milliseconds m_refresh_ahead;
+  cache_stats_recorder* m_stats;
+
+  // Guards all members below.
+  mutable std::mutex m_mutex;
+  std::unordered_map<key_type, std::shared_ptr<flight>> m_flights;
+  std::deque<key_type> m_refresh_queue;
+  std::unordered_set<key_type> m_refresh_pending;
+  std::condition_variable m_refresh_condition;
+  bool m_stopping;
+  std::thread m_refresher;
+};
+
+// -----------------------------------------------------------------------------
+
+template<class Cache, class Loader>
+loading_cache<Cache, Loader>::loading_cache(Cache& cache, const Loader& loader,
+  std::chrono::milliseconds refresh_ahead)
+  :
+  m_cache(cache),
+  m_loader(loader),
+  m_refresh_ahead(expiry_tag::value ?
+    refresh_ahead : std::chrono::milliseconds::zero()),
+  m_stats(NULL),
+  m_mutex(),
+  m_flights(),
+  m_refresh_queue(),
+  m_refresh_pending(),
+  m_refresh_condition(),
+  m_stopping(false),
+  m_refresher()
+{
+  if (m_refresh_ahead > std::chrono::milliseconds::zero())
+  {
+    m_refresher = std::thread(&loading_cache::run_refresher, this);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Cache, class Loader>
+loading_cache<Cache, Loader>::~loading_cache()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+
+  m_refresh_condition.notify_all();
+
+  if (m_refresher.joinable())
+  {
+    m_refresher.join();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Cache, class Loader>
+bool
+loading_cache<Cache, Loader>::get(const key_type& key, value_type& value)
+{
+  if (m_cache.get(key, value))
+  {
+    if (m_refresh_ahead > std::chrono::milliseconds::zero())
+    {
+      refresh_if_expiring(key, expiry_tag());
+    }
+
+    return true;
+  }
+
+  return load(key, value, false);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Cache, class Loader>
+void
+loading_cache<Cache, Loader>::refresh(const key_type& key)
+{
+  if (!m_refresher.joinable())
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_stopping || m_flights.count(key) ||
+      !m_refresh_pending.insert(key).second)
+    {
+      return;
+    }
+
+    m_refresh_queue.push_back(key);
+  }
+
+  m_refresh_condition.notify_one();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Cache, class Loader>
+size_t
+loading_cache<Cache, Loader>::in_flight() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_flights.size();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Cache, class Loader>
+void
+loading_cache<Cache, Loader>::set_stats_recorder(cache_stats_recorder* recorder)
+{
+  m_stats = recorder;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Cache, class Loader>
+bool
+loading_cache<Cache, Loader>::load(const key_type& key, value_type& value,
+  bool refresh)
+{
+  std::shared_ptr<flight> flight_;
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    const auto itr = m_flights.find(key);
+
+    if (itr != m_flights.end())
+    {
+      if (refresh)
+      {
+        return false;
+      }
+
+      // Wait for the load in flight.
+      flight_ = itr->second;
+      flight_->condition.wait(lock, [&flight_]() { return flight_->done; });
+
+      if (flight_->loaded)
+      {
+        value = flight_->value;
+      }
+
+      return flight_->loaded;
+    }
+
+    flight_ = std::make_shared<flight>();
+    m_flights[key] = flight_;
+  }
+
+  // A load of the key may have completed between the miss and the
+  // registration of this one.
+  if (!refresh && m_cache.get(key, value))
+  {
+    complete(key, *flight_, true, value);
+    return true;
+  }
+
+  bool loaded = false;
+
+  try
+  {
+    loaded = invoke_loader(key, value);
+  }
+  catch (...)
+  {
+    complete(key, *flight_, false, value);
+    throw;
+  }
+
+  if (loaded)
+  {
+    if (refresh)
+    {
+      m_cache.erase(key);
+    }
+
+    m_cache.insert(key, value);
+  }
+
+  complete(key, *flight_, loaded, value);
+
+  return loaded;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Cache, class Loader>
+bool
+loading_cache<Cache, Loader>::invoke_loader(const key_type& key,
+  value_type& value)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  bool loaded = false;
+
+  try
+  {
+    loaded = m_loader(key, value);
+  }
+  catch (...)
+  {
+    if (m_stats)
+    {
+      m_stats->record_load_failure(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start).count()));
+    }
+
+    throw;
+  }
+
+  if (m_stats)
+  {
+    const uint64_t elapsed = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+
+    if (loaded)
+    {
+      m_stats->record_load_success(elapsed);
+    }
+    else
+    {
+      m_stats->record_load_failure(elapsed);
+    }
+  }
+
+  return loaded;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Cache, class Loader>
+void
+loading_cache<Cache, Loader>::complete(const key_type& key, flight& flight_,
+  bool loaded, const value_type& value)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    flight_.done = true;
+    flight_.loaded = loaded;
+
+    if (loaded)
+    {
+      flight_.value = value;
+    }
+
+    m_flights.erase(key);
+  }
+
+  flight_.condition.notify_all();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Cache, class Loader>
+void
+loading_cache<Cache, Loader>::refresh_if_expiring(const key_type& /* key */,
+  std::false_type)
+{
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Cache, class Loader>
+void
+loading_cache<Cache, Loader>::refresh_if_expiring(const key_type& key,
+  std::true_type)
+{
+  if (m_cache.time_to_live(key) <= m_refresh_ahead)
+  {
+    refresh(key);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Cache, class Loader>
+void
+loading_cache<Cache, Loader>::run_refresher()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while (true)
+  {
+    m_refresh_condition.wait(lock, [this]() {
+      return m_stopping || !m_refresh_queue.empty();
+    });
+
+    if (m_stopping)
+    {
+      break;
+    }
+
+    const key_type key = m_refresh_queue.front();
+    m_refresh_queue.pop_front();
+    m_refresh_pending.erase(key);
+
+    lock.unlock();
+
+    value_type value = value_type();
+
+    try
+    {
+      load(key, value, true);
+    }
+    catch (...)
+    {
+      // The current value continues to be served until it expires.
+    }
+
+    lock.lock();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace cache */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CACHE_LOADING_CACHE_H_ */
@@ -64,6 +64,19 @@ public:
     return m_container.left.find(key) != m_container.left.end();
   }
 
+  /**
+   * Gets the value associated with the specified key without updating the
+   * order of eviction, or `NULL` if there is none. The value remains valid
+   * until the cache is modified.
+   */
+  const value_type* peek(const key_type& key)
+  {
+    const typename container_type::left_iterator it =
+      m_container.left.find(key);
+
+    return it != m_container.left.end() ? &it->second : NULL;
+  }
+
   bool get(const key_type& key, value_type& res)
   {
     const typename container_type::left_iterator it =
@@ -113,6 +126,20 @@ public:
     m_container.clear();
   }
 
+  /**
+   * Invokes `visitor(key, value)` on every entry, from the least recently
+   * used to the most recently used.
+   */
+  template<class Visitor>
+  void for_each(Visitor visitor) const
+  {
+    for (auto itr = m_container.right.begin(); itr != m_container.right.end();
+      ++itr)
+    {
+      visitor((*itr).get_left(), (*itr).get_right());
+    }
+  }
+
 private:
   typedef boost::bimaps::bimap<boost::bimaps::unordered_set_of<key_type>,
     boost::bimaps::list_of<value_type>> container_type;
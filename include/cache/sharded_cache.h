@@ -0,0 +1,312 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::cache::sharded_cache<CacheScheme, OnInsert, OnErase, S, Hash>`
+ * is a thread-safe cache that partitions its keys across `S` independent
+ * shards. Each shard is an instance of
+ * `sneaker::cache::cache_interface<CacheScheme, OnInsert, OnErase>` guarded by
+ * its own mutex, and keys are assigned to shards by their hash values.
+ *
+ * Since even a lookup on schemes such as `lru_cache` mutates the recency
+ * order of the underlying container, every operation on a shard requires an
+ * exclusive lock. Partitioning the keys into shards allows threads operating
+ * on different shards to proceed concurrently.
+ *
+ * The capacity of each shard is determined by the cache scheme, hence the
+ * total capacity of the cache is `S` times the capacity of the scheme.
+ *
+ * The insertion and erasure handlers are invoked while the lock of the shard
+ * is held, therefore they must be safe to be called from multiple threads,
+ * and must not call back into the cache.
+ *
+ * Example:
+ *
+ *  typedef sneaker::cache::sharded_cache<
+ *    sneaker::cache::lru_cache<int, std::string, 1024>,
+ *    InsertHandler, EraseHandler, 16> CacheType;
+ *
+ *  CacheType cache(InsertHandler(), EraseHandler());
+ *  cache.insert(1, "Hello world");
+ */
+
+#ifndef SNEAKER_CACHE_SHARDED_CACHE_H_
+#define SNEAKER_CACHE_SHARDED_CACHE_H_
+
+#include "cache/cache_interface.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace sneaker {
+namespace cache {
+
+template<class CacheScheme, class OnInsert, class OnErase, size_t S=16,
+  class Hash=std::hash<typename CacheScheme::key_type>>
+class sharded_cache
+{
+public:
+  typedef typename CacheScheme::key_type key_type;
+  typedef typename CacheScheme::value_type value_type;
+  typedef CacheScheme scheme_type;
+  typedef cache_interface<CacheScheme, OnInsert, OnErase> shard_type;
+
+  static_assert(S > 0, "A sharded cache requires at least one shard");
+
+  sharded_cache(const OnInsert& on_insert, const OnErase& on_erase,
+    const Hash& hash=Hash())
+    :
+    m_hash(hash),
+    m_shards()
+  {
+    m_shards.reserve(S);
+    for (size_t i = 0; i < S; ++i)
+    {
+      m_shards.push_back(
+        std::unique_ptr<shard>(new shard(on_insert, on_erase)));
+    }
+  }
+
+  /**
+   * Any arguments after the hash function are forwarded to the constructor
+   * of the cache scheme of every shard, such as the capacity of schemes sized
+   * at runtime.
+   */
+  template<class Arg, class... Args>
+  sharded_cache(const OnInsert& on_insert, const OnErase& on_erase,
+    const Hash& hash, const Arg& arg, const Args&... args)
+    :
+    m_hash(hash),
+    m_shards()
+  {
+    m_shards.reserve(S);
+    for (size_t i = 0; i < S; ++i)
+    {
+      m_shards.push_back(std::unique_ptr<shard>(
+        new shard(on_insert, on_erase, arg, args...)));
+    }
+  }
+
+  size_t shard_count() const
+  {
+    return S;
+  }
+
+  /**
+   * Attaches a recorder of statistics to every shard. See
+   * `cache_interface::set_stats_recorder()`.
+   */
+  void set_stats_recorder(cache_stats_recorder* recorder)
+  {
+    for (auto& shard_ : m_shards)
+    {
+      std::lock_guard<std::mutex> lock(shard_->mutex);
+      shard_->cache.set_stats_recorder(recorder);
+    }
+  }
+
+  bool empty() const
+  {
+    for (const auto& shard_ : m_shards)
+    {
+      std::lock_guard<std::mutex> lock(shard_->mutex);
+      if (!shard_->cache.empty())
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool full() const
+  {
+    for (const auto& shard_ : m_shards)
+    {
+      std::lock_guard<std::mutex> lock(shard_->mutex);
+      if (!shard_->cache.full())
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  size_t size() const
+  {
+    size_t res = 0;
+    for (const auto& shard_ : m_shards)
+    {
+      std::lock_guard<std::mutex> lock(shard_->mutex);
+      res += shard_->cache.size();
+    }
+
+    return res;
+  }
+
+  bool find(key_type key) const
+  {
+    const shard& shard_ = shard_of(key);
+    std::lock_guard<std::mutex> lock(shard_.mutex);
+    return shard_.cache.find(key);
+  }
+
+  bool get(key_type key, value_type& value)
+  {
+    shard& shard_ = shard_of(key);
+    std::lock_guard<std::mutex> lock(shard_.mutex);
+    return shard_.cache.get(key, value);
+  }
+
+  void insert(key_type key, const value_type& value)
+  {
+    shard& shard_ = shard_of(key);
+    std::lock_guard<std::mutex> lock(shard_.mutex);
+    shard_.cache.insert(key, value);
+  }
+
+  template<class Rep, class Period>
+  void insert(key_type key, const value_type& value,
+    const std::chrono::duration<Rep, Period>& ttl)
+  {
+    shard& shard_ = shard_of(key);
+    std::lock_guard<std::mutex> lock(shard_.mutex);
+    shard_.cache.insert(key, value, ttl);
+  }
+
+  std::chrono::milliseconds time_to_live(key_type key) const
+  {
+    const shard& shard_ = shard_of(key);
+    std::lock_guard<std::mutex> lock(shard_.mutex);
+    return shard_.cache.time_to_live(key);
+  }
+
+  bool erase(key_type key)
+  {
+    shard& shard_ = shard_of(key);
+    std::lock_guard<std::mutex> lock(shard_.mutex);
+    return shard_.cache.erase(key);
+  }
+
+  void clear()
+  {
+    for (auto& shard_ : m_shards)
+    {
+      std::lock_guard<std::mutex> lock(shard_->mutex);
+      shard_->cache.clear();
+    }
+  }
+
+  /**
+   * Erases up to `max_count` expired entries across all shards, for cache
+   * schemes whose entries can expire. Each shard is locked only while its
+   * own entries are being erased. Returns the number of entries erased.
+   */
+  size_t expire(size_t max_count)
+  {
+    size_t count = 0;
+    for (auto& shard_ : m_shards)
+    {
+      if (count == max_count)
+      {
+        break;
+      }
+
+      std::lock_guard<std::mutex> lock(shard_->mutex);
+      count += shard_->cache.expire(max_count - count);
+    }
+
+    return count;
+  }
+
+  /**
+   * Invokes `visitor(key, value)` on the entries of every shard, for cache
+   * schemes that support iteration. Each shard is locked only while its own
+   * entries are being visited, so the visitor must not access the cache.
+   */
+  template<class Visitor>
+  void for_each(Visitor visitor) const
+  {
+    for (const auto& shard_ : m_shards)
+    {
+      std::lock_guard<std::mutex> lock(shard_->mutex);
+      shard_->cache.for_each(visitor);
+    }
+  }
+
+private:
+  struct shard
+  {
+    template<class... Args>
+    shard(const OnInsert& on_insert, const OnErase& on_erase,
+      const Args&... args)
+      :
+      mutex(),
+      cache(on_insert, on_erase, args...)
+    {
+    }
+
+    mutable std::mutex mutex;
+    shard_type cache;
+  };
+
+  size_t shard_index(const key_type& key) const
+  {
+    // Hash functions such as `std::hash` on integral types are usually
+    // identities, so the bits are mixed before picking the shard to avoid
+    // clustering of sequential keys.
+    uint64_t h = static_cast<uint64_t>(m_hash(key));
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h % S);
+  }
+
+  shard& shard_of(const key_type& key)
+  {
+    return *m_shards[shard_index(key)];
+  }
+
+  const shard& shard_of(const key_type& key) const
+  {
+    return *m_shards[shard_index(key)];
+  }
+
+  Hash m_hash;
+  std::vector<std::unique_ptr<shard>> m_shards;
+};
+
+} /* end namespace cache */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CACHE_SHARDED_CACHE_H_ */
@@ -0,0 +1,115 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::cache::slab_file` is a growable file mapped into memory, which
+ * backs the off-heap storage of `sneaker::cache::slab_file_cache`.
+ *
+ * The file is created at a path generated by
+ * `sneaker::io::get_persistent_tmp_file_path()`, so that it resides on disk
+ * rather than on a memory-backed file system, and is removed when the instance
+ * is destroyed. Since the mapping is shared with the file, its pages are
+ * written back to the file and reclaimed by the kernel under memory pressure,
+ * instead of counting towards the anonymous memory of the process.
+ *
+ * Growing the file remaps it, which invalidates pointers previously obtained
+ * from `data()`; offsets into the file remain valid.
+ */
+
+#ifndef SNEAKER_CACHE_SLAB_FILE_H_
+#define SNEAKER_CACHE_SLAB_FILE_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+
+namespace sneaker {
+namespace cache {
+
+class slab_file
+{
+public:
+  /**
+   * Creates the file with the specified initial size in bytes.
+   *
+   * Throws `std::ios_base::failure` if the file cannot be created or mapped.
+   */
+  explicit slab_file(size_t initial_size);
+
+  ~slab_file();
+
+  slab_file(const slab_file&) = delete;
+  slab_file& operator=(const slab_file&) = delete;
+
+  uint8_t* data()
+  {
+    return m_data;
+  }
+
+  const uint8_t* data() const
+  {
+    return m_data;
+  }
+
+  /**
+   * Gets the size of the file in bytes, all of which are mapped.
+   */
+  size_t size() const
+  {
+    return m_size;
+  }
+
+  const char* path() const
+  {
+    return m_path.c_str();
+  }
+
+  /**
+   * Extends the file to at least the specified size, at least doubling it to
+   * amortize remapping. Does nothing if the file is already large enough.
+   *
+   * Throws `std::ios_base::failure` if the file cannot be extended or mapped,
+   * in which case the file remains mapped at its previous size.
+   */
+  void reserve(size_t size);
+
+private:
+  /**
+   * Extends the file to the specified size, and maps all of it.
+   */
+  uint8_t* map(size_t size);
+
+  void unmap();
+
+  std::string m_path;
+  int m_fd;
+  uint8_t* m_data;
+  size_t m_size;
+};
+
+} /* end namespace cache */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CACHE_SLAB_FILE_H_ */
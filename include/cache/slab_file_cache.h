@@ -0,0 +1,434 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::cache::slab_file_cache<K, V, Codec>` implements the LRU caching
+ * scheme for large values, keeping only the keys and the metadata of the
+ * entries in memory, and storing the values off-heap in a memory-mapped
+ * `sneaker::cache::slab_file`.
+ *
+ * Values are encoded by `Codec` and appended to the end of the file, in a
+ * log-structured manner. Erasing an entry only marks its bytes as dead. When
+ * there is no room left for a value, the file is compacted if at least half
+ * of its used bytes are dead, by sliding the live values towards the start of
+ * the file; otherwise the file grows. Compaction can also be triggered
+ * explicitly through `compact()`.
+ *
+ * The capacity is specified at runtime, and measured in the total number of
+ * bytes of the encoded values. Like `sneaker::cache::weighted_lru_cache`,
+ * inserting into a full cache does not evict any entry by itself; entries are
+ * evicted by `sneaker::cache::cache_interface` by erasing the pairs returned
+ * from `next_erasure_pair()` until the new value fits within the capacity,
+ * and values larger than the whole capacity are rejected. Since values are
+ * not kept in memory, the value returned from `next_erasure_pair()` is a
+ * decoded copy, which remains valid until the next call.
+ *
+ * A codec provides the following static member functions:
+ *
+ *  static size_t size(const V& value);
+ *  static void encode(const V& value, uint8_t* out);
+ *  static void decode(const uint8_t* data, size_t len, V& value);
+ *
+ * The default `slab_codec<V>` supports trivially copyable types as well as
+ * `std::string`.
+ */
+
+#ifndef SNEAKER_CACHE_SLAB_FILE_CACHE_H_
+#define SNEAKER_CACHE_SLAB_FILE_CACHE_H_
+
+#include "cache/cache_interface.h"
+#include "cache/slab_file.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+
+namespace sneaker {
+namespace cache {
+
+/**
+ * Codec of trivially copyable types, in the native byte order.
+ */
+template<typename V>
+struct slab_codec
+{
+  static_assert(std::is_trivially_copyable<V>::value,
+    "Type must be trivially copyable, or have a dedicated codec");
+
+  static size_t size(const V& /* value */)
+  {
+    return sizeof(V);
+  }
+
+  static void encode(const V& value, uint8_t* out)
+  {
+    memcpy(out, &value, sizeof(V));
+  }
+
+  static void decode(const uint8_t* data, size_t /* len */, V& value)
+  {
+    memcpy(&value, data, sizeof(V));
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct slab_codec<std::string>
+{
+  static size_t size(const std::string& value)
+  {
+    return value.size();
+  }
+
+  static void encode(const std::string& value, uint8_t* out)
+  {
+    memcpy(out, value.data(), value.size());
+  }
+
+  static void decode(const uint8_t* data, size_t len, std::string& value)
+  {
+    value.assign(reinterpret_cast<const char*>(data), len);
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+template<typename K, typename V, class Codec=slab_codec<V>>
+class slab_file_cache
+{
+public:
+  typedef K key_type;
+  typedef V value_type;
+
+  static constexpr size_t DEFAULT_INITIAL_FILE_SIZE = 1024 * 1024;
+
+  /**
+   * Constructs a cache with the specified capacity in bytes, whose file
+   * initially has the specified size in bytes.
+   *
+   * Throws `std::ios_base::failure` if the file cannot be created.
+   */
+  explicit slab_file_cache(size_t capacity,
+    size_t initial_file_size=DEFAULT_INITIAL_FILE_SIZE)
+    :
+    m_index(),
+    m_entries(),
+    m_file(std::min(initial_file_size, std::max<size_t>(capacity, 1))),
+    m_capacity(capacity),
+    m_tail(0),
+    m_live_bytes(0),
+    m_erasure_value()
+  {
+  }
+
+  bool empty() const
+  {
+    return m_index.empty();
+  }
+
+  /**
+   * The cache is full when the total number of bytes of its values has
+   * reached the capacity.
+   */
+  bool full() const
+  {
+    return m_live_bytes >= m_capacity;
+  }
+
+  size_t size() const
+  {
+    return m_index.size();
+  }
+
+  size_t capacity() const
+  {
+    return m_capacity;
+  }
+
+  /**
+   * Gets the total number of bytes of the values in the cache.
+   */
+  size_t weight() const
+  {
+    return m_live_bytes;
+  }
+
+  void resize(size_t capacity)
+  {
+    m_capacity = capacity;
+  }
+
+  /**
+   * Gets the number of bytes in the file that belong to erased values, and
+   * can be reclaimed by `compact()`.
+   */
+  size_t dead_bytes() const
+  {
+    return m_tail - m_live_bytes;
+  }
+
+  size_t file_size() const
+  {
+    return m_file.size();
+  }
+
+  const char* file_path() const
+  {
+    return m_file.path();
+  }
+
+  bool find(key_type key) const
+  {
+    return m_index.find(key) != m_index.end();
+  }
+
+  /**
+   * Gets a decoded copy of the value associated with the specified key
+   * without updating the order of eviction, or `NULL` if there is none. The
+   * copy remains valid until the next call, or to `next_erasure_pair()`.
+   */
+  const value_type* peek(const key_type& key)
+  {
+    const auto itr = m_index.find(key);
+
+    if (itr == m_index.end())
+    {
+      return NULL;
+    }
+
+    decode(*itr->second, m_erasure_value);
+
+    return &m_erasure_value;
+  }
+
+  bool get(const key_type& key, value_type& res)
+  {
+    const auto itr = m_index.find(key);
+
+    if (itr == m_index.end())
+    {
+      return false;
+    }
+
+    m_entries.splice(m_entries.end(), m_entries, itr->second);
+
+    decode(*itr->second, res);
+
+    return true;
+  }
+
+  /**
+   * Gets the number of bytes of the encoded value.
+   */
+  size_t weigh(const key_type& /* key */, const value_type& value) const
+  {
+    return Codec::size(value);
+  }
+
+  void next_erasure_pair(key_type** key_ptr, value_type** value_ptr)
+  {
+    if (!empty())
+    {
+      entry& victim = m_entries.front();
+      decode(victim, m_erasure_value);
+      *key_ptr = &victim.key;
+      *value_ptr = &m_erasure_value;
+    }
+  }
+
+  /**
+   * Throws `std::ios_base::failure` if the file cannot be extended.
+   */
+  void insert(key_type key, const value_type& value)
+  {
+    if (find(key))
+    {
+      return;
+    }
+
+    const size_t len = Codec::size(value);
+
+    if (m_tail + len > m_file.size())
+    {
+      if (dead_bytes() >= m_live_bytes)
+      {
+        compact();
+      }
+
+      m_file.reserve(m_tail + len);
+    }
+
+    Codec::encode(value, m_file.data() + m_tail);
+
+    m_entries.push_back(entry{key, m_tail, len});
+    m_index[key] = --m_entries.end();
+
+    m_tail += len;
+    m_live_bytes += len;
+  }
+
+  bool erase(key_type key)
+  {
+    const auto itr = m_index.find(key);
+
+    if (itr == m_index.end())
+    {
+      return false;
+    }
+
+    const entry& entry_ = *itr->second;
+
+    // Reclaims the bytes right away if the value is the last one appended.
+    if (entry_.offset + entry_.length == m_tail)
+    {
+      m_tail = entry_.offset;
+    }
+
+    m_live_bytes -= entry_.length;
+
+    m_entries.erase(itr->second);
+    m_index.erase(itr);
+
+    return true;
+  }
+
+  void clear()
+  {
+    m_index.clear();
+    m_entries.clear();
+    m_tail = 0;
+    m_live_bytes = 0;
+  }
+
+  /**
+   * Reclaims the bytes of erased values by sliding the live values towards
+   * the start of the file. Does not shrink the file.
+   */
+  void compact()
+  {
+    if (!dead_bytes())
+    {
+      return;
+    }
+
+    std::vector<entry*> entries;
+    entries.reserve(m_entries.size());
+
+    for (entry& entry_ : m_entries)
+    {
+      entries.push_back(&entry_);
+    }
+
+    std::sort(entries.begin(), entries.end(),
+      [](const entry* lhs, const entry* rhs) {
+        return lhs->offset < rhs->offset;
+      });
+
+    // Values only move towards the start of the file, so processing them in
+    // the order of their offsets never overwrites a value yet to be moved.
+    size_t offset = 0;
+
+    for (entry* entry_ : entries)
+    {
+      if (entry_->offset != offset)
+      {
+        memmove(m_file.data() + offset, m_file.data() + entry_->offset,
+          entry_->length);
+        entry_->offset = offset;
+      }
+
+      offset += entry_->length;
+    }
+
+    m_tail = offset;
+  }
+
+  /**
+   * Invokes `visitor(key, value)` on every entry, from the least recently
+   * used to the most recently used.
+   */
+  template<class Visitor>
+  void for_each(Visitor visitor) const
+  {
+    value_type value = value_type();
+
+    for (const entry& entry_ : m_entries)
+    {
+      decode(entry_, value);
+      visitor(entry_.key, value);
+    }
+  }
+
+private:
+  struct entry
+  {
+    key_type key;
+    size_t offset;
+    size_t length;
+  };
+
+  void decode(const entry& entry_, value_type& value) const
+  {
+    Codec::decode(m_file.data() + entry_.offset, entry_.length, value);
+  }
+
+  // Entries are ordered from the least recently used to the most recently
+  // used.
+  typedef std::list<entry> list_type;
+
+  std::unordered_map<key_type, typename list_type::iterator> m_index;
+  list_type m_entries;
+  slab_file m_file;
+  size_t m_capacity;
+  size_t m_tail;
+  size_t m_live_bytes;
+  value_type m_erasure_value;
+};
+
+// -----------------------------------------------------------------------------
+
+template<typename K, typename V, class Codec>
+constexpr size_t slab_file_cache<K, V, Codec>::DEFAULT_INITIAL_FILE_SIZE;
+
+// -----------------------------------------------------------------------------
+
+template<typename K, typename V, class Codec>
+struct cache_scheme_traits<slab_file_cache<K, V, Codec>>
+{
+  static constexpr bool expires = false;
+  static constexpr bool weighted = true;
+};
+
+} /* end namespace cache */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CACHE_SLAB_FILE_CACHE_H_ */
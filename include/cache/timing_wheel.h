@@ -0,0 +1,386 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::cache::timing_wheel<T>` is a hierarchical timing wheel, which
+ * keeps track of timers that expire at integral ticks with O(1) scheduling
+ * and cancellation.
+ *
+ * The wheel consists of 6 levels of 64 slots each. Level 0 holds the timers
+ * that expire within the next 64 ticks, one slot per tick, and each level
+ * above covers a range 64 times longer than the one below it. As the wheel
+ * advances, the timers in a slot of a higher level are cascaded down into the
+ * lower levels once their slot comes due, and the timers in the current slot
+ * of level 0 are moved into a list of expired timers, from which they are
+ * consumed through `next_expired()`.
+ *
+ * Timers expiring beyond the current revolution of the wheel, which spans
+ * 2^36 ticks, are parked in the top level until the next revolution starts.
+ */
+
+#ifndef SNEAKER_CACHE_TIMING_WHEEL_H_
+#define SNEAKER_CACHE_TIMING_WHEEL_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <list>
+
+
+namespace sneaker {
+namespace cache {
+
+template<typename T>
+class timing_wheel
+{
+private:
+  struct timer
+  {
+    T value;
+    uint64_t expiry;
+    size_t level;
+    size_t slot;
+  };
+
+  typedef std::list<timer> list_type;
+
+public:
+  typedef uint64_t tick_type;
+  typedef typename list_type::iterator handle_type;
+
+  explicit timing_wheel(tick_type now=0);
+
+  /**
+   * Gets the current tick of the wheel.
+   */
+  tick_type now() const;
+
+  /**
+   * Gets the number of timers, including expired timers that have not been
+   * consumed.
+   */
+  size_t size() const;
+
+  bool empty() const;
+
+  /**
+   * Schedules a timer that expires at the specified tick. Timers whose
+   * expiry is not later than the current tick are expired immediately.
+   * The returned handle remains valid until the timer is either cancelled
+   * or consumed through `next_expired()`.
+   */
+  handle_type schedule(const T& value, tick_type expiry);
+
+  void cancel(handle_type handle);
+
+  tick_type expiry(handle_type handle) const;
+
+  /**
+   * Advances the wheel to the specified tick, expiring all timers that are
+   * due by then.
+   */
+  void advance(tick_type now);
+
+  /**
+   * Consumes the next expired timer, and stores its value in `value`.
+   * Returns `true` if there is one, `false` otherwise.
+   */
+  bool next_expired(T* value);
+
+  void clear();
+
+private:
+  static constexpr size_t LEVELS = 6;
+  static constexpr size_t SLOT_BITS = 6;
+  static constexpr size_t SLOTS = 1 << SLOT_BITS;
+  static constexpr tick_type SLOT_MASK = SLOTS - 1;
+
+  // Level of the expired timers, which are kept in `m_expired`.
+  static constexpr size_t EXPIRED = LEVELS;
+
+  list_type& list_of(size_t level, size_t slot);
+
+  void place(list_type& from, handle_type handle);
+
+  void cascade(size_t level, size_t slot);
+
+  list_type m_slots[LEVELS][SLOTS];
+  size_t m_level_sizes[LEVELS];
+  list_type m_expired;
+  tick_type m_now;
+  size_t m_size;
+};
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+timing_wheel<T>::timing_wheel(tick_type now)
+  :
+  m_level_sizes(),
+  m_expired(),
+  m_now(now),
+  m_size(0)
+{
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+typename timing_wheel<T>::tick_type
+timing_wheel<T>::now() const
+{
+  return m_now;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+size_t
+timing_wheel<T>::size() const
+{
+  return m_size;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+bool
+timing_wheel<T>::empty() const
+{
+  return m_size == 0;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+typename timing_wheel<T>::handle_type
+timing_wheel<T>::schedule(const T& value, tick_type expiry)
+{
+  m_expired.push_back(timer{value, expiry, EXPIRED, 0});
+  ++m_size;
+
+  const handle_type handle = --m_expired.end();
+  place(m_expired, handle);
+
+  return handle;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+void
+timing_wheel<T>::cancel(handle_type handle)
+{
+  if (handle->level != EXPIRED)
+  {
+    --m_level_sizes[handle->level];
+  }
+
+  list_of(handle->level, handle->slot).erase(handle);
+  --m_size;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+typename timing_wheel<T>::tick_type
+timing_wheel<T>::expiry(handle_type handle) const
+{
+  return handle->expiry;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+void
+timing_wheel<T>::advance(tick_type now)
+{
+  while (m_now < now)
+  {
+    // Nothing to cascade or expire if all timers have expired already.
+    if (m_expired.size() == m_size)
+    {
+      m_now = now;
+      break;
+    }
+
+    // Skip the ticks at which there is nothing to cascade or expire, which
+    // are all the ticks before the next slot of the lowest non-empty level.
+    size_t lowest_level = 0;
+    while (m_level_sizes[lowest_level] == 0)
+    {
+      ++lowest_level;
+    }
+
+    if (lowest_level > 0)
+    {
+      const size_t shift = SLOT_BITS * lowest_level;
+      const tick_type next = ((m_now >> shift) + 1) << shift;
+
+      if (next > now)
+      {
+        m_now = now;
+        break;
+      }
+
+      m_now = next - 1;
+    }
+
+    ++m_now;
+
+    // Cascade from the top, so that timers moved into the current slot of a
+    // lower level are handled within the same tick.
+    for (size_t level = LEVELS - 1; level > 0; --level)
+    {
+      const size_t shift = SLOT_BITS * level;
+      if ((m_now & ((static_cast<tick_type>(1) << shift) - 1)) == 0)
+      {
+        cascade(level, static_cast<size_t>((m_now >> shift) & SLOT_MASK));
+      }
+    }
+
+    cascade(0, static_cast<size_t>(m_now & SLOT_MASK));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+bool
+timing_wheel<T>::next_expired(T* value)
+{
+  if (m_expired.empty())
+  {
+    return false;
+  }
+
+  *value = m_expired.front().value;
+  m_expired.pop_front();
+  --m_size;
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+void
+timing_wheel<T>::clear()
+{
+  for (size_t level = 0; level < LEVELS; ++level)
+  {
+    for (size_t slot = 0; slot < SLOTS; ++slot)
+    {
+      m_slots[level][slot].clear();
+    }
+
+    m_level_sizes[level] = 0;
+  }
+
+  m_expired.clear();
+  m_size = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+typename timing_wheel<T>::list_type&
+timing_wheel<T>::list_of(size_t level, size_t slot)
+{
+  if (level == EXPIRED)
+  {
+    return m_expired;
+  }
+
+  return m_slots[level][slot];
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+void
+timing_wheel<T>::place(list_type& from, handle_type handle)
+{
+  if (handle->level != EXPIRED)
+  {
+    --m_level_sizes[handle->level];
+  }
+
+  if (handle->expiry <= m_now)
+  {
+    handle->level = EXPIRED;
+    handle->slot = 0;
+    m_expired.splice(m_expired.end(), from, handle);
+    return;
+  }
+
+  // The level is determined by the most significant slot index in which the
+  // expiry differs from the current tick.
+  const tick_type diff = handle->expiry ^ m_now;
+
+  size_t level = 0;
+  while (level + 1 < LEVELS && (diff >> (SLOT_BITS * (level + 1))) != 0)
+  {
+    ++level;
+  }
+
+  const size_t shift = SLOT_BITS * level;
+  size_t slot = static_cast<size_t>((handle->expiry >> shift) & SLOT_MASK);
+
+  if ((diff >> (SLOT_BITS * LEVELS)) != 0)
+  {
+    // Beyond the current revolution of the wheel. Park the timer in the first
+    // slot of the top level, which only comes due when the next revolution
+    // starts, since the timers regularly placed in the top level always
+    // expire in a later slot than the current one.
+    slot = 0;
+  }
+
+  handle->level = level;
+  handle->slot = slot;
+  ++m_level_sizes[level];
+  m_slots[level][slot].splice(m_slots[level][slot].end(), from, handle);
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+void
+timing_wheel<T>::cascade(size_t level, size_t slot)
+{
+  // Timers may be placed back into the same slot if they are parked.
+  list_type timers;
+  timers.splice(timers.end(), m_slots[level][slot]);
+
+  while (!timers.empty())
+  {
+    place(timers, timers.begin());
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace cache */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CACHE_TIMING_WHEEL_H_ */
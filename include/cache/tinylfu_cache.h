@@ -0,0 +1,318 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::cache::tinylfu_cache<K, V, N>` implements the W-TinyLFU caching
+ * scheme, which is resistant to pollution by one-off scans.
+ *
+ * The cache is divided into two regions:
+ *
+ *  - A small admission window (about 1% of the capacity) managed by LRU,
+ *    which all new entries enter first.
+ *  - A main region managed by segmented LRU (SLRU), consisting of a probation
+ *    segment and a protected segment (about 80% of the main region). Entries
+ *    hit while in probation are promoted to the protected segment.
+ *
+ * When the window overflows, its least recently used entry becomes a
+ * candidate for the main region. If the main region is full, the candidate
+ * is only admitted if its estimated access frequency is higher than that of
+ * the main region's eviction victim, otherwise the candidate is evicted
+ * instead. Access frequencies are estimated by a
+ * `sneaker::cache::count_min_sketch` that periodically ages its counters.
+ *
+ * Accesses are counted by `get()`, hits and misses alike, and not by
+ * `insert()`, so that a read-through insertion after a miss is counted once.
+ *
+ * Keys that are only seen once, such as the ones of a batch scan, hence cannot
+ * displace frequently accessed entries in the main region.
+ */
+
+#ifndef SNEAKER_CACHE_TINYLFU_CACHE_H_
+#define SNEAKER_CACHE_TINYLFU_CACHE_H_
+
+#include "cache/count_min_sketch.h"
+
+#include <cstdlib>
+#include <list>
+#include <unordered_map>
+
+
+namespace sneaker {
+namespace cache {
+
+template<typename K, typename V, size_t N>
+class tinylfu_cache
+{
+public:
+  typedef K key_type;
+  typedef V value_type;
+
+  static_assert(N >= 2, "Capacity of the cache must be at least 2");
+
+  tinylfu_cache()
+    :
+    m_index(),
+    m_window(),
+    m_probation(),
+    m_protected(),
+    m_sketch(N)
+  {
+  }
+
+  bool empty() const
+  {
+    return m_index.empty();
+  }
+
+  bool full() const
+  {
+    return m_index.size() == N;
+  }
+
+  size_t size() const
+  {
+    return m_index.size();
+  }
+
+  bool find(key_type key) const
+  {
+    return m_index.find(key) != m_index.end();
+  }
+
+  /**
+   * Gets the value associated with the specified key without counting an
+   * access to it or updating the order of eviction, or `NULL` if there is
+   * none. The value remains valid until the cache is modified.
+   */
+  const value_type* peek(const key_type& key)
+  {
+    const auto itr = m_index.find(key);
+
+    return itr != m_index.end() ? &itr->second->value : NULL;
+  }
+
+  bool get(const key_type& key, value_type& res)
+  {
+    m_sketch.increment(key);
+
+    const auto itr = m_index.find(key);
+
+    if (itr == m_index.end())
+    {
+      return false;
+    }
+
+    const typename list_type::iterator entry_itr = itr->second;
+
+    switch (entry_itr->segment)
+    {
+      case WINDOW:
+        m_window.splice(m_window.end(), m_window, entry_itr);
+        break;
+      case PROBATION:
+        promote(entry_itr);
+        break;
+      case PROTECTED:
+        m_protected.splice(m_protected.end(), m_protected, entry_itr);
+        break;
+    }
+
+    res = entry_itr->value;
+
+    return true;
+  }
+
+  void next_erasure_pair(key_type** key_ptr, value_type** value_ptr)
+  {
+    if (full())
+    {
+      list_type* list = NULL;
+      const typename list_type::iterator victim = next_victim(&list);
+      *key_ptr = &victim->key;
+      *value_ptr = &victim->value;
+    }
+  }
+
+  void insert(key_type key, const value_type& value)
+  {
+    if (find(key))
+    {
+      return;
+    }
+
+    if (full())
+    {
+      list_type* list = NULL;
+      const typename list_type::iterator victim = next_victim(&list);
+      const bool candidate_admitted = list != &m_window;
+
+      m_index.erase(victim->key);
+      list->erase(victim);
+
+      if (candidate_admitted)
+      {
+        admit_window_candidate();
+      }
+    }
+
+    m_window.push_back(entry{key, value, WINDOW});
+    m_index[key] = --m_window.end();
+
+    if (m_window.size() > WINDOW_CAPACITY)
+    {
+      admit_window_candidate();
+    }
+  }
+
+  bool erase(key_type key)
+  {
+    const auto itr = m_index.find(key);
+
+    if (itr == m_index.end())
+    {
+      return false;
+    }
+
+    const typename list_type::iterator entry_itr = itr->second;
+
+    m_index.erase(itr);
+    list_of(entry_itr->segment).erase(entry_itr);
+
+    return true;
+  }
+
+  void clear()
+  {
+    m_index.clear();
+    m_window.clear();
+    m_probation.clear();
+    m_protected.clear();
+    m_sketch.clear();
+  }
+
+private:
+  enum segment_type
+  {
+    WINDOW,
+    PROBATION,
+    PROTECTED
+  };
+
+  struct entry
+  {
+    key_type key;
+    value_type value;
+    segment_type segment;
+  };
+
+  // Entries in each list are ordered from the least recently used to the
+  // most recently used.
+  typedef std::list<entry> list_type;
+
+  static constexpr size_t WINDOW_CAPACITY = N / 100 > 0 ? N / 100 : 1;
+  static constexpr size_t MAIN_CAPACITY = N - WINDOW_CAPACITY;
+  static constexpr size_t PROTECTED_CAPACITY = MAIN_CAPACITY * 4 / 5;
+
+  list_type& list_of(segment_type segment)
+  {
+    switch (segment)
+    {
+      case WINDOW:
+        return m_window;
+      case PROBATION:
+        return m_probation;
+      case PROTECTED:
+        break;
+    }
+
+    return m_protected;
+  }
+
+  /**
+   * Determines the entry to be evicted when inserting into a full cache,
+   * which is the loser of the duel between the window's candidate and the
+   * main region's victim.
+   */
+  typename list_type::iterator next_victim(list_type** list)
+  {
+    list_type* victim_list = m_probation.empty() ? &m_protected : &m_probation;
+
+    const typename list_type::iterator candidate = m_window.begin();
+    const typename list_type::iterator victim = victim_list->begin();
+
+    if (m_sketch.frequency(candidate->key) > m_sketch.frequency(victim->key))
+    {
+      *list = victim_list;
+      return victim;
+    }
+
+    *list = &m_window;
+    return candidate;
+  }
+
+  /**
+   * Moves the least recently used entry in the window into the probation
+   * segment. The main region must have room for the entry.
+   */
+  void admit_window_candidate()
+  {
+    const typename list_type::iterator candidate = m_window.begin();
+    candidate->segment = PROBATION;
+    m_probation.splice(m_probation.end(), m_window, candidate);
+  }
+
+  /**
+   * Moves an entry in the probation segment into the protected segment,
+   * demoting the least recently used protected entry if necessary.
+   */
+  void promote(typename list_type::iterator entry_itr)
+  {
+    if (PROTECTED_CAPACITY == 0)
+    {
+      m_probation.splice(m_probation.end(), m_probation, entry_itr);
+      return;
+    }
+
+    entry_itr->segment = PROTECTED;
+    m_protected.splice(m_protected.end(), m_probation, entry_itr);
+
+    if (m_protected.size() > PROTECTED_CAPACITY)
+    {
+      const typename list_type::iterator demoted = m_protected.begin();
+      demoted->segment = PROBATION;
+      m_probation.splice(m_probation.end(), m_protected, demoted);
+    }
+  }
+
+  std::unordered_map<key_type, typename list_type::iterator> m_index;
+  list_type m_window;
+  list_type m_probation;
+  list_type m_protected;
+  count_min_sketch<key_type> m_sketch;
+};
+
+} /* end namespace cache */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CACHE_TINYLFU_CACHE_H_ */
@@ -0,0 +1,265 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::cache::weighted_lru_cache<K, V, Weigher>` implements the LRU
+ * caching scheme with a capacity that is specified at runtime and measured
+ * in the total weight of the entries, rather than in their number.
+ *
+ * The weight of each entry is determined once upon insertion by invoking
+ * `Weigher` with its key and value, which for example can return the number
+ * of bytes the entry occupies. The default weigher assigns each entry a weight
+ * of one, in which case the capacity is the maximum number of entries.
+ *
+ * The capacity can be changed on a live cache through `resize()`. Shrinking
+ * the capacity does not evict any entry by itself; instead the cache reports
+ * itself as full until enough entries have been evicted, which
+ * `sneaker::cache::cache_interface` does incrementally on each insertion and
+ * through `cache_interface::evict()`.
+ *
+ * Unlike the schemes with a fixed capacity, inserting into a full cache does
+ * not evict any entry by itself, since a single eviction may not make enough
+ * room. Instead, `sneaker::cache::cache_interface` weighs each new entry
+ * before inserting it, and evicts the pairs returned from
+ * `next_erasure_pair()` until the entry fits within the capacity. Entries
+ * heavier than the whole capacity are rejected rather than admitted, since
+ * they would evict every other entry and still exceed the capacity.
+ */
+
+#ifndef SNEAKER_CACHE_WEIGHTED_LRU_CACHE_H_
+#define SNEAKER_CACHE_WEIGHTED_LRU_CACHE_H_
+
+#include "cache/cache_interface.h"
+
+#include <cstdlib>
+#include <list>
+#include <unordered_map>
+
+
+namespace sneaker {
+namespace cache {
+
+template<typename K, typename V>
+struct unit_weigher
+{
+  size_t operator()(const K& /* key */, const V& /* value */) const
+  {
+    return 1;
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+template<typename K, typename V, class Weigher=unit_weigher<K, V>>
+class weighted_lru_cache
+{
+public:
+  typedef K key_type;
+  typedef V value_type;
+
+  explicit weighted_lru_cache(size_t capacity, const Weigher& weigher=Weigher())
+    :
+    m_index(),
+    m_entries(),
+    m_weigher(weigher),
+    m_capacity(capacity),
+    m_weight(0)
+  {
+  }
+
+  bool empty() const
+  {
+    return m_index.empty();
+  }
+
+  /**
+   * The cache is full when the total weight of its entries has reached the
+   * capacity. The total weight may exceed the capacity after the capacity has
+   * been shrunk, or after inserting into the scheme directly an entry heavier
+   * than the remaining room, in which case the cache stays full until enough
+   * entries are evicted.
+   */
+  bool full() const
+  {
+    return m_weight >= m_capacity;
+  }
+
+  size_t size() const
+  {
+    return m_index.size();
+  }
+
+  size_t capacity() const
+  {
+    return m_capacity;
+  }
+
+  size_t weight() const
+  {
+    return m_weight;
+  }
+
+  void resize(size_t capacity)
+  {
+    m_capacity = capacity;
+  }
+
+  bool find(key_type key) const
+  {
+    return m_index.find(key) != m_index.end();
+  }
+
+  /**
+   * Gets the value associated with the specified key without updating the
+   * order of eviction, or `NULL` if there is none. The value remains valid
+   * until the cache is modified.
+   */
+  const value_type* peek(const key_type& key)
+  {
+    const auto itr = m_index.find(key);
+
+    return itr != m_index.end() ? &itr->second->value : NULL;
+  }
+
+  bool get(const key_type& key, value_type& res)
+  {
+    const auto itr = m_index.find(key);
+
+    if (itr == m_index.end())
+    {
+      return false;
+    }
+
+    m_entries.splice(m_entries.end(), m_entries, itr->second);
+
+    res = itr->second->value;
+
+    return true;
+  }
+
+  /**
+   * Gets the weight of an entry of the specified key and value.
+   */
+  size_t weigh(const key_type& key, const value_type& value) const
+  {
+    return m_weigher(key, value);
+  }
+
+  /**
+   * Gets the least recently used entry whenever the cache is not empty, so
+   * that entries can be evicted to make room for a new one before the cache
+   * is full.
+   */
+  void next_erasure_pair(key_type** key_ptr, value_type** value_ptr)
+  {
+    if (!empty())
+    {
+      entry& victim = m_entries.front();
+      *key_ptr = &victim.key;
+      *value_ptr = &victim.value;
+    }
+  }
+
+  void insert(key_type key, const value_type& value)
+  {
+    if (find(key))
+    {
+      return;
+    }
+
+    const size_t weight = weigh(key, value);
+
+    m_entries.push_back(entry{key, value, weight});
+    m_index[key] = --m_entries.end();
+    m_weight += weight;
+  }
+
+  bool erase(key_type key)
+  {
+    const auto itr = m_index.find(key);
+
+    if (itr == m_index.end())
+    {
+      return false;
+    }
+
+    m_weight -= itr->second->weight;
+    m_entries.erase(itr->second);
+    m_index.erase(itr);
+
+    return true;
+  }
+
+  void clear()
+  {
+    m_index.clear();
+    m_entries.clear();
+    m_weight = 0;
+  }
+
+  /**
+   * Invokes `visitor(key, value)` on every entry, from the least recently
+   * used to the most recently used.
+   */
+  template<class Visitor>
+  void for_each(Visitor visitor) const
+  {
+    for (const entry& entry_ : m_entries)
+    {
+      visitor(entry_.key, entry_.value);
+    }
+  }
+
+private:
+  struct entry
+  {
+    key_type key;
+    value_type value;
+    size_t weight;
+  };
+
+  // Entries are ordered from the least recently used to the most recently
+  // used.
+  typedef std::list<entry> list_type;
+
+  std::unordered_map<key_type, typename list_type::iterator> m_index;
+  list_type m_entries;
+  Weigher m_weigher;
+  size_t m_capacity;
+  size_t m_weight;
+};
+
+// -----------------------------------------------------------------------------
+
+template<typename K, typename V, class Weigher>
+struct cache_scheme_traits<weighted_lru_cache<K, V, Weigher>>
+{
+  static constexpr bool expires = false;
+  static constexpr bool weighted = true;
+};
+
+} /* end namespace cache */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CACHE_WEIGHTED_LRU_CACHE_H_ */
@@ -57,6 +57,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <boost/tuple/tuple.hpp>
 
 #include <map>
+#include <tuple>
+#include <utility>
 
 
 namespace sneaker {
@@ -115,6 +117,24 @@ public:
 
   void insert(K key, ValueTypes... values);
 
+  /**
+   * Constructs a key-value(s) pair in place, forwarding the arguments to the
+   * constructors of the key and of the values. Returns an iterator to the
+   * pair with the key, and whether the pair has been inserted.
+   */
+  template<class KeyArg, class... Args>
+  std::pair<iterator, bool> emplace(KeyArg&& key, Args&&... values);
+
+  /**
+   * Like `emplace()`, but the values are only constructed if the key does not
+   * exist in the map.
+   */
+  template<class... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... values);
+
+  template<class... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... values);
+
   void erase(iterator itr);
   size_type erase(const K& key);
   void erase(iterator first, iterator last);
@@ -123,14 +143,14 @@ public:
 
   void clear() noexcept;
 
-  mapped_type& at(K key);
-  const mapped_type& at(K key) const;
+  mapped_type& at(const K& key);
+  const mapped_type& at(const K& key) const;
 
   template<class A, size_t Index>
-  A get(K key);
+  A& get(const K& key);
 
   template<class A, size_t Index>
-  const A& get(K key) const;
+  const A& get(const K& key) const;
 
   mapped_type& operator[](const K& key);
 
@@ -152,8 +172,8 @@ public:
   const_reverse_iterator crbegin() const noexcept;
   const_reverse_iterator crend() const noexcept;
 
-  iterator find(K key);
-  const_iterator find(K key) const;
+  iterator find(const K& key);
+  const_iterator find(const K& key) const;
 
 protected:
   core_type m_core;
@@ -237,6 +257,63 @@ assorted_value_map<K, ValueTypes...>::insert(K key, ValueTypes... values)
 
 // -----------------------------------------------------------------------------
 
+template<class K, class... ValueTypes>
+template<class KeyArg, class... Args>
+std::pair<typename assorted_value_map<K, ValueTypes...>::iterator, bool>
+assorted_value_map<K, ValueTypes...>::emplace(
+  KeyArg&& key, Args&&... values)
+{
+  return m_core.emplace(std::piecewise_construct,
+    std::forward_as_tuple(std::forward<KeyArg>(key)),
+    std::forward_as_tuple(std::forward<Args>(values)...));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class... Args>
+std::pair<typename assorted_value_map<K, ValueTypes...>::iterator, bool>
+assorted_value_map<K, ValueTypes...>::try_emplace(
+  const K& key, Args&&... values)
+{
+  iterator itr = m_core.lower_bound(key);
+
+  if (itr != m_core.end() && !m_core.key_comp()(key, itr->first))
+  {
+    return std::make_pair(itr, false);
+  }
+
+  itr = m_core.emplace_hint(itr, std::piecewise_construct,
+    std::forward_as_tuple(key),
+    std::forward_as_tuple(std::forward<Args>(values)...));
+
+  return std::make_pair(itr, true);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class... Args>
+std::pair<typename assorted_value_map<K, ValueTypes...>::iterator, bool>
+assorted_value_map<K, ValueTypes...>::try_emplace(
+  K&& key, Args&&... values)
+{
+  iterator itr = m_core.lower_bound(key);
+
+  if (itr != m_core.end() && !m_core.key_comp()(key, itr->first))
+  {
+    return std::make_pair(itr, false);
+  }
+
+  itr = m_core.emplace_hint(itr, std::piecewise_construct,
+    std::forward_as_tuple(std::move(key)),
+    std::forward_as_tuple(std::forward<Args>(values)...));
+
+  return std::make_pair(itr, true);
+}
+
+// -----------------------------------------------------------------------------
+
 template<class K, class... ValueTypes>
 void
 assorted_value_map<K, ValueTypes...>::erase(iterator itr)
@@ -286,7 +363,7 @@ assorted_value_map<K, ValueTypes...>::clear() noexcept
 
 template<class K, class... ValueTypes>
 typename assorted_value_map<K, ValueTypes...>::mapped_type&
-assorted_value_map<K, ValueTypes...>::at(K key)
+assorted_value_map<K, ValueTypes...>::at(const K& key)
 {
   return static_cast<mapped_type&>(m_core.at(key));
 }
@@ -295,7 +372,7 @@ assorted_value_map<K, ValueTypes...>::at(K key)
 
 template<class K, class... ValueTypes>
 const typename assorted_value_map<K, ValueTypes...>::mapped_type&
-assorted_value_map<K, ValueTypes...>::at(K key) const
+assorted_value_map<K, ValueTypes...>::at(const K& key) const
 {
   return static_cast<const mapped_type&>(m_core.at(key));
 }
@@ -304,8 +381,8 @@ assorted_value_map<K, ValueTypes...>::at(K key) const
 
 template<class K, class... ValueTypes>
 template<class A, size_t Index>
-A
-assorted_value_map<K, ValueTypes...>::get(K key)
+A&
+assorted_value_map<K, ValueTypes...>::get(const K& key)
 {
   return boost::get<Index>(at(key));
 }
@@ -315,7 +392,7 @@ assorted_value_map<K, ValueTypes...>::get(K key)
 template<class K, class... ValueTypes>
 template<class A, size_t Index>
 const A&
-assorted_value_map<K, ValueTypes...>::get(K key) const
+assorted_value_map<K, ValueTypes...>::get(const K& key) const
 {
   return boost::get<Index>(at(key));
 }
@@ -441,7 +518,7 @@ assorted_value_map<K, ValueTypes...>::crend() const noexcept
 
 template<class K, class... ValueTypes>
 typename assorted_value_map<K, ValueTypes...>::iterator
-assorted_value_map<K, ValueTypes...>::find(K key)
+assorted_value_map<K, ValueTypes...>::find(const K& key)
 {
   return m_core.find(key);
 }
@@ -450,7 +527,7 @@ assorted_value_map<K, ValueTypes...>::find(K key)
 
 template<class K, class... ValueTypes>
 typename assorted_value_map<K, ValueTypes...>::const_iterator
-assorted_value_map<K, ValueTypes...>::find(K key) const
+assorted_value_map<K, ValueTypes...>::find(const K& key) const
 {
   return m_core.find(key);
 }
@@ -0,0 +1,601 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::container::columnar_assorted_value_map<K, ValueTypes...>` is a
+ * variant of `sneaker::container::flat_assorted_value_map<K, ValueTypes...>`
+ * with a structure-of-arrays layout, where the keys and each of the assorted
+ * value types are stored in their own contiguous arrays, all indexed by the
+ * rank of the keys in sorted order.
+ *
+ * Scanning a single column of values, such as summing the first value across
+ * all keys, only touches the bytes of that column rather than dragging whole
+ * tuples through the cache, and lends itself to vectorization.
+ *
+ * Since the values of a key are not stored together, they cannot be accessed
+ * as a whole by reference; `at()` assembles a copy of them, while `get()`
+ * accesses a single value by reference. Columns are exposed through
+ * `column()` and column iterators.
+ *
+ * Like `flat_assorted_value_map`, insertions and erasures take linear time and
+ * invalidate all iterators and indices, and the map is best populated at once
+ * through `build_from()`. Keys are ordered by `std::less<K>`.
+ *
+ * Example:
+ *
+ *  typedef sneaker::container::columnar_assorted_value_map<
+ *    uint64_t, double, std::string> map_type;
+ *
+ *  map_type prices;
+ *  prices.build_from(pairs.begin(), pairs.end());
+ *
+ *  const double total = std::accumulate(
+ *    prices.column_begin<0>(), prices.column_end<0>(), 0.0);
+ */
+
+#ifndef SNEAKER_COLUMNAR_ASSORTED_VALUE_MAP_H_
+#define SNEAKER_COLUMNAR_ASSORTED_VALUE_MAP_H_
+
+#include <boost/container/vector.hpp>
+#include <boost/tuple/tuple.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+namespace sneaker {
+namespace container {
+
+template<class K, class... ValueTypes>
+class columnar_assorted_value_map {
+public:
+  using key_type                = K;
+  using mapped_type             = boost::tuple<ValueTypes... >;
+  using value_type              = std::pair<K, mapped_type>;
+  using key_compare             = std::less<K>;
+  using size_type               = size_t;
+  using difference_type         = ptrdiff_t;
+
+  /**
+   * Columns are `boost::container::vector` rather than `std::vector`, which
+   * is not specialized for `bool` and thus provides references to its
+   * elements.
+   */
+  using columns_type = std::tuple<boost::container::vector<ValueTypes>...>;
+
+  template<size_t Index>
+  using column_type = typename std::tuple_element<Index, columns_type>::type;
+
+  template<size_t Index>
+  using column_iterator = typename column_type<Index>::iterator;
+
+  template<size_t Index>
+  using const_column_iterator = typename column_type<Index>::const_iterator;
+
+  /**
+   * Index returned by `index_of()` for keys that are absent.
+   */
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+  columnar_assorted_value_map();
+
+  columnar_assorted_value_map(
+    const columnar_assorted_value_map<K, ValueTypes...>&);
+
+  ~columnar_assorted_value_map();
+
+  /**
+   * Replaces the content of the map with the key-value(s) pairs in the
+   * specified range, sorting them once. If several pairs have the same key,
+   * only the first one is kept.
+   */
+  template<class InputIterator>
+  void build_from(InputIterator first, InputIterator last);
+
+  bool empty() const;
+
+  size_type size() const;
+
+  void reserve(size_type count);
+
+  void insert(K key, ValueTypes... values);
+
+  size_type erase(const K& key);
+
+  void swap(columnar_assorted_value_map<K, ValueTypes...>& other);
+
+  void clear() noexcept;
+
+  /**
+   * Gets the index of the specified key in the key array and in every
+   * column, or `npos` if the key does not exist in the map.
+   */
+  size_type index_of(const K& key) const;
+
+  /**
+   * Gets a copy of the values associated with the specified key. Throws
+   * `std::out_of_range` if the key does not exist in the map.
+   */
+  mapped_type at(const K& key) const;
+
+  template<class A, size_t Index>
+  A& get(const K& key);
+
+  template<class A, size_t Index>
+  const A& get(const K& key) const;
+
+  /**
+   * Gets the keys in sorted order.
+   */
+  const std::vector<K>& keys() const;
+
+  template<size_t Index>
+  const column_type<Index>& column() const;
+
+  template<size_t Index>
+  column_iterator<Index> column_begin();
+
+  template<size_t Index>
+  const_column_iterator<Index> column_begin() const;
+
+  template<size_t Index>
+  column_iterator<Index> column_end();
+
+  template<size_t Index>
+  const_column_iterator<Index> column_end() const;
+
+protected:
+  template<size_t... Indices>
+  struct index_list {};
+
+  template<size_t N, size_t... Indices>
+  struct make_index_list : make_index_list<N - 1, N - 1, Indices...> {};
+
+  template<size_t... Indices>
+  struct make_index_list<0, Indices...>
+  {
+    typedef index_list<Indices...> type;
+  };
+
+  typedef typename make_index_list<sizeof...(ValueTypes)>::type indices_type;
+
+  size_type lower_bound(const K& key) const;
+
+  size_type checked_index_of(const K& key) const;
+
+  /**
+   * Inserts the specified key and values at the specified index. If any of
+   * the insertions throws, the ones that succeeded are undone, so that the
+   * columns stay aligned with the keys.
+   */
+  void insert_at(size_type index, const K& key, const mapped_type& values);
+
+  template<size_t... Indices>
+  void insert_values(size_type index, const mapped_type& values,
+    index_list<Indices...>);
+
+  template<size_t... Indices>
+  void erase_values(size_type index, index_list<Indices...>);
+
+  template<size_t... Indices>
+  void reserve_values(size_type count, index_list<Indices...>);
+
+  template<size_t... Indices>
+  mapped_type values_at(size_type index, index_list<Indices...>) const;
+
+  std::vector<K> m_keys;
+  columns_type m_columns;
+};
+
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+constexpr typename columnar_assorted_value_map<K, ValueTypes...>::size_type
+columnar_assorted_value_map<K, ValueTypes...>::npos;
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+columnar_assorted_value_map<K, ValueTypes...>::columnar_assorted_value_map()
+  :
+  m_keys(),
+  m_columns()
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+columnar_assorted_value_map<K, ValueTypes...>::columnar_assorted_value_map(
+  const columnar_assorted_value_map<K, ValueTypes...>& other)
+  :
+  m_keys(other.m_keys),
+  m_columns(other.m_columns)
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+columnar_assorted_value_map<K, ValueTypes...>::~columnar_assorted_value_map()
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class InputIterator>
+void
+columnar_assorted_value_map<K, ValueTypes...>::build_from(
+  InputIterator first, InputIterator last)
+{
+  std::vector<value_type> pairs(first, last);
+
+  // A stable sort keeps the first of the pairs with the same key in front.
+  std::stable_sort(pairs.begin(), pairs.end(),
+    [](const value_type& lhs, const value_type& rhs) {
+      return key_compare()(lhs.first, rhs.first);
+    });
+
+  pairs.erase(
+    std::unique(pairs.begin(), pairs.end(),
+      [](const value_type& lhs, const value_type& rhs) {
+        return !key_compare()(lhs.first, rhs.first);
+      }),
+    pairs.end());
+
+  clear();
+  reserve(pairs.size());
+
+  for (const value_type& pair : pairs)
+  {
+    insert_at(m_keys.size(), pair.first, pair.second);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+bool
+columnar_assorted_value_map<K, ValueTypes...>::empty() const
+{
+  return m_keys.empty();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename columnar_assorted_value_map<K, ValueTypes...>::size_type
+columnar_assorted_value_map<K, ValueTypes...>::size() const
+{
+  return m_keys.size();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+void
+columnar_assorted_value_map<K, ValueTypes...>::reserve(size_type count)
+{
+  m_keys.reserve(count);
+  reserve_values(count, indices_type());
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+void
+columnar_assorted_value_map<K, ValueTypes...>::insert(K key, ValueTypes... values)
+{
+  const size_type index = lower_bound(key);
+
+  if (index != m_keys.size() && !key_compare()(key, m_keys[index]))
+  {
+    return;
+  }
+
+  insert_at(index, key, mapped_type(values...));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename columnar_assorted_value_map<K, ValueTypes...>::size_type
+columnar_assorted_value_map<K, ValueTypes...>::erase(const K& key)
+{
+  const size_type index = index_of(key);
+
+  if (index == npos)
+  {
+    return 0;
+  }
+
+  erase_values(index, indices_type());
+  m_keys.erase(m_keys.begin() + static_cast<difference_type>(index));
+
+  return 1;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+void
+columnar_assorted_value_map<K, ValueTypes...>::swap(
+  columnar_assorted_value_map<K, ValueTypes...>& other)
+{
+  m_keys.swap(other.m_keys);
+  m_columns.swap(other.m_columns);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+void
+columnar_assorted_value_map<K, ValueTypes...>::clear() noexcept
+{
+  m_keys.clear();
+  m_columns = columns_type();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename columnar_assorted_value_map<K, ValueTypes...>::size_type
+columnar_assorted_value_map<K, ValueTypes...>::index_of(const K& key) const
+{
+  const size_type index = lower_bound(key);
+
+  if (index != m_keys.size() && !key_compare()(key, m_keys[index]))
+  {
+    return index;
+  }
+
+  return npos;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename columnar_assorted_value_map<K, ValueTypes...>::mapped_type
+columnar_assorted_value_map<K, ValueTypes...>::at(const K& key) const
+{
+  return values_at(checked_index_of(key), indices_type());
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class A, size_t Index>
+A&
+columnar_assorted_value_map<K, ValueTypes...>::get(const K& key)
+{
+  return std::get<Index>(m_columns)[checked_index_of(key)];
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class A, size_t Index>
+const A&
+columnar_assorted_value_map<K, ValueTypes...>::get(const K& key) const
+{
+  return std::get<Index>(m_columns)[checked_index_of(key)];
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+const std::vector<K>&
+columnar_assorted_value_map<K, ValueTypes...>::keys() const
+{
+  return m_keys;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<size_t Index>
+const typename columnar_assorted_value_map<K, ValueTypes...>::template column_type<Index>&
+columnar_assorted_value_map<K, ValueTypes...>::column() const
+{
+  return std::get<Index>(m_columns);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<size_t Index>
+typename columnar_assorted_value_map<K, ValueTypes...>::template column_iterator<Index>
+columnar_assorted_value_map<K, ValueTypes...>::column_begin()
+{
+  return std::get<Index>(m_columns).begin();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<size_t Index>
+typename columnar_assorted_value_map<K, ValueTypes...>::template const_column_iterator<Index>
+columnar_assorted_value_map<K, ValueTypes...>::column_begin() const
+{
+  return std::get<Index>(m_columns).begin();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<size_t Index>
+typename columnar_assorted_value_map<K, ValueTypes...>::template column_iterator<Index>
+columnar_assorted_value_map<K, ValueTypes...>::column_end()
+{
+  return std::get<Index>(m_columns).end();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<size_t Index>
+typename columnar_assorted_value_map<K, ValueTypes...>::template const_column_iterator<Index>
+columnar_assorted_value_map<K, ValueTypes...>::column_end() const
+{
+  return std::get<Index>(m_columns).end();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename columnar_assorted_value_map<K, ValueTypes...>::size_type
+columnar_assorted_value_map<K, ValueTypes...>::lower_bound(const K& key) const
+{
+  return static_cast<size_type>(
+    std::lower_bound(m_keys.begin(), m_keys.end(), key, key_compare()) -
+      m_keys.begin());
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename columnar_assorted_value_map<K, ValueTypes...>::size_type
+columnar_assorted_value_map<K, ValueTypes...>::checked_index_of(const K& key) const
+{
+  const size_type index = index_of(key);
+
+  if (index == npos)
+  {
+    throw std::out_of_range("columnar_assorted_value_map::at");
+  }
+
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+void
+columnar_assorted_value_map<K, ValueTypes...>::insert_at(
+  size_type index, const K& key, const mapped_type& values)
+{
+  m_keys.insert(m_keys.begin() + static_cast<difference_type>(index), key);
+
+  try
+  {
+    insert_values(index, values, indices_type());
+  }
+  catch (...)
+  {
+    m_keys.erase(m_keys.begin() + static_cast<difference_type>(index));
+    throw;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<size_t... Indices>
+void
+columnar_assorted_value_map<K, ValueTypes...>::insert_values(
+  size_type index, const mapped_type& values, index_list<Indices...>)
+{
+  size_t inserted = 0;
+
+  try
+  {
+    const int expansion[] = { 0, (
+      (void)std::get<Indices>(m_columns).insert(
+        std::get<Indices>(m_columns).begin() +
+          static_cast<difference_type>(index),
+        boost::get<Indices>(values)), (void)++inserted, 0)... };
+    (void)expansion;
+  }
+  catch (...)
+  {
+    const int rollback[] = { 0, (Indices < inserted ? (
+      (void)std::get<Indices>(m_columns).erase(
+        std::get<Indices>(m_columns).begin() +
+          static_cast<difference_type>(index)), 0) : 0)... };
+    (void)rollback;
+    throw;
+  }
+
+  (void)inserted;
+  (void)index;
+  (void)values;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<size_t... Indices>
+void
+columnar_assorted_value_map<K, ValueTypes...>::erase_values(
+  size_type index, index_list<Indices...>)
+{
+  const int expansion[] = { 0, (
+    std::get<Indices>(m_columns).erase(
+      std::get<Indices>(m_columns).begin() +
+        static_cast<difference_type>(index)), 0)... };
+  (void)expansion;
+  (void)index;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<size_t... Indices>
+void
+columnar_assorted_value_map<K, ValueTypes...>::reserve_values(
+  size_type count, index_list<Indices...>)
+{
+  const int expansion[] = { 0, (
+    std::get<Indices>(m_columns).reserve(count), 0)... };
+  (void)expansion;
+  (void)count;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<size_t... Indices>
+typename columnar_assorted_value_map<K, ValueTypes...>::mapped_type
+columnar_assorted_value_map<K, ValueTypes...>::values_at(
+  size_type index, index_list<Indices...>) const
+{
+  return mapped_type(std::get<Indices>(m_columns)[index]...);
+}
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace container */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_COLUMNAR_ASSORTED_VALUE_MAP_H_ */
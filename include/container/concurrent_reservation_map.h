@@ -0,0 +1,706 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::container::concurrent_reservation_map<T>` is a thread-safe
+ * variant of `sneaker::container::slot_map<T>`, for tokens that are reserved
+ * by one thread and filled in by another, such as results handed back by
+ * worker threads.
+ *
+ * The container has a fixed number of slots. Tokens are 64-bit generational
+ * indices, as in `slot_map`, and are reserved without locking by popping a
+ * slot off an atomic free list. The generation of a slot and the state of
+ * its value share a single atomic word, so that a stale token can never
+ * publish into or read from a slot that has been reserved again.
+ *
+ * A value is put once per reservation, and is published with release
+ * semantics; readers that observe it, through `get()` or the blocking
+ * `wait_get()`, also observe its construction. Consumers waiting on a token
+ * are woken up through a small set of condition variables shared by the
+ * slots, which are only signaled when a thread is waiting.
+ *
+ * Threads copying a value are counted in the atomic word of its slot, and
+ * unreserving a token waits for them to finish before destroying the value,
+ * so a token can be unreserved while other threads are waiting on it.
+ *
+ * Example:
+ *
+ *  sneaker::container::concurrent_reservation_map<result> results(1024);
+ *
+ *  auto token = results.reserve();
+ *
+ *  pool.submit([&results, token]() {
+ *    results.put(token, compute());
+ *  });
+ *
+ *  result value;
+ *  results.wait_get(token, &value);
+ *  results.unreserve(token);
+ */
+
+#ifndef SNEAKER_CONCURRENT_RESERVATION_MAP_H_
+#define SNEAKER_CONCURRENT_RESERVATION_MAP_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+
+namespace sneaker {
+namespace container {
+
+template<class T>
+class concurrent_reservation_map {
+public:
+  typedef uint64_t token_t;
+
+  /**
+   * Constructs a container with the specified number of slots, which bounds
+   * the number of tokens that can be reserved at the same time.
+   */
+  explicit concurrent_reservation_map(size_t capacity);
+
+  ~concurrent_reservation_map();
+
+  concurrent_reservation_map(const concurrent_reservation_map&) = delete;
+  concurrent_reservation_map& operator=(
+    const concurrent_reservation_map&) = delete;
+
+  size_t capacity() const;
+
+  /**
+   * Gets the number of values currently stored in the container.
+   */
+  size_t size() const;
+
+  /**
+   * Gets the number of tokens currently reserved.
+   */
+  size_t reservations() const;
+
+  /**
+   * Reserves a slot and returns its token. Throws `std::length_error` if all
+   * the slots are reserved.
+   */
+  token_t reserve();
+
+  bool member(token_t id) const;
+
+  /**
+   * Stores and publishes a value for the specified token. Returns `false` if
+   * the token is not reserved, or if a value has already been put for it. If
+   * moving the value into the slot throws, no value is put for the token.
+   */
+  bool put(token_t id, T value);
+
+  /**
+   * Copies the value stored for the specified token, if it has been
+   * published.
+   */
+  bool get(token_t id, T* ptr) const;
+
+  /**
+   * Blocks until a value is published for the specified token, and copies
+   * it. Returns `false` if the token is not reserved, or is unreserved while
+   * waiting.
+   */
+  bool wait_get(token_t id, T* ptr) const;
+
+  /**
+   * Same as `wait_get()`, but gives up and returns `false` after the
+   * specified timeout.
+   */
+  template<class Rep, class Period>
+  bool wait_get(token_t id, T* ptr,
+    const std::chrono::duration<Rep, Period>& timeout) const;
+
+  /**
+   * Releases the slot of the specified token, destroys its value, if any, and
+   * wakes up the threads waiting on the token. Waits for the threads copying
+   * the value to finish.
+   */
+  bool unreserve(token_t id);
+
+private:
+  /**
+   * States of the value of a slot, held in the low bits of its atomic word,
+   * below the number of threads copying the value, in units of `READER`.
+   */
+  enum : uint32_t
+  {
+    EMPTY = 0,
+    WRITING = 1,
+    READY = 2,
+    STATE_MASK = 3,
+    READER = 4
+  };
+
+  static constexpr uint32_t NPOS = UINT32_MAX;
+
+  /**
+   * The number of condition variables shared by the slots.
+   */
+  static constexpr size_t WAIT_STRIPES = 16;
+
+  struct slot
+  {
+    /**
+     * The generation of the slot in the high 32 bits, odd while the slot is
+     * reserved, and the state of its value and the number of its readers in
+     * the low 32 bits.
+     */
+    std::atomic<uint64_t> word;
+
+    /**
+     * The next slot on the free list.
+     */
+    std::atomic<uint32_t> next;
+
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+    T* value()
+    {
+      return reinterpret_cast<T*>(&storage);
+    }
+
+    const T* value() const
+    {
+      return reinterpret_cast<const T*>(&storage);
+    }
+  };
+
+  struct wait_stripe
+  {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<size_t> waiters;
+  };
+
+  static uint64_t make_word(uint32_t generation, uint32_t state);
+
+  /**
+   * Gets the slot of the specified token, or `NULL` if the index of the token
+   * is out of range. The generation of the token is checked by the callers.
+   */
+  slot* slot_of(token_t id) const;
+
+  wait_stripe& stripe_of(token_t id) const;
+
+  bool copy_if_ready(token_t id, T* ptr, bool* valid) const;
+
+  /**
+   * Blocks until `copy_if_ready()` succeeds or finds the token invalid, or
+   * until `wait()` returns `false`.
+   */
+  template<class Wait>
+  bool wait_for_value(token_t id, T* ptr, Wait wait) const;
+
+  void notify(token_t id);
+
+  void push_free(uint32_t index);
+
+  const size_t m_capacity;
+  std::unique_ptr<slot[]> m_slots;
+  std::unique_ptr<wait_stripe[]> m_stripes;
+
+  /**
+   * The index of the first free slot in the low 32 bits, and a counter of
+   * the updates of the list in the high 32 bits, which prevents the ABA
+   * problem between concurrent pops and pushes.
+   */
+  std::atomic<uint64_t> m_free_head;
+
+  std::atomic<size_t> m_size;
+  std::atomic<size_t> m_reservations;
+};
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+constexpr uint32_t concurrent_reservation_map<T>::NPOS;
+
+template<class T>
+constexpr size_t concurrent_reservation_map<T>::WAIT_STRIPES;
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+concurrent_reservation_map<T>::concurrent_reservation_map(size_t capacity)
+  :
+  m_capacity(capacity),
+  m_slots(new slot[capacity]),
+  m_stripes(new wait_stripe[WAIT_STRIPES]),
+  m_free_head(NPOS),
+  m_size(0),
+  m_reservations(0)
+{
+  if (capacity >= NPOS)
+  {
+    throw std::length_error("concurrent_reservation_map");
+  }
+
+  for (size_t i = 0; i < WAIT_STRIPES; ++i)
+  {
+    m_stripes[i].waiters.store(0, std::memory_order_relaxed);
+  }
+
+  for (size_t i = 0; i < m_capacity; ++i)
+  {
+    m_slots[i].word.store(make_word(0, EMPTY), std::memory_order_relaxed);
+    m_slots[i].next.store(
+      i + 1 < m_capacity ? static_cast<uint32_t>(i + 1) : NPOS,
+      std::memory_order_relaxed);
+  }
+
+  if (m_capacity)
+  {
+    m_free_head.store(0, std::memory_order_release);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+concurrent_reservation_map<T>::~concurrent_reservation_map()
+{
+  for (size_t i = 0; i < m_capacity; ++i)
+  {
+    const uint64_t word = m_slots[i].word.load(std::memory_order_acquire);
+
+    if (static_cast<uint32_t>(word) == READY)
+    {
+      m_slots[i].value()->~T();
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+size_t
+concurrent_reservation_map<T>::capacity() const
+{
+  return m_capacity;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+size_t
+concurrent_reservation_map<T>::size() const
+{
+  return m_size.load(std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+size_t
+concurrent_reservation_map<T>::reservations() const
+{
+  return m_reservations.load(std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+typename concurrent_reservation_map<T>::token_t
+concurrent_reservation_map<T>::reserve()
+{
+  uint64_t head = m_free_head.load(std::memory_order_acquire);
+  uint32_t index = NPOS;
+
+  while (true)
+  {
+    index = static_cast<uint32_t>(head);
+
+    if (index == NPOS)
+    {
+      throw std::length_error("concurrent_reservation_map::reserve");
+    }
+
+    const uint64_t next = m_slots[index].next.load(std::memory_order_relaxed);
+    const uint64_t tag = (head >> 32) + 1;
+
+    if (m_free_head.compare_exchange_weak(head, (tag << 32) | next,
+        std::memory_order_acquire, std::memory_order_acquire))
+    {
+      break;
+    }
+  }
+
+  // The slot is owned exclusively until its token is handed out.
+  slot& reserved = m_slots[index];
+  const uint32_t generation = static_cast<uint32_t>(
+    reserved.word.load(std::memory_order_relaxed) >> 32) + 1;
+
+  reserved.word.store(make_word(generation, EMPTY), std::memory_order_release);
+
+  m_reservations.fetch_add(1, std::memory_order_relaxed);
+
+  return (static_cast<token_t>(generation) << 32) | index;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+bool
+concurrent_reservation_map<T>::member(token_t id) const
+{
+  const slot* reserved = slot_of(id);
+
+  return reserved &&
+    (reserved->word.load(std::memory_order_acquire) >> 32) == (id >> 32);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+bool
+concurrent_reservation_map<T>::put(token_t id, T value)
+{
+  slot* reserved = slot_of(id);
+
+  if (!reserved)
+  {
+    return false;
+  }
+
+  const uint32_t generation = static_cast<uint32_t>(id >> 32);
+
+  // Claiming the slot for writing fails for stale tokens, whose generation
+  // differs, and for tokens whose value has already been put.
+  uint64_t expected = make_word(generation, EMPTY);
+
+  if (!reserved->word.compare_exchange_strong(expected,
+      make_word(generation, WRITING), std::memory_order_acquire,
+      std::memory_order_relaxed))
+  {
+    return false;
+  }
+
+  try
+  {
+    new (&reserved->storage) T(std::move(value));
+  }
+  catch (...)
+  {
+    // Releases the slot for `unreserve()`, which waits while it is written.
+    reserved->word.store(make_word(generation, EMPTY),
+      std::memory_order_release);
+    throw;
+  }
+
+  m_size.fetch_add(1, std::memory_order_relaxed);
+
+  // Sequentially consistent, to be ordered with the registration of waiters
+  // in `wait_for_value()`.
+  reserved->word.store(make_word(generation, READY),
+    std::memory_order_seq_cst);
+
+  notify(id);
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+bool
+concurrent_reservation_map<T>::get(token_t id, T* ptr) const
+{
+  bool valid = false;
+  return copy_if_ready(id, ptr, &valid);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+bool
+concurrent_reservation_map<T>::wait_get(token_t id, T* ptr) const
+{
+  return wait_for_value(id, ptr,
+    [](std::condition_variable& condition, std::unique_lock<std::mutex>& lock)
+    {
+      condition.wait(lock);
+      return true;
+    }
+  );
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+template<class Rep, class Period>
+bool
+concurrent_reservation_map<T>::wait_get(token_t id, T* ptr,
+  const std::chrono::duration<Rep, Period>& timeout) const
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+  return wait_for_value(id, ptr,
+    [deadline](std::condition_variable& condition,
+      std::unique_lock<std::mutex>& lock)
+    {
+      return condition.wait_until(lock, deadline) !=
+        std::cv_status::timeout;
+    }
+  );
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+bool
+concurrent_reservation_map<T>::unreserve(token_t id)
+{
+  slot* reserved = slot_of(id);
+
+  if (!reserved)
+  {
+    return false;
+  }
+
+  const uint32_t generation = static_cast<uint32_t>(id >> 32);
+  uint64_t word = reserved->word.load(std::memory_order_acquire);
+
+  while (true)
+  {
+    if (static_cast<uint32_t>(word >> 32) != generation)
+    {
+      return false;
+    }
+
+    if (static_cast<uint32_t>(word) != EMPTY &&
+        static_cast<uint32_t>(word) != READY)
+    {
+      // A concurrent `put()` is constructing the value, or readers are
+      // copying it.
+      std::this_thread::yield();
+      word = reserved->word.load(std::memory_order_acquire);
+      continue;
+    }
+
+    // Sequentially consistent, as in `put()`, since waiters are woken up.
+    if (reserved->word.compare_exchange_weak(word,
+        make_word(generation + 1, EMPTY), std::memory_order_seq_cst,
+        std::memory_order_acquire))
+    {
+      break;
+    }
+  }
+
+  if (static_cast<uint32_t>(word) == READY)
+  {
+    reserved->value()->~T();
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  m_reservations.fetch_sub(1, std::memory_order_relaxed);
+
+  notify(id);
+
+  push_free(static_cast<uint32_t>(id));
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+uint64_t
+concurrent_reservation_map<T>::make_word(uint32_t generation, uint32_t state)
+{
+  return (static_cast<uint64_t>(generation) << 32) | state;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+typename concurrent_reservation_map<T>::slot*
+concurrent_reservation_map<T>::slot_of(token_t id) const
+{
+  const uint32_t index = static_cast<uint32_t>(id);
+
+  // Tokens are only issued with odd generations.
+  if (index >= m_capacity || !((id >> 32) & 1))
+  {
+    return NULL;
+  }
+
+  return &m_slots[index];
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+typename concurrent_reservation_map<T>::wait_stripe&
+concurrent_reservation_map<T>::stripe_of(token_t id) const
+{
+  return m_stripes[static_cast<uint32_t>(id) % WAIT_STRIPES];
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+bool
+concurrent_reservation_map<T>::copy_if_ready(
+  token_t id, T* ptr, bool* valid) const
+{
+  slot* reserved = slot_of(id);
+
+  if (!reserved)
+  {
+    *valid = false;
+    return false;
+  }
+
+  uint64_t word = reserved->word.load(std::memory_order_seq_cst);
+
+  // Registers as a reader of the value, which holds off `unreserve()`.
+  do
+  {
+    *valid = (word >> 32) == (id >> 32);
+
+    if (!*valid || (static_cast<uint32_t>(word) & STATE_MASK) != READY)
+    {
+      return false;
+    }
+  }
+  while (!reserved->word.compare_exchange_weak(word, word + READER,
+    std::memory_order_seq_cst, std::memory_order_seq_cst));
+
+  try
+  {
+    *ptr = *reserved->value();
+  }
+  catch (...)
+  {
+    reserved->word.fetch_sub(READER, std::memory_order_release);
+    throw;
+  }
+
+  reserved->word.fetch_sub(READER, std::memory_order_release);
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+template<class Wait>
+bool
+concurrent_reservation_map<T>::wait_for_value(
+  token_t id, T* ptr, Wait wait) const
+{
+  bool valid = false;
+
+  if (copy_if_ready(id, ptr, &valid) || !valid)
+  {
+    return valid;
+  }
+
+  wait_stripe& stripe = stripe_of(id);
+  std::unique_lock<std::mutex> lock(stripe.mutex);
+
+  // Registering as a waiter before checking the value again ensures that a
+  // concurrent publication either is seen, or sees the waiter and notifies.
+  stripe.waiters.fetch_add(1, std::memory_order_seq_cst);
+
+  bool copied = false;
+
+  while (!(copied = copy_if_ready(id, ptr, &valid)) && valid)
+  {
+    if (!wait(stripe.condition, lock))
+    {
+      copied = copy_if_ready(id, ptr, &valid);
+      break;
+    }
+  }
+
+  stripe.waiters.fetch_sub(1, std::memory_order_relaxed);
+
+  return copied;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+void
+concurrent_reservation_map<T>::notify(token_t id)
+{
+  wait_stripe& stripe = stripe_of(id);
+
+  if (!stripe.waiters.load(std::memory_order_seq_cst))
+  {
+    return;
+  }
+
+  {
+    // Acquiring the mutex ensures that waiters are either blocked on the
+    // condition, or have not checked the value yet.
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+  }
+
+  stripe.condition.notify_all();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+void
+concurrent_reservation_map<T>::push_free(uint32_t index)
+{
+  uint64_t head = m_free_head.load(std::memory_order_relaxed);
+
+  while (true)
+  {
+    m_slots[index].next.store(static_cast<uint32_t>(head),
+      std::memory_order_relaxed);
+
+    const uint64_t tag = (head >> 32) + 1;
+
+    if (m_free_head.compare_exchange_weak(head, (tag << 32) | index,
+        std::memory_order_release, std::memory_order_relaxed))
+    {
+      break;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace container */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_CONCURRENT_RESERVATION_MAP_H_ */
@@ -0,0 +1,990 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::container::flat_assorted_value_map<K, ValueTypes...>` is a variant
+ * of `sneaker::container::assorted_value_map<K, ValueTypes...>` that stores its
+ * key-value(s) pairs contiguously in a vector sorted by key, instead of in the
+ * nodes of a red-black tree.
+ *
+ * It is meant for maps that are built once and then read many times. Ordered
+ * iteration and range scans walk contiguous memory, and lookups descend the
+ * ranks of the pairs arranged in the Eytzinger (breadth-first) layout of a
+ * binary search tree, where the first levels of the tree share a few cache
+ * lines and the search path is a simple function of the comparison results.
+ *
+ * Insertions and erasures cost linear time, as they shift the pairs after the
+ * affected position, and they invalidate all iterators. They also discard the
+ * search layout, and lookups fall back to a binary search over the pairs
+ * until it is rebuilt by `build_from()` or `build_layout()`. A map is best
+ * populated at once through `build_from()`, which sorts the pairs once.
+ *
+ * Keys are ordered by `std::less<K>`, as in `assorted_value_map`.
+ *
+ * Example:
+ *
+ *  typedef sneaker::container::flat_assorted_value_map<int, std::string, double>
+ *    map_type;
+ *
+ *  std::vector<map_type::value_type> pairs = load_pairs();
+ *
+ *  map_type map;
+ *  map.build_from(pairs.begin(), pairs.end());
+ *
+ *  for (auto itr = map.lower_bound(100); itr != map.upper_bound(200); ++itr)
+ *  {
+ *    ...
+ *  }
+ */
+
+#ifndef SNEAKER_FLAT_ASSORTED_VALUE_MAP_H_
+#define SNEAKER_FLAT_ASSORTED_VALUE_MAP_H_
+
+#include <boost/tuple/tuple.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace sneaker {
+namespace container {
+
+template<class K, class... ValueTypes>
+class flat_assorted_value_map {
+public:
+  using core_type = typename std::vector<
+    std::pair<K, boost::tuple<ValueTypes... >>>;
+
+  using key_type                = K;
+  using mapped_type             = boost::tuple<ValueTypes... >;
+  using value_type              = typename core_type::value_type;
+  using key_compare             = std::less<K>;
+  using allocator_type          = typename core_type::allocator_type;
+  using reference               = typename core_type::reference;
+  using const_reference         = typename core_type::const_reference;
+  using pointer                 = typename core_type::pointer;
+  using const_pointer           = typename core_type::const_pointer;
+  using iterator                = typename core_type::iterator;
+  using const_iterator          = typename core_type::const_iterator;
+  using reverse_iterator        = typename core_type::reverse_iterator;
+  using const_reverse_iterator  = typename core_type::const_reverse_iterator;
+  using difference_type         = typename core_type::difference_type;
+  using size_type               = typename core_type::size_type;
+
+  flat_assorted_value_map();
+
+  flat_assorted_value_map(const flat_assorted_value_map<K, ValueTypes...>&);
+
+  ~flat_assorted_value_map();
+
+  /**
+   * Replaces the content of the map with the key-value(s) pairs in the
+   * specified range, sorting them once. If several pairs have the same key,
+   * only the first one is kept.
+   */
+  template<class InputIterator>
+  void build_from(InputIterator first, InputIterator last);
+
+  bool empty() const;
+
+  size_type size() const;
+
+  size_type max_size() const;
+
+  void reserve(size_type count);
+
+  void insert(K key, ValueTypes... values);
+
+  /**
+   * Constructs a key-value(s) pair in place, forwarding the arguments to the
+   * constructors of the key and of the values. Returns an iterator to the
+   * pair with the key, and whether the pair has been inserted.
+   */
+  template<class KeyArg, class... Args>
+  std::pair<iterator, bool> emplace(KeyArg&& key, Args&&... values);
+
+  /**
+   * Like `emplace()`, but the values are only constructed if the key does not
+   * exist in the map.
+   */
+  template<class... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... values);
+
+  template<class... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... values);
+
+  void erase(iterator itr);
+  size_type erase(const K& key);
+  void erase(iterator first, iterator last);
+
+  void swap(flat_assorted_value_map<K, ValueTypes...>& other);
+
+  void clear() noexcept;
+
+  mapped_type& at(const K& key);
+  const mapped_type& at(const K& key) const;
+
+  template<class A, size_t Index>
+  A& get(const K& key);
+
+  template<class A, size_t Index>
+  const A& get(const K& key) const;
+
+  mapped_type& operator[](const K& key);
+
+  iterator begin();
+  const_iterator begin() const;
+
+  iterator end();
+  const_iterator end() const;
+
+  reverse_iterator rbegin();
+  const_reverse_iterator rbegin() const;
+
+  reverse_iterator rend();
+  const_reverse_iterator rend() const;
+
+  const_iterator cbegin() const noexcept;
+  const_iterator cend() const noexcept;
+
+  const_reverse_iterator crbegin() const noexcept;
+  const_reverse_iterator crend() const noexcept;
+
+  iterator find(const K& key);
+  const_iterator find(const K& key) const;
+
+  /**
+   * Gets an iterator to the first pair whose key is not less than the
+   * specified key.
+   */
+  iterator lower_bound(const K& key);
+  const_iterator lower_bound(const K& key) const;
+
+  /**
+   * Gets an iterator to the first pair whose key is greater than the
+   * specified key.
+   */
+  iterator upper_bound(const K& key);
+  const_iterator upper_bound(const K& key) const;
+
+  /**
+   * Heterogeneous lookups, for keys of class types. They take any type that
+   * is comparable with the keys through `operator<`, consistently with
+   * `std::less<K>`, such as `const char*` for `std::string` keys, without
+   * constructing a temporary key.
+   */
+  template<class KeyLike>
+  using enable_if_heterogeneous = typename std::enable_if<
+    std::is_class<K>::value &&
+    !std::is_same<typename std::decay<KeyLike>::type, K>::value>::type;
+
+  template<class KeyLike, class = enable_if_heterogeneous<KeyLike>>
+  mapped_type& at(const KeyLike& key);
+
+  template<class KeyLike, class = enable_if_heterogeneous<KeyLike>>
+  const mapped_type& at(const KeyLike& key) const;
+
+  template<class A, size_t Index, class KeyLike,
+    class = enable_if_heterogeneous<KeyLike>>
+  A& get(const KeyLike& key);
+
+  template<class A, size_t Index, class KeyLike,
+    class = enable_if_heterogeneous<KeyLike>>
+  const A& get(const KeyLike& key) const;
+
+  template<class KeyLike, class = enable_if_heterogeneous<KeyLike>>
+  iterator find(const KeyLike& key);
+
+  template<class KeyLike, class = enable_if_heterogeneous<KeyLike>>
+  const_iterator find(const KeyLike& key) const;
+
+  template<class KeyLike, class = enable_if_heterogeneous<KeyLike>>
+  iterator lower_bound(const KeyLike& key);
+
+  template<class KeyLike, class = enable_if_heterogeneous<KeyLike>>
+  const_iterator lower_bound(const KeyLike& key) const;
+
+  template<class KeyLike, class = enable_if_heterogeneous<KeyLike>>
+  iterator upper_bound(const KeyLike& key);
+
+  template<class KeyLike, class = enable_if_heterogeneous<KeyLike>>
+  const_iterator upper_bound(const KeyLike& key) const;
+
+  /**
+   * Rebuilds the search layout from the sorted pairs, after a batch of
+   * insertions or erasures.
+   */
+  void build_layout();
+
+protected:
+  void build_layout(size_type node, size_type& rank);
+
+  /**
+   * Searches the layout, or the pairs if there is none, for the rank of the
+   * first pair whose key is not less than, or if `upper` is `true` greater
+   * than, the specified key.
+   */
+  template<class KeyLike>
+  size_type search(const KeyLike& key, bool upper) const;
+
+  static bool less(const K& lhs, const K& rhs);
+
+  template<class Lhs, class Rhs>
+  static bool less(const Lhs& lhs, const Rhs& rhs);
+
+  core_type m_core;
+
+  // The ranks of the sorted pairs in the Eytzinger layout, one-based, or
+  // empty if the layout has been discarded. The first element is unused.
+  std::vector<size_type> m_layout;
+};
+
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+flat_assorted_value_map<K, ValueTypes...>::flat_assorted_value_map()
+  :
+  m_core(),
+  m_layout()
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+flat_assorted_value_map<K, ValueTypes...>::flat_assorted_value_map(
+  const flat_assorted_value_map<K, ValueTypes...>& other)
+  :
+  m_core(other.m_core),
+  m_layout(other.m_layout)
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+flat_assorted_value_map<K, ValueTypes...>::~flat_assorted_value_map()
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class InputIterator>
+void
+flat_assorted_value_map<K, ValueTypes...>::build_from(
+  InputIterator first, InputIterator last)
+{
+  core_type core(first, last);
+
+  // A stable sort keeps the first of the pairs with the same key in front.
+  std::stable_sort(core.begin(), core.end(),
+    [](const value_type& lhs, const value_type& rhs) {
+      return key_compare()(lhs.first, rhs.first);
+    });
+
+  core.erase(
+    std::unique(core.begin(), core.end(),
+      [](const value_type& lhs, const value_type& rhs) {
+        return !key_compare()(lhs.first, rhs.first);
+      }),
+    core.end());
+
+  m_core.swap(core);
+
+  build_layout();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+bool
+flat_assorted_value_map<K, ValueTypes...>::empty() const
+{
+  return m_core.empty();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::size_type
+flat_assorted_value_map<K, ValueTypes...>::size() const
+{
+  return m_core.size();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::size_type
+flat_assorted_value_map<K, ValueTypes...>::max_size() const
+{
+  return m_core.max_size();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+void
+flat_assorted_value_map<K, ValueTypes...>::reserve(size_type count)
+{
+  m_core.reserve(count);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+void
+flat_assorted_value_map<K, ValueTypes...>::insert(K key, ValueTypes... values)
+{
+  const size_type rank = search(key, false);
+
+  if (rank != m_core.size() && !key_compare()(key, m_core[rank].first))
+  {
+    return;
+  }
+
+  m_core.insert(m_core.begin() + static_cast<difference_type>(rank),
+    value_type(key, mapped_type(values...)));
+
+  m_layout.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class KeyArg, class... Args>
+std::pair<typename flat_assorted_value_map<K, ValueTypes...>::iterator, bool>
+flat_assorted_value_map<K, ValueTypes...>::emplace(
+  KeyArg&& key, Args&&... values)
+{
+  // The position of the pair depends on the key, which is thus constructed
+  // first.
+  return try_emplace(K(std::forward<KeyArg>(key)),
+    std::forward<Args>(values)...);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class... Args>
+std::pair<typename flat_assorted_value_map<K, ValueTypes...>::iterator, bool>
+flat_assorted_value_map<K, ValueTypes...>::try_emplace(
+  const K& key, Args&&... values)
+{
+  const size_type rank = search(key, false);
+  const iterator itr = begin() + static_cast<difference_type>(rank);
+
+  if (rank != m_core.size() && !key_compare()(key, itr->first))
+  {
+    return std::make_pair(itr, false);
+  }
+
+  m_core.emplace(itr, std::piecewise_construct,
+    std::forward_as_tuple(key),
+    std::forward_as_tuple(std::forward<Args>(values)...));
+
+  m_layout.clear();
+
+  return std::make_pair(begin() + static_cast<difference_type>(rank), true);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class... Args>
+std::pair<typename flat_assorted_value_map<K, ValueTypes...>::iterator, bool>
+flat_assorted_value_map<K, ValueTypes...>::try_emplace(
+  K&& key, Args&&... values)
+{
+  const size_type rank = search(key, false);
+  const iterator itr = begin() + static_cast<difference_type>(rank);
+
+  if (rank != m_core.size() && !key_compare()(key, itr->first))
+  {
+    return std::make_pair(itr, false);
+  }
+
+  m_core.emplace(itr, std::piecewise_construct,
+    std::forward_as_tuple(std::move(key)),
+    std::forward_as_tuple(std::forward<Args>(values)...));
+
+  m_layout.clear();
+
+  return std::make_pair(begin() + static_cast<difference_type>(rank), true);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+void
+flat_assorted_value_map<K, ValueTypes...>::erase(iterator itr)
+{
+  m_core.erase(itr);
+  m_layout.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::size_type
+flat_assorted_value_map<K, ValueTypes...>::erase(const K& key)
+{
+  const iterator itr = find(key);
+
+  if (itr == end())
+  {
+    return 0;
+  }
+
+  erase(itr);
+
+  return 1;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+void
+flat_assorted_value_map<K, ValueTypes...>::erase(
+  iterator first, iterator last)
+{
+  m_core.erase(first, last);
+  m_layout.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+void
+flat_assorted_value_map<K, ValueTypes...>::swap(
+  flat_assorted_value_map<K, ValueTypes...>& other)
+{
+  m_core.swap(other.m_core);
+  m_layout.swap(other.m_layout);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+void
+flat_assorted_value_map<K, ValueTypes...>::clear() noexcept
+{
+  m_core.clear();
+  m_layout.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::mapped_type&
+flat_assorted_value_map<K, ValueTypes...>::at(const K& key)
+{
+  const iterator itr = find(key);
+
+  if (itr == end())
+  {
+    throw std::out_of_range("flat_assorted_value_map::at");
+  }
+
+  return itr->second;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+const typename flat_assorted_value_map<K, ValueTypes...>::mapped_type&
+flat_assorted_value_map<K, ValueTypes...>::at(const K& key) const
+{
+  const const_iterator itr = find(key);
+
+  if (itr == end())
+  {
+    throw std::out_of_range("flat_assorted_value_map::at");
+  }
+
+  return itr->second;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class A, size_t Index>
+A&
+flat_assorted_value_map<K, ValueTypes...>::get(const K& key)
+{
+  return boost::get<Index>(at(key));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class A, size_t Index>
+const A&
+flat_assorted_value_map<K, ValueTypes...>::get(const K& key) const
+{
+  return boost::get<Index>(at(key));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::mapped_type&
+flat_assorted_value_map<K, ValueTypes...>::operator[](const K& key)
+{
+  const size_type rank = search(key, false);
+
+  if (rank == m_core.size() || key_compare()(key, m_core[rank].first))
+  {
+    m_core.insert(m_core.begin() + static_cast<difference_type>(rank),
+      value_type(key, mapped_type()));
+
+    m_layout.clear();
+  }
+
+  return m_core[rank].second;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::iterator
+flat_assorted_value_map<K, ValueTypes...>::begin()
+{
+  return m_core.begin();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::const_iterator
+flat_assorted_value_map<K, ValueTypes...>::begin() const
+{
+  return m_core.begin();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::iterator
+flat_assorted_value_map<K, ValueTypes...>::end()
+{
+  return m_core.end();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::const_iterator
+flat_assorted_value_map<K, ValueTypes...>::end() const
+{
+  return m_core.end();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::reverse_iterator
+flat_assorted_value_map<K, ValueTypes...>::rbegin()
+{
+  return m_core.rbegin();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::const_reverse_iterator
+flat_assorted_value_map<K, ValueTypes...>::rbegin() const
+{
+  return m_core.rbegin();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::reverse_iterator
+flat_assorted_value_map<K, ValueTypes...>::rend()
+{
+  return m_core.rend();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::const_reverse_iterator
+flat_assorted_value_map<K, ValueTypes...>::rend() const
+{
+  return m_core.rend();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::const_iterator
+flat_assorted_value_map<K, ValueTypes...>::cbegin() const noexcept
+{
+  return m_core.cbegin();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::const_iterator
+flat_assorted_value_map<K, ValueTypes...>::cend() const noexcept
+{
+  return m_core.cend();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::const_reverse_iterator
+flat_assorted_value_map<K, ValueTypes...>::crbegin() const noexcept
+{
+  return m_core.crbegin();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::const_reverse_iterator
+flat_assorted_value_map<K, ValueTypes...>::crend() const noexcept
+{
+  return m_core.crend();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::iterator
+flat_assorted_value_map<K, ValueTypes...>::find(const K& key)
+{
+  const iterator itr = lower_bound(key);
+
+  if (itr != end() && !key_compare()(key, itr->first))
+  {
+    return itr;
+  }
+
+  return end();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::const_iterator
+flat_assorted_value_map<K, ValueTypes...>::find(const K& key) const
+{
+  const const_iterator itr = lower_bound(key);
+
+  if (itr != end() && !key_compare()(key, itr->first))
+  {
+    return itr;
+  }
+
+  return end();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::iterator
+flat_assorted_value_map<K, ValueTypes...>::lower_bound(const K& key)
+{
+  return begin() + static_cast<difference_type>(search(key, false));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::const_iterator
+flat_assorted_value_map<K, ValueTypes...>::lower_bound(const K& key) const
+{
+  return begin() + static_cast<difference_type>(search(key, false));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::iterator
+flat_assorted_value_map<K, ValueTypes...>::upper_bound(const K& key)
+{
+  return begin() + static_cast<difference_type>(search(key, true));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+typename flat_assorted_value_map<K, ValueTypes...>::const_iterator
+flat_assorted_value_map<K, ValueTypes...>::upper_bound(const K& key) const
+{
+  return begin() + static_cast<difference_type>(search(key, true));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class KeyLike, class>
+typename flat_assorted_value_map<K, ValueTypes...>::mapped_type&
+flat_assorted_value_map<K, ValueTypes...>::at(const KeyLike& key)
+{
+  const iterator itr = find(key);
+
+  if (itr == end())
+  {
+    throw std::out_of_range("flat_assorted_value_map::at");
+  }
+
+  return itr->second;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class KeyLike, class>
+const typename flat_assorted_value_map<K, ValueTypes...>::mapped_type&
+flat_assorted_value_map<K, ValueTypes...>::at(const KeyLike& key) const
+{
+  const const_iterator itr = find(key);
+
+  if (itr == end())
+  {
+    throw std::out_of_range("flat_assorted_value_map::at");
+  }
+
+  return itr->second;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class A, size_t Index, class KeyLike, class>
+A&
+flat_assorted_value_map<K, ValueTypes...>::get(const KeyLike& key)
+{
+  return boost::get<Index>(at(key));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class A, size_t Index, class KeyLike, class>
+const A&
+flat_assorted_value_map<K, ValueTypes...>::get(const KeyLike& key) const
+{
+  return boost::get<Index>(at(key));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class KeyLike, class>
+typename flat_assorted_value_map<K, ValueTypes...>::iterator
+flat_assorted_value_map<K, ValueTypes...>::find(const KeyLike& key)
+{
+  const iterator itr = lower_bound(key);
+
+  if (itr != end() && !less(key, itr->first))
+  {
+    return itr;
+  }
+
+  return end();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class KeyLike, class>
+typename flat_assorted_value_map<K, ValueTypes...>::const_iterator
+flat_assorted_value_map<K, ValueTypes...>::find(const KeyLike& key) const
+{
+  const const_iterator itr = lower_bound(key);
+
+  if (itr != end() && !less(key, itr->first))
+  {
+    return itr;
+  }
+
+  return end();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class KeyLike, class>
+typename flat_assorted_value_map<K, ValueTypes...>::iterator
+flat_assorted_value_map<K, ValueTypes...>::lower_bound(const KeyLike& key)
+{
+  return begin() + static_cast<difference_type>(search(key, false));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class KeyLike, class>
+typename flat_assorted_value_map<K, ValueTypes...>::const_iterator
+flat_assorted_value_map<K, ValueTypes...>::lower_bound(const KeyLike& key) const
+{
+  return begin() + static_cast<difference_type>(search(key, false));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class KeyLike, class>
+typename flat_assorted_value_map<K, ValueTypes...>::iterator
+flat_assorted_value_map<K, ValueTypes...>::upper_bound(const KeyLike& key)
+{
+  return begin() + static_cast<difference_type>(search(key, true));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class KeyLike, class>
+typename flat_assorted_value_map<K, ValueTypes...>::const_iterator
+flat_assorted_value_map<K, ValueTypes...>::upper_bound(const KeyLike& key) const
+{
+  return begin() + static_cast<difference_type>(search(key, true));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+bool
+flat_assorted_value_map<K, ValueTypes...>::less(const K& lhs, const K& rhs)
+{
+  return key_compare()(lhs, rhs);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class Lhs, class Rhs>
+bool
+flat_assorted_value_map<K, ValueTypes...>::less(const Lhs& lhs, const Rhs& rhs)
+{
+  return lhs < rhs;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+void
+flat_assorted_value_map<K, ValueTypes...>::build_layout()
+{
+  m_layout.assign(m_core.size() + 1, 0);
+
+  size_type rank = 0;
+  build_layout(1, rank);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+void
+flat_assorted_value_map<K, ValueTypes...>::build_layout(
+  size_type node, size_type& rank)
+{
+  // An in-order traversal of the implicit tree visits the nodes in the order
+  // of the sorted pairs.
+  if (node < m_layout.size())
+  {
+    build_layout(2 * node, rank);
+
+    m_layout[node] = rank;
+    ++rank;
+
+    build_layout(2 * node + 1, rank);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+template<class KeyLike>
+typename flat_assorted_value_map<K, ValueTypes...>::size_type
+flat_assorted_value_map<K, ValueTypes...>::search(
+  const KeyLike& key, bool upper) const
+{
+  const size_type n = m_core.size();
+
+  if (m_layout.empty())
+  {
+    const const_iterator itr = upper ?
+      std::upper_bound(m_core.begin(), m_core.end(), key,
+        [](const KeyLike& lhs, const value_type& rhs) {
+          return less(lhs, rhs.first);
+        }) :
+      std::lower_bound(m_core.begin(), m_core.end(), key,
+        [](const value_type& lhs, const KeyLike& rhs) {
+          return less(lhs.first, rhs);
+        });
+
+    return static_cast<size_type>(itr - m_core.begin());
+  }
+
+  // Descends to the left child when the node is a candidate for the bound,
+  // and to the right child otherwise.
+  size_type node = 1;
+
+  if (upper)
+  {
+    while (node <= n)
+    {
+      node = 2 * node + !less(key, m_core[m_layout[node]].first);
+    }
+  }
+  else
+  {
+    while (node <= n)
+    {
+      node = 2 * node + less(m_core[m_layout[node]].first, key);
+    }
+  }
+
+  // The bound is the last node at which the search descended to the left,
+  // found by stripping the trailing right turns and the final left turn.
+  node >>= __builtin_ffsll(static_cast<long long>(~node));
+
+  return node ? m_layout[node] : n;
+}
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace container */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_FLAT_ASSORTED_VALUE_MAP_H_ */
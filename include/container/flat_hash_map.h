@@ -0,0 +1,1441 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::container::flat_hash_map<K, V, Hash, Pred, Alloc>` is an
+ * open-addressing hash table with the interface of `std::unordered_map` that
+ * matters to `sneaker::container::basic_unordered_assorted_value_map`, in the
+ * style of Swiss tables.
+ *
+ * The key-value pairs are stored inline in a single array of slots, next to
+ * an array of one-byte control words. The control word of a slot tells whether
+ * the slot is empty, deleted or full, and for a full slot holds 7 bits of the
+ * hash of its key. Lookups probe groups of 16 consecutive control words at a
+ * time, with SSE2 instructions when they are available, and only compare the
+ * keys of the slots whose control words match the hash. Probing stops at the
+ * first group that has an empty slot.
+ *
+ * Erased slots are marked as deleted, unless no probe sequence can go past
+ * them, and are reused by subsequent insertions. The table grows to keep at
+ * least one eighth of its slots free; its maximum load factor is thus fixed.
+ *
+ * Unlike `std::unordered_map`, insertions that grow the table invalidate all
+ * iterators, references and pointers to the elements, and the table has no
+ * bucket interface.
+ *
+ * Example:
+ *
+ *  sneaker::container::flat_hash_map<int, std::string> map;
+ *
+ *  map.insert(std::make_pair(1, "one"));
+ *  map[2] = "two";
+ *
+ *  auto itr = map.find(1);
+ */
+
+#ifndef SNEAKER_FLAT_HASH_MAP_H_
+#define SNEAKER_FLAT_HASH_MAP_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace sneaker {
+namespace container {
+
+template<class K, class V, class Hash = std::hash<K>,
+  class Pred = std::equal_to<K>,
+  class Alloc = std::allocator<std::pair<const K, V>>>
+class flat_hash_map {
+public:
+  typedef K                                       key_type;
+  typedef V                                       mapped_type;
+  typedef std::pair<const K, V>                   value_type;
+  typedef Hash                                    hasher;
+  typedef Pred                                    key_equal;
+  typedef Alloc                                   allocator_type;
+  typedef value_type&                             reference;
+  typedef const value_type&                       const_reference;
+  typedef value_type*                             pointer;
+  typedef const value_type*                       const_pointer;
+  typedef size_t                                  size_type;
+  typedef ptrdiff_t                               difference_type;
+
+  /**
+   * Forward iterator over the full slots, in the order of the slots.
+   */
+  template<class Value>
+  class basic_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::remove_const<Value>::type value_type;
+    typedef ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    basic_iterator()
+      :
+      m_ctrl(NULL),
+      m_slot(NULL)
+    {
+    }
+
+    /**
+     * Converts an iterator into a constant iterator.
+     */
+    template<class Other,
+      class = typename std::enable_if<
+        std::is_convertible<Other*, Value*>::value>::type>
+    basic_iterator(const basic_iterator<Other>& other)
+      :
+      m_ctrl(other.m_ctrl),
+      m_slot(other.m_slot)
+    {
+    }
+
+    reference operator*() const
+    {
+      return *m_slot;
+    }
+
+    pointer operator->() const
+    {
+      return m_slot;
+    }
+
+    basic_iterator& operator++()
+    {
+      ++m_ctrl;
+      ++m_slot;
+      skip_free_slots();
+      return *this;
+    }
+
+    basic_iterator operator++(int)
+    {
+      basic_iterator itr = *this;
+      ++(*this);
+      return itr;
+    }
+
+    template<class Other>
+    bool operator==(const basic_iterator<Other>& other) const
+    {
+      return m_ctrl == other.m_ctrl;
+    }
+
+    template<class Other>
+    bool operator!=(const basic_iterator<Other>& other) const
+    {
+      return m_ctrl != other.m_ctrl;
+    }
+
+  private:
+    friend class flat_hash_map;
+
+    template<class Other>
+    friend class basic_iterator;
+
+    basic_iterator(const int8_t* ctrl, Value* slot)
+      :
+      m_ctrl(ctrl),
+      m_slot(slot)
+    {
+    }
+
+    /**
+     * Moves forward to the next full slot, or to the sentinel control word
+     * that follows the last slot.
+     */
+    void skip_free_slots()
+    {
+      while (*m_ctrl < SENTINEL)
+      {
+        ++m_ctrl;
+        ++m_slot;
+      }
+    }
+
+    const int8_t* m_ctrl;
+    Value* m_slot;
+  };
+
+  typedef basic_iterator<value_type>              iterator;
+  typedef basic_iterator<const value_type>        const_iterator;
+
+  /**
+   * Constructs an empty table with room for at least the specified number of
+   * elements.
+   */
+  explicit flat_hash_map(size_type bucket_count=0,
+    const hasher& hash=hasher(), const key_equal& key_eq=key_equal(),
+    const allocator_type& allocator=allocator_type());
+
+  flat_hash_map(const flat_hash_map&);
+  flat_hash_map(flat_hash_map&&) noexcept;
+
+  flat_hash_map& operator=(flat_hash_map);
+
+  ~flat_hash_map();
+
+  bool empty() const noexcept;
+
+  size_type size() const noexcept;
+
+  size_type max_size() const noexcept;
+
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+
+  /**
+   * Constructs an element from the arguments, and inserts it unless its key
+   * already exists in the table.
+   */
+  template<class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+
+  iterator erase(const_iterator pos);
+  size_type erase(const K& key);
+  iterator erase(const_iterator first, const_iterator last);
+
+  void swap(flat_hash_map&) noexcept;
+
+  void clear() noexcept;
+
+  V& at(const K& key);
+  const V& at(const K& key) const;
+
+  V& operator[](const K& key);
+
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+
+  const_iterator cbegin() const noexcept;
+  const_iterator cend() const noexcept;
+
+  iterator find(const K& key);
+  const_iterator find(const K& key) const;
+
+  /**
+   * Heterogeneous lookups, for keys comparable with the keys of the table
+   * through `operator==`, consistently with `key_equal`, such as `const char*`
+   * for `std::string` keys, without constructing a temporary key. The hash
+   * is the one of the equal key through `hasher`, which may be computed once
+   * for repeated lookups.
+   */
+  template<class KeyLike>
+  iterator find(const KeyLike& key, size_type hash);
+
+  template<class KeyLike>
+  const_iterator find(const KeyLike& key, size_type hash) const;
+
+  size_type count(const K& key) const;
+
+  /**
+   * The number of slots in the table, which is either zero or one less than a
+   * power of two.
+   */
+  size_type capacity() const noexcept;
+
+  float load_factor() const noexcept;
+
+  /**
+   * The maximum load factor is fixed at 7/8; setting it has no effect.
+   */
+  float max_load_factor() const noexcept;
+  void max_load_factor(float);
+
+  /**
+   * Resizes the table to have room for at least the specified number of
+   * elements, and at least the current elements, which drops the deleted
+   * slots.
+   */
+  void rehash(size_type);
+
+  /**
+   * Grows the table, if needed, so that the specified number of elements can
+   * be held without further growth.
+   */
+  void reserve(size_type);
+
+  hasher hash_function() const;
+  key_equal key_eq() const;
+  allocator_type get_allocator() const noexcept;
+
+  /**
+   * The number of control words in a group probed at once.
+   */
+  static constexpr size_type GROUP_WIDTH = 16;
+
+private:
+  typedef int8_t ctrl_t;
+
+  typedef typename std::allocator_traits<Alloc>::template
+    rebind_alloc<ctrl_t> ctrl_allocator_type;
+
+  typedef std::allocator_traits<Alloc> slot_traits;
+  typedef std::allocator_traits<ctrl_allocator_type> ctrl_traits;
+
+  static constexpr ctrl_t EMPTY = -128;
+  static constexpr ctrl_t DELETED = -2;
+  static constexpr ctrl_t SENTINEL = -1;
+
+  static constexpr size_type MIN_CAPACITY = GROUP_WIDTH - 1;
+
+  /**
+   * The control words of a group, matched against a value at once.
+   */
+  class probe_group
+  {
+  public:
+    explicit probe_group(const ctrl_t* pos);
+
+    /**
+     * Each of the matching functions returns a bit mask, where the bit `i` is
+     * set if the `i`th control word of the group matches.
+     */
+    uint32_t match(ctrl_t h2) const;
+    uint32_t match_empty() const;
+    uint32_t match_empty_or_deleted() const;
+
+  private:
+#if defined(__SSE2__)
+    __m128i m_ctrl;
+#else
+    ctrl_t m_ctrl[GROUP_WIDTH];
+#endif
+  };
+
+  size_type hash_of(const K& key) const;
+
+  static size_type mix(size_type hash);
+
+  bool keys_equal(const K& lhs, const K& rhs) const;
+
+  template<class KeyLike>
+  static bool keys_equal(const K& lhs, const KeyLike& rhs);
+
+  static size_type h1(size_type hash);
+  static ctrl_t h2(size_type hash);
+
+  static size_type max_growth(size_type capacity);
+  static size_type normalize_capacity(size_type count);
+
+  template<class KeyLike>
+  size_type find_index(const KeyLike& key, size_type hash) const;
+
+  size_type find_first_non_full(size_type hash) const;
+
+  /**
+   * Claims a slot for a new element with the specified hash, growing the
+   * table if needed, and returns the index of the slot.
+   */
+  size_type prepare_insert(size_type hash);
+
+  template<class... Args>
+  std::pair<iterator, bool> insert_unique(const K& key, Args&&... args);
+
+  void set_ctrl(size_type index, ctrl_t h);
+
+  void erase_at(size_type index);
+
+  void grow();
+
+  void resize(size_type capacity);
+
+  void allocate(size_type capacity);
+  void destroy_slots() noexcept;
+  void deallocate() noexcept;
+
+  iterator iterator_at(size_type index);
+  const_iterator iterator_at(size_type index) const;
+
+  ctrl_t* m_ctrl;
+  value_type* m_slots;
+  size_type m_capacity;
+  size_type m_size;
+  size_type m_growth_left;
+  hasher m_hash;
+  key_equal m_key_eq;
+  allocator_type m_allocator;
+};
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+constexpr typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::GROUP_WIDTH;
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+constexpr typename flat_hash_map<K, V, Hash, Pred, Alloc>::ctrl_t
+flat_hash_map<K, V, Hash, Pred, Alloc>::EMPTY;
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+constexpr typename flat_hash_map<K, V, Hash, Pred, Alloc>::ctrl_t
+flat_hash_map<K, V, Hash, Pred, Alloc>::DELETED;
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+constexpr typename flat_hash_map<K, V, Hash, Pred, Alloc>::ctrl_t
+flat_hash_map<K, V, Hash, Pred, Alloc>::SENTINEL;
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+constexpr typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::MIN_CAPACITY;
+
+// -----------------------------------------------------------------------------
+
+#if defined(__SSE2__)
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+flat_hash_map<K, V, Hash, Pred, Alloc>::probe_group::probe_group(
+  const ctrl_t* pos)
+  :
+  m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos)))
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+uint32_t
+flat_hash_map<K, V, Hash, Pred, Alloc>::probe_group::match(ctrl_t h2) const
+{
+  return static_cast<uint32_t>(
+    _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+uint32_t
+flat_hash_map<K, V, Hash, Pred, Alloc>::probe_group::match_empty() const
+{
+  return static_cast<uint32_t>(
+    _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(EMPTY), m_ctrl)));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+uint32_t
+flat_hash_map<K, V, Hash, Pred, Alloc>::probe_group::match_empty_or_deleted()
+  const
+{
+  // Empty and deleted slots are the only ones whose control words are less
+  // than the sentinel.
+  return static_cast<uint32_t>(
+    _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(SENTINEL), m_ctrl)));
+}
+
+#else
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+flat_hash_map<K, V, Hash, Pred, Alloc>::probe_group::probe_group(
+  const ctrl_t* pos)
+{
+  memcpy(m_ctrl, pos, sizeof(m_ctrl));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+uint32_t
+flat_hash_map<K, V, Hash, Pred, Alloc>::probe_group::match(ctrl_t h2) const
+{
+  uint32_t mask = 0;
+  for (size_type i = 0; i < GROUP_WIDTH; ++i)
+  {
+    mask |= static_cast<uint32_t>(m_ctrl[i] == h2) << i;
+  }
+
+  return mask;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+uint32_t
+flat_hash_map<K, V, Hash, Pred, Alloc>::probe_group::match_empty() const
+{
+  return match(EMPTY);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+uint32_t
+flat_hash_map<K, V, Hash, Pred, Alloc>::probe_group::match_empty_or_deleted()
+  const
+{
+  uint32_t mask = 0;
+  for (size_type i = 0; i < GROUP_WIDTH; ++i)
+  {
+    mask |= static_cast<uint32_t>(m_ctrl[i] < SENTINEL) << i;
+  }
+
+  return mask;
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+flat_hash_map<K, V, Hash, Pred, Alloc>::flat_hash_map(size_type bucket_count,
+  const hasher& hash, const key_equal& key_eq,
+  const allocator_type& allocator)
+  :
+  m_ctrl(NULL),
+  m_slots(NULL),
+  m_capacity(0),
+  m_size(0),
+  m_growth_left(0),
+  m_hash(hash),
+  m_key_eq(key_eq),
+  m_allocator(allocator)
+{
+  reserve(bucket_count);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+flat_hash_map<K, V, Hash, Pred, Alloc>::flat_hash_map(
+  const flat_hash_map& other)
+  :
+  m_ctrl(NULL),
+  m_slots(NULL),
+  m_capacity(0),
+  m_size(0),
+  m_growth_left(0),
+  m_hash(other.m_hash),
+  m_key_eq(other.m_key_eq),
+  m_allocator(slot_traits::select_on_container_copy_construction(
+    other.m_allocator))
+{
+  if (!other.m_capacity)
+  {
+    return;
+  }
+
+  // The copy keeps the layout of the original, deleted slots included, which
+  // saves rehashing the keys.
+  allocate(other.m_capacity);
+  memcpy(m_ctrl, other.m_ctrl, m_capacity + GROUP_WIDTH);
+
+  for (size_type i = 0; i < m_capacity; ++i)
+  {
+    if (m_ctrl[i] >= 0)
+    {
+      slot_traits::construct(m_allocator, m_slots + i, other.m_slots[i]);
+    }
+  }
+
+  m_size = other.m_size;
+  m_growth_left = other.m_growth_left;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+flat_hash_map<K, V, Hash, Pred, Alloc>::flat_hash_map(
+  flat_hash_map&& other) noexcept
+  :
+  m_ctrl(other.m_ctrl),
+  m_slots(other.m_slots),
+  m_capacity(other.m_capacity),
+  m_size(other.m_size),
+  m_growth_left(other.m_growth_left),
+  m_hash(std::move(other.m_hash)),
+  m_key_eq(std::move(other.m_key_eq)),
+  m_allocator(std::move(other.m_allocator))
+{
+  other.m_ctrl = NULL;
+  other.m_slots = NULL;
+  other.m_capacity = 0;
+  other.m_size = 0;
+  other.m_growth_left = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+flat_hash_map<K, V, Hash, Pred, Alloc>&
+flat_hash_map<K, V, Hash, Pred, Alloc>::operator=(flat_hash_map other)
+{
+  swap(other);
+  return *this;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+flat_hash_map<K, V, Hash, Pred, Alloc>::~flat_hash_map()
+{
+  destroy_slots();
+  deallocate();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+bool
+flat_hash_map<K, V, Hash, Pred, Alloc>::empty() const noexcept
+{
+  return m_size == 0;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::size() const noexcept
+{
+  return m_size;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::max_size() const noexcept
+{
+  return max_growth(slot_traits::max_size(m_allocator));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+std::pair<typename flat_hash_map<K, V, Hash, Pred, Alloc>::iterator, bool>
+flat_hash_map<K, V, Hash, Pred, Alloc>::insert(const value_type& value)
+{
+  return insert_unique(value.first, value);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+std::pair<typename flat_hash_map<K, V, Hash, Pred, Alloc>::iterator, bool>
+flat_hash_map<K, V, Hash, Pred, Alloc>::insert(value_type&& value)
+{
+  return insert_unique(value.first, std::move(value));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+template<class... Args>
+std::pair<typename flat_hash_map<K, V, Hash, Pred, Alloc>::iterator, bool>
+flat_hash_map<K, V, Hash, Pred, Alloc>::emplace(Args&&... args)
+{
+  // The key is only known once the element is constructed, which happens
+  // outside of the table so that nothing is left to undo for a duplicate.
+  value_type value(std::forward<Args>(args)...);
+  return insert_unique(value.first, std::move(value));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::erase(const_iterator pos)
+{
+  const size_type index = static_cast<size_type>(pos.m_ctrl - m_ctrl);
+
+  erase_at(index);
+
+  iterator itr = iterator_at(index);
+  itr.skip_free_slots();
+
+  return itr;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::erase(const K& key)
+{
+  if (!m_capacity)
+  {
+    return 0;
+  }
+
+  const size_type index = find_index(key, hash_of(key));
+  if (index == m_capacity)
+  {
+    return 0;
+  }
+
+  erase_at(index);
+
+  return 1;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::erase(
+  const_iterator first, const_iterator last)
+{
+  while (first != last)
+  {
+    first = erase(first);
+  }
+
+  return iterator(last.m_ctrl, const_cast<value_type*>(last.m_slot));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+void
+flat_hash_map<K, V, Hash, Pred, Alloc>::swap(flat_hash_map& other) noexcept
+{
+  using std::swap;
+
+  swap(m_ctrl, other.m_ctrl);
+  swap(m_slots, other.m_slots);
+  swap(m_capacity, other.m_capacity);
+  swap(m_size, other.m_size);
+  swap(m_growth_left, other.m_growth_left);
+  swap(m_hash, other.m_hash);
+  swap(m_key_eq, other.m_key_eq);
+  swap(m_allocator, other.m_allocator);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+void
+flat_hash_map<K, V, Hash, Pred, Alloc>::clear() noexcept
+{
+  if (!m_capacity)
+  {
+    return;
+  }
+
+  destroy_slots();
+
+  memset(m_ctrl, EMPTY, m_capacity + GROUP_WIDTH);
+  m_ctrl[m_capacity] = SENTINEL;
+
+  m_size = 0;
+  m_growth_left = max_growth(m_capacity);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+V&
+flat_hash_map<K, V, Hash, Pred, Alloc>::at(const K& key)
+{
+  const iterator itr = find(key);
+
+  if (itr == end())
+  {
+    throw std::out_of_range("flat_hash_map::at");
+  }
+
+  return itr->second;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+const V&
+flat_hash_map<K, V, Hash, Pred, Alloc>::at(const K& key) const
+{
+  const const_iterator itr = find(key);
+
+  if (itr == end())
+  {
+    throw std::out_of_range("flat_hash_map::at");
+  }
+
+  return itr->second;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+V&
+flat_hash_map<K, V, Hash, Pred, Alloc>::operator[](const K& key)
+{
+  return insert_unique(key, std::piecewise_construct,
+    std::forward_as_tuple(key), std::forward_as_tuple()).first->second;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::begin() noexcept
+{
+  if (!m_capacity)
+  {
+    return end();
+  }
+
+  iterator itr = iterator_at(0);
+  itr.skip_free_slots();
+
+  return itr;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::const_iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::begin() const noexcept
+{
+  if (!m_capacity)
+  {
+    return end();
+  }
+
+  const_iterator itr = iterator_at(0);
+  itr.skip_free_slots();
+
+  return itr;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::end() noexcept
+{
+  return iterator_at(m_capacity);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::const_iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::end() const noexcept
+{
+  return iterator_at(m_capacity);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::const_iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::cbegin() const noexcept
+{
+  return begin();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::const_iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::cend() const noexcept
+{
+  return end();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::find(const K& key)
+{
+  if (!m_capacity)
+  {
+    return end();
+  }
+
+  return iterator_at(find_index(key, hash_of(key)));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::const_iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::find(const K& key) const
+{
+  if (!m_capacity)
+  {
+    return end();
+  }
+
+  return iterator_at(find_index(key, hash_of(key)));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+template<class KeyLike>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::find(const KeyLike& key,
+  size_type hash)
+{
+  if (!m_capacity)
+  {
+    return end();
+  }
+
+  return iterator_at(find_index(key, mix(hash)));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+template<class KeyLike>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::const_iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::find(const KeyLike& key,
+  size_type hash) const
+{
+  if (!m_capacity)
+  {
+    return end();
+  }
+
+  return iterator_at(find_index(key, mix(hash)));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::count(const K& key) const
+{
+  return find(key) != end() ? 1 : 0;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::capacity() const noexcept
+{
+  return m_capacity;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+float
+flat_hash_map<K, V, Hash, Pred, Alloc>::load_factor() const noexcept
+{
+  return m_capacity ?
+    static_cast<float>(m_size) / static_cast<float>(m_capacity) : 0.0f;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+float
+flat_hash_map<K, V, Hash, Pred, Alloc>::max_load_factor() const noexcept
+{
+  return 0.875f;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+void
+flat_hash_map<K, V, Hash, Pred, Alloc>::max_load_factor(float)
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+void
+flat_hash_map<K, V, Hash, Pred, Alloc>::rehash(size_type n)
+{
+  const size_type count = std::max(n, m_size);
+
+  if (!count)
+  {
+    destroy_slots();
+    deallocate();
+    m_size = 0;
+    m_growth_left = 0;
+    return;
+  }
+
+  resize(normalize_capacity(count));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+void
+flat_hash_map<K, V, Hash, Pred, Alloc>::reserve(size_type n)
+{
+  if (n > m_size + m_growth_left)
+  {
+    resize(normalize_capacity(n));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::hasher
+flat_hash_map<K, V, Hash, Pred, Alloc>::hash_function() const
+{
+  return m_hash;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::key_equal
+flat_hash_map<K, V, Hash, Pred, Alloc>::key_eq() const
+{
+  return m_key_eq;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::allocator_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::get_allocator() const noexcept
+{
+  return m_allocator;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::hash_of(const K& key) const
+{
+  return mix(m_hash(key));
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::mix(size_type value)
+{
+  // Hashers such as `std::hash` of integers are the identity, so the hash is
+  // mixed to spread the bits of the key over both halves of it.
+  uint64_t hash = static_cast<uint64_t>(value);
+
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+
+  return static_cast<size_type>(hash);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+bool
+flat_hash_map<K, V, Hash, Pred, Alloc>::keys_equal(
+  const K& lhs, const K& rhs) const
+{
+  return m_key_eq(lhs, rhs);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+template<class KeyLike>
+bool
+flat_hash_map<K, V, Hash, Pred, Alloc>::keys_equal(
+  const K& lhs, const KeyLike& rhs)
+{
+  return lhs == rhs;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::h1(size_type hash)
+{
+  return hash >> 7;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::ctrl_t
+flat_hash_map<K, V, Hash, Pred, Alloc>::h2(size_type hash)
+{
+  return static_cast<ctrl_t>(hash & 0x7f);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::max_growth(size_type capacity)
+{
+  return capacity - capacity / 8;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::normalize_capacity(size_type count)
+{
+  // The smallest capacity of the form `2^n - 1` whose maximum growth covers
+  // the specified number of elements.
+  size_type capacity = MIN_CAPACITY;
+  while (max_growth(capacity) < count)
+  {
+    capacity = capacity * 2 + 1;
+  }
+
+  return capacity;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+template<class KeyLike>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::find_index(
+  const KeyLike& key, size_type hash) const
+{
+  const ctrl_t tag = h2(hash);
+
+  // Groups are probed along a triangular sequence, which visits every group
+  // of a table whose capacity is one less than a power of two.
+  size_type pos = h1(hash) & m_capacity;
+  size_type step = 0;
+
+  while (true)
+  {
+    const probe_group group(m_ctrl + pos);
+
+    for (uint32_t mask = group.match(tag); mask; mask &= mask - 1)
+    {
+      const size_type index =
+        (pos + static_cast<size_type>(__builtin_ctz(mask))) & m_capacity;
+
+      if (keys_equal(m_slots[index].first, key))
+      {
+        return index;
+      }
+    }
+
+    if (group.match_empty())
+    {
+      return m_capacity;
+    }
+
+    step += GROUP_WIDTH;
+    pos = (pos + step) & m_capacity;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::find_first_non_full(
+  size_type hash) const
+{
+  size_type pos = h1(hash) & m_capacity;
+  size_type step = 0;
+
+  while (true)
+  {
+    const uint32_t mask = probe_group(m_ctrl + pos).match_empty_or_deleted();
+
+    if (mask)
+    {
+      return (pos + static_cast<size_type>(__builtin_ctz(mask))) & m_capacity;
+    }
+
+    step += GROUP_WIDTH;
+    pos = (pos + step) & m_capacity;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::size_type
+flat_hash_map<K, V, Hash, Pred, Alloc>::prepare_insert(size_type hash)
+{
+  if (!m_capacity)
+  {
+    grow();
+  }
+
+  size_type index = find_first_non_full(hash);
+
+  // Reusing a deleted slot does not take any room from the empty slots that
+  // terminate the probe sequences.
+  if (!m_growth_left && m_ctrl[index] == EMPTY)
+  {
+    grow();
+    index = find_first_non_full(hash);
+  }
+
+  if (m_ctrl[index] == EMPTY)
+  {
+    --m_growth_left;
+  }
+
+  set_ctrl(index, h2(hash));
+  ++m_size;
+
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+template<class... Args>
+std::pair<typename flat_hash_map<K, V, Hash, Pred, Alloc>::iterator, bool>
+flat_hash_map<K, V, Hash, Pred, Alloc>::insert_unique(
+  const K& key, Args&&... args)
+{
+  const size_type hash = hash_of(key);
+
+  if (m_capacity)
+  {
+    const size_type index = find_index(key, hash);
+    if (index != m_capacity)
+    {
+      return std::make_pair(iterator_at(index), false);
+    }
+  }
+
+  // The element is constructed before the slot is claimed, as growing the
+  // table may move the element that `key` refers to.
+  value_type value(std::forward<Args>(args)...);
+
+  const size_type index = prepare_insert(hash);
+  slot_traits::construct(m_allocator, m_slots + index, std::move(value));
+
+  return std::make_pair(iterator_at(index), true);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+void
+flat_hash_map<K, V, Hash, Pred, Alloc>::set_ctrl(size_type index, ctrl_t h)
+{
+  m_ctrl[index] = h;
+
+  // The first control words are cloned after the sentinel, so that groups
+  // can be loaded from any position without wrapping around.
+  if (index < GROUP_WIDTH - 1)
+  {
+    m_ctrl[m_capacity + 1 + index] = h;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+void
+flat_hash_map<K, V, Hash, Pred, Alloc>::erase_at(size_type index)
+{
+  slot_traits::destroy(m_allocator, m_slots + index);
+  --m_size;
+
+  // A slot can be made empty again if no probe sequence has ever gone past
+  // it, which is the case when the window of `GROUP_WIDTH` slots around it
+  // has always had an empty slot.
+  const size_type before = (index - GROUP_WIDTH) & m_capacity;
+  const uint32_t empty_after = probe_group(m_ctrl + index).match_empty();
+  const uint32_t empty_before = probe_group(m_ctrl + before).match_empty();
+
+  const bool was_never_full = empty_before && empty_after &&
+    static_cast<size_type>(__builtin_ctz(empty_after)) +
+    static_cast<size_type>(__builtin_clz(empty_before) - 16) < GROUP_WIDTH;
+
+  if (was_never_full)
+  {
+    set_ctrl(index, EMPTY);
+    ++m_growth_left;
+  }
+  else
+  {
+    set_ctrl(index, DELETED);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+void
+flat_hash_map<K, V, Hash, Pred, Alloc>::grow()
+{
+  if (!m_capacity)
+  {
+    resize(MIN_CAPACITY);
+  }
+  else if (m_size <= max_growth(m_capacity) / 2)
+  {
+    // Mostly deleted slots; rehashing in place reclaims them.
+    resize(m_capacity);
+  }
+  else
+  {
+    resize(m_capacity * 2 + 1);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+void
+flat_hash_map<K, V, Hash, Pred, Alloc>::resize(size_type capacity)
+{
+  ctrl_t* old_ctrl = m_ctrl;
+  value_type* old_slots = m_slots;
+  const size_type old_capacity = m_capacity;
+
+  allocate(capacity);
+
+  for (size_type i = 0; i < old_capacity; ++i)
+  {
+    if (old_ctrl[i] >= 0)
+    {
+      const size_type hash = hash_of(old_slots[i].first);
+      const size_type index = find_first_non_full(hash);
+
+      set_ctrl(index, h2(hash));
+      slot_traits::construct(m_allocator, m_slots + index,
+        std::move(old_slots[i]));
+      slot_traits::destroy(m_allocator, old_slots + i);
+    }
+  }
+
+  m_growth_left = max_growth(m_capacity) - m_size;
+
+  if (old_capacity)
+  {
+    ctrl_allocator_type ctrl_allocator(m_allocator);
+    ctrl_traits::deallocate(ctrl_allocator, old_ctrl,
+      old_capacity + GROUP_WIDTH);
+    slot_traits::deallocate(m_allocator, old_slots, old_capacity);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+void
+flat_hash_map<K, V, Hash, Pred, Alloc>::allocate(size_type capacity)
+{
+  ctrl_allocator_type ctrl_allocator(m_allocator);
+
+  m_ctrl = ctrl_traits::allocate(ctrl_allocator, capacity + GROUP_WIDTH);
+  m_slots = slot_traits::allocate(m_allocator, capacity);
+  m_capacity = capacity;
+
+  memset(m_ctrl, EMPTY, m_capacity + GROUP_WIDTH);
+  m_ctrl[m_capacity] = SENTINEL;
+
+  m_growth_left = max_growth(m_capacity);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+void
+flat_hash_map<K, V, Hash, Pred, Alloc>::destroy_slots() noexcept
+{
+  for (size_type i = 0; i < m_capacity; ++i)
+  {
+    if (m_ctrl[i] >= 0)
+    {
+      slot_traits::destroy(m_allocator, m_slots + i);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+void
+flat_hash_map<K, V, Hash, Pred, Alloc>::deallocate() noexcept
+{
+  if (!m_capacity)
+  {
+    return;
+  }
+
+  ctrl_allocator_type ctrl_allocator(m_allocator);
+  ctrl_traits::deallocate(ctrl_allocator, m_ctrl, m_capacity + GROUP_WIDTH);
+  slot_traits::deallocate(m_allocator, m_slots, m_capacity);
+
+  m_ctrl = NULL;
+  m_slots = NULL;
+  m_capacity = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::iterator_at(size_type index)
+{
+  return iterator(m_ctrl + index, m_slots + index);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class V, class Hash, class Pred, class Alloc>
+typename flat_hash_map<K, V, Hash, Pred, Alloc>::const_iterator
+flat_hash_map<K, V, Hash, Pred, Alloc>::iterator_at(size_type index) const
+{
+  return const_iterator(m_ctrl + index, m_slots + index);
+}
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace container */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_FLAT_HASH_MAP_H_ */
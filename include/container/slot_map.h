@@ -0,0 +1,480 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::container::slot_map<T>` is a reservation-based container with the
+ * interface of `sneaker::container::reservation_map<T>`, for handle tables
+ * that reserve and release tokens at high rates.
+ *
+ * Instead of random UUIDs, tokens are 64-bit generational indices: the low
+ * 32 bits are the index of a slot, and the high 32 bits are the generation
+ * of the slot when it was reserved. Unreserving a token bumps the generation
+ * of its slot, which invalidates the token, and puts the slot on a free list
+ * for subsequent reservations. A token is thus only accepted by the slot it
+ * was issued for, as long as that reservation lasts.
+ *
+ * The values are stored contiguously in a dense array, which is kept packed
+ * by moving the last value into the place of an erased one. Reservations,
+ * storage, retrieval and unreservations all take constant time, and only
+ * allocate when the arrays grow beyond their previous sizes.
+ *
+ * A slot can be reused 2^31 times before its generation wraps around, after
+ * which a stale token of that slot could be accepted again.
+ *
+ * Example:
+ *
+ *  sneaker::container::slot_map<connection> connections;
+ *
+ *  sneaker::container::slot_map<connection>::token_t token =
+ *    connections.reserve();
+ *
+ *  connections.put(token, connection(socket));
+ *
+ *  connection* conn = connections.find(token);
+ *  ...
+ *  connections.unreserve(token);
+ */
+
+#ifndef SNEAKER_SLOT_MAP_H_
+#define SNEAKER_SLOT_MAP_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace sneaker {
+namespace container {
+
+template<class T>
+class slot_map {
+public:
+  typedef uint64_t token_t;
+
+  slot_map();
+
+  /**
+   * Constructs an empty container with storage for the specified number of
+   * reservations and values.
+   */
+  explicit slot_map(size_t capacity);
+
+  ~slot_map();
+
+  /**
+   * Gets the number of values stored in the container.
+   */
+  size_t size() const;
+
+  /**
+   * Gets the number of tokens currently reserved, with or without values.
+   */
+  size_t reservations() const;
+
+  token_t reserve();
+
+  bool member(token_t id) const;
+
+  /**
+   * Stores a value for the specified token, replacing the value previously
+   * stored for it, if any. Returns `false` if the token is not reserved. If
+   * storing the first value of a token throws, the token remains reserved
+   * without a value.
+   */
+  bool put(token_t id, T value);
+
+  bool get(token_t id, T* ptr) const;
+
+  /**
+   * Gets a pointer to the value stored for the specified token, or `NULL` if
+   * the token is not reserved or has no value. The pointer is invalidated by
+   * subsequent calls to `put()` and `unreserve()`.
+   */
+  T* find(token_t id);
+  const T* find(token_t id) const;
+
+  bool unreserve(token_t id);
+
+  /**
+   * Unreserves all the tokens.
+   */
+  void clear();
+
+  /**
+   * Invokes `visitor(token, value)` on every value stored in the container,
+   * in the order of the dense array of values.
+   */
+  template<class Visitor>
+  void for_each(Visitor visitor);
+
+protected:
+  struct slot
+  {
+    /**
+     * Odd while the slot is reserved, even while it is free.
+     */
+    uint32_t generation;
+
+    /**
+     * The position of the value of a reserved slot in the dense array, or of
+     * the next free slot for a free one; `NPOS` if there is none.
+     */
+    uint32_t link;
+  };
+
+  static constexpr uint32_t NPOS = UINT32_MAX;
+
+  static token_t make_token(uint32_t index, uint32_t generation);
+
+  /**
+   * Gets the index of the slot reserved for the specified token, or `NPOS` if
+   * the token is not reserved.
+   */
+  uint32_t slot_index(token_t id) const;
+
+  void erase_value(uint32_t pos);
+
+  std::vector<slot> m_slots;
+  std::vector<T> m_values;
+  std::vector<uint32_t> m_value_slots;
+  uint32_t m_free_head;
+  size_t m_reservations;
+};
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+constexpr uint32_t slot_map<T>::NPOS;
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+slot_map<T>::slot_map()
+  :
+  m_slots(),
+  m_values(),
+  m_value_slots(),
+  m_free_head(NPOS),
+  m_reservations(0)
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+slot_map<T>::slot_map(size_t capacity)
+  :
+  slot_map()
+{
+  m_slots.reserve(capacity);
+  m_values.reserve(capacity);
+  m_value_slots.reserve(capacity);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+slot_map<T>::~slot_map()
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+size_t
+slot_map<T>::size() const
+{
+  return m_values.size();
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+size_t
+slot_map<T>::reservations() const
+{
+  return m_reservations;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+typename slot_map<T>::token_t
+slot_map<T>::reserve()
+{
+  uint32_t index = m_free_head;
+
+  if (index != NPOS)
+  {
+    m_free_head = m_slots[index].link;
+  }
+  else
+  {
+    if (m_slots.size() >= NPOS)
+    {
+      throw std::length_error("slot_map::reserve");
+    }
+
+    index = static_cast<uint32_t>(m_slots.size());
+    m_slots.push_back(slot{0, NPOS});
+  }
+
+  slot& reserved = m_slots[index];
+  ++reserved.generation;
+  reserved.link = NPOS;
+
+  ++m_reservations;
+
+  return make_token(index, reserved.generation);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+bool
+slot_map<T>::member(token_t id) const
+{
+  return slot_index(id) != NPOS;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+bool
+slot_map<T>::put(token_t id, T value)
+{
+  const uint32_t index = slot_index(id);
+
+  if (index == NPOS)
+  {
+    return false;
+  }
+
+  slot& reserved = m_slots[index];
+
+  if (reserved.link != NPOS)
+  {
+    m_values[reserved.link] = std::move(value);
+  }
+  else
+  {
+    // The slot is only linked once both columns have grown, so that a throw
+    // leaves it reserved.
+    m_values.push_back(std::move(value));
+
+    try
+    {
+      m_value_slots.push_back(index);
+    }
+    catch (...)
+    {
+      m_values.pop_back();
+      throw;
+    }
+
+    reserved.link = static_cast<uint32_t>(m_values.size() - 1);
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+bool
+slot_map<T>::get(token_t id, T* ptr) const
+{
+  const T* value = find(id);
+
+  if (!value)
+  {
+    return false;
+  }
+
+  *ptr = *value;
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+T*
+slot_map<T>::find(token_t id)
+{
+  const uint32_t index = slot_index(id);
+
+  if (index == NPOS || m_slots[index].link == NPOS)
+  {
+    return NULL;
+  }
+
+  return &m_values[m_slots[index].link];
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+const T*
+slot_map<T>::find(token_t id) const
+{
+  const uint32_t index = slot_index(id);
+
+  if (index == NPOS || m_slots[index].link == NPOS)
+  {
+    return NULL;
+  }
+
+  return &m_values[m_slots[index].link];
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+bool
+slot_map<T>::unreserve(token_t id)
+{
+  const uint32_t index = slot_index(id);
+
+  if (index == NPOS)
+  {
+    return false;
+  }
+
+  slot& reserved = m_slots[index];
+
+  if (reserved.link != NPOS)
+  {
+    erase_value(reserved.link);
+  }
+
+  ++reserved.generation;
+  reserved.link = m_free_head;
+  m_free_head = index;
+
+  --m_reservations;
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+void
+slot_map<T>::clear()
+{
+  m_values.clear();
+  m_value_slots.clear();
+
+  // Every reserved slot moves on to its next generation, which invalidates
+  // all the tokens, and the free list is rebuilt in the order of the slots.
+  m_free_head = NPOS;
+
+  for (size_t i = m_slots.size(); i > 0; --i)
+  {
+    slot& current = m_slots[i - 1];
+
+    if (current.generation & 1)
+    {
+      ++current.generation;
+    }
+
+    current.link = m_free_head;
+    m_free_head = static_cast<uint32_t>(i - 1);
+  }
+
+  m_reservations = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+template<class Visitor>
+void
+slot_map<T>::for_each(Visitor visitor)
+{
+  for (size_t i = 0; i < m_values.size(); ++i)
+  {
+    const uint32_t index = m_value_slots[i];
+    visitor(make_token(index, m_slots[index].generation), m_values[i]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+typename slot_map<T>::token_t
+slot_map<T>::make_token(uint32_t index, uint32_t generation)
+{
+  return (static_cast<token_t>(generation) << 32) | index;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+uint32_t
+slot_map<T>::slot_index(token_t id) const
+{
+  const uint32_t index = static_cast<uint32_t>(id);
+  const uint32_t generation = static_cast<uint32_t>(id >> 32);
+
+  // Only odd generations are issued, which also rejects the free slots.
+  if (index >= m_slots.size() || !(generation & 1) ||
+      m_slots[index].generation != generation)
+  {
+    return NPOS;
+  }
+
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class T>
+void
+slot_map<T>::erase_value(uint32_t pos)
+{
+  const size_t last = m_values.size() - 1;
+
+  if (pos != last)
+  {
+    m_values[pos] = std::move(m_values[last]);
+    m_value_slots[pos] = m_value_slots[last];
+    m_slots[m_value_slots[pos]].link = pos;
+  }
+
+  m_values.pop_back();
+  m_value_slots.pop_back();
+}
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace container */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_SLOT_MAP_H_ */
@@ -32,6 +32,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  * Since this is an associative container, its interfaces and usage are very much
  * the same as the ones of `std::unordered_map`.
  *
+ * The pairs are stored in a `std::unordered_map` by default. The variant
+ * `flat_unordered_assorted_value_map<K, ValueTypes...>` stores them in the
+ * open-addressing `sneaker::container::flat_hash_map` instead, which has
+ * better locality for lookups and insertions.
+ *
  * Example:
  *
  * // Define a map of fruits to their scores and descriptions
@@ -53,18 +58,30 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef SNEAKER_UNORDERED_ASSORTED_VALUE_MAP_H_
 #define SNEAKER_UNORDERED_ASSORTED_VALUE_MAP_H_
 
+#include "container/flat_hash_map.h"
+
 #include <boost/tuple/tuple.hpp>
 
+#include <stdexcept>
 #include <unordered_map>
+#include <tuple>
+#include <utility>
 
 
 namespace sneaker {
 namespace container {
 
-template<class K, class... ValueTypes>
-class unordered_assorted_value_map {
+/**
+ * The implementation of `unordered_assorted_value_map`, parameterized on the
+ * template of its core hash table, such as `std::unordered_map` or
+ * `sneaker::container::flat_hash_map`. The core table is instantiated with
+ * the key type and the tuple of value types, and must provide the interface
+ * of `std::unordered_map` used by the map.
+ */
+template<template<class...> class Core, class K, class... ValueTypes>
+class basic_unordered_assorted_value_map {
 public:
-  using core_type = typename std::unordered_map<K, boost::tuple<ValueTypes... >>;
+  using core_type = Core<K, boost::tuple<ValueTypes... >>;
 
   using key_type              = typename core_type::key_type;
   using mapped_type           = typename core_type::mapped_type;
@@ -78,32 +95,30 @@ public:
   using const_pointer         = typename core_type::const_pointer;
   using iterator              = typename core_type::iterator;
   using const_iterator        = typename core_type::const_iterator;
-  using local_iterator        = typename core_type::local_iterator;
-  using const_local_iterator  = typename core_type::const_local_iterator;
   using size_type             = typename core_type::size_type;
   using difference_type       = typename core_type::difference_type;
 
-  unordered_assorted_value_map();
-  explicit unordered_assorted_value_map(const core_type&);
+  basic_unordered_assorted_value_map();
+  explicit basic_unordered_assorted_value_map(const core_type&);
 
-  unordered_assorted_value_map(
-    const unordered_assorted_value_map<K, ValueTypes...>&);
+  basic_unordered_assorted_value_map(
+    const basic_unordered_assorted_value_map<Core, K, ValueTypes...>&);
 
-  ~unordered_assorted_value_map();
+  ~basic_unordered_assorted_value_map();
 
   template<size_type N, class Hash, class Pred, class Alloc>
   static
-  unordered_assorted_value_map<K, ValueTypes...> create() {
-    return unordered_assorted_value_map<K, ValueTypes...>(
+  basic_unordered_assorted_value_map<Core, K, ValueTypes...> create() {
+    return basic_unordered_assorted_value_map<Core, K, ValueTypes...>(
       core_type(N, Hash(), Pred(), Alloc()));
   }
 
   template<size_type N, class Hash, class Pred, class Alloc>
   static
-  unordered_assorted_value_map<K, ValueTypes...> create(
+  basic_unordered_assorted_value_map<Core, K, ValueTypes...> create(
     const Hash& hasher, const Pred& key_eq, const Alloc& allocator)
   {
-    return unordered_assorted_value_map<K, ValueTypes...>(
+    return basic_unordered_assorted_value_map<Core, K, ValueTypes...>(
       core_type(N, hasher, key_eq, allocator));
   }
 
@@ -115,25 +130,43 @@ public:
 
   void insert(K key, ValueTypes... values);
 
+  /**
+   * Constructs a key-value(s) pair in place, forwarding the arguments to the
+   * constructors of the key and of the values. Returns an iterator to the
+   * pair with the key, and whether the pair has been inserted.
+   */
+  template<class KeyArg, class... Args>
+  std::pair<iterator, bool> emplace(KeyArg&& key, Args&&... values);
+
+  /**
+   * Like `emplace()`, but the values are only constructed if the key does not
+   * exist in the map.
+   */
+  template<class... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... values);
+
+  template<class... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... values);
+
   void erase(iterator itr);
   size_type erase(const K& key);
   void erase(iterator first, iterator last);
 
-  void swap(unordered_assorted_value_map<K, ValueTypes...>& other);
+  void swap(basic_unordered_assorted_value_map<Core, K, ValueTypes...>& other);
 
   void clear() noexcept;
 
-  mapped_type& at(K key);
-  const mapped_type& at(K key) const;
+  mapped_type& at(const K& key);
+  const mapped_type& at(const K& key) const;
 
   template<class A, size_t Index>
-  A get(K key);
+  A& get(const K& key);
 
   template<class A, size_t Index>
-  const A& get(K key) const;
+  const A& get(const K& key) const;
 
-  mapped_type& operator[](K key);
-  const mapped_type& operator[](K key) const;
+  mapped_type& operator[](const K& key);
+  const mapped_type& operator[](const K& key) const;
 
   iterator begin();
   const_iterator begin() const;
@@ -144,8 +177,8 @@ public:
   const_iterator cbegin() const noexcept;
   const_iterator cend() const noexcept;
 
-  iterator find(K key);
-  const_iterator find(K key) const;
+  iterator find(const K& key);
+  const_iterator find(const K& key) const;
 
   float load_factor() const noexcept;
 
@@ -159,14 +192,38 @@ public:
   key_equal key_eq() const;
   allocator_type get_allocator() const noexcept;
 
+  /**
+   * Heterogeneous lookups with the hash of the equal key through `hasher`,
+   * which compare the keys of the map with the lookup key through
+   * `operator==` without constructing or assigning any key. Only available
+   * with cores that support them, such as `flat_hash_map`.
+   */
+  template<class KeyLike>
+  mapped_type& at(const KeyLike& key, size_type hash);
+
+  template<class KeyLike>
+  const mapped_type& at(const KeyLike& key, size_type hash) const;
+
+  template<class A, size_t Index, class KeyLike>
+  A& get(const KeyLike& key, size_type hash);
+
+  template<class A, size_t Index, class KeyLike>
+  const A& get(const KeyLike& key, size_type hash) const;
+
+  template<class KeyLike>
+  iterator find(const KeyLike& key, size_type hash);
+
+  template<class KeyLike>
+  const_iterator find(const KeyLike& key, size_type hash) const;
+
 protected:
   core_type m_core;
 };
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-unordered_assorted_value_map<K, ValueTypes...>::unordered_assorted_value_map()
+template<template<class...> class Core, class K, class... ValueTypes>
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::basic_unordered_assorted_value_map()
   :
   m_core()
 {
@@ -175,8 +232,8 @@ unordered_assorted_value_map<K, ValueTypes...>::unordered_assorted_value_map()
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-unordered_assorted_value_map<K, ValueTypes...>::unordered_assorted_value_map(
+template<template<class...> class Core, class K, class... ValueTypes>
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::basic_unordered_assorted_value_map(
   const core_type& core)
   :
   m_core(core)
@@ -186,9 +243,9 @@ unordered_assorted_value_map<K, ValueTypes...>::unordered_assorted_value_map(
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-unordered_assorted_value_map<K, ValueTypes...>::unordered_assorted_value_map(
-  const unordered_assorted_value_map<K, ValueTypes...>& other)
+template<template<class...> class Core, class K, class... ValueTypes>
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::basic_unordered_assorted_value_map(
+  const basic_unordered_assorted_value_map<Core, K, ValueTypes...>& other)
   :
   m_core(other.m_core)
 {
@@ -197,44 +254,44 @@ unordered_assorted_value_map<K, ValueTypes...>::unordered_assorted_value_map(
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-unordered_assorted_value_map<K, ValueTypes...>::~unordered_assorted_value_map()
+template<template<class...> class Core, class K, class... ValueTypes>
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::~basic_unordered_assorted_value_map()
 {
   // Do nothing here.
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
+template<template<class...> class Core, class K, class... ValueTypes>
 bool
-unordered_assorted_value_map<K, ValueTypes...>::empty() const
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::empty() const
 {
   return m_core.empty();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::size_type
-unordered_assorted_value_map<K, ValueTypes...>::size() const
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::size_type
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::size() const
 {
   return m_core.size();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::size_type
-unordered_assorted_value_map<K, ValueTypes...>::max_size() const
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::size_type
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::max_size() const
 {
   return m_core.max_size();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
+template<template<class...> class Core, class K, class... ValueTypes>
 void
-unordered_assorted_value_map<K, ValueTypes...>::insert(
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::insert(
   K key, ValueTypes... values)
 {
   m_core.insert( value_type(key, mapped_type(values...)) );
@@ -242,27 +299,80 @@ unordered_assorted_value_map<K, ValueTypes...>::insert(
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
+template<template<class...> class Core, class K, class... ValueTypes>
+template<class KeyArg, class... Args>
+std::pair<typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::iterator, bool>
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::emplace(
+  KeyArg&& key, Args&&... values)
+{
+  return m_core.emplace(std::piecewise_construct,
+    std::forward_as_tuple(std::forward<KeyArg>(key)),
+    std::forward_as_tuple(std::forward<Args>(values)...));
+}
+
+// -----------------------------------------------------------------------------
+
+template<template<class...> class Core, class K, class... ValueTypes>
+template<class... Args>
+std::pair<typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::iterator, bool>
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::try_emplace(
+  const K& key, Args&&... values)
+{
+  const iterator itr = m_core.find(key);
+
+  if (itr != m_core.end())
+  {
+    return std::make_pair(itr, false);
+  }
+
+  return m_core.emplace(std::piecewise_construct,
+    std::forward_as_tuple(key),
+    std::forward_as_tuple(std::forward<Args>(values)...));
+}
+
+// -----------------------------------------------------------------------------
+
+template<template<class...> class Core, class K, class... ValueTypes>
+template<class... Args>
+std::pair<typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::iterator, bool>
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::try_emplace(
+  K&& key, Args&&... values)
+{
+  const iterator itr = m_core.find(key);
+
+  if (itr != m_core.end())
+  {
+    return std::make_pair(itr, false);
+  }
+
+  return m_core.emplace(std::piecewise_construct,
+    std::forward_as_tuple(std::move(key)),
+    std::forward_as_tuple(std::forward<Args>(values)...));
+}
+
+// -----------------------------------------------------------------------------
+
+template<template<class...> class Core, class K, class... ValueTypes>
 void
-unordered_assorted_value_map<K, ValueTypes...>::erase(iterator itr)
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::erase(iterator itr)
 {
   m_core.erase(itr);
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::size_type
-unordered_assorted_value_map<K, ValueTypes...>::erase(const K& key)
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::size_type
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::erase(const K& key)
 {
   return m_core.erase(key);
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
+template<template<class...> class Core, class K, class... ValueTypes>
 void
-unordered_assorted_value_map<K, ValueTypes...>::erase(
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::erase(
   iterator first, iterator last)
 {
   m_core.erase(first, last);
@@ -270,225 +380,317 @@ unordered_assorted_value_map<K, ValueTypes...>::erase(
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
+template<template<class...> class Core, class K, class... ValueTypes>
 void
-unordered_assorted_value_map<K, ValueTypes...>::swap(
-  unordered_assorted_value_map<K, ValueTypes...>& other)
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::swap(
+  basic_unordered_assorted_value_map<Core, K, ValueTypes...>& other)
 {
   m_core.swap(other.m_core);
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
+template<template<class...> class Core, class K, class... ValueTypes>
 void
-unordered_assorted_value_map<K, ValueTypes...>::clear() noexcept
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::clear() noexcept
 {
   m_core.clear();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::mapped_type&
-unordered_assorted_value_map<K, ValueTypes...>::at(K key)
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::mapped_type&
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::at(const K& key)
 {
   return static_cast<mapped_type&>(m_core.at(key));
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-const typename unordered_assorted_value_map<K, ValueTypes...>::mapped_type&
-unordered_assorted_value_map<K, ValueTypes...>::at(K key) const
+template<template<class...> class Core, class K, class... ValueTypes>
+const typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::mapped_type&
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::at(const K& key) const
 {
   return static_cast<const mapped_type&>(m_core.at(key));
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
+template<template<class...> class Core, class K, class... ValueTypes>
 template<class A, size_t Index>
-A
-unordered_assorted_value_map<K, ValueTypes...>::get(K key)
+A&
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::get(const K& key)
 {
   return boost::get<Index>(at(key));
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
+template<template<class...> class Core, class K, class... ValueTypes>
 template<class A, size_t Index>
 const A&
-unordered_assorted_value_map<K, ValueTypes...>::get(K key) const
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::get(const K& key) const
 {
   return boost::get<Index>(at(key));
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::mapped_type&
-unordered_assorted_value_map<K, ValueTypes...>::operator[](K key)
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::mapped_type&
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::operator[](const K& key)
 {
   return at(key);
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-const typename unordered_assorted_value_map<K, ValueTypes...>::mapped_type&
-unordered_assorted_value_map<K, ValueTypes...>::operator[](K key) const
+template<template<class...> class Core, class K, class... ValueTypes>
+const typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::mapped_type&
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::operator[](const K& key) const
 {
   return at(key);
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::iterator
-unordered_assorted_value_map<K, ValueTypes...>::begin()
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::iterator
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::begin()
 {
   return m_core.begin();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::const_iterator
-unordered_assorted_value_map<K, ValueTypes...>::begin() const
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::const_iterator
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::begin() const
 {
   return m_core.begin();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::iterator
-unordered_assorted_value_map<K, ValueTypes...>::end()
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::iterator
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::end()
 {
   return m_core.end();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::const_iterator
-unordered_assorted_value_map<K, ValueTypes...>::end() const
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::const_iterator
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::end() const
 {
   return m_core.end();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::const_iterator
-unordered_assorted_value_map<K, ValueTypes...>::cbegin() const noexcept
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::const_iterator
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::cbegin() const noexcept
 {
   return m_core.cbegin();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::const_iterator
-unordered_assorted_value_map<K, ValueTypes...>::cend() const noexcept
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::const_iterator
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::cend() const noexcept
 {
   return m_core.cend();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::iterator
-unordered_assorted_value_map<K, ValueTypes...>::find(K key)
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::iterator
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::find(const K& key)
 {
   return m_core.find(key);
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::const_iterator
-unordered_assorted_value_map<K, ValueTypes...>::find(K key) const
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::const_iterator
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::find(const K& key) const
 {
   return m_core.find(key);
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
+template<template<class...> class Core, class K, class... ValueTypes>
 float
-unordered_assorted_value_map<K, ValueTypes...>::load_factor() const noexcept
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::load_factor() const noexcept
 {
   return m_core.load_factor();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
+template<template<class...> class Core, class K, class... ValueTypes>
 float
-unordered_assorted_value_map<K, ValueTypes...>::max_load_factor() const noexcept
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::max_load_factor() const noexcept
 {
   return m_core.max_load_factor();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
+template<template<class...> class Core, class K, class... ValueTypes>
 void
-unordered_assorted_value_map<K, ValueTypes...>::max_load_factor(float z)
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::max_load_factor(float z)
 {
   return m_core.max_load_factor(z);
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
+template<template<class...> class Core, class K, class... ValueTypes>
 void
-unordered_assorted_value_map<K, ValueTypes...>::rehash(size_type n)
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::rehash(size_type n)
 {
   return m_core.rehash(n);
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
+template<template<class...> class Core, class K, class... ValueTypes>
 void
-unordered_assorted_value_map<K, ValueTypes...>::reserve(size_type n)
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::reserve(size_type n)
 {
   return m_core.reserve(n);
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::hasher
-unordered_assorted_value_map<K, ValueTypes...>::hash_function() const
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::hasher
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::hash_function() const
 {
   return m_core.hash_function();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::key_equal
-unordered_assorted_value_map<K, ValueTypes...>::key_eq() const
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::key_equal
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::key_eq() const
 {
   return m_core.key_eq();
 }
 
 // -----------------------------------------------------------------------------
 
-template<class K, class... ValueTypes>
-typename unordered_assorted_value_map<K, ValueTypes...>::allocator_type
-unordered_assorted_value_map<K, ValueTypes...>::get_allocator() const noexcept
+template<template<class...> class Core, class K, class... ValueTypes>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::allocator_type
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::get_allocator() const noexcept
 {
   return m_core.get_allocator();
 }
 
 // -----------------------------------------------------------------------------
 
+template<template<class...> class Core, class K, class... ValueTypes>
+template<class KeyLike>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::mapped_type&
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::at(const KeyLike& key, size_type hash)
+{
+  const iterator itr = find(key, hash);
+
+  if (itr == end())
+  {
+    throw std::out_of_range("unordered_assorted_value_map::at");
+  }
+
+  return itr->second;
+}
+
+// -----------------------------------------------------------------------------
+
+template<template<class...> class Core, class K, class... ValueTypes>
+template<class KeyLike>
+const typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::mapped_type&
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::at(const KeyLike& key, size_type hash) const
+{
+  const const_iterator itr = find(key, hash);
+
+  if (itr == end())
+  {
+    throw std::out_of_range("unordered_assorted_value_map::at");
+  }
+
+  return itr->second;
+}
+
+// -----------------------------------------------------------------------------
+
+template<template<class...> class Core, class K, class... ValueTypes>
+template<class A, size_t Index, class KeyLike>
+A&
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::get(const KeyLike& key, size_type hash)
+{
+  return boost::get<Index>(at(key, hash));
+}
+
+// -----------------------------------------------------------------------------
+
+template<template<class...> class Core, class K, class... ValueTypes>
+template<class A, size_t Index, class KeyLike>
+const A&
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::get(const KeyLike& key, size_type hash) const
+{
+  return boost::get<Index>(at(key, hash));
+}
+
+// -----------------------------------------------------------------------------
+
+template<template<class...> class Core, class K, class... ValueTypes>
+template<class KeyLike>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::iterator
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::find(const KeyLike& key, size_type hash)
+{
+  return m_core.find(key, hash);
+}
+
+// -----------------------------------------------------------------------------
+
+template<template<class...> class Core, class K, class... ValueTypes>
+template<class KeyLike>
+typename basic_unordered_assorted_value_map<Core, K, ValueTypes...>::const_iterator
+basic_unordered_assorted_value_map<Core, K, ValueTypes...>::find(const KeyLike& key, size_type hash) const
+{
+  return m_core.find(key, hash);
+}
+
+// -----------------------------------------------------------------------------
+
+template<class K, class... ValueTypes>
+using unordered_assorted_value_map =
+  basic_unordered_assorted_value_map<std::unordered_map, K, ValueTypes...>;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Variant of `unordered_assorted_value_map` whose core is the open-addressing
+ * `sneaker::container::flat_hash_map`, which stores the key-value(s) pairs
+ * inline instead of in separately allocated nodes. Insertions that grow the
+ * map invalidate all iterators and references.
+ */
+template<class K, class... ValueTypes>
+using flat_unordered_assorted_value_map =
+  basic_unordered_assorted_value_map<flat_hash_map, K, ValueTypes...>;
+
+// -----------------------------------------------------------------------------
+
 } /* end namespace container */
 } /* end namespace sneaker */
 
@@ -94,6 +94,15 @@ std::unique_ptr<input_stream> memory_input_stream(const uint8_t* data,
 
 // -----------------------------------------------------------------------------
 
+/**
+ * Returns a new instance of `input_stream` whose contents come from the
+ * specified file, which is memory-mapped and read in a single chunk without
+ * being copied.
+ */
+std::unique_ptr<input_stream> mmap_input_stream(const char* filename);
+
+// -----------------------------------------------------------------------------
+
 class stream_reader
 {
 public:
@@ -89,6 +89,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define SNEAKER_JSON_H_
 
 #include <cstdint>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <stdexcept>
@@ -110,6 +111,56 @@ typedef std::invalid_argument invalid_json_error;
 
 // -----------------------------------------------------------------------------
 
+/**
+ * A reference to a sequence of characters owned elsewhere, such as the value
+ * of a JSON string, which may contain null characters and is not
+ * null-terminated.
+ */
+class string_view {
+public:
+  string_view() : m_data(""), m_size(0) {}
+
+  string_view(const char* data, size_t size) : m_data(data), m_size(size) {}
+
+  string_view(const std::string& str) : m_data(str.data()), m_size(str.size()) {}
+
+  const char* data() const { return m_data; }
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  const char* begin() const { return m_data; }
+  const char* end() const { return m_data + m_size; }
+
+  char operator[](size_t i) const { return m_data[i]; }
+
+  std::string to_string() const { return std::string(m_data, m_size); }
+
+  /**
+   * Compares in the order of `std::string::compare()`.
+   */
+  int compare(const string_view& other) const {
+    const int result = memcmp(m_data, other.m_data,
+      m_size < other.m_size ? m_size : other.m_size);
+    if (result != 0) {
+      return result;
+    }
+    return (m_size < other.m_size) ? -1 : (m_size > other.m_size ? 1 : 0);
+  }
+
+  bool operator==(const string_view& other) const {
+    return m_size == other.m_size && memcmp(m_data, other.m_data, m_size) == 0;
+  }
+
+  bool operator!=(const string_view& other) const { return !(*this == other); }
+  bool operator<(const string_view& other) const { return compare(other) < 0; }
+
+private:
+  const char* m_data;
+  size_t m_size;
+};
+
+// -----------------------------------------------------------------------------
+
 class JSON {
 public:
   enum Type {
@@ -173,6 +224,13 @@ public:
   int64_t int_value() const;
   bool bool_value() const;
   const string& string_value() const;
+
+  /**
+   * Gets the value of a string without copying it. The view remains valid
+   * for as long as the value it was obtained from.
+   */
+  string_view string_view_value() const;
+
   const array& array_items() const;
   const object& object_items() const;
   const JSON& operator[](size_t i) const;
@@ -192,8 +250,17 @@ public:
   static JSON from_int64(int64_t);
 
 private:
+  friend struct json_parser;
+
   JSON(int64_t, char);
 
+  /**
+   * Constructs a string whose value is the specified slice of the source,
+   * unescaped on first access if `escaped` is `true`.
+   */
+  static JSON from_source(const std::shared_ptr<const std::string>& source,
+    size_t offset, size_t size, bool escaped);
+
   std::shared_ptr<json_value> m_ptr;
 };
 
@@ -203,6 +270,25 @@ JSON parse(const std::string& in);
 
 // -----------------------------------------------------------------------------
 
+/**
+ * Parses a JSON blob like `parse(const std::string&)`, from the specified
+ * range of characters, which needs not be null-terminated.
+ */
+JSON parse(const char* data, size_t size);
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Parses a JSON blob like `parse(const std::string&)`, except that string
+ * values refer to the shared input instead of copying it. Strings without
+ * escape sequences are never copied when read through
+ * `JSON::string_view_value()`, and the others are unescaped on first access.
+ * The input is kept alive by the values that refer to it.
+ */
+JSON parse(const std::shared_ptr<const std::string>& in);
+
+// -----------------------------------------------------------------------------
+
 } /* end namespace json */
 } /* end namespace sneaker */
 
@@ -0,0 +1,397 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::json::json_document` is an immutable JSON DOM stored in a single
+ * arena, as an alternative to the reference-counted values of
+ * `sneaker::json::JSON` for large documents that are parsed to be read.
+ *
+ * A document owns a copy of its input and an array of 16-byte tagged values.
+ * Strings are slices of the copied input, and those with escape sequences
+ * are unescaped in place, since unescaping never lengthens a string. The
+ * items of an array and the members of an object are stored contiguously,
+ * the latter as pairs of keys and values sorted by key, so that parsing a
+ * document performs a bounded number of allocations regardless of the
+ * number of values it holds.
+ *
+ * Values are read through `sneaker::json::json_view`, whose accessors mirror
+ * those of `sneaker::json::JSON`. Objects behave like `JSON::object`: their
+ * members are iterated in the order of their keys, and the last of several
+ * members with the same key takes precedence. Views remain valid for as long
+ * as the document they refer to, including after it has been moved.
+ *
+ * Example:
+ *
+ *  using namespace sneaker::json;
+ *
+ *  json_document document = parse_document(
+ *    "{\"k1\": \"v1\", \"k2\": [1, 2.5, true, null]}");
+ *
+ *  json_view root = document.root();
+ *
+ *  assert(std::string("v1") == root["k1"].string_value());
+ *  assert(2.5 == root["k2"][1].number_value());
+ *
+ *  for (const auto member : root.object_items())
+ *  {
+ *    std::cout << member.first.string_value() << std::endl;
+ *  }
+ */
+
+#ifndef SNEAKER_JSON_DOCUMENT_H_
+#define SNEAKER_JSON_DOCUMENT_H_
+
+#include "json/json.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace sneaker {
+namespace json {
+
+// -----------------------------------------------------------------------------
+
+// Forward declaration of `sneaker::json::json_view`.
+class json_view;
+
+// -----------------------------------------------------------------------------
+
+class json_document
+{
+public:
+  /**
+   * Constructs a document whose root is `null`.
+   */
+  json_document();
+
+  json_document(const json_document&) = delete;
+  json_document& operator=(const json_document&) = delete;
+
+  json_document(json_document&&) = default;
+  json_document& operator=(json_document&&) = default;
+
+  json_view root() const;
+
+  /**
+   * Gets the number of values in the document, including object keys.
+   */
+  size_t value_count() const
+  {
+    return m_values.size();
+  }
+
+private:
+  friend class json_view;
+
+  friend json_document parse_document(const char* data, size_t size);
+  friend json_document parse_indexed_document(const char* data, size_t size);
+
+  class builder;
+
+  /**
+   * Constructs a document holding a copy of the specified input, whose
+   * values are yet to be built.
+   */
+  json_document(const char* data, size_t size);
+
+  /**
+   * A tagged value. `size` is the length of strings, and the number of items
+   * of arrays or members of objects. While a document is built, the children
+   * of containers are referred to by their offset in the value array, which
+   * are turned into pointers once it stops growing.
+   */
+  struct value
+  {
+    uint8_t type;
+    uint8_t integral;
+    uint32_t size;
+    union
+    {
+      int64_t integer;
+      double number;
+      const char* string;
+      const value* children;
+      uint64_t offset;
+    };
+  };
+
+  static const value NULL_VALUE;
+
+  std::vector<char> m_input;
+  std::vector<value> m_values;
+  size_t m_root;
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * A read-only view of a value in a `json_document`. Accessors that do not
+ * apply to the type of the value return defaults, and lookups of missing
+ * items or members return views of `null`, as with `JSON`.
+ */
+class json_view
+{
+public:
+  typedef std::pair<json_view, json_view> member;
+
+  /**
+   * Iterator over the items of an array, or the members of an object, which
+   * yields them by value.
+   */
+  template<class T, size_t Stride>
+  class basic_iterator
+  {
+  public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef T reference;
+
+    struct arrow_proxy
+    {
+      T item;
+
+      const T* operator->() const
+      {
+        return &item;
+      }
+    };
+
+    explicit basic_iterator(const json_document::value* value)
+      :
+      m_value(value)
+    {
+      // Do nothing here.
+    }
+
+    T operator*() const;
+
+    arrow_proxy operator->() const
+    {
+      arrow_proxy proxy = { **this };
+      return proxy;
+    }
+
+    basic_iterator& operator++()
+    {
+      m_value += Stride;
+      return *this;
+    }
+
+    basic_iterator operator++(int)
+    {
+      basic_iterator copy(*this);
+      m_value += Stride;
+      return copy;
+    }
+
+    bool operator==(const basic_iterator& other) const
+    {
+      return m_value == other.m_value;
+    }
+
+    bool operator!=(const basic_iterator& other) const
+    {
+      return m_value != other.m_value;
+    }
+
+  private:
+    const json_document::value* m_value;
+  };
+
+  typedef basic_iterator<json_view, 1> item_iterator;
+  typedef basic_iterator<member, 2> member_iterator;
+
+  template<class Iterator>
+  class range
+  {
+  public:
+    range(Iterator begin, Iterator end, size_t size)
+      :
+      m_begin(begin),
+      m_end(end),
+      m_size(size)
+    {
+      // Do nothing here.
+    }
+
+    Iterator begin() const
+    {
+      return m_begin;
+    }
+
+    Iterator end() const
+    {
+      return m_end;
+    }
+
+    size_t size() const
+    {
+      return m_size;
+    }
+
+    bool empty() const
+    {
+      return m_size == 0;
+    }
+
+  private:
+    Iterator m_begin;
+    Iterator m_end;
+    size_t m_size;
+  };
+
+  /**
+   * Constructs a view of `null` that does not belong to any document.
+   */
+  json_view();
+
+  JSON::Type type() const
+  {
+    return static_cast<JSON::Type>(m_value->type);
+  }
+
+  bool is_null()   const { return type() == JSON::NUL; }
+  bool is_number() const { return type() == JSON::NUMBER; }
+  bool is_bool()   const { return type() == JSON::BOOL; }
+  bool is_string() const { return type() == JSON::STRING; }
+  bool is_array()  const { return type() == JSON::ARRAY; }
+  bool is_object() const { return type() == JSON::OBJECT; }
+
+  double number_value() const;
+
+  int64_t int_value() const;
+
+  bool bool_value() const;
+
+  /**
+   * Copies the value of a string. Use `string_data()` and `string_size()` to
+   * read it in place.
+   */
+  std::string string_value() const;
+
+  /**
+   * Gets the bytes of a string, which are not null-terminated and may
+   * contain null characters, or `NULL` for other types.
+   */
+  const char* string_data() const;
+
+  size_t string_size() const;
+
+  /**
+   * Gets the number of items of an array or members of an object, or zero
+   * for other types.
+   */
+  size_t size() const;
+
+  range<item_iterator> array_items() const;
+
+  range<member_iterator> object_items() const;
+
+  json_view operator[](size_t i) const;
+
+  json_view operator[](const std::string& key) const;
+
+  /**
+   * Looks up the member of an object with the specified key in logarithmic
+   * time, without constructing a `std::string`.
+   */
+  json_view find(const char* key, size_t length) const;
+
+  /**
+   * Copies the value, and every value nested within it, into a `JSON`.
+   */
+  JSON to_json() const;
+
+private:
+  friend class json_document;
+
+  explicit json_view(const json_document::value* value)
+    :
+    m_value(value)
+  {
+    // Do nothing here.
+  }
+
+  const json_document::value* m_value;
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+inline json_view
+json_view::item_iterator::operator*() const
+{
+  return json_view(m_value);
+}
+
+// -----------------------------------------------------------------------------
+
+template<>
+inline json_view::member
+json_view::member_iterator::operator*() const
+{
+  return member(json_view(m_value), json_view(m_value + 1));
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Parses a JSON blob into a `json_document`. Accepts the same documents as
+ * `sneaker::json::parse()`, and throws `invalid_json_error` with the same
+ * messages for the others.
+ */
+json_document parse_document(const char* data, size_t size);
+
+json_document parse_document(const std::string& in);
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Parses a JSON blob into a `json_document` in two stages. The first stage
+ * finds the positions of the structural characters, strings and other values
+ * with SIMD instructions where available, see
+ * `sneaker::json::json_structural_index`, and the second builds the document
+ * from those positions alone, without scanning whitespace nor strings that
+ * have no escape sequences.
+ *
+ * Accepts the same documents as `parse_document()`, although the messages of
+ * the errors thrown for the others may differ.
+ */
+json_document parse_indexed_document(const char* data, size_t size);
+
+json_document parse_indexed_document(const std::string& in);
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace json */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_JSON_DOCUMENT_H_ */
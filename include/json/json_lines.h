@@ -0,0 +1,153 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::json::json_lines_reader` reads newline-delimited JSON, also known
+ * as JSON Lines, where every line holds a record, and parses the records on
+ * multiple threads.
+ *
+ * The input is consumed from a `sneaker::io::input_stream` and cut into
+ * blocks of about `block_size` bytes at line boundaries. Chunks of the stream
+ * that hold whole blocks, such as the single chunk of a memory-mapped file,
+ * are parsed in place, while smaller chunks are gathered into a block first,
+ * of which only the partial line at the end is carried over to the next one.
+ * The lines of each block are parsed straight from the input with
+ * `sneaker::json::parse()` by a pool of threads that lives for the whole
+ * read, while the calling thread reads the next block. Chunks parsed in place
+ * are done before the next chunk is read, as streams may reuse their memory.
+ *
+ * Records are delivered either in the order of their lines, from the calling
+ * thread as their lines are parsed, or in no particular order, from the
+ * threads that parsed them as soon as they are parsed. Invalid lines are
+ * reported to the error callback with the message of the
+ * `invalid_json_error` they raised, and do not stop the rest of the input
+ * from being read. Blank lines are skipped, and a carriage return before a
+ * newline is ignored.
+ *
+ * Example:
+ *
+ *  sneaker::json::json_lines_reader reader(8);
+ *
+ *  auto summary = reader.read_file("records.jsonl",
+ *    [](size_t line_number, sneaker::json::JSON& record) {
+ *      std::cout << line_number << ": " << record["id"].int_value() << std::endl;
+ *    },
+ *    [](size_t line_number, const std::string& message) {
+ *      std::cerr << line_number << ": " << message << std::endl;
+ *    }
+ *  );
+ */
+
+#ifndef SNEAKER_JSON_LINES_H_
+#define SNEAKER_JSON_LINES_H_
+
+#include "io/input_stream.h"
+#include "json/json.h"
+
+#include <cstdlib>
+#include <functional>
+#include <string>
+
+
+namespace sneaker {
+namespace json {
+
+class json_lines_reader
+{
+public:
+  /**
+   * The size of the blocks parsed at once by default.
+   */
+  static constexpr size_t DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;
+
+  enum class delivery
+  {
+    /**
+     * Records and errors are delivered from the calling thread, in the order
+     * of their lines.
+     */
+    ORDERED,
+
+    /**
+     * Records and errors are delivered from the parsing threads as soon as
+     * they are parsed, so the callbacks must be safe to invoke concurrently.
+     */
+    UNORDERED
+  };
+
+  /**
+   * Invoked with the 1-based number of the line of every record, which the
+   * callback may move from.
+   */
+  typedef std::function<void(size_t, JSON&)> record_callback;
+
+  /**
+   * Invoked with the 1-based number of every invalid line, and the message
+   * of the error it raised.
+   */
+  typedef std::function<void(size_t, const std::string&)> error_callback;
+
+  struct summary
+  {
+    size_t line_count;
+    size_t record_count;
+    size_t error_count;
+  };
+
+  /**
+   * Constructs an instance that parses on the specified number of threads,
+   * or on as many threads as the hardware supports if `0`.
+   */
+  explicit json_lines_reader(size_t thread_count=0,
+    delivery order=delivery::ORDERED, size_t block_size=DEFAULT_BLOCK_SIZE);
+
+  size_t thread_count() const
+  {
+    return m_thread_count;
+  }
+
+  /**
+   * Reads every line of the stream, and returns the number of lines, records
+   * and errors encountered. Callbacks must not throw when delivery is
+   * unordered.
+   */
+  summary read(io::input_stream* stream, const record_callback& on_record,
+    const error_callback& on_error) const;
+
+  /**
+   * Same as `read()`, on the memory-mapped contents of the specified file.
+   */
+  summary read_file(const char* filename, const record_callback& on_record,
+    const error_callback& on_error) const;
+
+private:
+  size_t m_thread_count;
+  delivery m_order;
+  size_t m_block_size;
+};
+
+} /* end namespace json */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_JSON_LINES_H_ */
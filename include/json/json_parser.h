@@ -25,24 +25,81 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "json.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <memory>
 #include <string>
 
 
 namespace sneaker {
 namespace json {
 
+/**
+ * The input of `json_parser`, which is either a string or a range of
+ * characters that needs not be null-terminated. Reads past the end yield
+ * `'\0'`, as they do on a `std::string`.
+ */
+class json_input {
+public:
+  json_input(const std::string& str)
+    :
+    m_data(str.data()),
+    m_size(str.size())
+  {
+    // Do nothing here.
+  }
+
+  json_input(const char* data, size_t size)
+    :
+    m_data(data),
+    m_size(size)
+  {
+    // Do nothing here.
+  }
+
+  size_t size() const
+  {
+    return m_size;
+  }
+
+  char operator[](size_t i) const
+  {
+    return i < m_size ? m_data[i] : '\0';
+  }
+
+  std::string substr(size_t pos, size_t len) const
+  {
+    pos = std::min(pos, m_size);
+    return std::string(m_data + pos, std::min(len, m_size - pos));
+  }
+
+private:
+  const char* m_data;
+  size_t m_size;
+};
+
 struct json_parser {
 public:
-  const std::string &str;
+  json_input str;
   size_t i;
   std::string &err;
   bool failed;
 
+  /**
+   * The input shared by the string values parsed, which refer to it rather
+   * than copy it, or `nullptr` to copy them.
+   */
+  std::shared_ptr<const std::string> source;
+
   static const size_t MAX_DEPTH;
 
   JSON parse_json();
 private:
+  /**
+   * Unescapes string slices on first access.
+   */
+  friend class json_string_slice;
+
   void consume_whitespace();
 
   JSON parse_json(uint32_t depth);
@@ -62,6 +119,8 @@ private:
 
   std::string parse_string();
 
+  JSON parse_string_slice();
+
   JSON expect(const std::string& expected, JSON res);
 
   bool in_range(long x, long lower, long upper);
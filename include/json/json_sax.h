@@ -0,0 +1,248 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::json::json_sax_parser` is an event-driven JSON parser for inputs
+ * that are too large to be held in memory. Input is pushed to the parser in
+ * chunks of any size, and the parser reports the values it encounters to a
+ * `sneaker::json::json_sax_handler` as soon as they are complete, without
+ * building a DOM.
+ *
+ * The state of the parser is carried across chunks, so that a chunk may end
+ * anywhere, including in the middle of a string, a number or an escape
+ * sequence. Memory use is bounded by the maximum nesting depth and by the
+ * longest string or number that straddles chunks or contains escape
+ * sequences; other strings are reported in place, out of the chunk they were
+ * found in.
+ *
+ * Example:
+ *
+ *  class key_counter : public sneaker::json::json_sax_handler
+ *  {
+ *  public:
+ *    virtual void key(const char*, size_t) { ++count; }
+ *
+ *    size_t count = 0;
+ *  };
+ *
+ *  key_counter counter;
+ *
+ *  std::unique_ptr<sneaker::io::input_stream> stream =
+ *    sneaker::io::file_input_stream("large.json", 65536);
+ *
+ *  sneaker::json::parse_sax(stream.get(), &counter);
+ */
+
+#ifndef SNEAKER_JSON_SAX_H_
+#define SNEAKER_JSON_SAX_H_
+
+#include "io/input_stream.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+
+namespace sneaker {
+namespace json {
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Receives the events of a `json_sax_parser`. Every event does nothing by
+ * default. The bytes of keys and strings are unescaped but not
+ * null-terminated, and are only valid for the duration of the call.
+ */
+class json_sax_handler
+{
+public:
+  virtual ~json_sax_handler();
+
+  virtual void start_object() {}
+
+  virtual void end_object() {}
+
+  virtual void start_array() {}
+
+  virtual void end_array() {}
+
+  virtual void key(const char*, size_t) {}
+
+  virtual void string_value(const char*, size_t) {}
+
+  /**
+   * Called for numbers that `sneaker::json::parse()` represents as integers,
+   * which are those without a fraction nor an exponent and with at most 18
+   * digits.
+   */
+  virtual void int_value(int64_t) {}
+
+  virtual void number_value(double) {}
+
+  virtual void bool_value(bool) {}
+
+  virtual void null_value() {}
+};
+
+// -----------------------------------------------------------------------------
+
+class json_sax_parser
+{
+public:
+  /**
+   * Constructs a parser reporting to the specified handler, which must
+   * outlive it. If `multiple_values` is `true`, the input may contain any
+   * number of top-level values separated by whitespace, such as
+   * newline-delimited JSON, rather than exactly one.
+   */
+  explicit json_sax_parser(json_sax_handler* handler,
+    bool multiple_values=false);
+
+  json_sax_parser(const json_sax_parser&) = delete;
+  json_sax_parser& operator=(const json_sax_parser&) = delete;
+
+  /**
+   * Parses the next chunk of input, reporting every value completed by it.
+   *
+   * Throws `invalid_json_error` with the messages of `sneaker::json::parse()`
+   * as soon as the input is known to be invalid, after which every call
+   * throws the same error until the parser is reset.
+   */
+  void feed(const char* data, size_t size);
+
+  /**
+   * Signals the end of the input. Throws `invalid_json_error` if the input
+   * ends within a value, or if it holds no value and `multiple_values` is
+   * `false`.
+   */
+  void finish();
+
+  /**
+   * Discards the state of the parser, to parse a new input.
+   */
+  void reset();
+
+  /**
+   * Gets the number of bytes fed to the parser since it was last reset.
+   */
+  size_t bytes_parsed() const
+  {
+    return m_bytes_parsed;
+  }
+
+private:
+  enum class state : uint8_t
+  {
+    ROOT,
+    VALUE,
+    VALUE_OR_END_ARRAY,
+    KEY,
+    KEY_OR_END_OBJECT,
+    COLON,
+    COMMA_OR_END,
+    STRING,
+    ESCAPE,
+    UNICODE_ESCAPE,
+    NUMBER,
+    LITERAL,
+    DONE,
+    FAILED
+  };
+
+  /**
+   * The parts of a number, in the order of its grammar.
+   */
+  enum class number_part : uint8_t
+  {
+    START,
+    MINUS,
+    ZERO,
+    INTEGER,
+    FRACTION_START,
+    FRACTION,
+    EXPONENT_START,
+    EXPONENT_SIGN,
+    EXPONENT
+  };
+
+  [[noreturn]] void fail(const std::string& msg);
+
+  const char* parse_structural(const char* p);
+
+  const char* begin_value(const char* p);
+
+  void begin_string(bool in_key);
+
+  void end_value();
+
+  const char* parse_string(const char* p, const char* end);
+
+  const char* parse_escape(const char* p);
+
+  const char* parse_unicode_escape(const char* p, const char* end);
+
+  const char* parse_number(const char* p, const char* end);
+
+  void end_number();
+
+  const char* parse_literal(const char* p, const char* end);
+
+  void append_span(const char* p);
+
+  void flush_codepoint();
+
+  json_sax_handler* m_handler;
+  bool m_multiple_values;
+  state m_state;
+  number_part m_number_part;
+  bool m_in_key;
+  bool m_string_copied;
+  const char* m_span;
+  std::vector<char> m_containers;
+  std::string m_token;
+  const char* m_literal;
+  size_t m_literal_size;
+  char m_hex[5];
+  size_t m_hex_size;
+  long m_last_escaped_codepoint;
+  std::string m_error;
+  size_t m_bytes_parsed;
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Parses the input of the specified stream chunk by chunk, as returned by
+ * `io::input_stream::next()`, reporting its values to the handler.
+ */
+void parse_sax(io::input_stream* stream, json_sax_handler* handler,
+  bool multiple_values=false);
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace json */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_JSON_SAX_H_ */
@@ -0,0 +1,99 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::json::json_structural_index` is the first stage of the two-stage
+ * parsing of `sneaker::json::parse_indexed_document()`. It finds the positions
+ * in a JSON blob that the second stage needs to visit, so that the second
+ * stage never scans whitespace, nor the contents of strings.
+ *
+ * The input is classified 64 bytes at a time into bit masks of quotes,
+ * backslashes, whitespace, structural characters and control characters,
+ * using SSE2 instructions where available. Escaped characters are derived
+ * from the runs of backslashes, and the characters within strings from a
+ * prefix XOR of the unescaped quotes, with the state of both carried across
+ * blocks. The positions indexed are
+ *
+ *  - the structural characters `{`, `}`, `[`, `]`, `:` and `,` outside of
+ *    strings,
+ *  - the opening and closing quotes of every string, and
+ *  - the first character of every other run of characters outside of strings
+ *    that are neither whitespace nor structural, such as numbers, `true`,
+ *    `false` and `null`.
+ *
+ * Example:
+ *
+ *  sneaker::json::json_structural_index index;
+ *  index.build("{\"k\": [1, true]}", 16);
+ *
+ *  // {  "  "  :  [  1  ,  t  ]  }
+ *  assert(10 == index.positions().size());
+ */
+
+#ifndef SNEAKER_JSON_STRUCTURAL_INDEX_H_
+#define SNEAKER_JSON_STRUCTURAL_INDEX_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+
+namespace sneaker {
+namespace json {
+
+class json_structural_index
+{
+public:
+  json_structural_index();
+
+  /**
+   * Whether the input can be classified with SIMD instructions on the
+   * target the library was built for.
+   */
+  static bool simd_available();
+
+  /**
+   * Indexes the specified input, replacing any previous positions. The
+   * scalar classification is used if `use_simd` is `false` or if SIMD
+   * instructions are not available, and produces the same positions.
+   *
+   * Throws `invalid_json_error` if a string is not terminated or contains a
+   * control character, and `std::length_error` if the input does not fit
+   * 32-bit positions.
+   */
+  void build(const char* data, size_t size, bool use_simd=true);
+
+  const std::vector<uint32_t>& positions() const
+  {
+    return m_positions;
+  }
+
+private:
+  std::vector<uint32_t> m_positions;
+};
+
+} /* end namespace json */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_JSON_STRUCTURAL_INDEX_H_ */
@@ -0,0 +1,122 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::json::json_writer` serializes instances of `sneaker::json::JSON`,
+ * either compactly, without any whitespace, or pretty-printed, with every
+ * element and member on its own indented line.
+ *
+ * Unlike `JSON::dump()`, output is written into buffers obtained up front:
+ * a `std::string` is grown once to the estimated size of the output, and an
+ * `sneaker::io::output_stream` is written into directly, one buffer at a
+ * time. Strings are copied in runs between the characters that need escaping,
+ * which are found 16 bytes at a time where SSE2 is available. Integers are
+ * written exactly, and other numbers with the shortest digits that read back
+ * as the same double, generated with the Grisu2 algorithm. Numbers that are
+ * not finite are written as `null`, since JSON cannot represent them.
+ *
+ * Example:
+ *
+ *  sneaker::json::json_writer writer(sneaker::json::json_writer::style::PRETTY);
+ *
+ *  std::unique_ptr<sneaker::io::output_stream> stream =
+ *    sneaker::io::file_output_stream("out.json", 65536);
+ *
+ *  writer.write(json, stream.get());
+ *  stream->flush();
+ */
+
+#ifndef SNEAKER_JSON_WRITER_H_
+#define SNEAKER_JSON_WRITER_H_
+
+#include "io/output_stream.h"
+#include "json/json.h"
+
+#include <cstdlib>
+#include <string>
+
+
+namespace sneaker {
+namespace json {
+
+class json_writer
+{
+public:
+  enum class style
+  {
+    /**
+     * No whitespace is written between tokens.
+     */
+    COMPACT,
+
+    /**
+     * Every element of an array and member of an object is written on its
+     * own line, indented by `indent` spaces per level of nesting, and a space
+     * follows the colon after every key.
+     */
+    PRETTY
+  };
+
+  explicit json_writer(style layout=style::COMPACT, size_t indent=2);
+
+  style layout() const
+  {
+    return m_layout;
+  }
+
+  size_t indent() const
+  {
+    return m_indent;
+  }
+
+  /**
+   * Estimates the size of the output for the specified value, without
+   * escaping its strings or formatting its numbers. The estimate is exact
+   * for values without strings that need escaping or non-integral numbers.
+   */
+  size_t estimate_size(const JSON& json) const;
+
+  std::string write(const JSON& json) const;
+
+  /**
+   * Appends the output for the specified value to the string.
+   */
+  void write(const JSON& json, std::string* out) const;
+
+  /**
+   * Writes the output for the specified value to the stream, and backs up
+   * the part of the last buffer that was not written into, without flushing
+   * the stream. Returns `false` if the stream ran out of buffers.
+   */
+  bool write(const JSON& json, io::output_stream* stream) const;
+
+private:
+  style m_layout;
+  size_t m_indent;
+};
+
+} /* end namespace json */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_JSON_WRITER_H_ */
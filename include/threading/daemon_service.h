@@ -41,6 +41,8 @@ protected:
 
   virtual void handle() = 0;
 
+  void join();
+
   pthread_attr_t m_attr;
   pthread_t m_thread_id;
 
@@ -48,6 +50,7 @@ private:
   void init();
 
   bool m_wait_for_termination;
+  bool m_joinable;
 };
 
 } /* end namespace threading */
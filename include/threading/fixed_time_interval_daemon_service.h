@@ -40,6 +40,13 @@ public:
   fixed_time_interval_daemon_service(uint32_t, ExternalHandler,
     bool=false, int32_t=INT_MAX);
 
+  /**
+   * Same as above, except that the handler is invoked with the specified
+   * argument, instead of the internal state of the service.
+   */
+  fixed_time_interval_daemon_service(uint32_t, ExternalHandler, void*,
+    bool=false, int32_t=INT_MAX);
+
   virtual ~fixed_time_interval_daemon_service();
 
   size_t interval() const;
@@ -0,0 +1,130 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::threading::parallel_for` invokes a function on every item of a
+ * range of indices, spread over a number of threads.
+ *
+ * The threads claim consecutive blocks of `grain` items from a shared
+ * counter until the range is exhausted, which balances uneven work across
+ * threads without any per-item coordination. The calling thread takes part
+ * in the work, and no more threads are started than there are blocks.
+ *
+ * The function is invoked as `fn(item, thread)`, where `thread` is the
+ * ordinal of the invoking thread in `[0, thread_count)`, which lets callers
+ * keep per-thread state without synchronization.
+ *
+ * The threads are either started and joined by each call, or taken from a
+ * `sneaker::threading::worker_pool`, which suits callers that loop over many
+ * short ranges, such as the levels of a traversal.
+ *
+ * Example:
+ *
+ *  std::vector<std::vector<size_t>> buckets(thread_count);
+ *
+ *  sneaker::threading::parallel_for(thread_count, items.size(), 1024,
+ *    [&](size_t item, size_t thread) {
+ *      if (keep(items[item]))
+ *      {
+ *        buckets[thread].push_back(item);
+ *      }
+ *    }
+ *  );
+ */
+
+#ifndef SNEAKER_THREADING_PARALLEL_FOR_H_
+#define SNEAKER_THREADING_PARALLEL_FOR_H_
+
+#include "threading/worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+
+namespace sneaker {
+namespace threading {
+
+/**
+ * Invokes `fn(item, thread)` on every item in `[0, count)`, on the calling
+ * thread and the threads of the specified pool, so up to
+ * `pool.thread_count() + 1` threads.
+ */
+template<class Fn>
+void
+parallel_for(worker_pool& pool, size_t count, size_t grain, const Fn& fn)
+{
+  grain = std::max<size_t>(grain, 1);
+
+  const size_t workers = std::min(pool.thread_count() + 1,
+    (count + grain - 1) / grain);
+
+  std::atomic<size_t> next(0);
+
+  auto run = [&next, &fn, count, grain](size_t thread) {
+    for (;;)
+    {
+      const size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+      if (begin >= count)
+      {
+        break;
+      }
+
+      const size_t end = std::min(begin + grain, count);
+      for (size_t item = begin; item < end; ++item)
+      {
+        fn(item, thread);
+      }
+    }
+  };
+
+  if (workers <= 1)
+  {
+    run(0);
+    return;
+  }
+
+  pool.run(workers, run);
+}
+
+/**
+ * Same as above, on up to `thread_count` threads, which are started and
+ * joined by the call.
+ */
+template<class Fn>
+void
+parallel_for(size_t thread_count, size_t count, size_t grain, const Fn& fn)
+{
+  grain = std::max<size_t>(grain, 1);
+
+  const size_t workers = std::min(thread_count, (count + grain - 1) / grain);
+
+  worker_pool pool(workers > 1 ? workers - 1 : 0);
+  parallel_for(pool, count, grain, fn);
+}
+
+} /* end namespace threading */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_THREADING_PARALLEL_FOR_H_ */
@@ -0,0 +1,125 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/**
+ * `sneaker::threading::worker_pool` keeps a fixed set of threads that run
+ * tasks handed to them in rounds, so that algorithms that fork and join many
+ * times, such as once per level of a traversal, only start their threads
+ * once.
+ *
+ * A round is started by `start()`, which wakes up a number of the threads to
+ * invoke the same task with distinct ordinals, and returns right away so that
+ * the calling thread can do other work in the meantime. `wait()` blocks until
+ * the round is over. `run()` starts a round in which the calling thread takes
+ * part as well, and waits for it.
+ *
+ * Rounds are started by a single thread, one at a time.
+ *
+ * Example:
+ *
+ *  sneaker::threading::worker_pool pool(3);
+ *
+ *  for (auto& level : levels)
+ *  {
+ *    pool.run(4, [&level](size_t thread) {
+ *      process(level, thread);
+ *    });
+ *  }
+ */
+
+#ifndef SNEAKER_THREADING_WORKER_POOL_H_
+#define SNEAKER_THREADING_WORKER_POOL_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace sneaker {
+namespace threading {
+
+class worker_pool {
+public:
+  typedef std::function<void(size_t)> task_type;
+
+  /**
+   * Starts the specified number of threads, which wait for rounds.
+   */
+  explicit worker_pool(size_t thread_count);
+
+  /**
+   * Waits for the current round, if any, and stops the threads.
+   */
+  ~worker_pool();
+
+  worker_pool(const worker_pool&) = delete;
+  worker_pool& operator=(const worker_pool&) = delete;
+
+  size_t thread_count() const;
+
+  /**
+   * Starts a round in which up to `workers` threads of the pool invoke
+   * `task(first + i)`, with distinct `i` in `[0, workers)`. The previous round
+   * must be over.
+   */
+  void start(size_t workers, const task_type& task, size_t first=0);
+
+  /**
+   * Blocks until the current round is over. Rethrows the first exception
+   * thrown by the task during the round, if any.
+   */
+  void wait();
+
+  /**
+   * Invokes `task(thread)` on up to `workers` threads, the calling thread
+   * included as thread 0, and the threads of the pool as the others, and
+   * waits for all of them to return.
+   */
+  void run(size_t workers, const task_type& task);
+
+private:
+  void work(size_t index);
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_idle;
+  task_type m_task;
+  size_t m_workers;
+  size_t m_first;
+  size_t m_running;
+  uint64_t m_round;
+  bool m_stopping;
+  std::exception_ptr m_error;
+};
+
+} /* end namespace threading */
+} /* end namespace sneaker */
+
+
+#endif /* SNEAKER_THREADING_WORKER_POOL_H_ */
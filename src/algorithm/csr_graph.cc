@@ -0,0 +1,158 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "algorithm/csr_graph.h"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace sneaker {
+
+
+namespace algorithm {
+
+
+// -----------------------------------------------------------------------------
+
+csr_graph::csr_graph()
+  :
+  m_offsets(1, 0),
+  m_targets()
+{
+}
+
+// -----------------------------------------------------------------------------
+
+csr_graph::csr_graph(std::vector<size_t> offsets,
+  std::vector<vertex_id> targets)
+  :
+  m_offsets(std::move(offsets)),
+  m_targets(std::move(targets))
+{
+  if (m_offsets.empty() || m_offsets.front() != 0 ||
+      m_offsets.back() != m_targets.size())
+  {
+    throw std::invalid_argument("Inconsistent CSR arrays");
+  }
+
+  for (size_t i = 1; i < m_offsets.size(); ++i)
+  {
+    if (m_offsets[i] < m_offsets[i - 1])
+    {
+      throw std::invalid_argument("Inconsistent CSR arrays");
+    }
+  }
+
+  const size_t count = vertex_count();
+
+  for (const vertex_id target : m_targets)
+  {
+    if (target >= count)
+    {
+      throw std::invalid_argument("Inconsistent CSR arrays");
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+csr_graph
+csr_graph::from_edges(size_t vertex_count, const std::vector<edge>& edges)
+{
+  std::vector<size_t> offsets(vertex_count + 1, 0);
+
+  for (const edge& e : edges)
+  {
+    if (e.first >= vertex_count || e.second >= vertex_count)
+    {
+      throw std::out_of_range("Edge refers to a vertex out of range");
+    }
+
+    ++offsets[e.first + 1];
+  }
+
+  for (size_t i = 1; i <= vertex_count; ++i)
+  {
+    offsets[i] += offsets[i - 1];
+  }
+
+  std::vector<vertex_id> targets(edges.size());
+  std::vector<size_t> positions(offsets.begin(), offsets.end() - 1);
+
+  for (const edge& e : edges)
+  {
+    targets[positions[e.first]++] = e.second;
+  }
+
+  csr_graph graph;
+  graph.m_offsets = std::move(offsets);
+  graph.m_targets = std::move(targets);
+
+  return graph;
+}
+
+// -----------------------------------------------------------------------------
+
+csr_graph
+csr_graph::transpose() const
+{
+  const size_t count = vertex_count();
+
+  std::vector<size_t> offsets(count + 1, 0);
+
+  for (const vertex_id target : m_targets)
+  {
+    ++offsets[target + 1];
+  }
+
+  for (size_t i = 1; i <= count; ++i)
+  {
+    offsets[i] += offsets[i - 1];
+  }
+
+  std::vector<vertex_id> targets(m_targets.size());
+  std::vector<size_t> positions(offsets.begin(), offsets.end() - 1);
+
+  for (vertex_id source = 0; source < count; ++source)
+  {
+    for (size_t i = m_offsets[source]; i < m_offsets[source + 1]; ++i)
+    {
+      targets[positions[m_targets[i]]++] = source;
+    }
+  }
+
+  csr_graph graph;
+  graph.m_offsets = std::move(offsets);
+  graph.m_targets = std::move(targets);
+
+  return graph;
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace algorithm */
+
+
+} /* end namespace sneaker */
@@ -0,0 +1,293 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "algorithm/dag.h"
+
+#include "algorithm/csr_graph.h"
+#include "algorithm/iterative_tarjan.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace sneaker {
+
+
+namespace algorithm {
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+typedef csr_graph::vertex_id vertex_id;
+
+const vertex_id NONE = UINT32_MAX;
+
+void
+topological_sort_or_throw(const csr_graph& dag, std::vector<vertex_id>* order)
+{
+  if (!topological_sort(dag, order))
+  {
+    throw std::invalid_argument("Graph has a cycle");
+  }
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+csr_graph
+condensation(const csr_graph& graph, std::vector<vertex_id>* labels)
+{
+  iterative_tarjan algo;
+  const size_t count = algo.label_components(graph, labels);
+
+  // Components are completed in reverse topological order.
+  for (vertex_id& label : *labels)
+  {
+    label = static_cast<vertex_id>(count - 1 - label);
+  }
+
+  std::vector<csr_graph::edge> edges;
+
+  for (vertex_id source = 0; source < graph.vertex_count(); ++source)
+  {
+    for (auto itr = graph.neighbors_begin(source);
+      itr != graph.neighbors_end(source); ++itr)
+    {
+      const vertex_id from = (*labels)[source];
+      const vertex_id to = (*labels)[*itr];
+
+      if (from != to)
+      {
+        edges.push_back(csr_graph::edge(from, to));
+      }
+    }
+  }
+
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+  return csr_graph::from_edges(count, edges);
+}
+
+// -----------------------------------------------------------------------------
+
+bool
+topological_sort(const csr_graph& graph, std::vector<vertex_id>* order)
+{
+  const size_t vertex_count = graph.vertex_count();
+
+  std::vector<vertex_id> in_degrees(vertex_count, 0);
+  for (const vertex_id target : graph.targets())
+  {
+    ++in_degrees[target];
+  }
+
+  order->clear();
+  order->reserve(vertex_count);
+
+  for (vertex_id vertex = 0; vertex < vertex_count; ++vertex)
+  {
+    if (in_degrees[vertex] == 0)
+    {
+      order->push_back(vertex);
+    }
+  }
+
+  // The order doubles as the queue of vertices whose predecessors are all
+  // placed.
+  for (size_t i = 0; i < order->size(); ++i)
+  {
+    const vertex_id vertex = (*order)[i];
+
+    for (auto itr = graph.neighbors_begin(vertex);
+      itr != graph.neighbors_end(vertex); ++itr)
+    {
+      if (--in_degrees[*itr] == 0)
+      {
+        order->push_back(*itr);
+      }
+    }
+  }
+
+  return order->size() == vertex_count;
+}
+
+// -----------------------------------------------------------------------------
+
+uint64_t
+critical_path_length(const csr_graph& dag, const std::vector<uint64_t>& weights,
+  std::vector<vertex_id>* path)
+{
+  const size_t vertex_count = dag.vertex_count();
+
+  if (!weights.empty() && weights.size() != vertex_count)
+  {
+    throw std::invalid_argument("Number of weights mismatches vertices");
+  }
+
+  std::vector<vertex_id> order;
+  topological_sort_or_throw(dag, &order);
+
+  // The heaviest path ending at each vertex, and the vertex before it.
+  std::vector<uint64_t> lengths(vertex_count, 0);
+  std::vector<vertex_id> predecessors(vertex_count, NONE);
+
+  uint64_t longest = 0;
+  vertex_id last = NONE;
+
+  for (const vertex_id vertex : order)
+  {
+    lengths[vertex] += weights.empty() ? 1 : weights[vertex];
+
+    if (last == NONE || lengths[vertex] > longest)
+    {
+      longest = lengths[vertex];
+      last = vertex;
+    }
+
+    for (auto itr = dag.neighbors_begin(vertex);
+      itr != dag.neighbors_end(vertex); ++itr)
+    {
+      if (predecessors[*itr] == NONE || lengths[vertex] > lengths[*itr])
+      {
+        lengths[*itr] = lengths[vertex];
+        predecessors[*itr] = vertex;
+      }
+    }
+  }
+
+  if (path)
+  {
+    path->clear();
+
+    for (vertex_id vertex = last; vertex != NONE; vertex = predecessors[vertex])
+    {
+      path->push_back(vertex);
+    }
+
+    std::reverse(path->begin(), path->end());
+  }
+
+  return longest;
+}
+
+// -----------------------------------------------------------------------------
+
+csr_graph
+transitive_reduction(const csr_graph& dag)
+{
+  const size_t vertex_count = dag.vertex_count();
+
+  std::vector<vertex_id> order;
+  topological_sort_or_throw(dag, &order);
+
+  std::vector<vertex_id> positions(vertex_count);
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    positions[order[i]] = static_cast<vertex_id>(i);
+  }
+
+  // `reached[v] == u` once `v` is known to be reachable from `u`, and
+  // `kept[v] == u` while the edge from `u` to `v` is to be kept.
+  std::vector<vertex_id> reached(vertex_count, NONE);
+  std::vector<vertex_id> kept(vertex_count, NONE);
+  std::vector<vertex_id> successors;
+  std::vector<vertex_id> pending;
+
+  std::vector<size_t> offsets(1, 0);
+  std::vector<vertex_id> targets;
+
+  for (vertex_id source = 0; source < vertex_count; ++source)
+  {
+    successors.assign(dag.neighbors_begin(source), dag.neighbors_end(source));
+
+    // A successor is redundant iff another successor reaches it, which then
+    // comes earlier in topological order.
+    std::sort(successors.begin(), successors.end(),
+      [&positions](vertex_id a, vertex_id b) {
+        return positions[a] < positions[b];
+      }
+    );
+
+    // Vertices past the last successor in topological order cannot lead
+    // back to one, which confines the searches to a window of the order.
+    const vertex_id bound =
+      successors.empty() ? 0 : positions[successors.back()];
+
+    for (const vertex_id successor : successors)
+    {
+      if (reached[successor] == source)
+      {
+        continue;
+      }
+
+      reached[successor] = source;
+      kept[successor] = source;
+
+      pending.push_back(successor);
+
+      while (!pending.empty())
+      {
+        const vertex_id vertex = pending.back();
+        pending.pop_back();
+
+        for (auto itr = dag.neighbors_begin(vertex);
+          itr != dag.neighbors_end(vertex); ++itr)
+        {
+          if (reached[*itr] != source && positions[*itr] <= bound)
+          {
+            reached[*itr] = source;
+            pending.push_back(*itr);
+          }
+        }
+      }
+    }
+
+    for (auto itr = dag.neighbors_begin(source);
+      itr != dag.neighbors_end(source); ++itr)
+    {
+      if (kept[*itr] == source)
+      {
+        targets.push_back(*itr);
+        kept[*itr] = NONE;
+      }
+    }
+
+    offsets.push_back(targets.size());
+  }
+
+  return csr_graph(std::move(offsets), std::move(targets));
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace algorithm */
+
+
+} /* end namespace sneaker */
@@ -0,0 +1,489 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "algorithm/incremental_scc.h"
+
+#include "algorithm/csr_graph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace sneaker {
+
+
+namespace algorithm {
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const uint8_t FORWARD = 1;
+const uint8_t BACKWARD = 2;
+
+const incremental_scc::vertex_id NONE = UINT32_MAX;
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+incremental_scc::incremental_scc()
+  :
+  m_parents(),
+  m_members(),
+  m_out_edges(),
+  m_in_edges(),
+  m_compacted_out(),
+  m_compacted_in(),
+  m_positions(),
+  m_order(),
+  m_marks(),
+  m_component_count(0),
+  m_holes(0)
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+incremental_scc::incremental_scc(size_t vertex_count)
+  :
+  incremental_scc()
+{
+  for (size_t i = 0; i < vertex_count; ++i)
+  {
+    add_vertex();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+incremental_scc::vertex_id
+incremental_scc::add_vertex()
+{
+  if (m_parents.size() >= NONE)
+  {
+    throw std::length_error("Graph has too many vertices");
+  }
+
+  const vertex_id vertex = static_cast<vertex_id>(m_parents.size());
+
+  m_parents.push_back(vertex);
+  m_members.push_back(std::vector<vertex_id>(1, vertex));
+  m_out_edges.push_back(std::vector<vertex_id>());
+  m_in_edges.push_back(std::vector<vertex_id>());
+  m_compacted_out.push_back(0);
+  m_compacted_in.push_back(0);
+  m_positions.push_back(m_order.size());
+  m_order.push_back(vertex);
+  m_marks.push_back(0);
+
+  ++m_component_count;
+
+  return vertex;
+}
+
+// -----------------------------------------------------------------------------
+
+bool
+incremental_scc::add_edge(vertex_id source, vertex_id target)
+{
+  check_vertex(source);
+  check_vertex(target);
+
+  const vertex_id source_component = component(source);
+  const vertex_id target_component = component(target);
+
+  if (source_component == target_component)
+  {
+    return false;
+  }
+
+  m_out_edges[source_component].push_back(target);
+  m_in_edges[target_component].push_back(source);
+
+  const size_t lower = m_positions[target_component];
+  const size_t upper = m_positions[source_component];
+
+  if (upper < lower)
+  {
+    return false;
+  }
+
+  // Every path from the target back to the source runs through components
+  // between the two in the current order.
+  std::vector<vertex_id> forward;
+  search(target_component, m_out_edges, FORWARD, lower, upper, &forward);
+
+  std::vector<vertex_id> backward;
+  search(source_component, m_in_edges, BACKWARD, lower, upper, &backward);
+
+  const bool cycle = (m_marks[source_component] & FORWARD) != 0;
+
+  vertex_id merged = NONE;
+
+  if (cycle)
+  {
+    std::vector<vertex_id> components;
+    for (const vertex_id c : forward)
+    {
+      if (m_marks[c] & BACKWARD)
+      {
+        components.push_back(c);
+      }
+    }
+
+    merged = merge(components);
+  }
+
+  reorder(&backward, merged, &forward);
+
+  return cycle;
+}
+
+// -----------------------------------------------------------------------------
+
+incremental_scc::vertex_id
+incremental_scc::component(vertex_id vertex) const
+{
+  check_vertex(vertex);
+
+  while (m_parents[vertex] != vertex)
+  {
+    m_parents[vertex] = m_parents[m_parents[vertex]];
+    vertex = m_parents[vertex];
+  }
+
+  return vertex;
+}
+
+// -----------------------------------------------------------------------------
+
+std::vector<incremental_scc::vertex_id>
+incremental_scc::topological_order() const
+{
+  std::vector<vertex_id> order;
+  order.reserve(m_component_count);
+
+  for (const vertex_id c : m_order)
+  {
+    if (c != NONE)
+    {
+      order.push_back(c);
+    }
+  }
+
+  return order;
+}
+
+// -----------------------------------------------------------------------------
+
+csr_graph
+incremental_scc::condensation(std::vector<vertex_id>* labels) const
+{
+  const std::vector<vertex_id> order = topological_order();
+
+  std::vector<vertex_id> numbers(m_parents.size(), NONE);
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    numbers[order[i]] = static_cast<vertex_id>(i);
+  }
+
+  labels->resize(m_parents.size());
+  for (vertex_id vertex = 0; vertex < m_parents.size(); ++vertex)
+  {
+    (*labels)[vertex] = numbers[component(vertex)];
+  }
+
+  std::vector<csr_graph::edge> edges;
+
+  for (const vertex_id c : order)
+  {
+    for (const vertex_id target : m_out_edges[c])
+    {
+      const vertex_id target_number = (*labels)[target];
+
+      if (target_number != numbers[c])
+      {
+        edges.push_back(csr_graph::edge(numbers[c], target_number));
+      }
+    }
+  }
+
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+  return csr_graph::from_edges(order.size(), edges);
+}
+
+// -----------------------------------------------------------------------------
+
+void
+incremental_scc::check_vertex(vertex_id vertex) const
+{
+  if (vertex >= m_parents.size())
+  {
+    throw std::out_of_range("Vertex out of range");
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void
+incremental_scc::search(vertex_id start,
+  const std::vector<std::vector<vertex_id>>& edges, uint8_t mark,
+  size_t lower, size_t upper, std::vector<vertex_id>* visited)
+{
+  m_marks[start] |= mark;
+  visited->push_back(start);
+
+  std::vector<vertex_id> pending(1, start);
+
+  while (!pending.empty())
+  {
+    const vertex_id c = pending.back();
+    pending.pop_back();
+
+    for (const vertex_id vertex : edges[c])
+    {
+      const vertex_id next = component(vertex);
+
+      if ((m_marks[next] & mark) || m_positions[next] < lower ||
+          m_positions[next] > upper)
+      {
+        continue;
+      }
+
+      m_marks[next] |= mark;
+      visited->push_back(next);
+      pending.push_back(next);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+incremental_scc::vertex_id
+incremental_scc::merge(const std::vector<vertex_id>& components)
+{
+  vertex_id root = components.front();
+  for (const vertex_id c : components)
+  {
+    if (m_members[c].size() > m_members[root].size())
+    {
+      root = c;
+    }
+  }
+
+  for (const vertex_id c : components)
+  {
+    if (c == root)
+    {
+      continue;
+    }
+
+    m_parents[c] = root;
+
+    absorb(&m_members[root], &m_members[c]);
+    absorb(&m_out_edges[root], &m_out_edges[c]);
+    absorb(&m_in_edges[root], &m_in_edges[c]);
+
+    m_compacted_out[root] += m_compacted_out[c];
+    m_compacted_in[root] += m_compacted_in[c];
+  }
+
+  // The edges that became internal or redundant are left in place, as they
+  // are skipped when traversed, until the lists have doubled since they were
+  // last compacted.
+  if (m_out_edges[root].size() > 2 * m_compacted_out[root])
+  {
+    m_compacted_out[root] = compact_edges(root, &m_out_edges[root]);
+  }
+
+  if (m_in_edges[root].size() > 2 * m_compacted_in[root])
+  {
+    m_compacted_in[root] = compact_edges(root, &m_in_edges[root]);
+  }
+
+  m_component_count -= components.size() - 1;
+
+  return root;
+}
+
+// -----------------------------------------------------------------------------
+
+void
+incremental_scc::absorb(std::vector<vertex_id>* into,
+  std::vector<vertex_id>* from)
+{
+  // Appends the shorter list to the longer one.
+  if (into->size() < from->size())
+  {
+    into->swap(*from);
+  }
+
+  into->insert(into->end(), from->begin(), from->end());
+
+  std::vector<vertex_id>().swap(*from);
+}
+
+// -----------------------------------------------------------------------------
+
+size_t
+incremental_scc::compact_edges(vertex_id root, std::vector<vertex_id>* edges)
+{
+  // Drops the edges within the component, and keeps a single edge to each
+  // other component.
+  for (vertex_id& vertex : *edges)
+  {
+    vertex = component(vertex);
+  }
+
+  std::sort(edges->begin(), edges->end());
+  edges->erase(std::unique(edges->begin(), edges->end()), edges->end());
+  edges->erase(std::remove(edges->begin(), edges->end(), root),
+    edges->end());
+
+  return edges->size();
+}
+
+// -----------------------------------------------------------------------------
+
+void
+incremental_scc::reorder(std::vector<vertex_id>* backward, vertex_id merged,
+  std::vector<vertex_id>* forward)
+{
+  // The positions of all the components visited, merged ones included, are
+  // reassigned among themselves.
+  std::vector<vertex_id> visited(*forward);
+
+  for (const vertex_id c : *backward)
+  {
+    if (!(m_marks[c] & FORWARD))
+    {
+      visited.push_back(c);
+    }
+  }
+
+  std::vector<size_t> positions;
+  positions.reserve(visited.size());
+
+  for (const vertex_id c : visited)
+  {
+    positions.push_back(m_positions[c]);
+  }
+
+  std::sort(positions.begin(), positions.end());
+
+  // Components on the new cycle are replaced by the merged component.
+  auto on_cycle = [this](vertex_id c) {
+    return m_marks[c] == (FORWARD | BACKWARD);
+  };
+
+  auto by_position = [this](vertex_id a, vertex_id b) {
+    return m_positions[a] < m_positions[b];
+  };
+
+  forward->erase(std::remove_if(forward->begin(), forward->end(), on_cycle),
+    forward->end());
+  backward->erase(std::remove_if(backward->begin(), backward->end(), on_cycle),
+    backward->end());
+
+  for (const vertex_id c : visited)
+  {
+    m_marks[c] = 0;
+  }
+
+  std::sort(backward->begin(), backward->end(), by_position);
+  std::sort(forward->begin(), forward->end(), by_position);
+
+  for (const size_t position : positions)
+  {
+    m_order[position] = NONE;
+  }
+
+  // Components that reach the source take the lowest positions and those
+  // reached from the target the highest ones, so that none moves past a
+  // component outside of the searches.
+  size_t next = 0;
+
+  auto place = [this, &positions](vertex_id c, size_t index) {
+    m_positions[c] = positions[index];
+    m_order[positions[index]] = c;
+  };
+
+  for (const vertex_id c : *backward)
+  {
+    place(c, next++);
+  }
+
+  if (merged != NONE)
+  {
+    place(merged, next++);
+  }
+
+  const size_t first_forward = positions.size() - forward->size();
+
+  m_holes += first_forward - next;
+
+  for (size_t i = 0; i < forward->size(); ++i)
+  {
+    place((*forward)[i], first_forward + i);
+  }
+
+  if (m_holes > m_order.size() / 2)
+  {
+    compact_order();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void
+incremental_scc::compact_order()
+{
+  size_t next = 0;
+
+  for (const vertex_id c : m_order)
+  {
+    if (c != NONE)
+    {
+      m_positions[c] = next;
+      m_order[next++] = c;
+    }
+  }
+
+  m_order.resize(next);
+  m_holes = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace algorithm */
+
+
+} /* end namespace sneaker */
@@ -0,0 +1,119 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "algorithm/iterative_tarjan.h"
+
+#include "algorithm/csr_graph.h"
+
+#include <stdexcept>
+#include <vector>
+
+
+namespace sneaker {
+
+
+namespace algorithm {
+
+
+// -----------------------------------------------------------------------------
+
+constexpr iterative_tarjan::vertex_id iterative_tarjan::UNVISITED;
+
+// -----------------------------------------------------------------------------
+
+iterative_tarjan::iterative_tarjan()
+  :
+  m_next_index(0),
+  m_index(),
+  m_lowlink(),
+  m_on_stack(),
+  m_stack(),
+  m_frames(),
+  m_component()
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+size_t
+iterative_tarjan::label_components(const csr_graph& graph,
+  std::vector<vertex_id>* labels)
+{
+  labels->assign(graph.vertex_count(), 0);
+
+  vertex_id label = 0;
+
+  return for_each_component(graph,
+    [labels, &label](const std::vector<vertex_id>& component) {
+      for (const vertex_id vertex : component)
+      {
+        (*labels)[vertex] = label;
+      }
+
+      ++label;
+    }
+  );
+}
+
+// -----------------------------------------------------------------------------
+
+void
+iterative_tarjan::reset(size_t vertex_count)
+{
+  if (vertex_count >= UNVISITED)
+  {
+    throw std::length_error("Graph has too many vertices");
+  }
+
+  m_next_index = 0;
+  m_index.assign(vertex_count, UNVISITED);
+  m_lowlink.assign(vertex_count, UNVISITED);
+  m_on_stack.assign((vertex_count + 63) / 64, 0);
+  m_stack.clear();
+  m_frames.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+void
+iterative_tarjan::visit(const csr_graph& graph, vertex_id vertex)
+{
+  m_index[vertex] = m_next_index;
+  m_lowlink[vertex] = m_next_index;
+
+  ++m_next_index;
+
+  m_stack.push_back(vertex);
+  set_on_stack(vertex);
+
+  const frame entry = { vertex, graph.offsets()[vertex] };
+  m_frames.push_back(entry);
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace algorithm */
+
+
+} /* end namespace sneaker */
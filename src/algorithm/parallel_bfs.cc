@@ -0,0 +1,305 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "algorithm/parallel_bfs.h"
+
+#include "algorithm/csr_graph.h"
+#include "threading/parallel_for.h"
+#include "threading/worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+namespace sneaker {
+
+
+namespace algorithm {
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+using sneaker::threading::parallel_for;
+using sneaker::threading::worker_pool;
+
+typedef csr_graph::vertex_id vertex_id;
+
+/**
+ * The number of frontier vertices claimed at once by each thread in the
+ * top-down steps, which is kept small as their degrees vary widely.
+ */
+const size_t TOP_DOWN_GRAIN = 64;
+
+/**
+ * The number of bitset words claimed at once by each thread in the
+ * bottom-up steps, 64 vertices each.
+ */
+const size_t BOTTOM_UP_GRAIN = 16;
+
+const size_t GRAIN = 1024;
+
+const size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * The vertices visited by a thread during a step, and their out-degrees.
+ * The padding keeps the state of different threads on different cache
+ * lines, as a vector cannot hold over-aligned types before C++17.
+ */
+struct thread_state
+{
+  std::vector<vertex_id> bucket;
+  size_t visited_count;
+  size_t visited_edges;
+  char padding[CACHE_LINE_SIZE];
+};
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+constexpr parallel_bfs::vertex_id parallel_bfs::UNREACHED;
+constexpr size_t parallel_bfs::ALPHA;
+constexpr size_t parallel_bfs::BETA;
+
+// -----------------------------------------------------------------------------
+
+parallel_bfs::parallel_bfs(size_t thread_count)
+  :
+  m_thread_count(thread_count),
+  m_bottom_up_levels(0)
+{
+  if (m_thread_count == 0)
+  {
+    m_thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+size_t
+parallel_bfs::run(const csr_graph& graph, const csr_graph& transpose,
+  vertex_id source, std::vector<vertex_id>* distances)
+{
+  const size_t vertex_count = graph.vertex_count();
+
+  if (source >= vertex_count)
+  {
+    throw std::out_of_range("Source vertex out of range");
+  }
+
+  if (transpose.vertex_count() != vertex_count ||
+      transpose.edge_count() != graph.edge_count())
+  {
+    throw std::invalid_argument("Transpose mismatches graph");
+  }
+
+  // The threads are started once, rather than for every step.
+  worker_pool pool(m_thread_count - 1);
+
+  // Written concurrently by the top-down steps, which race to claim the
+  // vertices on the next level.
+  std::unique_ptr<std::atomic<vertex_id>[]> levels(
+    new std::atomic<vertex_id>[vertex_count]);
+
+  parallel_for(pool, vertex_count, GRAIN,
+    [&levels](size_t vertex, size_t) {
+      levels[vertex].store(UNREACHED, std::memory_order_relaxed);
+    }
+  );
+
+  levels[source].store(0, std::memory_order_relaxed);
+
+  const size_t word_count = (vertex_count + 63) / 64;
+
+  std::vector<vertex_id> frontier(1, source);
+  std::vector<uint64_t> frontier_bits(word_count, 0);
+  std::vector<uint64_t> next_bits(word_count, 0);
+
+  std::vector<thread_state> states(m_thread_count);
+  for (auto& state : states)
+  {
+    state.visited_count = 0;
+    state.visited_edges = 0;
+  }
+
+  size_t frontier_size = 1;
+  size_t frontier_edges = graph.degree(source);
+  size_t unexplored_edges = graph.edge_count() - frontier_edges;
+  size_t reached = 1;
+  bool bottom_up = false;
+  vertex_id level = 0;
+
+  m_bottom_up_levels = 0;
+
+  while (frontier_size)
+  {
+    if (!bottom_up && frontier_edges > unexplored_edges / ALPHA)
+    {
+      std::fill(frontier_bits.begin(), frontier_bits.end(), 0);
+
+      for (const vertex_id vertex : frontier)
+      {
+        frontier_bits[vertex >> 6] |= uint64_t(1) << (vertex & 63);
+      }
+
+      bottom_up = true;
+    }
+    else if (bottom_up && frontier_size < vertex_count / BETA)
+    {
+      parallel_for(pool, word_count, BOTTOM_UP_GRAIN,
+        [&frontier_bits, &states](size_t word, size_t thread) {
+          for (uint64_t bits = frontier_bits[word]; bits; bits &= bits - 1)
+          {
+            states[thread].bucket.push_back(static_cast<vertex_id>(
+              word * 64 + static_cast<size_t>(__builtin_ctzll(bits))));
+          }
+        }
+      );
+
+      frontier.clear();
+      for (auto& state : states)
+      {
+        frontier.insert(frontier.end(), state.bucket.begin(),
+          state.bucket.end());
+        state.bucket.clear();
+      }
+
+      bottom_up = false;
+    }
+
+    const vertex_id next = level + 1;
+
+    if (bottom_up)
+    {
+      // Every word of the next frontier is written by the single thread
+      // that claims the vertices it covers.
+      parallel_for(pool, word_count, BOTTOM_UP_GRAIN,
+        [&](size_t word, size_t thread) {
+          uint64_t bits = 0;
+
+          const size_t end = std::min(word * 64 + 64, vertex_count);
+
+          for (size_t vertex = word * 64; vertex < end; ++vertex)
+          {
+            if (levels[vertex].load(std::memory_order_relaxed) != UNREACHED)
+            {
+              continue;
+            }
+
+            const vertex_id id = static_cast<vertex_id>(vertex);
+
+            for (auto itr = transpose.neighbors_begin(id);
+              itr != transpose.neighbors_end(id); ++itr)
+            {
+              if ((frontier_bits[*itr >> 6] >> (*itr & 63)) & 1)
+              {
+                levels[vertex].store(next, std::memory_order_relaxed);
+                bits |= uint64_t(1) << (vertex & 63);
+                ++states[thread].visited_count;
+                states[thread].visited_edges += graph.degree(id);
+                break;
+              }
+            }
+          }
+
+          next_bits[word] = bits;
+        }
+      );
+
+      frontier_bits.swap(next_bits);
+
+      ++m_bottom_up_levels;
+    }
+    else
+    {
+      parallel_for(pool, frontier.size(), TOP_DOWN_GRAIN,
+        [&](size_t item, size_t thread) {
+          const vertex_id vertex = frontier[item];
+
+          for (auto itr = graph.neighbors_begin(vertex);
+            itr != graph.neighbors_end(vertex); ++itr)
+          {
+            vertex_id expected = UNREACHED;
+
+            if (levels[*itr].load(std::memory_order_relaxed) == UNREACHED &&
+                levels[*itr].compare_exchange_strong(expected, next,
+                  std::memory_order_relaxed))
+            {
+              thread_state& state = states[thread];
+              state.bucket.push_back(*itr);
+              ++state.visited_count;
+              state.visited_edges += graph.degree(*itr);
+            }
+          }
+        }
+      );
+
+      frontier.clear();
+      for (auto& state : states)
+      {
+        frontier.insert(frontier.end(), state.bucket.begin(),
+          state.bucket.end());
+        state.bucket.clear();
+      }
+    }
+
+    frontier_size = 0;
+    frontier_edges = 0;
+
+    for (auto& state : states)
+    {
+      frontier_size += state.visited_count;
+      frontier_edges += state.visited_edges;
+      state.visited_count = 0;
+      state.visited_edges = 0;
+    }
+
+    unexplored_edges -= frontier_edges;
+    reached += frontier_size;
+    level = next;
+  }
+
+  distances->resize(vertex_count);
+
+  parallel_for(pool, vertex_count, GRAIN,
+    [&levels, distances](size_t vertex, size_t) {
+      (*distances)[vertex] = levels[vertex].load(std::memory_order_relaxed);
+    }
+  );
+
+  return reached;
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace algorithm */
+
+
+} /* end namespace sneaker */
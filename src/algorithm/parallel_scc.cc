@@ -0,0 +1,513 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "algorithm/parallel_scc.h"
+
+#include "algorithm/csr_graph.h"
+#include "algorithm/iterative_tarjan.h"
+#include "threading/parallel_for.h"
+#include "threading/worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace sneaker {
+
+
+namespace algorithm {
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+using sneaker::threading::parallel_for;
+using sneaker::threading::worker_pool;
+
+typedef csr_graph::vertex_id vertex_id;
+
+const vertex_id UNASSIGNED = UINT32_MAX;
+
+/**
+ * The number of items claimed at once by each thread in `parallel_for`.
+ */
+const size_t GRAIN = 1024;
+
+const uint8_t FORWARD = 1;
+const uint8_t BACKWARD = 2;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * The state of a single decomposition. Every array indexed by vertex is
+ * atomic, as the phases read vertices that other threads are updating. The
+ * accesses are relaxed, so a flag is never cleared in the same phase as it is
+ * set by other threads; the joins between phases order them instead.
+ */
+class decomposition
+{
+public:
+  decomposition(const csr_graph& graph, size_t thread_count);
+
+  size_t run(std::vector<vertex_id>* labels);
+
+private:
+  void trim();
+
+  void extract_pivot_component();
+
+  void color_components();
+
+  void reach(vertex_id source, const csr_graph& graph, uint8_t mark,
+    uint8_t required);
+
+  void collect_live();
+
+  void gather(std::vector<vertex_id>* items);
+
+  bool live(vertex_id vertex) const
+  {
+    return m_labels[vertex].load(std::memory_order_relaxed) == UNASSIGNED;
+  }
+
+  vertex_id next_label()
+  {
+    return m_label_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  template<class Fn>
+  void for_each(const std::vector<vertex_id>& items, size_t grain,
+    const Fn& fn)
+  {
+    parallel_for(m_pool, items.size(), grain,
+      [&items, &fn](size_t item, size_t thread) {
+        fn(items[item], thread);
+      }
+    );
+  }
+
+  const csr_graph& m_graph;
+  const csr_graph m_transpose;
+  const size_t m_thread_count;
+
+  /**
+   * The threads of the phases, which are started once for the whole
+   * decomposition.
+   */
+  worker_pool m_pool;
+  const size_t m_vertex_count;
+  std::unique_ptr<std::atomic<vertex_id>[]> m_labels;
+  std::unique_ptr<std::atomic<vertex_id>[]> m_in_degrees;
+  std::unique_ptr<std::atomic<vertex_id>[]> m_out_degrees;
+  std::unique_ptr<std::atomic<vertex_id>[]> m_colors;
+  std::unique_ptr<std::atomic<uint8_t>[]> m_flags;
+  std::atomic<vertex_id> m_label_count;
+  std::vector<vertex_id> m_live;
+  std::vector<std::vector<vertex_id>> m_buckets;
+};
+
+// -----------------------------------------------------------------------------
+
+decomposition::decomposition(const csr_graph& graph, size_t thread_count)
+  :
+  m_graph(graph),
+  m_transpose(graph.transpose()),
+  m_thread_count(thread_count),
+  m_pool(thread_count - 1),
+  m_vertex_count(graph.vertex_count()),
+  m_labels(new std::atomic<vertex_id>[m_vertex_count]),
+  m_in_degrees(new std::atomic<vertex_id>[m_vertex_count]),
+  m_out_degrees(new std::atomic<vertex_id>[m_vertex_count]),
+  m_colors(new std::atomic<vertex_id>[m_vertex_count]),
+  m_flags(new std::atomic<uint8_t>[m_vertex_count]),
+  m_label_count(0),
+  m_live(m_vertex_count),
+  m_buckets(thread_count)
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+size_t
+decomposition::run(std::vector<vertex_id>* labels)
+{
+  parallel_for(m_pool, m_vertex_count, GRAIN,
+    [this](size_t vertex, size_t) {
+      m_labels[vertex].store(UNASSIGNED, std::memory_order_relaxed);
+      m_live[vertex] = static_cast<vertex_id>(vertex);
+    }
+  );
+
+  trim();
+  extract_pivot_component();
+  trim();
+  color_components();
+
+  labels->resize(m_vertex_count);
+
+  parallel_for(m_pool, m_vertex_count, GRAIN,
+    [this, labels](size_t vertex, size_t) {
+      (*labels)[vertex] = m_labels[vertex].load(std::memory_order_relaxed);
+    }
+  );
+
+  return m_label_count.load(std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+
+void
+decomposition::trim()
+{
+  for_each(m_live, GRAIN, [this](vertex_id vertex, size_t thread) {
+    vertex_id out_degree = 0;
+    for (auto itr = m_graph.neighbors_begin(vertex);
+      itr != m_graph.neighbors_end(vertex); ++itr)
+    {
+      out_degree += live(*itr) ? 1 : 0;
+    }
+
+    vertex_id in_degree = 0;
+    for (auto itr = m_transpose.neighbors_begin(vertex);
+      itr != m_transpose.neighbors_end(vertex); ++itr)
+    {
+      in_degree += live(*itr) ? 1 : 0;
+    }
+
+    m_out_degrees[vertex].store(out_degree, std::memory_order_relaxed);
+    m_in_degrees[vertex].store(in_degree, std::memory_order_relaxed);
+    m_flags[vertex].store(0, std::memory_order_relaxed);
+
+    if (in_degree == 0 || out_degree == 0)
+    {
+      m_buckets[thread].push_back(vertex);
+    }
+  });
+
+  std::vector<vertex_id> frontier;
+  gather(&frontier);
+
+  while (!frontier.empty())
+  {
+    for_each(frontier, GRAIN, [this](vertex_id vertex, size_t thread) {
+      // A vertex can run out of in-edges and out-edges in the same round.
+      if (m_flags[vertex].exchange(1, std::memory_order_relaxed))
+      {
+        return;
+      }
+
+      m_labels[vertex].store(next_label(), std::memory_order_relaxed);
+
+      for (auto itr = m_graph.neighbors_begin(vertex);
+        itr != m_graph.neighbors_end(vertex); ++itr)
+      {
+        if (live(*itr) &&
+            m_in_degrees[*itr].fetch_sub(1, std::memory_order_relaxed) == 1)
+        {
+          m_buckets[thread].push_back(*itr);
+        }
+      }
+
+      for (auto itr = m_transpose.neighbors_begin(vertex);
+        itr != m_transpose.neighbors_end(vertex); ++itr)
+      {
+        if (live(*itr) &&
+            m_out_degrees[*itr].fetch_sub(1, std::memory_order_relaxed) == 1)
+        {
+          m_buckets[thread].push_back(*itr);
+        }
+      }
+    });
+
+    gather(&frontier);
+  }
+
+  collect_live();
+}
+
+// -----------------------------------------------------------------------------
+
+void
+decomposition::extract_pivot_component()
+{
+  if (m_live.empty())
+  {
+    return;
+  }
+
+  // The product of the degrees favors vertices well inside the giant
+  // component over hubs with edges in a single direction.
+  std::vector<uint64_t> best_scores(m_thread_count, 0);
+  std::vector<vertex_id> best_vertices(m_thread_count, m_live.front());
+
+  for_each(m_live, GRAIN,
+    [this, &best_scores, &best_vertices](vertex_id vertex, size_t thread) {
+      m_flags[vertex].store(0, std::memory_order_relaxed);
+
+      const uint64_t score =
+        static_cast<uint64_t>(m_graph.degree(vertex)) *
+        static_cast<uint64_t>(m_transpose.degree(vertex));
+
+      if (score > best_scores[thread])
+      {
+        best_scores[thread] = score;
+        best_vertices[thread] = vertex;
+      }
+    }
+  );
+
+  const size_t best = static_cast<size_t>(
+    std::max_element(best_scores.begin(), best_scores.end()) -
+    best_scores.begin());
+  const vertex_id pivot = best_vertices[best];
+
+  reach(pivot, m_graph, FORWARD, 0);
+  reach(pivot, m_transpose, BACKWARD, FORWARD);
+
+  const vertex_id label = next_label();
+
+  for_each(m_live, GRAIN, [this, label](vertex_id vertex, size_t) {
+    if (m_flags[vertex].load(std::memory_order_relaxed) == (FORWARD | BACKWARD))
+    {
+      m_labels[vertex].store(label, std::memory_order_relaxed);
+    }
+  });
+
+  collect_live();
+}
+
+// -----------------------------------------------------------------------------
+
+void
+decomposition::color_components()
+{
+  while (!m_live.empty())
+  {
+    for_each(m_live, GRAIN, [this](vertex_id vertex, size_t) {
+      m_colors[vertex].store(vertex, std::memory_order_relaxed);
+      m_flags[vertex].store(0, std::memory_order_relaxed);
+    });
+
+    // Propagates the highest color along the out-edges until it settles.
+    std::vector<vertex_id> frontier(m_live);
+
+    while (!frontier.empty())
+    {
+      for_each(frontier, GRAIN, [this](vertex_id vertex, size_t thread) {
+        const vertex_id color = m_colors[vertex].load(std::memory_order_relaxed);
+
+        for (auto itr = m_graph.neighbors_begin(vertex);
+          itr != m_graph.neighbors_end(vertex); ++itr)
+        {
+          if (!live(*itr))
+          {
+            continue;
+          }
+
+          vertex_id current = m_colors[*itr].load(std::memory_order_relaxed);
+
+          while (current < color)
+          {
+            if (m_colors[*itr].compare_exchange_weak(current, color,
+                  std::memory_order_relaxed))
+            {
+              if (!m_flags[*itr].exchange(1, std::memory_order_relaxed))
+              {
+                m_buckets[thread].push_back(*itr);
+              }
+
+              break;
+            }
+          }
+        }
+      });
+
+      gather(&frontier);
+
+      // The flags of the next frontier are only cleared once the round that
+      // set them has been joined, so a vertex whose color is raised while it
+      // is being propagated is always pushed again.
+      for_each(frontier, GRAIN, [this](vertex_id vertex, size_t) {
+        m_flags[vertex].store(0, std::memory_order_relaxed);
+      });
+    }
+
+    for_each(m_live, GRAIN, [this](vertex_id vertex, size_t thread) {
+      if (m_colors[vertex].load(std::memory_order_relaxed) == vertex)
+      {
+        m_buckets[thread].push_back(vertex);
+      }
+    });
+
+    std::vector<vertex_id> roots;
+    gather(&roots);
+
+    // Every color is searched by a single thread, so the vertices of a color
+    // are only ever labeled by the thread of its root.
+    for_each(roots, 1, [this](vertex_id root, size_t) {
+      const vertex_id label = next_label();
+
+      std::vector<vertex_id> pending(1, root);
+      m_labels[root].store(label, std::memory_order_relaxed);
+
+      while (!pending.empty())
+      {
+        const vertex_id vertex = pending.back();
+        pending.pop_back();
+
+        for (auto itr = m_transpose.neighbors_begin(vertex);
+          itr != m_transpose.neighbors_end(vertex); ++itr)
+        {
+          if (live(*itr) &&
+              m_colors[*itr].load(std::memory_order_relaxed) == root)
+          {
+            m_labels[*itr].store(label, std::memory_order_relaxed);
+            pending.push_back(*itr);
+          }
+        }
+      }
+    });
+
+    collect_live();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void
+decomposition::reach(vertex_id source, const csr_graph& graph, uint8_t mark,
+  uint8_t required)
+{
+  m_flags[source].fetch_or(mark, std::memory_order_relaxed);
+
+  std::vector<vertex_id> frontier(1, source);
+
+  while (!frontier.empty())
+  {
+    for_each(frontier, GRAIN / 16,
+      [this, &graph, mark, required](vertex_id vertex, size_t thread) {
+        for (auto itr = graph.neighbors_begin(vertex);
+          itr != graph.neighbors_end(vertex); ++itr)
+        {
+          if (!live(*itr))
+          {
+            continue;
+          }
+
+          const uint8_t flags = m_flags[*itr].load(std::memory_order_relaxed);
+
+          if ((flags & required) != required || (flags & mark))
+          {
+            continue;
+          }
+
+          if (!(m_flags[*itr].fetch_or(mark, std::memory_order_relaxed) & mark))
+          {
+            m_buckets[thread].push_back(*itr);
+          }
+        }
+      }
+    );
+
+    gather(&frontier);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void
+decomposition::collect_live()
+{
+  for_each(m_live, GRAIN, [this](vertex_id vertex, size_t thread) {
+    if (live(vertex))
+    {
+      m_buckets[thread].push_back(vertex);
+    }
+  });
+
+  gather(&m_live);
+}
+
+// -----------------------------------------------------------------------------
+
+void
+decomposition::gather(std::vector<vertex_id>* items)
+{
+  items->clear();
+
+  for (auto& bucket : m_buckets)
+  {
+    items->insert(items->end(), bucket.begin(), bucket.end());
+    bucket.clear();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+constexpr size_t parallel_scc::DEFAULT_SEQUENTIAL_THRESHOLD;
+
+// -----------------------------------------------------------------------------
+
+parallel_scc::parallel_scc(size_t thread_count, size_t sequential_threshold)
+  :
+  m_thread_count(thread_count),
+  m_sequential_threshold(sequential_threshold)
+{
+  if (m_thread_count == 0)
+  {
+    m_thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+size_t
+parallel_scc::label_components(const csr_graph& graph,
+  std::vector<vertex_id>* labels) const
+{
+  if (graph.vertex_count() < m_sequential_threshold)
+  {
+    iterative_tarjan algo;
+    return algo.label_components(graph, labels);
+  }
+
+  decomposition state(graph, m_thread_count);
+  return state.run(labels);
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace algorithm */
+
+
+} /* end namespace sneaker */
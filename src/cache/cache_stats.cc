@@ -0,0 +1,218 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "cache/cache_stats.h"
+
+#include "json/json.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+
+namespace sneaker {
+
+
+namespace cache {
+
+
+// -----------------------------------------------------------------------------
+
+constexpr size_t cache_stats::LOAD_LATENCY_BUCKETS;
+
+// -----------------------------------------------------------------------------
+
+cache_stats::cache_stats()
+  :
+  hits(0),
+  misses(0),
+  insertions(0),
+  evictions(0),
+  expirations(0),
+  removals(0),
+  load_successes(0),
+  load_failures(0),
+  size(0)
+{
+  memset(load_latencies, 0, sizeof(load_latencies));
+}
+
+// -----------------------------------------------------------------------------
+
+uint64_t
+cache_stats::requests() const
+{
+  return hits + misses;
+}
+
+// -----------------------------------------------------------------------------
+
+double
+cache_stats::hit_ratio() const
+{
+  const uint64_t total = requests();
+
+  if (total == 0)
+  {
+    return 1.0;
+  }
+
+  return static_cast<double>(hits) / static_cast<double>(total);
+}
+
+// -----------------------------------------------------------------------------
+
+uint64_t
+cache_stats::loads() const
+{
+  return load_successes + load_failures;
+}
+
+// -----------------------------------------------------------------------------
+
+sneaker::json::JSON
+cache_stats::to_json() const
+{
+  using sneaker::json::JSON;
+
+  JSON::array latencies;
+
+  for (size_t i = 0; i < LOAD_LATENCY_BUCKETS; ++i)
+  {
+    // The last bucket has no upper bound.
+    const JSON upper_bound = i + 1 < LOAD_LATENCY_BUCKETS ?
+      JSON::from_int64(static_cast<int64_t>(1) << i) : JSON(nullptr);
+
+    latencies.push_back(JSON::object {
+      { "upper_bound_us", upper_bound },
+      { "count", JSON::from_int64(static_cast<int64_t>(load_latencies[i])) },
+    });
+  }
+
+  return JSON::object {
+    { "hits", JSON::from_int64(static_cast<int64_t>(hits)) },
+    { "misses", JSON::from_int64(static_cast<int64_t>(misses)) },
+    { "hit_ratio", hit_ratio() },
+    { "insertions", JSON::from_int64(static_cast<int64_t>(insertions)) },
+    { "evictions", JSON::object {
+      { "size", JSON::from_int64(static_cast<int64_t>(evictions)) },
+      { "expired", JSON::from_int64(static_cast<int64_t>(expirations)) },
+      { "explicit", JSON::from_int64(static_cast<int64_t>(removals)) },
+    } },
+    { "loads", JSON::object {
+      { "successes", JSON::from_int64(static_cast<int64_t>(load_successes)) },
+      { "failures", JSON::from_int64(static_cast<int64_t>(load_failures)) },
+      { "latencies", latencies },
+    } },
+    { "size", JSON::from_int64(size) },
+  };
+}
+
+// -----------------------------------------------------------------------------
+
+cache_stats_recorder::cache_stats_recorder()
+{
+  reset();
+}
+
+// -----------------------------------------------------------------------------
+
+void*
+cache_stats_recorder::operator new(size_t size)
+{
+  void* ptr = NULL;
+
+  if (posix_memalign(&ptr, CACHE_LINE_SIZE, size) != 0)
+  {
+    throw std::bad_alloc();
+  }
+
+  return ptr;
+}
+
+// -----------------------------------------------------------------------------
+
+void
+cache_stats_recorder::operator delete(void* ptr)
+{
+  free(ptr);
+}
+
+// -----------------------------------------------------------------------------
+
+cache_stats
+cache_stats_recorder::snapshot() const
+{
+  uint64_t totals[COUNTERS] = { 0 };
+
+  for (size_t i = 0; i < STRIPES; ++i)
+  {
+    for (size_t counter = 0; counter < COUNTERS; ++counter)
+    {
+      totals[counter] +=
+        m_stripes[i].counters[counter].load(std::memory_order_relaxed);
+    }
+  }
+
+  cache_stats stats;
+  stats.hits = totals[HITS];
+  stats.misses = totals[MISSES];
+  stats.insertions = totals[INSERTIONS];
+  stats.evictions = totals[EVICTIONS];
+  stats.expirations = totals[EXPIRATIONS];
+  stats.removals = totals[REMOVALS];
+  stats.load_successes = totals[LOAD_SUCCESSES];
+  stats.load_failures = totals[LOAD_FAILURES];
+
+  // Decrements are recorded as wrapped-around additions.
+  stats.size = static_cast<int64_t>(totals[SIZE]);
+
+  for (size_t i = 0; i < cache_stats::LOAD_LATENCY_BUCKETS; ++i)
+  {
+    stats.load_latencies[i] = totals[LOAD_LATENCIES + i];
+  }
+
+  return stats;
+}
+
+// -----------------------------------------------------------------------------
+
+void
+cache_stats_recorder::reset()
+{
+  for (size_t i = 0; i < STRIPES; ++i)
+  {
+    for (size_t counter = 0; counter < COUNTERS; ++counter)
+    {
+      m_stripes[i].counters[counter].store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace cache */
+
+
+} /* end namespace sneaker */
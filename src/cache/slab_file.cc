@@ -0,0 +1,143 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "cache/slab_file.h"
+
+#include "io/tmp_file.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <ios>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+namespace sneaker {
+
+
+namespace cache {
+
+
+// -----------------------------------------------------------------------------
+
+slab_file::slab_file(size_t initial_size)
+  :
+  m_path(),
+  m_fd(-1),
+  m_data(NULL),
+  m_size(0)
+{
+  const char* path = io::get_persistent_tmp_file_path();
+  m_path = path;
+  free(const_cast<char*>(path));
+
+  m_fd = open(m_path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (m_fd < 0)
+  {
+    throw std::ios_base::failure("Cannot create slab file");
+  }
+
+  try
+  {
+    m_size = std::max<size_t>(initial_size, 1);
+    m_data = map(m_size);
+  }
+  catch (...)
+  {
+    close(m_fd);
+    unlink(m_path.c_str());
+    throw;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+slab_file::~slab_file()
+{
+  unmap();
+  close(m_fd);
+  unlink(m_path.c_str());
+}
+
+// -----------------------------------------------------------------------------
+
+void
+slab_file::reserve(size_t size)
+{
+  if (size <= m_size)
+  {
+    return;
+  }
+
+  const size_t new_size = std::max(size, m_size * 2);
+
+  // The file is mapped again before the old mapping is removed, so that the
+  // old mapping remains in place if the file cannot be extended or mapped.
+  uint8_t* data = map(new_size);
+
+  unmap();
+
+  m_data = data;
+  m_size = new_size;
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t*
+slab_file::map(size_t size)
+{
+  if (size > static_cast<size_t>(std::numeric_limits<off_t>::max()) ||
+    ftruncate(m_fd, static_cast<off_t>(size)) < 0)
+  {
+    throw std::ios_base::failure("Cannot extend slab file");
+  }
+
+  void* data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (data == MAP_FAILED)
+  {
+    throw std::ios_base::failure("Cannot map slab file");
+  }
+
+  return static_cast<uint8_t*>(data);
+}
+
+// -----------------------------------------------------------------------------
+
+void
+slab_file::unmap()
+{
+  if (m_data)
+  {
+    munmap(m_data, m_size);
+    m_data = NULL;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+} /* end namespace cache */
+
+
+} /* end namespace sneaker */
@@ -30,6 +30,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 
 namespace sneaker {
@@ -258,6 +260,92 @@ private:
 
 // -----------------------------------------------------------------------------
 
+class mmap_input_stream_reader : public io::input_stream
+{
+public:
+  mmap_input_stream_reader(const char* filename)
+    :
+    m_data(NULL),
+    m_total_size(0),
+    m_bytes_read(0)
+  {
+    const int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+      throw std::ios_base::failure("Cannot open file");
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0)
+    {
+      close(fd);
+      throw std::ios_base::failure("Cannot stat file");
+    }
+
+    m_total_size = static_cast<size_t>(st.st_size);
+
+    if (m_total_size)
+    {
+      void* data = mmap(NULL, m_total_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED)
+      {
+        close(fd);
+        throw std::ios_base::failure("Cannot map file");
+      }
+
+      // The mapping is usually consumed front to back.
+      madvise(data, m_total_size, MADV_SEQUENTIAL);
+
+      m_data = static_cast<const uint8_t*>(data);
+    }
+
+    // The mapping remains valid after the descriptor is closed.
+    close(fd);
+  }
+
+  ~mmap_input_stream_reader()
+  {
+    if (m_data)
+    {
+      munmap(const_cast<uint8_t*>(m_data), m_total_size);
+    }
+  }
+
+  bool next(const uint8_t** data, size_t* len)
+  {
+    if (m_bytes_read == m_total_size)
+    {
+      return false;
+    }
+    *data = &m_data[m_bytes_read];
+    *len = m_total_size - m_bytes_read;
+    m_bytes_read = m_total_size;
+    return true;
+  }
+
+  void skip(size_t len)
+  {
+    if (len > (m_total_size - m_bytes_read))
+    {
+      len = m_total_size - m_bytes_read;
+    }
+
+    m_bytes_read += len;
+  }
+
+  size_t bytes_read() const
+  {
+    return m_bytes_read;
+  }
+
+private:
+  const uint8_t* m_data;
+  size_t m_total_size;
+  size_t m_bytes_read;
+};
+
+// -----------------------------------------------------------------------------
+
 } /* end anonymous namespace */
 
 namespace io {
@@ -304,6 +392,14 @@ memory_input_stream(const uint8_t* data, size_t len)
 
 // -----------------------------------------------------------------------------
 
+std::unique_ptr<input_stream>
+mmap_input_stream(const char* filename)
+{
+  return std::unique_ptr<input_stream>(new mmap_input_stream_reader(filename));
+}
+
+// -----------------------------------------------------------------------------
+
 stream_reader::stream_reader(input_stream* stream)
   :
   m_stream(stream),
@@ -26,6 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "utility/util.numeric.h"
 
 #include <initializer_list>
+#include <mutex>
 #include <sstream>
 #include <type_traits>
 #include <utility>
@@ -57,6 +58,7 @@ public:
   virtual int64_t int_value() const;
   virtual bool bool_value() const;
   virtual const JSON::string& string_value() const;
+  virtual string_view string_view_value() const;
   virtual const JSON::array& array_items() const;
   virtual const JSON::object& object_items() const;
   virtual const JSON& operator[](size_t i) const;
@@ -249,12 +251,24 @@ public:
     return m_value;
   }
 
+  string_view string_view_value() const {
+    return string_view(m_value);
+  }
+
+  virtual bool equals(const json_value* other) const;
+
+  virtual bool less(const json_value* other) const;
+
   virtual void dump(std::string& out) const;
 
   static void dump(const std::string& value, std::string& out) {
+    dump(value.data(), value.size(), out);
+  }
+
+  static void dump(const char* value, size_t length, std::string& out) {
     out += '"';
 
-    for (std::string::size_type i = 0; i < value.length(); i++) {
+    for (size_t i = 0; i < length; i++) {
       const char ch = value[i];
 
       if (ch == '\\') {
@@ -275,12 +289,12 @@ public:
         char buf[8];
         snprintf(buf, sizeof buf, "\\u%04x", ch);
         out += buf;
-      } else if (static_cast<uint8_t>(ch) == 0xe2 &&
+      } else if (static_cast<uint8_t>(ch) == 0xe2 && i + 2 < length &&
                  static_cast<uint8_t>(value[i+1]) == 0x80 &&
                  static_cast<uint8_t>(value[i+2]) == 0xa8) {
         out += "\\u2028";
         i += 2;
-      } else if (static_cast<uint8_t>(ch) == 0xe2 &&
+      } else if (static_cast<uint8_t>(ch) == 0xe2 && i + 2 < length &&
                  static_cast<uint8_t>(value[i+1]) == 0x80 &&
                  static_cast<uint8_t>(value[i+2]) == 0xa9) {
         out += "\\u2029";
@@ -288,7 +302,7 @@ public:
       } else {
         out += ch;
       }
-    } /* end `for (auto i = 0; i < value.length(); i++)` */
+    } /* end `for (size_t i = 0; i < length; i++)` */
 
     out += '"';
   }
@@ -296,11 +310,110 @@ public:
 
 // -----------------------------------------------------------------------------
 
+/* virtual */
+bool
+json_string::equals(const json_value* other) const
+{
+  return string_view_value() == other->string_view_value();
+}
+
+// -----------------------------------------------------------------------------
+
+/* virtual */
+bool
+json_string::less(const json_value* other) const
+{
+  return string_view_value() < other->string_view_value();
+}
+
+// -----------------------------------------------------------------------------
+
 /* virtual */
 void
 json_string::dump(std::string& out) const
 {
-  json_string::dump(value(), out);
+  json_string::dump(m_value, out);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * A string whose value is a slice of a shared input. Slices with escape
+ * sequences are unescaped on first access, as are the others when they are
+ * read as a `std::string`, once even if accessed by multiple threads.
+ */
+class json_string_slice final : public json_value {
+public:
+  json_string_slice(const std::shared_ptr<const std::string>& source,
+    size_t offset, size_t size, bool escaped)
+    :
+    m_source(source),
+    m_offset(offset),
+    m_size(size),
+    m_escaped(escaped),
+    m_once(),
+    m_value()
+  {
+  }
+
+  JSON::Type type() const {
+    return JSON::Type::STRING;
+  }
+
+  const JSON::string& string_value() const {
+    materialize();
+    return m_value;
+  }
+
+  string_view string_view_value() const {
+    if (!m_escaped) {
+      return string_view(m_source->data() + m_offset, m_size);
+    }
+
+    materialize();
+    return string_view(m_value);
+  }
+
+  virtual bool equals(const json_value* other) const {
+    return string_view_value() == other->string_view_value();
+  }
+
+  virtual bool less(const json_value* other) const {
+    return string_view_value() < other->string_view_value();
+  }
+
+  virtual void dump(std::string& out) const {
+    const string_view value = string_view_value();
+    json_string::dump(value.data(), value.size(), out);
+  }
+
+private:
+  void materialize() const;
+
+  const std::shared_ptr<const std::string> m_source;
+  const size_t m_offset;
+  const size_t m_size;
+  const bool m_escaped;
+  mutable std::once_flag m_once;
+  mutable std::string m_value;
+};
+
+// -----------------------------------------------------------------------------
+
+void
+json_string_slice::materialize() const
+{
+  std::call_once(m_once, [this]() {
+    if (!m_escaped) {
+      m_value.assign(m_source->data() + m_offset, m_size);
+      return;
+    }
+
+    // The slice was validated when parsed, so unescaping it cannot fail.
+    std::string err;
+    json_parser parser { *m_source, m_offset, err, false, nullptr };
+    m_value = parser.parse_string();
+  });
 }
 
 // -----------------------------------------------------------------------------
@@ -569,6 +682,14 @@ JSON::string_value() const
 
 // -----------------------------------------------------------------------------
 
+string_view
+JSON::string_view_value() const
+{
+  return m_ptr->string_view_value();
+}
+
+// -----------------------------------------------------------------------------
+
 const JSON::array&
 JSON::array_items() const
 {
@@ -707,6 +828,14 @@ json_value::string_value() const
 
 // -----------------------------------------------------------------------------
 
+string_view
+json_value::string_view_value() const
+{
+  return string_view();
+}
+
+// -----------------------------------------------------------------------------
+
 const JSON::array&
 json_value::array_items() const
 {
@@ -764,7 +893,39 @@ JSON
 parse(const std::string& in)
 {
   std::string err;
-  json_parser parser { in, 0, err, false };
+  json_parser parser { in, 0, err, false, nullptr };
+  JSON result = parser.parse_json();
+
+  if (!parser.err.empty()) {
+    throw invalid_json_error(parser.err);
+  }
+
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+
+JSON
+parse(const char* data, size_t size)
+{
+  std::string err;
+  json_parser parser { json_input(data, size), 0, err, false, nullptr };
+  JSON result = parser.parse_json();
+
+  if (!parser.err.empty()) {
+    throw invalid_json_error(parser.err);
+  }
+
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+
+JSON
+parse(const std::shared_ptr<const std::string>& in)
+{
+  std::string err;
+  json_parser parser { *in, 0, err, false, in };
   JSON result = parser.parse_json();
 
   if (!parser.err.empty()) {
@@ -794,6 +955,19 @@ JSON::from_int64(int64_t value)
 
 // -----------------------------------------------------------------------------
 
+/* static */
+JSON
+JSON::from_source(const std::shared_ptr<const std::string>& source,
+  size_t offset, size_t size, bool escaped)
+{
+  JSON result;
+  result.m_ptr = std::make_shared<json_string_slice>(source, offset, size,
+    escaped);
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+
 
 } /* end namespace json */
 
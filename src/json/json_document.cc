@@ -0,0 +1,1020 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "json/json_document.h"
+
+#include "json/json_parser.h"
+#include "json/json_structural_index.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+
+namespace sneaker {
+
+
+namespace json {
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+bool
+in_range(long x, long lower, long upper)
+{
+  return (x >= lower && x <= upper);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string
+esc(char c)
+{
+  char buf[12];
+
+  if (static_cast<uint8_t>(c) >= 0x20 && static_cast<uint8_t>(c) <= 0x7f) {
+    snprintf(buf, sizeof buf, "'%c' (%d)", c, c);
+  } else {
+    snprintf(buf, sizeof buf, "(%d)", c);
+  }
+
+  return std::string(buf);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Compares two keys in the order of `std::string::compare()`, which is the
+ * order of the members of `JSON::object`.
+ */
+int
+compare_keys(const char* lhs, size_t lhs_size, const char* rhs,
+  size_t rhs_size)
+{
+  const int result = memcmp(lhs, rhs, std::min(lhs_size, rhs_size));
+  if (result != 0) {
+    return result;
+  }
+
+  return (lhs_size < rhs_size) ? -1 : (lhs_size > rhs_size ? 1 : 0);
+}
+
+} /* anonymous namespace */
+
+
+// -----------------------------------------------------------------------------
+
+const json_document::value json_document::NULL_VALUE = { JSON::NUL, 0, 0, { 0 } };
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Recursive descent parser that follows the grammar and the error messages
+ * of `json_parser`. Children are accumulated on a scratch stack while their
+ * container is parsed, and appended to the value array once it is complete,
+ * which keeps them contiguous.
+ *
+ * The parser either scans the input itself, or visits only the positions of
+ * a `json_structural_index`, in which case the values outside of strings
+ * are additionally checked to end where the index says they do.
+ */
+class json_document::builder
+{
+public:
+  static_assert(sizeof(value) == 16, "Values are expected to be 16 bytes.");
+
+  builder(std::vector<char>* input, std::vector<value>* values)
+    :
+    m_str(input->data()),
+    m_size(input->size() - 1),
+    m_i(0),
+    m_values(values),
+    m_positions(NULL),
+    m_position_count(0),
+    m_k(0)
+  {
+    // Do nothing here.
+  }
+
+  /**
+   * Parses the input, and returns the position of the root in the value
+   * array.
+   */
+  size_t build()
+  {
+    const value result = parse_json<false>(0);
+
+    consume_whitespace();
+
+    if (m_i != m_size) {
+      fail("Unexpected trailing " + esc(m_str[m_i]));
+    }
+
+    return finish(result);
+  }
+
+  /**
+   * Parses the input from the positions of its structural index, and
+   * returns the position of the root in the value array.
+   */
+  size_t build(const json_structural_index& index)
+  {
+    m_positions = index.positions().data();
+    m_position_count = index.positions().size();
+
+    const value result = parse_json<true>(0);
+
+    if (m_k != m_position_count) {
+      fail("Unexpected trailing " + esc(m_str[m_positions[m_k]]));
+    }
+
+    return finish(result);
+  }
+
+private:
+  [[noreturn]] static void fail(const std::string& msg)
+  {
+    throw invalid_json_error(msg);
+  }
+
+  /**
+   * Appends the root, and turns the offsets of the children of containers
+   * into pointers, now that the value array has stopped growing.
+   */
+  size_t finish(const value& result)
+  {
+    if (result.type != JSON::ARRAY && result.type != JSON::OBJECT) {
+      fail("Invalid JSON. Expecting [ or {");
+    }
+
+    m_values->push_back(result);
+
+    value* const values = m_values->data();
+    for (size_t i = 0; i < m_values->size(); ++i) {
+      if (values[i].type == JSON::ARRAY || values[i].type == JSON::OBJECT) {
+        values[i].children = values + values[i].offset;
+      }
+    }
+
+    return m_values->size() - 1;
+  }
+
+  static value make_value(JSON::Type type, size_t size, uint64_t offset)
+  {
+    if (size > std::numeric_limits<uint32_t>::max()) {
+      fail("Value too large");
+    }
+
+    value result;
+    result.type = static_cast<uint8_t>(type);
+    result.integral = 0;
+    result.size = static_cast<uint32_t>(size);
+    result.offset = offset;
+
+    return result;
+  }
+
+  value make_string(size_t start_pos, size_t size) const
+  {
+    value result = make_value(JSON::STRING, size, 0);
+    result.string = m_str + start_pos;
+
+    return result;
+  }
+
+  void consume_whitespace()
+  {
+    while (m_str[m_i] == ' ' || m_str[m_i] == '\r' || m_str[m_i] == '\n' ||
+      m_str[m_i] == '\t')
+    {
+      m_i++;
+    }
+  }
+
+  char get_next_token()
+  {
+    consume_whitespace();
+
+    if (m_i == m_size) {
+      fail("Unexpected end of input");
+    }
+
+    return m_str[m_i++];
+  }
+
+  value expect(const char* expected, value result)
+  {
+    m_i--;
+
+    const size_t length = strlen(expected);
+    const size_t available = std::min(length, m_size - m_i);
+
+    if (available == length && memcmp(m_str + m_i, expected, length) == 0) {
+      m_i += length;
+      return result;
+    }
+
+    fail(std::string("Parse error: expected ") + expected + ", got " +
+      std::string(m_str + m_i, available));
+  }
+
+  value parse_number()
+  {
+    const size_t start_pos = m_i;
+
+    if (m_str[m_i] == '-') {
+      m_i++;
+    }
+
+    if (m_str[m_i] == '0') {
+      m_i++;
+      if (in_range(m_str[m_i], '0', '9')) {
+        fail("Leading 0s not permitted in numbers");
+      }
+    } else if (in_range(m_str[m_i], '1', '9')) {
+      m_i++;
+      while (in_range(m_str[m_i], '0', '9')) {
+        m_i++;
+      }
+    } else {
+      fail("Invalid " + esc(m_str[m_i]) + " in number");
+    }
+
+    value result = make_value(JSON::NUMBER, 0, 0);
+
+    if (m_str[m_i] != '.' && m_str[m_i] != 'e' && m_str[m_i] != 'E' &&
+      (m_i - start_pos - 1) <=
+        static_cast<size_t>(std::numeric_limits<int64_t>::digits10))
+    {
+      result.integral = 1;
+      result.integer = static_cast<int64_t>(std::atoll(m_str + start_pos));
+      return result;
+    }
+
+    // Decimal part.
+    if (m_str[m_i] == '.') {
+      m_i++;
+      if (!in_range(m_str[m_i], '0', '9')) {
+        fail("At least one digit required in fractional part");
+      }
+      while (in_range(m_str[m_i], '0', '9')) {
+        m_i++;
+      }
+    }
+
+    // Exponent part.
+    if (m_str[m_i] == 'e' || m_str[m_i] == 'E') {
+      m_i++;
+
+      if (m_str[m_i] == '+' || m_str[m_i] == '-') {
+        m_i++;
+      }
+
+      if (!in_range(m_str[m_i], '0', '9')) {
+        fail("At least one digit required in exponent");
+      }
+    }
+
+    while (in_range(m_str[m_i], '0', '9')) {
+      m_i++;
+    }
+
+    result.number = std::atof(m_str + start_pos);
+
+    return result;
+  }
+
+  /**
+   * Same as `json_parser::encode_utf8()`, writing in place.
+   */
+  static void encode_utf8(long pt, char*& out)
+  {
+    if (pt < 0) {
+      return;
+    }
+
+    if (pt < 0x80) {
+      *out++ = static_cast<char>(pt);
+    } else if (pt < 0x800) {
+      *out++ = static_cast<char>((pt >> 6) | 0xC0);
+      *out++ = static_cast<char>((pt & 0x3F) | 0x80);
+    } else if (pt < 0x10000) {
+      *out++ = static_cast<char>((pt >> 12) | 0xE0);
+      *out++ = static_cast<char>(((pt >> 6) & 0x3F) | 0x80);
+      *out++ = static_cast<char>((pt & 0x3F) | 0x80);
+    } else {
+      *out++ = static_cast<char>((pt >> 18) | 0xF0);
+      *out++ = static_cast<char>(((pt >> 12) & 0x3F) | 0x80);
+      *out++ = static_cast<char>(((pt >> 6) & 0x3F) | 0x80);
+      *out++ = static_cast<char>((pt & 0x3F) | 0x80);
+    }
+  }
+
+  /**
+   * Parses the string starting after its opening quote. Strings without
+   * escape sequences are sliced as is, and the others are unescaped over
+   * their own bytes, behind the read position.
+   */
+  value parse_string()
+  {
+    const size_t start_pos = m_i;
+
+    while (m_i < m_size) {
+      const char ch = m_str[m_i];
+
+      if (ch == '"') {
+        m_i++;
+        return make_string(start_pos, m_i - 1 - start_pos);
+      }
+
+      if (ch == '\\' || in_range(ch, 0, 0x1f)) {
+        break;
+      }
+
+      m_i++;
+    }
+
+    return unescape_string(start_pos);
+  }
+
+  /**
+   * Continues parsing the string that starts at `start_pos` from its first
+   * escape sequence, at the read position, writing unescaped characters
+   * over the escaped ones.
+   */
+  value unescape_string(size_t start_pos)
+  {
+    char* const begin = m_str + start_pos;
+    char* out = m_str + m_i;
+    long last_escaped_codepoint = -1;
+
+    while (true) {
+      if (m_i == m_size) {
+        fail("Unexpected end of input in string");
+      }
+
+      char ch = m_str[m_i++];
+
+      if (ch == '"') {
+        encode_utf8(last_escaped_codepoint, out);
+        return make_string(start_pos, static_cast<size_t>(out - begin));
+      }
+
+      if (in_range(ch, 0, 0x1f)) {
+        fail("Unescaped " + esc(ch) + " in string");
+      }
+
+      // The usual case: non-escaped characters.
+      if (ch != '\\') {
+        encode_utf8(last_escaped_codepoint, out);
+        last_escaped_codepoint = -1;
+        *out++ = ch;
+        continue;
+      }
+
+      // Handle escapes.
+      if (m_i == m_size) {
+        fail("Unexpected end of input in string");
+      }
+
+      ch = m_str[m_i++];
+
+      if (ch == 'u') {
+        // Extract 4-byte escape sequence.
+        const std::string sequence(m_str + m_i,
+          std::min<size_t>(4, m_size - m_i));
+
+        for (size_t j = 0; j < 4; j++) {
+          if (j >= sequence.size() || (!in_range(sequence[j], 'a', 'f') &&
+            !in_range(sequence[j], 'A', 'F') && !in_range(sequence[j], '0', '9')))
+          {
+            fail("Bad \\u escape: " + sequence);
+          }
+        }
+
+        const long codepoint = strtol(sequence.data(), nullptr, 16);
+
+        // See `json_parser::parse_string()` on surrogate pairs.
+        if (in_range(last_escaped_codepoint, 0xD800, 0xDBFF) &&
+          in_range(codepoint, 0xDC00, 0xDFFF))
+        {
+          encode_utf8((((last_escaped_codepoint - 0xD800) << 10) |
+            (codepoint - 0xDC00)) + 0x10000, out);
+          last_escaped_codepoint = -1;
+        } else {
+          encode_utf8(last_escaped_codepoint, out);
+          last_escaped_codepoint = codepoint;
+        }
+
+        m_i += 4;
+
+        continue;
+      }
+
+      encode_utf8(last_escaped_codepoint, out);
+      last_escaped_codepoint = -1;
+
+      if (ch == 'b') {
+        *out++ = '\b';
+      } else if (ch == 'f') {
+        *out++ = '\f';
+      } else if (ch == 'n') {
+        *out++ = '\n';
+      } else if (ch == 'r') {
+        *out++ = '\r';
+      } else if (ch == 't') {
+        *out++ = '\t';
+      } else if (ch == '"' || ch == '\\' || ch == '/') {
+        *out++ = ch;
+      } else {
+        fail("Invalid escape character " + esc(ch));
+      }
+    } /* end of `while (true)` */
+  }
+
+  bool key_less(const value& lhs, const value& rhs) const
+  {
+    return compare_keys(lhs.string, lhs.size, rhs.string, rhs.size) < 0;
+  }
+
+  /**
+   * Moves the items on the scratch stack from `start` into the value array.
+   */
+  value finish_array(size_t start)
+  {
+    const value result = make_value(JSON::ARRAY, m_scratch.size() - start,
+      m_values->size());
+
+    m_values->insert(m_values->end(), m_scratch.begin() +
+      static_cast<ptrdiff_t>(start), m_scratch.end());
+    m_scratch.resize(start);
+
+    return result;
+  }
+
+  /**
+   * Moves the members on the scratch stack from `start` into the value
+   * array, sorted by key, keeping only the last member of each key.
+   */
+  value finish_object(size_t start)
+  {
+    const size_t count = (m_scratch.size() - start) / 2;
+    const value* members = m_scratch.data() + start;
+
+    bool sorted = true;
+    for (size_t i = 1; i < count && sorted; ++i) {
+      sorted = key_less(members[2 * (i - 1)], members[2 * i]);
+    }
+
+    if (sorted) {
+      const value result = make_value(JSON::OBJECT, count, m_values->size());
+      m_values->insert(m_values->end(), m_scratch.begin() +
+        static_cast<ptrdiff_t>(start), m_scratch.end());
+      m_scratch.resize(start);
+      return result;
+    }
+
+    m_order.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+      m_order[i] = i;
+    }
+
+    auto less = [this, members](size_t lhs, size_t rhs) {
+      return key_less(members[2 * lhs], members[2 * rhs]);
+    };
+
+    // Insertion sort is stable too, and spares small objects the temporary
+    // buffer of `std::stable_sort()`.
+    if (count <= 16) {
+      for (size_t i = 1; i < count; ++i) {
+        const size_t index = m_order[i];
+        size_t j = i;
+        for (; j > 0 && less(index, m_order[j - 1]); --j) {
+          m_order[j] = m_order[j - 1];
+        }
+        m_order[j] = index;
+      }
+    } else {
+      std::stable_sort(m_order.begin(), m_order.end(), less);
+    }
+
+    const size_t offset = m_values->size();
+
+    for (size_t i = 0; i < count; ++i) {
+      const value* member = members + 2 * m_order[i];
+
+      if (i + 1 < count && !key_less(*member, members[2 * m_order[i + 1]])) {
+        continue;
+      }
+
+      m_values->push_back(member[0]);
+      m_values->push_back(member[1]);
+    }
+
+    m_scratch.resize(start);
+
+    return make_value(JSON::OBJECT, (m_values->size() - offset) / 2, offset);
+  }
+
+  /**
+   * Gets the next token, either by scanning past whitespace or from the
+   * next position of the index.
+   */
+  template<bool Indexed>
+  char next_token()
+  {
+    if (!Indexed) {
+      return get_next_token();
+    }
+
+    if (m_k == m_position_count) {
+      fail("Unexpected end of input");
+    }
+
+    m_i = m_positions[m_k++];
+
+    return m_str[m_i++];
+  }
+
+  template<bool Indexed>
+  void unget_token()
+  {
+    if (Indexed) {
+      m_k--;
+    } else {
+      m_i--;
+    }
+  }
+
+  /**
+   * Parses the string whose opening quote was the last token. Its closing
+   * quote is the next position of the index, so that only strings with
+   * escape sequences are scanned character by character.
+   */
+  value parse_indexed_string()
+  {
+    const size_t start_pos = m_i;
+    const size_t end_pos = m_positions[m_k++];
+
+    const void* escape = memchr(m_str + start_pos, '\\', end_pos - start_pos);
+
+    if (!escape) {
+      m_i = end_pos + 1;
+      return make_string(start_pos, end_pos - start_pos);
+    }
+
+    m_i = static_cast<size_t>(static_cast<const char*>(escape) - m_str);
+
+    return unescape_string(start_pos);
+  }
+
+  /**
+   * Checks that a number or literal found from the index ends before the
+   * next token, as the characters after it up to the next position of the
+   * index are not visited otherwise.
+   */
+  template<bool Indexed>
+  value check_scalar_end(const value& result)
+  {
+    if (!Indexed || m_i == m_size) {
+      return result;
+    }
+
+    const char ch = m_str[m_i];
+
+    if (ch != ' ' && ch != '\t' && ch != '\n' && ch != '\r' && ch != ',' &&
+      ch != ']' && ch != '}' && ch != ':' && ch != '[' && ch != '{' && ch != '"')
+    {
+      fail("Unexpected " + esc(ch) + " after value");
+    }
+
+    return result;
+  }
+
+  template<bool Indexed>
+  value parse_json(uint32_t depth)
+  {
+    if (depth > json_parser::MAX_DEPTH) {
+      fail("Exceeded maximum nesting depth");
+    }
+
+    char ch = next_token<Indexed>();
+
+    if (ch == '-' || (ch >= '0' && ch <= '9')) {
+      m_i--;
+      return check_scalar_end<Indexed>(parse_number());
+    }
+
+    if (ch == 't') {
+      value result = make_value(JSON::BOOL, 0, 0);
+      result.integer = 1;
+      return check_scalar_end<Indexed>(expect("true", result));
+    }
+
+    if (ch == 'f') {
+      return check_scalar_end<Indexed>(
+        expect("false", make_value(JSON::BOOL, 0, 0)));
+    }
+
+    if (ch == 'n') {
+      return check_scalar_end<Indexed>(
+        expect("null", make_value(JSON::NUL, 0, 0)));
+    }
+
+    if (ch == '"') {
+      return Indexed ? parse_indexed_string() : parse_string();
+    }
+
+    if (ch == '{') {
+      const size_t start = m_scratch.size();
+
+      ch = next_token<Indexed>();
+
+      if (ch == '}') {
+        return finish_object(start);
+      }
+
+      while (true) {
+        if (ch != '"') {
+          fail("Expected '\"' in object, got " + esc(ch));
+        }
+
+        const value key = Indexed ? parse_indexed_string() : parse_string();
+
+        ch = next_token<Indexed>();
+
+        if (ch != ':') {
+          fail("Expected ':' in object, got " + esc(ch));
+        }
+
+        const value item = parse_json<Indexed>(depth + 1);
+
+        m_scratch.push_back(key);
+        m_scratch.push_back(item);
+
+        ch = next_token<Indexed>();
+
+        if (ch == '}') {
+          break;
+        }
+
+        if (ch != ',') {
+          fail("Expected ',' in object, got " + esc(ch));
+        }
+
+        ch = next_token<Indexed>();
+      } /* end `while (true)` */
+
+      return finish_object(start);
+    } /* end `if (char == '{')` */
+
+    if (ch == '[') {
+      const size_t start = m_scratch.size();
+
+      ch = next_token<Indexed>();
+
+      if (ch == ']') {
+        return finish_array(start);
+      }
+
+      while (true) {
+        unget_token<Indexed>();
+
+        const value item = parse_json<Indexed>(depth + 1);
+        m_scratch.push_back(item);
+
+        ch = next_token<Indexed>();
+
+        if (ch == ']') {
+          break;
+        }
+
+        if (ch != ',') {
+          fail("Expected ',' in list, got " + esc(ch));
+        }
+
+        ch = next_token<Indexed>();
+      } /* end `while (true)` */
+
+      return finish_array(start);
+    } /* end `if (ch == '[')` */
+
+    fail("Expected value, got " + esc(ch));
+  }
+
+  char* m_str;
+  const size_t m_size;
+  size_t m_i;
+  std::vector<value>* m_values;
+  const uint32_t* m_positions;
+  size_t m_position_count;
+  size_t m_k;
+  std::vector<value> m_scratch;
+  std::vector<size_t> m_order;
+};
+
+// -----------------------------------------------------------------------------
+
+json_document::json_document()
+  :
+  m_input(),
+  m_values(1, NULL_VALUE),
+  m_root(0)
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+json_view
+json_document::root() const
+{
+  return json_view(m_values.data() + m_root);
+}
+
+// -----------------------------------------------------------------------------
+
+json_document::json_document(const char* data, size_t size)
+  :
+  m_input(),
+  m_values(),
+  m_root(0)
+{
+  // The terminating null character stops scans past the end of the input.
+  m_input.reserve(size + 1);
+  m_input.assign(data, data + size);
+  m_input.push_back('\0');
+}
+
+// -----------------------------------------------------------------------------
+
+json_document
+parse_document(const char* data, size_t size)
+{
+  json_document document(data, size);
+
+  json_document::builder builder(&document.m_input, &document.m_values);
+  document.m_root = builder.build();
+
+  return document;
+}
+
+// -----------------------------------------------------------------------------
+
+json_document
+parse_document(const std::string& in)
+{
+  return parse_document(in.data(), in.size());
+}
+
+// -----------------------------------------------------------------------------
+
+json_document
+parse_indexed_document(const char* data, size_t size)
+{
+  json_document document(data, size);
+
+  json_structural_index index;
+  index.build(document.m_input.data(), size);
+
+  json_document::builder builder(&document.m_input, &document.m_values);
+  document.m_root = builder.build(index);
+
+  return document;
+}
+
+// -----------------------------------------------------------------------------
+
+json_document
+parse_indexed_document(const std::string& in)
+{
+  return parse_indexed_document(in.data(), in.size());
+}
+
+// -----------------------------------------------------------------------------
+
+json_view::json_view()
+  :
+  m_value(&json_document::NULL_VALUE)
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+double
+json_view::number_value() const
+{
+  if (!is_number()) {
+    return 0;
+  }
+
+  return m_value->integral ? static_cast<double>(m_value->integer) :
+    m_value->number;
+}
+
+// -----------------------------------------------------------------------------
+
+int64_t
+json_view::int_value() const
+{
+  if (!is_number()) {
+    return 0;
+  }
+
+  return m_value->integral ? m_value->integer :
+    static_cast<int64_t>(m_value->number);
+}
+
+// -----------------------------------------------------------------------------
+
+bool
+json_view::bool_value() const
+{
+  return is_bool() && m_value->integer != 0;
+}
+
+// -----------------------------------------------------------------------------
+
+std::string
+json_view::string_value() const
+{
+  if (!is_string()) {
+    return std::string();
+  }
+
+  return std::string(string_data(), string_size());
+}
+
+// -----------------------------------------------------------------------------
+
+const char*
+json_view::string_data() const
+{
+  return is_string() ? m_value->string : NULL;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t
+json_view::string_size() const
+{
+  return is_string() ? m_value->size : 0;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t
+json_view::size() const
+{
+  return (is_array() || is_object()) ? m_value->size : 0;
+}
+
+// -----------------------------------------------------------------------------
+
+json_view::range<json_view::item_iterator>
+json_view::array_items() const
+{
+  const size_t count = is_array() ? m_value->size : 0;
+  const json_document::value* begin = count ? m_value->children : m_value;
+
+  return range<item_iterator>(item_iterator(begin),
+    item_iterator(begin + count), count);
+}
+
+// -----------------------------------------------------------------------------
+
+json_view::range<json_view::member_iterator>
+json_view::object_items() const
+{
+  const size_t count = is_object() ? m_value->size : 0;
+  const json_document::value* begin = count ? m_value->children : m_value;
+
+  return range<member_iterator>(member_iterator(begin),
+    member_iterator(begin + 2 * count), count);
+}
+
+// -----------------------------------------------------------------------------
+
+json_view
+json_view::operator[](size_t i) const
+{
+  if (!is_array() || i >= m_value->size) {
+    return json_view();
+  }
+
+  return json_view(m_value->children + i);
+}
+
+// -----------------------------------------------------------------------------
+
+json_view
+json_view::operator[](const std::string& key) const
+{
+  return find(key.data(), key.size());
+}
+
+// -----------------------------------------------------------------------------
+
+json_view
+json_view::find(const char* key, size_t length) const
+{
+  if (!is_object()) {
+    return json_view();
+  }
+
+  const json_document::value* members = m_value->children;
+
+  size_t lower = 0;
+  size_t upper = m_value->size;
+
+  while (lower < upper) {
+    const size_t middle = lower + (upper - lower) / 2;
+    const json_document::value& candidate = members[2 * middle];
+
+    const int result = compare_keys(candidate.string, candidate.size, key,
+      length);
+
+    if (result == 0) {
+      return json_view(members + 2 * middle + 1);
+    }
+
+    if (result < 0) {
+      lower = middle + 1;
+    } else {
+      upper = middle;
+    }
+  }
+
+  return json_view();
+}
+
+// -----------------------------------------------------------------------------
+
+JSON
+json_view::to_json() const
+{
+  switch (type()) {
+    case JSON::NUMBER:
+      return m_value->integral ? JSON::from_int64(m_value->integer) :
+        JSON(m_value->number);
+    case JSON::BOOL:
+      return JSON(bool_value());
+    case JSON::STRING:
+      return JSON(string_value());
+    case JSON::ARRAY:
+      {
+        JSON::array items;
+        items.reserve(size());
+        for (const json_view item : array_items()) {
+          items.push_back(item.to_json());
+        }
+        return JSON(std::move(items));
+      }
+    case JSON::OBJECT:
+      {
+        JSON::object members;
+        for (const member item : object_items()) {
+          members.emplace_hint(members.end(), item.first.string_value(),
+            item.second.to_json());
+        }
+        return JSON(std::move(members));
+      }
+    case JSON::NUL:
+      return JSON();
+  }
+
+  return JSON();
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace json */
+
+
+} /* end namespace sneaker */
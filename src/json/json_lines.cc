@@ -0,0 +1,506 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "json/json_lines.h"
+
+#include "io/input_stream.h"
+#include "json/json.h"
+#include "threading/worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace sneaker {
+
+
+namespace json {
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+using sneaker::threading::worker_pool;
+
+/**
+ * The number of lines claimed at once by each thread.
+ */
+const size_t GRAIN = 16;
+
+/**
+ * The number of lines per thread whose records are held at once until they
+ * are delivered in order.
+ */
+const size_t WINDOW = 256;
+
+// -----------------------------------------------------------------------------
+
+bool
+is_blank(const char* data, size_t size)
+{
+  for (size_t i = 0; i < size; ++i) {
+    if (data[i] != ' ' && data[i] != '\t' && data[i] != '\r') {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Finds the position after the last newline in the range, or `begin` if
+ * there is none.
+ */
+const char*
+after_last_newline(const char* begin, const char* end)
+{
+  while (end != begin && end[-1] != '\n') {
+    --end;
+  }
+
+  return end;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Parses blocks of complete lines on a pool of threads, and delivers their
+ * records and errors. Every block is parsed in the background while the
+ * calling thread reads the next one, and its records are delivered as its
+ * lines are parsed, from the next call to `parse()` or `finish()`, during
+ * which the calling thread parses lines as well. The lines of a block must
+ * stay valid until then.
+ */
+class block_parser
+{
+public:
+  block_parser(size_t thread_count, json_lines_reader::delivery order,
+    const json_lines_reader::record_callback& on_record,
+    const json_lines_reader::error_callback& on_error)
+    :
+    m_order(order),
+    m_on_record(on_record),
+    m_on_error(on_error),
+    m_batches(),
+    m_current(0),
+    m_pending(false),
+    m_window_grains(std::max<size_t>(WINDOW * thread_count / GRAIN, 1)),
+    m_next_grain(0),
+    m_delivered_grains(0),
+    m_failed(false),
+    m_summary(),
+    m_pool(thread_count)
+  {
+    // Do nothing here.
+  }
+
+  /**
+   * Delivers the records of the previous block, and then starts parsing the
+   * lines of the range, the last of which may lack a newline if it is the
+   * last of the input.
+   */
+  void parse(const char* begin, const char* end)
+  {
+    const size_t current = 1 - m_current;
+    batch& lines = m_batches[current];
+
+    lines.lines.clear();
+
+    while (begin != end) {
+      const char* newline = static_cast<const char*>(
+        memchr(begin, '\n', static_cast<size_t>(end - begin)));
+      const char* line_end = newline ? newline : end;
+
+      ++m_summary.line_count;
+
+      size_t size = static_cast<size_t>(line_end - begin);
+      if (size && begin[size - 1] == '\r') {
+        --size;
+      }
+
+      if (!is_blank(begin, size)) {
+        const line item = { begin, size, m_summary.line_count };
+        lines.lines.push_back(item);
+      }
+
+      begin = newline ? newline + 1 : end;
+    }
+
+    const size_t count = lines.lines.size();
+    const size_t grain_count = (count + GRAIN - 1) / GRAIN;
+
+    lines.parsed.assign(count, 0);
+    if (m_order == json_lines_reader::delivery::ORDERED) {
+      lines.records.resize(count);
+      lines.errors.resize(count);
+    }
+
+    if (lines.parsed_grains.size() < grain_count) {
+      std::vector<std::atomic<uint8_t>> parsed_grains(grain_count);
+      lines.parsed_grains.swap(parsed_grains);
+    }
+
+    for (size_t grain = 0; grain < grain_count; ++grain) {
+      lines.parsed_grains[grain].store(0, std::memory_order_relaxed);
+    }
+
+    finish();
+
+    m_current = current;
+    m_pending = true;
+    m_next_grain.store(0, std::memory_order_relaxed);
+    m_delivered_grains.store(0, std::memory_order_relaxed);
+    m_failed.store(false, std::memory_order_relaxed);
+
+    m_pool.start(m_pool.thread_count(), [this, &lines](size_t) {
+      parse_lines(lines);
+    });
+  }
+
+  /**
+   * Delivers the records of the block being parsed, if any, as its lines
+   * are parsed.
+   */
+  void finish()
+  {
+    if (m_pending) {
+      m_pending = false;
+      deliver(m_batches[m_current]);
+    }
+
+    m_pool.wait();
+  }
+
+  const json_lines_reader::summary& summary() const
+  {
+    return m_summary;
+  }
+
+private:
+  struct line
+  {
+    const char* data;
+    size_t size;
+    size_t number;
+  };
+
+  /**
+   * The lines of a block, and their records or errors until they are
+   * delivered in order.
+   */
+  struct batch
+  {
+    std::vector<line> lines;
+    std::vector<uint8_t> parsed;
+    std::vector<JSON> records;
+    std::vector<std::string> errors;
+
+    /**
+     * Set once every line of a grain is parsed.
+     */
+    std::vector<std::atomic<uint8_t>> parsed_grains;
+  };
+
+  void parse_lines(batch& lines)
+  {
+    const size_t grain_count = (lines.lines.size() + GRAIN - 1) / GRAIN;
+
+    while (!m_failed.load(std::memory_order_relaxed)) {
+      const size_t grain = m_next_grain.fetch_add(1,
+        std::memory_order_relaxed);
+      if (grain >= grain_count) {
+        return;
+      }
+
+      // Records are held until they are delivered, so they are parsed
+      // within a window of the lines delivered, which keeps them in cache.
+      while (m_order == json_lines_reader::delivery::ORDERED &&
+        grain >= m_delivered_grains.load(std::memory_order_acquire) +
+          m_window_grains)
+      {
+        if (m_failed.load(std::memory_order_relaxed)) {
+          return;
+        }
+        std::this_thread::yield();
+      }
+
+      parse_grain(lines, grain);
+    }
+  }
+
+  void parse_grain(batch& lines, size_t grain)
+  {
+    const bool ordered = m_order == json_lines_reader::delivery::ORDERED;
+    const size_t last = std::min((grain + 1) * GRAIN, lines.lines.size());
+
+    for (size_t i = grain * GRAIN; i < last; ++i) {
+      const line& item = lines.lines[i];
+
+      JSON record;
+      try {
+        record = json::parse(item.data, item.size);
+      } catch (const invalid_json_error& err) {
+        if (ordered) {
+          lines.errors[i] = err.what();
+        } else {
+          m_on_error(item.number, err.what());
+        }
+        continue;
+      } catch (...) {
+        // Such as `std::bad_alloc`, which stops the other threads.
+        m_failed.store(true, std::memory_order_relaxed);
+        throw;
+      }
+
+      lines.parsed[i] = 1;
+
+      if (ordered) {
+        lines.records[i] = std::move(record);
+      } else {
+        m_on_record(item.number, record);
+      }
+    }
+
+    lines.parsed_grains[grain].store(1, std::memory_order_release);
+  }
+
+  void deliver(batch& lines)
+  {
+    const bool ordered = m_order == json_lines_reader::delivery::ORDERED;
+    const size_t count = lines.lines.size();
+    const size_t grain_count = (count + GRAIN - 1) / GRAIN;
+
+    try {
+      for (size_t grain = 0; grain < grain_count; ++grain) {
+        while (!lines.parsed_grains[grain].load(std::memory_order_acquire)) {
+          if (m_failed.load(std::memory_order_relaxed)) {
+            // Rethrows the exception of the thread that failed.
+            m_pool.wait();
+          }
+
+          // Parses the next grain within the window rather than wait.
+          size_t next = m_next_grain.load(std::memory_order_relaxed);
+          if (next < std::min(grain_count, grain + m_window_grains) &&
+            m_next_grain.compare_exchange_weak(next, next + 1,
+              std::memory_order_relaxed))
+          {
+            parse_grain(lines, next);
+          } else {
+            std::this_thread::yield();
+          }
+        }
+
+        const size_t last = std::min((grain + 1) * GRAIN, count);
+
+        for (size_t i = grain * GRAIN; i < last; ++i) {
+          const size_t number = lines.lines[i].number;
+
+          if (lines.parsed[i]) {
+            ++m_summary.record_count;
+            if (ordered) {
+              m_on_record(number, lines.records[i]);
+              lines.records[i] = JSON();
+            }
+          } else {
+            ++m_summary.error_count;
+            if (ordered) {
+              m_on_error(number, lines.errors[i]);
+            }
+          }
+        }
+
+        m_delivered_grains.store(grain + 1, std::memory_order_release);
+      }
+    } catch (...) {
+      // Stops the threads, which may be waiting for records to be delivered.
+      m_failed.store(true, std::memory_order_relaxed);
+      throw;
+    }
+  }
+
+  json_lines_reader::delivery m_order;
+  const json_lines_reader::record_callback& m_on_record;
+  const json_lines_reader::error_callback& m_on_error;
+
+  /**
+   * The block being parsed, and the next one being cut into lines.
+   */
+  batch m_batches[2];
+  size_t m_current;
+  bool m_pending;
+  size_t m_window_grains;
+  std::atomic<size_t> m_next_grain;
+  std::atomic<size_t> m_delivered_grains;
+  std::atomic<bool> m_failed;
+  json_lines_reader::summary m_summary;
+
+  /**
+   * Declared last so that it waits for the block being parsed before the
+   * batches are destroyed, such as when a callback throws.
+   */
+  worker_pool m_pool;
+};
+
+} /* anonymous namespace */
+
+
+// -----------------------------------------------------------------------------
+
+constexpr size_t json_lines_reader::DEFAULT_BLOCK_SIZE;
+
+// -----------------------------------------------------------------------------
+
+json_lines_reader::json_lines_reader(size_t thread_count, delivery order,
+  size_t block_size)
+  :
+  m_thread_count(thread_count),
+  m_order(order),
+  m_block_size(std::max<size_t>(block_size, 1))
+{
+  if (m_thread_count == 0) {
+    m_thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+json_lines_reader::summary
+json_lines_reader::read(io::input_stream* stream,
+  const record_callback& on_record, const error_callback& on_error) const
+{
+  // Chunks smaller than a block are gathered into one of the buffers, and
+  // only the partial line after the last newline is carried over to the
+  // other one once the block is handed over, so that the next block is
+  // gathered while it is parsed.
+  std::string buffers[2];
+  std::string* buffer = &buffers[0];
+
+  auto other_buffer = [&buffers, &buffer]() {
+    return buffer == &buffers[0] ? &buffers[1] : &buffers[0];
+  };
+
+  block_parser parser(m_thread_count, m_order, on_record, on_error);
+
+  // Cuts a range of complete lines into blocks at line boundaries.
+  auto parse_blocks = [this, &parser](const char* begin, const char* end) {
+    while (begin != end) {
+      const char* block_end = end;
+
+      if (static_cast<size_t>(end - begin) > m_block_size) {
+        const char* newline = static_cast<const char*>(memchr(
+          begin + m_block_size - 1, '\n',
+          static_cast<size_t>(end - begin) - (m_block_size - 1)));
+        block_end = newline ? newline + 1 : end;
+      }
+
+      parser.parse(begin, block_end);
+      begin = block_end;
+    }
+  };
+
+  const uint8_t* data = NULL;
+  size_t len = 0;
+
+  while (stream->next(&data, &len)) {
+    const char* begin = reinterpret_cast<const char*>(data);
+    const char* end = begin + len;
+
+    if (len < m_block_size) {
+      buffer->append(begin, end);
+
+      if (buffer->size() >= m_block_size) {
+        const char* buffer_begin = buffer->data();
+        const char* buffer_end = buffer_begin + buffer->size();
+        const char* tail = after_last_newline(buffer_begin, buffer_end);
+
+        if (tail != buffer_begin) {
+          parse_blocks(buffer_begin, tail);
+
+          // The other buffer is no longer parsed once this one is.
+          std::string* other = other_buffer();
+          other->assign(tail, buffer_end);
+          buffer = other;
+        }
+      }
+
+      continue;
+    }
+
+    // The chunk holds whole blocks, which are parsed in place once the line
+    // gathered before it, if any, is completed.
+    if (!buffer->empty()) {
+      const char* newline = static_cast<const char*>(memchr(begin, '\n', len));
+      if (!newline) {
+        buffer->append(begin, end);
+        continue;
+      }
+
+      buffer->append(begin, newline + 1);
+      parse_blocks(buffer->data(), buffer->data() + buffer->size());
+      buffer = other_buffer();
+      buffer->clear();
+
+      begin = newline + 1;
+    }
+
+    const char* tail = after_last_newline(begin, end);
+    parse_blocks(begin, tail);
+
+    // The stream may reuse the memory of the chunk for the next one.
+    parser.finish();
+
+    buffer->assign(tail, end);
+  }
+
+  parse_blocks(buffer->data(), buffer->data() + buffer->size());
+  parser.finish();
+
+  return parser.summary();
+}
+
+// -----------------------------------------------------------------------------
+
+json_lines_reader::summary
+json_lines_reader::read_file(const char* filename,
+  const record_callback& on_record, const error_callback& on_error) const
+{
+  std::unique_ptr<io::input_stream> stream = io::mmap_input_stream(filename);
+
+  return read(stream.get(), on_record, on_error);
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace json */
+
+
+} /* end namespace sneaker */
@@ -143,8 +143,10 @@ json_parser::parse_number()
   if (str[i] != '.' && str[i] != 'e' && str[i] != 'E' &&
     (i - start_pos - 1) <= static_cast<size_t>(std::numeric_limits<int64_t>::digits10))
   {
-    return JSON::from_int64(
-      static_cast<int64_t>(std::atoll(str.c_str() + start_pos)));
+    // The input may not be null-terminated, so the number is converted from
+    // a copy.
+    return JSON::from_int64(static_cast<int64_t>(
+      std::atoll(str.substr(start_pos, i - start_pos).c_str())));
   }
 
   // Decimal part.
@@ -175,7 +177,7 @@ json_parser::parse_number()
     i++;
   }
 
-  return JSON(std::atof(str.c_str() + start_pos));
+  return JSON(std::atof(str.substr(start_pos, i - start_pos).c_str()));
 }
 
 // -----------------------------------------------------------------------------
@@ -287,6 +289,68 @@ json_parser::parse_string()
 
 // -----------------------------------------------------------------------------
 
+JSON
+json_parser::parse_string_slice()
+{
+  const size_t start_pos = i;
+  bool escaped = false;
+
+  // Validates the string as `parse_string()` does, without unescaping it.
+  while (true) {
+    if (i == str.size()) {
+      return fail("Unexpected end of input in string");
+    }
+
+    char ch = str[i++];
+
+    if (ch == '"') {
+      break;
+    }
+
+    if (in_range(ch, 0, 0x1f)) {
+      return fail("Unescaped " + esc(ch) + " in string");
+    }
+
+    if (ch != '\\') {
+      continue;
+    }
+
+    escaped = true;
+
+    if (i == str.size()) {
+      return fail("Unexpected end of input in string");
+    }
+
+    ch = str[i++];
+
+    if (ch == 'u') {
+      const std::string digits = str.substr(i, 4);
+
+      for (size_t j = 0; j < 4; j++) {
+        if (j >= digits.size() || (!in_range(digits[j], 'a', 'f') &&
+          !in_range(digits[j], 'A', 'F') && !in_range(digits[j], '0', '9')))
+        {
+          return fail("Bad \\u escape: " + digits);
+        }
+      }
+
+      i += 4;
+
+      continue;
+    }
+
+    if (ch != 'b' && ch != 'f' && ch != 'n' && ch != 'r' && ch != 't' &&
+      ch != '"' && ch != '\\' && ch != '/')
+    {
+      return fail("Invalid escape character " + esc(ch));
+    }
+  } /* end of `while (true)` */
+
+  return JSON::from_source(source, start_pos, i - 1 - start_pos, escaped);
+}
+
+// -----------------------------------------------------------------------------
+
 JSON
 json_parser::parse_json()
 {
@@ -338,6 +402,9 @@ json_parser::parse_json(uint32_t depth)
   }
 
   if (ch == '"') {
+    if (source) {
+      return parse_string_slice();
+    }
     return parse_string();
   }
 
@@ -0,0 +1,773 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "json/json_sax.h"
+
+#include "io/input_stream.h"
+#include "json/json.h"
+#include "json/json_parser.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace sneaker {
+
+
+namespace json {
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+bool
+in_range(long x, long lower, long upper)
+{
+  return (x >= lower && x <= upper);
+}
+
+// -----------------------------------------------------------------------------
+
+bool
+is_digit(char ch)
+{
+  return in_range(ch, '0', '9');
+}
+
+// -----------------------------------------------------------------------------
+
+std::string
+esc(char c)
+{
+  char buf[12];
+
+  if (static_cast<uint8_t>(c) >= 0x20 && static_cast<uint8_t>(c) <= 0x7f) {
+    snprintf(buf, sizeof buf, "'%c' (%d)", c, c);
+  } else {
+    snprintf(buf, sizeof buf, "(%d)", c);
+  }
+
+  return std::string(buf);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Same as `json_parser::encode_utf8()`.
+ */
+void
+encode_utf8(long pt, std::string& out)
+{
+  if (pt < 0) {
+    return;
+  }
+
+  if (pt < 0x80) {
+    out += static_cast<char>(pt);
+  } else if (pt < 0x800) {
+    out += static_cast<char>((pt >> 6) | 0xC0);
+    out += static_cast<char>((pt & 0x3F) | 0x80);
+  } else if (pt < 0x10000) {
+    out += static_cast<char>((pt >> 12) | 0xE0);
+    out += static_cast<char>(((pt >> 6) & 0x3F) | 0x80);
+    out += static_cast<char>((pt & 0x3F) | 0x80);
+  } else {
+    out += static_cast<char>((pt >> 18) | 0xF0);
+    out += static_cast<char>(((pt >> 12) & 0x3F) | 0x80);
+    out += static_cast<char>(((pt >> 6) & 0x3F) | 0x80);
+    out += static_cast<char>((pt & 0x3F) | 0x80);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Finds the first quote, backslash or control character in the range, or
+ * `end` if there is none.
+ */
+const char*
+scan_string(const char* p, const char* end)
+{
+#if defined(__SSE2__)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i max_control = _mm_set1_epi8(0x1F);
+
+  while (end - p >= 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+
+    const int mask = _mm_movemask_epi8(_mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+        _mm_cmpeq_epi8(chunk, backslash)),
+      _mm_cmpeq_epi8(_mm_max_epu8(chunk, max_control), max_control)));
+
+    if (mask) {
+      return p + __builtin_ctz(static_cast<unsigned int>(mask));
+    }
+
+    p += 16;
+  }
+#endif
+
+  while (p != end && *p != '"' && *p != '\\' && !in_range(*p, 0, 0x1f)) {
+    ++p;
+  }
+
+  return p;
+}
+
+} /* anonymous namespace */
+
+
+// -----------------------------------------------------------------------------
+
+json_sax_handler::~json_sax_handler()
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+json_sax_parser::json_sax_parser(json_sax_handler* handler,
+  bool multiple_values)
+  :
+  m_handler(handler),
+  m_multiple_values(multiple_values),
+  m_state(state::ROOT),
+  m_number_part(number_part::START),
+  m_in_key(false),
+  m_string_copied(false),
+  m_span(NULL),
+  m_containers(),
+  m_token(),
+  m_literal(NULL),
+  m_literal_size(0),
+  m_hex(),
+  m_hex_size(0),
+  m_last_escaped_codepoint(-1),
+  m_error(),
+  m_bytes_parsed(0)
+{
+  m_containers.reserve(json_parser::MAX_DEPTH + 1);
+}
+
+// -----------------------------------------------------------------------------
+
+void
+json_sax_parser::reset()
+{
+  m_state = state::ROOT;
+  m_containers.clear();
+  m_token.clear();
+  m_error.clear();
+  m_bytes_parsed = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+void
+json_sax_parser::fail(const std::string& msg)
+{
+  m_state = state::FAILED;
+  m_error = msg;
+
+  throw invalid_json_error(msg);
+}
+
+// -----------------------------------------------------------------------------
+
+void
+json_sax_parser::feed(const char* data, size_t size)
+{
+  if (m_state == state::FAILED) {
+    throw invalid_json_error(m_error);
+  }
+
+  m_bytes_parsed += size;
+
+  const char* p = data;
+  const char* const end = data + size;
+
+  if (m_state == state::STRING) {
+    m_span = p;
+  }
+
+  while (p != end) {
+    switch (m_state) {
+      case state::STRING:
+        p = parse_string(p, end);
+        break;
+      case state::ESCAPE:
+        p = parse_escape(p);
+        break;
+      case state::UNICODE_ESCAPE:
+        p = parse_unicode_escape(p, end);
+        break;
+      case state::NUMBER:
+        p = parse_number(p, end);
+        break;
+      case state::LITERAL:
+        p = parse_literal(p, end);
+        break;
+      case state::ROOT:
+      case state::VALUE:
+      case state::VALUE_OR_END_ARRAY:
+      case state::KEY:
+      case state::KEY_OR_END_OBJECT:
+      case state::COLON:
+      case state::COMMA_OR_END:
+      case state::DONE:
+      case state::FAILED:
+        p = parse_structural(p);
+        break;
+    }
+  }
+
+  // The bytes of a string that continues in the next chunk are kept, since
+  // the chunk they are in may not outlive this call.
+  if (m_state == state::STRING) {
+    append_span(end);
+    m_string_copied = true;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void
+json_sax_parser::finish()
+{
+  if (m_state == state::FAILED) {
+    throw invalid_json_error(m_error);
+  }
+
+  // Numbers are only known to end at the character after them.
+  if (m_state == state::NUMBER) {
+    if (m_number_part == number_part::ZERO ||
+      m_number_part == number_part::INTEGER ||
+      m_number_part == number_part::FRACTION ||
+      m_number_part == number_part::EXPONENT)
+    {
+      end_number();
+    }
+  }
+
+  if (m_state == state::DONE) {
+    return;
+  }
+
+  if (m_state == state::ROOT && m_multiple_values) {
+    return;
+  }
+
+  if (m_state == state::STRING || m_state == state::ESCAPE ||
+    m_state == state::UNICODE_ESCAPE)
+  {
+    fail("Unexpected end of input in string");
+  }
+
+  fail("Unexpected end of input");
+}
+
+// -----------------------------------------------------------------------------
+
+const char*
+json_sax_parser::parse_structural(const char* p)
+{
+  const char ch = *p;
+
+  if (ch == ' ' || ch == '\r' || ch == '\n' || ch == '\t') {
+    return p + 1;
+  }
+
+  switch (m_state) {
+    case state::ROOT:
+      if (ch == '"' || ch == '-' || is_digit(ch) || ch == 't' || ch == 'f' ||
+        ch == 'n')
+      {
+        fail("Invalid JSON. Expecting [ or {");
+      }
+      return begin_value(p);
+
+    case state::VALUE:
+      return begin_value(p);
+
+    case state::VALUE_OR_END_ARRAY:
+      if (ch == ']') {
+        m_containers.pop_back();
+        m_handler->end_array();
+        end_value();
+        return p + 1;
+      }
+      return begin_value(p);
+
+    case state::KEY_OR_END_OBJECT:
+    case state::KEY:
+      if (m_state == state::KEY_OR_END_OBJECT && ch == '}') {
+        m_containers.pop_back();
+        m_handler->end_object();
+        end_value();
+        return p + 1;
+      }
+      if (ch != '"') {
+        fail("Expected '\"' in object, got " + esc(ch));
+      }
+      begin_string(true);
+      m_span = p + 1;
+      return p + 1;
+
+    case state::COLON:
+      if (ch != ':') {
+        fail("Expected ':' in object, got " + esc(ch));
+      }
+      m_state = state::VALUE;
+      return p + 1;
+
+    case state::COMMA_OR_END:
+      if (m_containers.back() == '[') {
+        if (ch == ']') {
+          m_containers.pop_back();
+          m_handler->end_array();
+          end_value();
+        } else if (ch == ',') {
+          m_state = state::VALUE;
+        } else {
+          fail("Expected ',' in list, got " + esc(ch));
+        }
+      } else {
+        if (ch == '}') {
+          m_containers.pop_back();
+          m_handler->end_object();
+          end_value();
+        } else if (ch == ',') {
+          m_state = state::KEY;
+        } else {
+          fail("Expected ',' in object, got " + esc(ch));
+        }
+      }
+      return p + 1;
+
+    case state::DONE:
+      fail("Unexpected trailing " + esc(ch));
+
+    case state::STRING:
+    case state::ESCAPE:
+    case state::UNICODE_ESCAPE:
+    case state::NUMBER:
+    case state::LITERAL:
+    case state::FAILED:
+      break;
+  }
+
+  fail("Invalid state");
+}
+
+// -----------------------------------------------------------------------------
+
+const char*
+json_sax_parser::begin_value(const char* p)
+{
+  if (m_containers.size() > json_parser::MAX_DEPTH) {
+    fail("Exceeded maximum nesting depth");
+  }
+
+  const char ch = *p;
+
+  if (ch == '{') {
+    m_containers.push_back('{');
+    m_state = state::KEY_OR_END_OBJECT;
+    m_handler->start_object();
+    return p + 1;
+  }
+
+  if (ch == '[') {
+    m_containers.push_back('[');
+    m_state = state::VALUE_OR_END_ARRAY;
+    m_handler->start_array();
+    return p + 1;
+  }
+
+  if (ch == '"') {
+    begin_string(false);
+    m_span = p + 1;
+    return p + 1;
+  }
+
+  if (ch == '-' || is_digit(ch)) {
+    m_state = state::NUMBER;
+    m_number_part = number_part::START;
+    m_token.clear();
+    return p;
+  }
+
+  if (ch == 't' || ch == 'f' || ch == 'n') {
+    m_literal = (ch == 't') ? "true" : (ch == 'f' ? "false" : "null");
+    m_literal_size = strlen(m_literal);
+    m_state = state::LITERAL;
+    m_token.assign(1, ch);
+    return p + 1;
+  }
+
+  fail("Expected value, got " + esc(ch));
+}
+
+// -----------------------------------------------------------------------------
+
+void
+json_sax_parser::end_value()
+{
+  if (!m_containers.empty()) {
+    m_state = state::COMMA_OR_END;
+  } else {
+    m_state = m_multiple_values ? state::ROOT : state::DONE;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void
+json_sax_parser::begin_string(bool in_key)
+{
+  m_state = state::STRING;
+  m_in_key = in_key;
+  m_string_copied = false;
+  m_token.clear();
+  m_last_escaped_codepoint = -1;
+}
+
+// -----------------------------------------------------------------------------
+
+const char*
+json_sax_parser::parse_string(const char* p, const char* end)
+{
+  p = scan_string(p, end);
+
+  if (p == end) {
+    return p;
+  }
+
+  const char ch = *p;
+
+  if (ch == '"') {
+    const char* data = m_span;
+    size_t size = static_cast<size_t>(p - m_span);
+
+    // Strings without escape sequences that lie within a single chunk are
+    // reported in place.
+    if (m_string_copied) {
+      append_span(p);
+      flush_codepoint();
+      data = m_token.data();
+      size = m_token.size();
+    }
+
+    if (m_in_key) {
+      m_handler->key(data, size);
+      m_state = state::COLON;
+    } else {
+      m_handler->string_value(data, size);
+      end_value();
+    }
+
+    return p + 1;
+  }
+
+  if (ch == '\\') {
+    append_span(p);
+    m_string_copied = true;
+    m_state = state::ESCAPE;
+    return p + 1;
+  }
+
+  fail("Unescaped " + esc(ch) + " in string");
+}
+
+// -----------------------------------------------------------------------------
+
+const char*
+json_sax_parser::parse_escape(const char* p)
+{
+  const char ch = *p;
+
+  if (ch == 'u') {
+    m_state = state::UNICODE_ESCAPE;
+    m_hex_size = 0;
+    return p + 1;
+  }
+
+  flush_codepoint();
+
+  if (ch == 'b') {
+    m_token += '\b';
+  } else if (ch == 'f') {
+    m_token += '\f';
+  } else if (ch == 'n') {
+    m_token += '\n';
+  } else if (ch == 'r') {
+    m_token += '\r';
+  } else if (ch == 't') {
+    m_token += '\t';
+  } else if (ch == '"' || ch == '\\' || ch == '/') {
+    m_token += ch;
+  } else {
+    fail("Invalid escape character " + esc(ch));
+  }
+
+  m_state = state::STRING;
+  m_span = p + 1;
+
+  return p + 1;
+}
+
+// -----------------------------------------------------------------------------
+
+const char*
+json_sax_parser::parse_unicode_escape(const char* p, const char* end)
+{
+  while (p != end && m_hex_size < 4) {
+    const char ch = *p;
+
+    if (!in_range(ch, 'a', 'f') && !in_range(ch, 'A', 'F') && !is_digit(ch)) {
+      fail("Bad \\u escape: " + std::string(m_hex, m_hex_size) + ch);
+    }
+
+    m_hex[m_hex_size++] = ch;
+    ++p;
+  }
+
+  if (m_hex_size < 4) {
+    return p;
+  }
+
+  m_hex[4] = 0;
+
+  const long codepoint = strtol(m_hex, nullptr, 16);
+
+  // Surrogate pairs are reassembled as in `json_parser::parse_string()`.
+  if (in_range(m_last_escaped_codepoint, 0xD800, 0xDBFF) &&
+    in_range(codepoint, 0xDC00, 0xDFFF))
+  {
+    encode_utf8((((m_last_escaped_codepoint - 0xD800) << 10) |
+      (codepoint - 0xDC00)) + 0x10000, m_token);
+    m_last_escaped_codepoint = -1;
+  } else {
+    flush_codepoint();
+    m_last_escaped_codepoint = codepoint;
+  }
+
+  m_state = state::STRING;
+  m_span = p;
+
+  return p;
+}
+
+// -----------------------------------------------------------------------------
+
+const char*
+json_sax_parser::parse_number(const char* p, const char* end)
+{
+  const char* start = p;
+
+  for (; p != end; ++p) {
+    const char ch = *p;
+
+    switch (m_number_part) {
+      case number_part::START:
+      case number_part::MINUS:
+        if (m_number_part == number_part::START && ch == '-') {
+          m_number_part = number_part::MINUS;
+        } else if (ch == '0') {
+          m_number_part = number_part::ZERO;
+        } else if (in_range(ch, '1', '9')) {
+          m_number_part = number_part::INTEGER;
+        } else {
+          fail("Invalid " + esc(ch) + " in number");
+        }
+        continue;
+
+      case number_part::ZERO:
+      case number_part::INTEGER:
+        if (is_digit(ch)) {
+          if (m_number_part == number_part::ZERO) {
+            fail("Leading 0s not permitted in numbers");
+          }
+          continue;
+        }
+        if (ch == '.') {
+          m_number_part = number_part::FRACTION_START;
+          continue;
+        }
+        if (ch == 'e' || ch == 'E') {
+          m_number_part = number_part::EXPONENT_START;
+          continue;
+        }
+        break;
+
+      case number_part::FRACTION_START:
+        if (!is_digit(ch)) {
+          fail("At least one digit required in fractional part");
+        }
+        m_number_part = number_part::FRACTION;
+        continue;
+
+      case number_part::FRACTION:
+        if (is_digit(ch)) {
+          continue;
+        }
+        if (ch == 'e' || ch == 'E') {
+          m_number_part = number_part::EXPONENT_START;
+          continue;
+        }
+        break;
+
+      case number_part::EXPONENT_START:
+      case number_part::EXPONENT_SIGN:
+        if (m_number_part == number_part::EXPONENT_START &&
+          (ch == '+' || ch == '-'))
+        {
+          m_number_part = number_part::EXPONENT_SIGN;
+          continue;
+        }
+        if (!is_digit(ch)) {
+          fail("At least one digit required in exponent");
+        }
+        m_number_part = number_part::EXPONENT;
+        continue;
+
+      case number_part::EXPONENT:
+        if (is_digit(ch)) {
+          continue;
+        }
+        break;
+    }
+
+    // The number ends before the current character.
+    m_token.append(start, p);
+    end_number();
+    return p;
+  }
+
+  m_token.append(start, p);
+
+  return p;
+}
+
+// -----------------------------------------------------------------------------
+
+void
+json_sax_parser::end_number()
+{
+  if (m_token.find_first_of(".eE") == std::string::npos &&
+    m_token.size() - 1 <=
+      static_cast<size_t>(std::numeric_limits<int64_t>::digits10))
+  {
+    m_handler->int_value(static_cast<int64_t>(std::atoll(m_token.c_str())));
+  } else {
+    m_handler->number_value(std::atof(m_token.c_str()));
+  }
+
+  end_value();
+}
+
+// -----------------------------------------------------------------------------
+
+const char*
+json_sax_parser::parse_literal(const char* p, const char* end)
+{
+  while (p != end && m_token.size() < m_literal_size) {
+    if (*p != m_literal[m_token.size()]) {
+      fail("Parse error: expected " + std::string(m_literal) + ", got " +
+        m_token + *p);
+    }
+
+    m_token += *p++;
+  }
+
+  if (m_token.size() < m_literal_size) {
+    return p;
+  }
+
+  if (m_literal[0] == 'n') {
+    m_handler->null_value();
+  } else {
+    m_handler->bool_value(m_literal[0] == 't');
+  }
+
+  end_value();
+
+  return p;
+}
+
+// -----------------------------------------------------------------------------
+
+void
+json_sax_parser::append_span(const char* p)
+{
+  if (p != m_span) {
+    flush_codepoint();
+    m_token.append(m_span, p);
+  }
+
+  m_span = p;
+}
+
+// -----------------------------------------------------------------------------
+
+void
+json_sax_parser::flush_codepoint()
+{
+  encode_utf8(m_last_escaped_codepoint, m_token);
+  m_last_escaped_codepoint = -1;
+}
+
+// -----------------------------------------------------------------------------
+
+void
+parse_sax(io::input_stream* stream, json_sax_handler* handler,
+  bool multiple_values)
+{
+  json_sax_parser parser(handler, multiple_values);
+
+  const uint8_t* data = NULL;
+  size_t len = 0;
+
+  while (stream->next(&data, &len)) {
+    parser.feed(reinterpret_cast<const char*>(data), len);
+  }
+
+  parser.finish();
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace json */
+
+
+} /* end namespace sneaker */
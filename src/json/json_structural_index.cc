@@ -0,0 +1,317 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "json/json_structural_index.h"
+
+#include "json/json.h"
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace sneaker {
+
+
+namespace json {
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t BLOCK_SIZE = 64;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Bit masks of the character classes of a block, where bit `i` stands for
+ * the `i`-th character of the block.
+ */
+struct block_masks
+{
+  uint64_t backslash;
+  uint64_t quote;
+  uint64_t whitespace;
+  uint64_t structural;
+  uint64_t control;
+};
+
+// -----------------------------------------------------------------------------
+
+void
+classify_scalar(const char* block, block_masks* masks)
+{
+  *masks = block_masks();
+
+  for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+    const uint8_t ch = static_cast<uint8_t>(block[i]);
+    const uint64_t bit = uint64_t(1) << i;
+
+    switch (ch) {
+      case '\\':
+        masks->backslash |= bit;
+        break;
+      case '"':
+        masks->quote |= bit;
+        break;
+      case ' ':
+        masks->whitespace |= bit;
+        break;
+      case '\t':
+      case '\n':
+      case '\r':
+        masks->whitespace |= bit;
+        masks->control |= bit;
+        break;
+      case '{':
+      case '}':
+      case '[':
+      case ']':
+      case ':':
+      case ',':
+        masks->structural |= bit;
+        break;
+      default:
+        if (ch < 0x20) {
+          masks->control |= bit;
+        }
+        break;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+#if defined(__SSE2__)
+
+uint64_t
+match(__m128i chunk, char ch)
+{
+  return static_cast<uint16_t>(
+    _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(ch))));
+}
+
+// -----------------------------------------------------------------------------
+
+void
+classify_simd(const char* block, block_masks* masks)
+{
+  *masks = block_masks();
+
+  const __m128i max_control = _mm_set1_epi8(0x1F);
+
+  for (size_t i = 0; i < BLOCK_SIZE; i += 16) {
+    const __m128i chunk =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+
+    const uint64_t control = static_cast<uint16_t>(_mm_movemask_epi8(
+      _mm_cmpeq_epi8(_mm_max_epu8(chunk, max_control), max_control)));
+
+    masks->backslash |= match(chunk, '\\') << i;
+    masks->quote |= match(chunk, '"') << i;
+    masks->whitespace |= (match(chunk, ' ') | match(chunk, '\t') |
+      match(chunk, '\n') | match(chunk, '\r')) << i;
+    masks->structural |= (match(chunk, '{') | match(chunk, '}') |
+      match(chunk, '[') | match(chunk, ']') | match(chunk, ':') |
+      match(chunk, ',')) << i;
+    masks->control |= control << i;
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Finds the characters escaped by the backslashes of a block. A backslash
+ * escapes the character after it unless it is escaped itself, and
+ * `escape_carry` tells whether the first character of the block is escaped
+ * by the last one of the previous block. Backslashes are rare enough that
+ * visiting them one at a time is cheaper than the carry-less arithmetic
+ * needed to handle their runs at once.
+ */
+uint64_t
+find_escaped(uint64_t backslash, uint64_t* escape_carry)
+{
+  uint64_t escaped = *escape_carry;
+  uint64_t escapes = backslash & ~escaped;
+
+  *escape_carry = 0;
+
+  while (escapes) {
+    const int i = __builtin_ctzll(escapes);
+
+    if (i == 63) {
+      *escape_carry = 1;
+    } else {
+      escaped |= uint64_t(2) << i;
+    }
+
+    escapes &= ~(uint64_t(3) << i);
+  }
+
+  return escaped;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Computes the XOR of every bit with all the bits below it, which turns the
+ * quotes of a block into the characters from each opening quote up to, but
+ * excluding, the matching closing quote.
+ */
+uint64_t
+prefix_xor(uint64_t bits)
+{
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+
+  return bits;
+}
+
+// -----------------------------------------------------------------------------
+
+std::string
+esc(char c)
+{
+  char buf[12];
+  snprintf(buf, sizeof buf, "(%d)", c);
+
+  return std::string(buf);
+}
+
+} /* anonymous namespace */
+
+
+// -----------------------------------------------------------------------------
+
+json_structural_index::json_structural_index()
+  :
+  m_positions()
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+/* static */
+bool
+json_structural_index::simd_available()
+{
+#if defined(__SSE2__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+
+void
+json_structural_index::build(const char* data, size_t size, bool use_simd)
+{
+  if (size >= std::numeric_limits<uint32_t>::max()) {
+    throw std::length_error("Input too large to be indexed");
+  }
+
+  m_positions.clear();
+
+  uint64_t escape_carry = 0;
+  uint64_t string_carry = 0;
+  uint64_t scalar_carry = 0;
+
+  char tail[BLOCK_SIZE];
+
+  for (size_t offset = 0; offset < size; offset += BLOCK_SIZE) {
+    const char* block = data + offset;
+
+    // The last block is padded with whitespace, which is never indexed.
+    if (size - offset < BLOCK_SIZE) {
+      memset(tail, ' ', BLOCK_SIZE);
+      memcpy(tail, block, size - offset);
+      block = tail;
+    }
+
+    block_masks masks;
+
+#if defined(__SSE2__)
+    if (use_simd) {
+      classify_simd(block, &masks);
+    } else {
+      classify_scalar(block, &masks);
+    }
+#else
+    (void)use_simd;
+    classify_scalar(block, &masks);
+#endif
+
+    const uint64_t escaped = find_escaped(masks.backslash, &escape_carry);
+    const uint64_t quotes = masks.quote & ~escaped;
+    const uint64_t in_string = prefix_xor(quotes) ^ string_carry;
+
+    string_carry = (in_string >> 63) ? ~uint64_t(0) : 0;
+
+    const uint64_t invalid = masks.control & in_string;
+    if (invalid) {
+      const char ch = block[__builtin_ctzll(invalid)];
+      throw invalid_json_error("Unescaped " + esc(ch) + " in string");
+    }
+
+    const uint64_t scalar =
+      ~(masks.whitespace | masks.structural | quotes | in_string);
+    const uint64_t scalar_starts = scalar & ~((scalar << 1) | scalar_carry);
+
+    scalar_carry = scalar >> 63;
+
+    uint64_t bits = (masks.structural & ~in_string) | quotes | scalar_starts;
+
+    while (bits) {
+      m_positions.push_back(
+        static_cast<uint32_t>(offset) +
+          static_cast<uint32_t>(__builtin_ctzll(bits)));
+      bits &= bits - 1;
+    }
+  }
+
+  if (string_carry) {
+    throw invalid_json_error("Unexpected end of input in string");
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace json */
+
+
+} /* end namespace sneaker */
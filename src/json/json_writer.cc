@@ -0,0 +1,1141 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "json/json_writer.h"
+
+#include "io/output_stream.h"
+#include "json/json.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace sneaker {
+
+
+namespace json {
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/**
+ * The magnitude of the smallest integral double out of the range of
+ * `int64_t`.
+ */
+const double INT64_LIMIT = 9223372036854775808.0;
+
+/**
+ * The size estimated for a number that is not an integer.
+ */
+const size_t DOUBLE_SIZE_ESTIMATE = 24;
+
+const char SPACES[] = "                                ";
+
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+const char DIGIT_PAIRS[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Compares two doubles for exact equality.
+ */
+bool
+same_double(double lhs, double rhs)
+{
+  return !(lhs < rhs) && !(lhs > rhs);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Determines if the number is written as an integer.
+ */
+bool
+is_int64(double number)
+{
+  return number >= -INT64_LIMIT && number < INT64_LIMIT &&
+    same_double(std::floor(number), number) &&
+    !(same_double(number, 0) && std::signbit(number));
+}
+
+// -----------------------------------------------------------------------------
+
+size_t
+digit_count(uint64_t magnitude)
+{
+  size_t count = 1;
+
+  while (magnitude >= 10) {
+    magnitude /= 10;
+    ++count;
+  }
+
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Finds the first character in the range that needs escaping, or `end` if
+ * there is none. The first byte of U+2028 and U+2029 counts as one.
+ */
+const char*
+scan_escape(const char* p, const char* end)
+{
+#if defined(__SSE2__)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i max_control = _mm_set1_epi8(0x1F);
+  const __m128i separator_lead = _mm_set1_epi8(static_cast<char>(0xE2));
+
+  while (end - p >= 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+
+    const int mask = _mm_movemask_epi8(_mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+        _mm_cmpeq_epi8(chunk, backslash)),
+      _mm_or_si128(
+        _mm_cmpeq_epi8(_mm_max_epu8(chunk, max_control), max_control),
+        _mm_cmpeq_epi8(chunk, separator_lead))));
+
+    if (mask) {
+      return p + __builtin_ctz(static_cast<unsigned int>(mask));
+    }
+
+    p += 16;
+  }
+#endif
+
+  while (p != end) {
+    const uint8_t ch = static_cast<uint8_t>(*p);
+
+    if (ch <= 0x1F || ch == '"' || ch == '\\' || ch == 0xE2) {
+      break;
+    }
+
+    ++p;
+  }
+
+  return p;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * A region of memory written into, which is replenished when full.
+ */
+class output_buffer
+{
+public:
+  output_buffer()
+    :
+    m_next(NULL),
+    m_end(NULL)
+  {
+    // Do nothing here.
+  }
+
+  virtual ~output_buffer()
+  {
+    // Do nothing here.
+  }
+
+  void put(char ch)
+  {
+    if (m_next == m_end && !more(1)) {
+      return;
+    }
+
+    *m_next++ = ch;
+  }
+
+  void put(const char* data, size_t size)
+  {
+    while (size) {
+      if (m_next == m_end && !more(size)) {
+        return;
+      }
+
+      const size_t n = std::min(size, static_cast<size_t>(m_end - m_next));
+      memcpy(m_next, data, n);
+
+      m_next += n;
+      data += n;
+      size -= n;
+    }
+  }
+
+protected:
+  /**
+   * Makes room for at least one more byte, and preferably for `size` bytes.
+   * Returns `false` if there is no more room.
+   */
+  virtual bool more(size_t size) = 0;
+
+  char* m_next;
+  char* m_end;
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Appends to a string, which is grown to the size hint up front.
+ */
+class string_buffer : public output_buffer
+{
+public:
+  string_buffer(std::string* out, size_t size_hint)
+    :
+    output_buffer(),
+    m_out(out)
+  {
+    const size_t used = m_out->size();
+    m_out->resize(used + size_hint);
+    reset(used);
+  }
+
+  /**
+   * Trims the string to the bytes written.
+   */
+  void finish()
+  {
+    m_out->resize(static_cast<size_t>(m_next - &(*m_out)[0]));
+  }
+
+protected:
+  virtual bool more(size_t size)
+  {
+    const size_t used = static_cast<size_t>(m_next - &(*m_out)[0]);
+    m_out->resize(std::max(used + size, 2 * m_out->size()));
+    reset(used);
+    return true;
+  }
+
+private:
+  void reset(size_t used)
+  {
+    char* data = &(*m_out)[0];
+    m_next = data + used;
+    m_end = data + m_out->size();
+  }
+
+  std::string* m_out;
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Writes into the buffers of an output stream.
+ */
+class stream_buffer : public output_buffer
+{
+public:
+  explicit stream_buffer(io::output_stream* stream)
+    :
+    output_buffer(),
+    m_stream(stream),
+    m_failed(false)
+  {
+    // Do nothing here.
+  }
+
+  /**
+   * Backs up the part of the last buffer that was not written into, and
+   * returns `false` if the stream ran out of buffers.
+   */
+  bool finish()
+  {
+    if (m_next != m_end) {
+      m_stream->backup(static_cast<size_t>(m_end - m_next));
+      m_next = m_end;
+    }
+
+    return !m_failed;
+  }
+
+protected:
+  virtual bool more(size_t)
+  {
+    uint8_t* data = NULL;
+    size_t len = 0;
+
+    while (len == 0) {
+      if (m_failed || !m_stream->next(&data, &len)) {
+        m_failed = true;
+        return false;
+      }
+    }
+
+    m_next = reinterpret_cast<char*>(data);
+    m_end = m_next + len;
+
+    return true;
+  }
+
+private:
+  io::output_stream* m_stream;
+  bool m_failed;
+};
+
+// -----------------------------------------------------------------------------
+
+void
+write_string(output_buffer& out, const char* data, size_t size)
+{
+  const char* end = data + size;
+
+  out.put('"');
+
+  while (true) {
+    const char* run_end = scan_escape(data, end);
+    out.put(data, static_cast<size_t>(run_end - data));
+
+    if (run_end == end) {
+      break;
+    }
+
+    data = run_end;
+    const uint8_t ch = static_cast<uint8_t>(*data++);
+
+    if (ch == '\\') {
+      out.put("\\\\", 2);
+    } else if (ch == '"') {
+      out.put("\\\"", 2);
+    } else if (ch == '\b') {
+      out.put("\\b", 2);
+    } else if (ch == '\f') {
+      out.put("\\f", 2);
+    } else if (ch == '\n') {
+      out.put("\\n", 2);
+    } else if (ch == '\r') {
+      out.put("\\r", 2);
+    } else if (ch == '\t') {
+      out.put("\\t", 2);
+    } else if (ch <= 0x1F) {
+      const char escaped[] = {
+        '\\', 'u', '0', '0', HEX_DIGITS[ch >> 4], HEX_DIGITS[ch & 0xF]
+      };
+      out.put(escaped, sizeof escaped);
+    } else if (end - data >= 2 && static_cast<uint8_t>(data[0]) == 0x80 &&
+               (static_cast<uint8_t>(data[1]) == 0xA8 ||
+                static_cast<uint8_t>(data[1]) == 0xA9)) {
+      out.put(static_cast<uint8_t>(data[1]) == 0xA8 ? "\\u2028" : "\\u2029", 6);
+      data += 2;
+    } else {
+      out.put(static_cast<char>(ch));
+    }
+  } /* end `while (true)` */
+
+  out.put('"');
+}
+
+// -----------------------------------------------------------------------------
+
+void
+write_int(output_buffer& out, int64_t value)
+{
+  char buf[24];
+  char* p = buf + sizeof buf;
+
+  uint64_t magnitude = value < 0 ?
+    0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+
+  while (magnitude >= 100) {
+    const size_t pair = static_cast<size_t>(magnitude % 100) * 2;
+    magnitude /= 100;
+    *--p = DIGIT_PAIRS[pair + 1];
+    *--p = DIGIT_PAIRS[pair];
+  }
+
+  if (magnitude >= 10) {
+    const size_t pair = static_cast<size_t>(magnitude) * 2;
+    *--p = DIGIT_PAIRS[pair + 1];
+    *--p = DIGIT_PAIRS[pair];
+  } else {
+    *--p = static_cast<char>('0' + magnitude);
+  }
+
+  if (value < 0) {
+    *--p = '-';
+  }
+
+  out.put(p, static_cast<size_t>(buf + sizeof buf - p));
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * A floating-point number of `f * 2^e`, with a 64-bit significand.
+ */
+struct diy_fp
+{
+  diy_fp(uint64_t f_, int e_)
+    :
+    f(f_),
+    e(e_)
+  {
+    // Do nothing here.
+  }
+
+  uint64_t f;
+  int e;
+};
+
+// -----------------------------------------------------------------------------
+
+diy_fp
+subtract(const diy_fp& x, const diy_fp& y)
+{
+  return diy_fp(x.f - y.f, x.e);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Multiplies two numbers, keeping the upper 64 bits of the product of the
+ * significands, rounded.
+ */
+diy_fp
+multiply(const diy_fp& x, const diy_fp& y)
+{
+  const uint64_t x_lo = x.f & 0xFFFFFFFFu;
+  const uint64_t x_hi = x.f >> 32;
+  const uint64_t y_lo = y.f & 0xFFFFFFFFu;
+  const uint64_t y_hi = y.f >> 32;
+
+  const uint64_t lo_lo = x_lo * y_lo;
+  const uint64_t lo_hi = x_lo * y_hi;
+  const uint64_t hi_lo = x_hi * y_lo;
+  const uint64_t hi_hi = x_hi * y_hi;
+
+  const uint64_t middle = (lo_lo >> 32) + (lo_hi & 0xFFFFFFFFu) +
+    (hi_lo & 0xFFFFFFFFu) + (1u << 31);
+
+  return diy_fp(hi_hi + (lo_hi >> 32) + (hi_lo >> 32) + (middle >> 32),
+    x.e + y.e + 64);
+}
+
+// -----------------------------------------------------------------------------
+
+diy_fp
+normalize(diy_fp x)
+{
+  while (!(x.f >> 63)) {
+    x.f <<= 1;
+    --x.e;
+  }
+
+  return x;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * A power of ten, `10^k = f * 2^e`, with `f` rounded and normalized.
+ */
+struct cached_power
+{
+  uint64_t f;
+  int e;
+  int k;
+};
+
+/**
+ * Every eighth power of ten from 10^-300 to 10^324, which cover the range
+ * needed to scale any double into the range of exponents of `ALPHA` to
+ * `GAMMA`.
+ */
+const cached_power CACHED_POWERS[] = {
+  { 0xAB70FE17C79AC6CAULL, -1060, -300 },
+  { 0xFF77B1FCBEBCDC4FULL, -1034, -292 },
+  { 0xBE5691EF416BD60CULL, -1007, -284 },
+  { 0x8DD01FAD907FFC3CULL,  -980, -276 },
+  { 0xD3515C2831559A83ULL,  -954, -268 },
+  { 0x9D71AC8FADA6C9B5ULL,  -927, -260 },
+  { 0xEA9C227723EE8BCBULL,  -901, -252 },
+  { 0xAECC49914078536DULL,  -874, -244 },
+  { 0x823C12795DB6CE57ULL,  -847, -236 },
+  { 0xC21094364DFB5637ULL,  -821, -228 },
+  { 0x9096EA6F3848984FULL,  -794, -220 },
+  { 0xD77485CB25823AC7ULL,  -768, -212 },
+  { 0xA086CFCD97BF97F4ULL,  -741, -204 },
+  { 0xEF340A98172AACE5ULL,  -715, -196 },
+  { 0xB23867FB2A35B28EULL,  -688, -188 },
+  { 0x84C8D4DFD2C63F3BULL,  -661, -180 },
+  { 0xC5DD44271AD3CDBAULL,  -635, -172 },
+  { 0x936B9FCEBB25C996ULL,  -608, -164 },
+  { 0xDBAC6C247D62A584ULL,  -582, -156 },
+  { 0xA3AB66580D5FDAF6ULL,  -555, -148 },
+  { 0xF3E2F893DEC3F126ULL,  -529, -140 },
+  { 0xB5B5ADA8AAFF80B8ULL,  -502, -132 },
+  { 0x87625F056C7C4A8BULL,  -475, -124 },
+  { 0xC9BCFF6034C13053ULL,  -449, -116 },
+  { 0x964E858C91BA2655ULL,  -422, -108 },
+  { 0xDFF9772470297EBDULL,  -396, -100 },
+  { 0xA6DFBD9FB8E5B88FULL,  -369,  -92 },
+  { 0xF8A95FCF88747D94ULL,  -343,  -84 },
+  { 0xB94470938FA89BCFULL,  -316,  -76 },
+  { 0x8A08F0F8BF0F156BULL,  -289,  -68 },
+  { 0xCDB02555653131B6ULL,  -263,  -60 },
+  { 0x993FE2C6D07B7FACULL,  -236,  -52 },
+  { 0xE45C10C42A2B3B06ULL,  -210,  -44 },
+  { 0xAA242499697392D3ULL,  -183,  -36 },
+  { 0xFD87B5F28300CA0EULL,  -157,  -28 },
+  { 0xBCE5086492111AEBULL,  -130,  -20 },
+  { 0x8CBCCC096F5088CCULL,  -103,  -12 },
+  { 0xD1B71758E219652CULL,   -77,   -4 },
+  { 0x9C40000000000000ULL,   -50,    4 },
+  { 0xE8D4A51000000000ULL,   -24,   12 },
+  { 0xAD78EBC5AC620000ULL,     3,   20 },
+  { 0x813F3978F8940984ULL,    30,   28 },
+  { 0xC097CE7BC90715B3ULL,    56,   36 },
+  { 0x8F7E32CE7BEA5C70ULL,    83,   44 },
+  { 0xD5D238A4ABE98068ULL,   109,   52 },
+  { 0x9F4F2726179A2245ULL,   136,   60 },
+  { 0xED63A231D4C4FB27ULL,   162,   68 },
+  { 0xB0DE65388CC8ADA8ULL,   189,   76 },
+  { 0x83C7088E1AAB65DBULL,   216,   84 },
+  { 0xC45D1DF942711D9AULL,   242,   92 },
+  { 0x924D692CA61BE758ULL,   269,  100 },
+  { 0xDA01EE641A708DEAULL,   295,  108 },
+  { 0xA26DA3999AEF774AULL,   322,  116 },
+  { 0xF209787BB47D6B85ULL,   348,  124 },
+  { 0xB454E4A179DD1877ULL,   375,  132 },
+  { 0x865B86925B9BC5C2ULL,   402,  140 },
+  { 0xC83553C5C8965D3DULL,   428,  148 },
+  { 0x952AB45CFA97A0B3ULL,   455,  156 },
+  { 0xDE469FBD99A05FE3ULL,   481,  164 },
+  { 0xA59BC234DB398C25ULL,   508,  172 },
+  { 0xF6C69A72A3989F5CULL,   534,  180 },
+  { 0xB7DCBF5354E9BECEULL,   561,  188 },
+  { 0x88FCF317F22241E2ULL,   588,  196 },
+  { 0xCC20CE9BD35C78A5ULL,   614,  204 },
+  { 0x98165AF37B2153DFULL,   641,  212 },
+  { 0xE2A0B5DC971F303AULL,   667,  220 },
+  { 0xA8D9D1535CE3B396ULL,   694,  228 },
+  { 0xFB9B7CD9A4A7443CULL,   720,  236 },
+  { 0xBB764C4CA7A44410ULL,   747,  244 },
+  { 0x8BAB8EEFB6409C1AULL,   774,  252 },
+  { 0xD01FEF10A657842CULL,   800,  260 },
+  { 0x9B10A4E5E9913129ULL,   827,  268 },
+  { 0xE7109BFBA19C0C9DULL,   853,  276 },
+  { 0xAC2820D9623BF429ULL,   880,  284 },
+  { 0x80444B5E7AA7CF85ULL,   907,  292 },
+  { 0xBF21E44003ACDD2DULL,   933,  300 },
+  { 0x8E679C2F5E44FF8FULL,   960,  308 },
+  { 0xD433179D9C8CB841ULL,   986,  316 },
+  { 0x9E19DB92B4E31BA9ULL,  1013,  324 }
+};
+
+/**
+ * The range of binary exponents of the scaled numbers, for which the integral
+ * part of the upper boundary fits in 32 bits and its digits can be generated with
+ * 64-bit arithmetic.
+ */
+const int ALPHA = -60;
+const int GAMMA = -32;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Gets the cached power of ten `c` for which the binary exponent of `c * 2^e`
+ * is in the range of `ALPHA` to `GAMMA`.
+ */
+const cached_power&
+cached_power_for(int e)
+{
+  // The decimal exponent is ceil((ALPHA - e - 1) * log10(2)), for which
+  // 78913 / 2^18 is a close enough approximation of log10(2).
+  const int f = ALPHA - e - 1;
+  const int k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+
+  return CACHED_POWERS[static_cast<size_t>((300 + k + 7) / 8)];
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Gets the largest power of ten that is at most `n`, and its number of
+ * digits.
+ */
+int
+largest_pow10(uint32_t n, uint32_t* pow10)
+{
+  int digits = 10;
+  *pow10 = 1000000000;
+
+  while (digits > 1 && n < *pow10) {
+    *pow10 /= 10;
+    --digits;
+  }
+
+  return digits;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Moves the last digit closer to the scaled number `w`, while the digits stay
+ * in the rounding interval, where `dist` is `upper - w`, `delta` is the width
+ * of the interval, `rest` is `upper` minus the digits and `ten_k` is the unit
+ * of the last digit, all scaled alike.
+ */
+void
+round_last_digit(char* digits, int length, uint64_t dist, uint64_t delta,
+  uint64_t rest, uint64_t ten_k)
+{
+  while (rest < dist && delta - rest >= ten_k &&
+         (rest + ten_k < dist || dist - rest > rest + ten_k - dist)) {
+    --digits[length - 1];
+    rest += ten_k;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Generates the shortest digits of a number in the interval of `lower` to
+ * `upper`, which is as close to `w` as the interval allows, where the three
+ * numbers have the same binary exponent in the range of `ALPHA` to `GAMMA`.
+ * The digits are multiplied by `10^exponent`, which is adjusted in place.
+ */
+void
+generate_digits(char* digits, int* length, int* exponent,
+  const diy_fp& lower, const diy_fp& w, const diy_fp& upper)
+{
+  uint64_t delta = subtract(upper, lower).f;
+  uint64_t dist = subtract(upper, w).f;
+
+  const int shift = -upper.e;
+  const uint64_t one = static_cast<uint64_t>(1) << shift;
+
+  uint32_t integral = static_cast<uint32_t>(upper.f >> shift);
+  uint64_t fractional = upper.f & (one - 1);
+
+  uint32_t pow10 = 0;
+  int n = largest_pow10(integral, &pow10);
+
+  // The digits of the integral part, until the rest is within the interval.
+  while (n > 0) {
+    digits[(*length)++] = static_cast<char>('0' + integral / pow10);
+    integral %= pow10;
+    --n;
+
+    const uint64_t rest = (static_cast<uint64_t>(integral) << shift) +
+      fractional;
+
+    if (rest <= delta) {
+      *exponent += n;
+      round_last_digit(digits, *length, dist, delta, rest,
+        static_cast<uint64_t>(pow10) << shift);
+      return;
+    }
+
+    pow10 /= 10;
+  }
+
+  // The digits of the fractional part, scaling the interval along.
+  int m = 0;
+
+  while (true) {
+    fractional *= 10;
+    digits[(*length)++] = static_cast<char>('0' + (fractional >> shift));
+    fractional &= one - 1;
+    ++m;
+
+    delta *= 10;
+    dist *= 10;
+
+    if (fractional <= delta) {
+      break;
+    }
+  }
+
+  *exponent -= m;
+  round_last_digit(digits, *length, dist, delta, fractional, one);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Generates the shortest digits of a positive finite double that read back as
+ * the same double, with the Grisu2 algorithm by Florian Loitsch. The double is
+ * the digits multiplied by `10^exponent`. The digits are the shortest for
+ * nearly all doubles, and one digit longer than the shortest for the rest.
+ */
+void
+shortest_digits(double value, char* digits, int* length, int* exponent)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof bits);
+
+  const uint64_t HIDDEN_BIT = static_cast<uint64_t>(1) << 52;
+  const int BIAS = 1075;
+
+  const int biased_exponent = static_cast<int>(bits >> 52);
+  const uint64_t fraction = bits & (HIDDEN_BIT - 1);
+
+  const diy_fp v = biased_exponent == 0 ?
+    diy_fp(fraction, 1 - BIAS) :
+    diy_fp(fraction + HIDDEN_BIT, biased_exponent - BIAS);
+
+  // The boundaries halfway to the neighboring doubles, where the lower one is
+  // closer when the fraction is zero, unless the double is the smallest one
+  // with its exponent.
+  const diy_fp upper = normalize(diy_fp(2 * v.f + 1, v.e - 1));
+  diy_fp lower = fraction == 0 && biased_exponent > 1 ?
+    diy_fp(4 * v.f - 1, v.e - 2) : diy_fp(2 * v.f - 1, v.e - 1);
+
+  lower.f <<= lower.e - upper.e;
+  lower.e = upper.e;
+
+  const cached_power& power = cached_power_for(upper.e);
+  const diy_fp c(power.f, power.e);
+
+  const diy_fp w = multiply(normalize(v), c);
+  const diy_fp scaled_lower = multiply(lower, c);
+  const diy_fp scaled_upper = multiply(upper, c);
+
+  // The scaled boundaries are off by at most one unit, so the interval is
+  // narrowed by one unit on both ends to only contain digits that read back.
+  *length = 0;
+  *exponent = -power.k;
+
+  generate_digits(digits, length, exponent,
+    diy_fp(scaled_lower.f + 1, scaled_lower.e), w,
+    diy_fp(scaled_upper.f - 1, scaled_upper.e));
+}
+
+// -----------------------------------------------------------------------------
+
+char*
+write_exponent(char* p, int exponent)
+{
+  *p++ = 'e';
+  *p++ = exponent < 0 ? '-' : '+';
+
+  uint32_t magnitude = static_cast<uint32_t>(exponent < 0 ? -exponent : exponent);
+
+  if (magnitude >= 100) {
+    *p++ = static_cast<char>('0' + magnitude / 100);
+    magnitude %= 100;
+    *p++ = DIGIT_PAIRS[magnitude * 2];
+    *p++ = DIGIT_PAIRS[magnitude * 2 + 1];
+  } else if (magnitude >= 10) {
+    *p++ = DIGIT_PAIRS[magnitude * 2];
+    *p++ = DIGIT_PAIRS[magnitude * 2 + 1];
+  } else {
+    *p++ = static_cast<char>('0' + magnitude);
+  }
+
+  return p;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Writes the double with the shortest digits that read back as the same
+ * value, in the notation of `Number.prototype.toString()` in JavaScript:
+ * numbers from 1e-6 up to 1e21 are written without an exponent.
+ */
+void
+write_double(output_buffer& out, double value)
+{
+  char buf[32];
+  char* p = buf;
+
+  if (std::signbit(value)) {
+    *p++ = '-';
+    value = -value;
+  }
+
+  if (same_double(value, 0)) {
+    *p++ = '0';
+    out.put(buf, static_cast<size_t>(p - buf));
+    return;
+  }
+
+  char digits[20];
+  int length = 0;
+  int exponent = 0;
+
+  shortest_digits(value, digits, &length, &exponent);
+
+  // The position of the decimal point relative to the first digit.
+  const int point = length + exponent;
+  const size_t size = static_cast<size_t>(length);
+
+  if (length <= point && point <= 21) {
+    memcpy(p, digits, size);
+    p += length;
+    memset(p, '0', static_cast<size_t>(point - length));
+    p += point - length;
+  } else if (0 < point && point <= 21) {
+    memcpy(p, digits, static_cast<size_t>(point));
+    p += point;
+    *p++ = '.';
+    memcpy(p, digits + point, static_cast<size_t>(length - point));
+    p += length - point;
+  } else if (-6 < point && point <= 0) {
+    *p++ = '0';
+    *p++ = '.';
+    memset(p, '0', static_cast<size_t>(-point));
+    p += -point;
+    memcpy(p, digits, size);
+    p += length;
+  } else {
+    *p++ = digits[0];
+
+    if (length > 1) {
+      *p++ = '.';
+      memcpy(p, digits + 1, size - 1);
+      p += length - 1;
+    }
+
+    p = write_exponent(p, point - 1);
+  }
+
+  out.put(buf, static_cast<size_t>(p - buf));
+}
+
+// -----------------------------------------------------------------------------
+
+void
+write_number(output_buffer& out, const JSON& json)
+{
+  const double number = json.number_value();
+
+  if (!std::isfinite(number)) {
+    out.put("null", 4);
+  } else if (is_int64(number)) {
+    write_int(out, json.int_value());
+  } else if (same_double(number, INT64_LIMIT)) {
+    // Integers just below the limit round up to it as doubles, so they are
+    // told apart from the double by how they are dumped.
+    const std::string dumped = json.dump();
+
+    if (dumped.find_first_not_of("0123456789") == std::string::npos) {
+      out.put(dumped.data(), dumped.size());
+    } else {
+      write_double(out, number);
+    }
+  } else {
+    write_double(out, number);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class serializer
+{
+public:
+  serializer(output_buffer& out, json_writer::style layout, size_t indent)
+    :
+    m_out(out),
+    m_pretty(layout == json_writer::style::PRETTY),
+    m_indent(indent)
+  {
+    // Do nothing here.
+  }
+
+  void write(const JSON& json, size_t depth)
+  {
+    switch (json.type()) {
+      case JSON::NUL:
+        m_out.put("null", 4);
+        break;
+      case JSON::NUMBER:
+        write_number(m_out, json);
+        break;
+      case JSON::BOOL:
+        if (json.bool_value()) {
+          m_out.put("true", 4);
+        } else {
+          m_out.put("false", 5);
+        }
+        break;
+      case JSON::STRING:
+        {
+          const string_view value = json.string_view_value();
+          write_string(m_out, value.data(), value.size());
+        }
+        break;
+      case JSON::ARRAY:
+        write_array(json.array_items(), depth);
+        break;
+      case JSON::OBJECT:
+        write_object(json.object_items(), depth);
+        break;
+    }
+  }
+
+private:
+  void write_array(const JSON::array& items, size_t depth)
+  {
+    m_out.put('[');
+
+    if (!items.empty()) {
+      bool first = true;
+
+      for (const JSON& item : items) {
+        if (!first) {
+          m_out.put(',');
+        }
+
+        new_line(depth + 1);
+        write(item, depth + 1);
+
+        first = false;
+      }
+
+      new_line(depth);
+    }
+
+    m_out.put(']');
+  }
+
+  void write_object(const JSON::object& members, size_t depth)
+  {
+    m_out.put('{');
+
+    if (!members.empty()) {
+      bool first = true;
+
+      for (const auto& member : members) {
+        if (!first) {
+          m_out.put(',');
+        }
+
+        new_line(depth + 1);
+
+        write_string(m_out, member.first.data(), member.first.size());
+
+        if (m_pretty) {
+          m_out.put(": ", 2);
+        } else {
+          m_out.put(':');
+        }
+
+        write(member.second, depth + 1);
+
+        first = false;
+      }
+
+      new_line(depth);
+    }
+
+    m_out.put('}');
+  }
+
+  void new_line(size_t depth)
+  {
+    if (!m_pretty) {
+      return;
+    }
+
+    m_out.put('\n');
+
+    for (size_t n = m_indent * depth; n;) {
+      const size_t count = std::min(n, sizeof SPACES - 1);
+      m_out.put(SPACES, count);
+      n -= count;
+    }
+  }
+
+  output_buffer& m_out;
+  bool m_pretty;
+  size_t m_indent;
+};
+
+// -----------------------------------------------------------------------------
+
+class size_estimator
+{
+public:
+  size_estimator(json_writer::style layout, size_t indent)
+    :
+    m_pretty(layout == json_writer::style::PRETTY),
+    m_indent(indent)
+  {
+    // Do nothing here.
+  }
+
+  size_t estimate(const JSON& json, size_t depth) const
+  {
+    switch (json.type()) {
+      case JSON::NUL:
+        return 4;
+      case JSON::NUMBER:
+        return estimate_number(json.number_value());
+      case JSON::BOOL:
+        return json.bool_value() ? 4 : 5;
+      case JSON::STRING:
+        return json.string_view_value().size() + 2;
+      case JSON::ARRAY:
+        {
+          const JSON::array& items = json.array_items();
+
+          size_t size = 2 + separators(items.size(), depth);
+          for (const JSON& item : items) {
+            size += estimate(item, depth + 1);
+          }
+
+          return size;
+        }
+      case JSON::OBJECT:
+        {
+          const JSON::object& members = json.object_items();
+
+          size_t size = 2 + separators(members.size(), depth);
+          for (const auto& member : members) {
+            size += member.first.size() + (m_pretty ? 4 : 3);
+            size += estimate(member.second, depth + 1);
+          }
+
+          return size;
+        }
+    }
+
+    return 0;
+  }
+
+private:
+  static size_t estimate_number(double number)
+  {
+    if (!std::isfinite(number)) {
+      return 4;
+    }
+
+    if (!is_int64(number)) {
+      return DOUBLE_SIZE_ESTIMATE;
+    }
+
+    return (number < 0 ? 1 : 0) +
+      digit_count(static_cast<uint64_t>(std::fabs(number)));
+  }
+
+  /**
+   * The size of the commas and of the whitespace between the specified
+   * number of elements of a container.
+   */
+  size_t separators(size_t count, size_t depth) const
+  {
+    if (count == 0) {
+      return 0;
+    }
+
+    size_t size = count - 1;
+
+    if (m_pretty) {
+      size += count * (1 + m_indent * (depth + 1)) + 1 + m_indent * depth;
+    }
+
+    return size;
+  }
+
+  bool m_pretty;
+  size_t m_indent;
+};
+
+} /* anonymous namespace */
+
+
+// -----------------------------------------------------------------------------
+
+json_writer::json_writer(style layout, size_t indent)
+  :
+  m_layout(layout),
+  m_indent(indent)
+{
+  // Do nothing here.
+}
+
+// -----------------------------------------------------------------------------
+
+size_t
+json_writer::estimate_size(const JSON& json) const
+{
+  return size_estimator(m_layout, m_indent).estimate(json, 0);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string
+json_writer::write(const JSON& json) const
+{
+  std::string out;
+  write(json, &out);
+  return out;
+}
+
+// -----------------------------------------------------------------------------
+
+void
+json_writer::write(const JSON& json, std::string* out) const
+{
+  string_buffer buffer(out, estimate_size(json));
+
+  serializer(buffer, m_layout, m_indent).write(json, 0);
+
+  buffer.finish();
+}
+
+// -----------------------------------------------------------------------------
+
+bool
+json_writer::write(const JSON& json, io::output_stream* stream) const
+{
+  stream_buffer buffer(stream);
+
+  serializer(buffer, m_layout, m_indent).write(json, 0);
+
+  return buffer.finish();
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace json */
+
+
+} /* end namespace sneaker */
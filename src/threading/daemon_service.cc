@@ -33,7 +33,8 @@ namespace threading {
 
 daemon_service::daemon_service(bool wait_for_termination)
   :
-  m_wait_for_termination(wait_for_termination)
+  m_wait_for_termination(wait_for_termination),
+  m_joinable(false)
 {
   this->init();
 }
@@ -64,6 +65,8 @@ daemon_service::start()
   if (m_wait_for_termination) {
     void* res = NULL;
     created = pthread_join(m_thread_id, &res);
+  } else {
+    m_joinable = created == 0;
   }
 
   return created == 0;
@@ -71,6 +74,18 @@ daemon_service::start()
 
 // -----------------------------------------------------------------------------
 
+void
+daemon_service::join()
+{
+  if (m_joinable) {
+    void* res = NULL;
+    pthread_join(m_thread_id, &res);
+    m_joinable = false;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 void*
 daemon_service::handler(void* instance)
 {
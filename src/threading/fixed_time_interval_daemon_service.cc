@@ -44,6 +44,7 @@ class fixed_time_interval_daemon_service::impl : public daemon_service
 public:
   impl(uint32_t interval,
        ExternalHandler external_handler,
+       void* external_handler_arg,
        bool wait_for_termination,
        int32_t max_iterations);
 
@@ -65,6 +66,7 @@ protected:
 
 private:
   ExternalHandler m_external_handler;
+  void* m_external_handler_arg;
   uint32_t m_interval;
   int32_t m_max_iterations;
   uint32_t m_iteration_count;
@@ -76,11 +78,13 @@ private:
 
 fixed_time_interval_daemon_service::impl::impl(uint32_t interval,
   ExternalHandler external_handler,
+  void* external_handler_arg,
   bool wait_for_termination,
   int32_t max_iterations)
   :
   daemon_service(wait_for_termination),
   m_external_handler(external_handler),
+  m_external_handler_arg(external_handler_arg ? external_handler_arg : this),
   m_interval(interval),
   m_max_iterations(max_iterations),
   m_iteration_count(0),
@@ -112,6 +116,9 @@ fixed_time_interval_daemon_service::impl::stop()
   m_io_service.stop();
 
   m_max_iterations = 0;
+
+  // Make sure the handler is not running anymore.
+  join();
 }
 
 // -----------------------------------------------------------------------------
@@ -140,7 +147,7 @@ fixed_time_interval_daemon_service::impl::handle()
 void
 fixed_time_interval_daemon_service::impl::invoke_external_handler()
 {
-  m_external_handler(this);
+  m_external_handler(m_external_handler_arg);
   ++m_iteration_count;
 }
 
@@ -183,7 +190,22 @@ fixed_time_interval_daemon_service::fixed_time_interval_daemon_service(
   bool wait_for_termination,
   int32_t max_iterations)
   :
-  m_impl(new impl(interval, external_handler, wait_for_termination, max_iterations))
+  m_impl(new impl(interval, external_handler, NULL, wait_for_termination,
+    max_iterations))
+{
+}
+
+// -----------------------------------------------------------------------------
+
+fixed_time_interval_daemon_service::fixed_time_interval_daemon_service(
+  uint32_t interval,
+  ExternalHandler external_handler,
+  void* external_handler_arg,
+  bool wait_for_termination,
+  int32_t max_iterations)
+  :
+  m_impl(new impl(interval, external_handler, external_handler_arg,
+    wait_for_termination, max_iterations))
 {
 }
 
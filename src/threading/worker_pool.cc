@@ -0,0 +1,215 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+#include "threading/worker_pool.h"
+
+#include <algorithm>
+
+
+namespace sneaker {
+
+
+namespace threading {
+
+
+// -----------------------------------------------------------------------------
+
+worker_pool::worker_pool(size_t thread_count)
+  :
+  m_threads(),
+  m_mutex(),
+  m_wake(),
+  m_idle(),
+  m_task(),
+  m_workers(0),
+  m_first(0),
+  m_running(0),
+  m_round(0),
+  m_stopping(false),
+  m_error()
+{
+  m_threads.reserve(thread_count);
+
+  for (size_t index = 0; index < thread_count; ++index)
+  {
+    m_threads.push_back(std::thread(&worker_pool::work, this, index));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+worker_pool::~worker_pool()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_running == 0; });
+    m_stopping = true;
+  }
+
+  m_wake.notify_all();
+
+  for (auto& thread : m_threads)
+  {
+    thread.join();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+size_t
+worker_pool::thread_count() const
+{
+  return m_threads.size();
+}
+
+// -----------------------------------------------------------------------------
+
+void
+worker_pool::start(size_t workers, const task_type& task, size_t first)
+{
+  workers = std::min(workers, m_threads.size());
+
+  if (workers == 0)
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_task = task;
+    m_workers = workers;
+    m_first = first;
+    m_running = workers;
+    ++m_round;
+  }
+
+  m_wake.notify_all();
+}
+
+// -----------------------------------------------------------------------------
+
+void
+worker_pool::wait()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_idle.wait(lock, [this]() { return m_running == 0; });
+
+  if (m_error)
+  {
+    std::exception_ptr error;
+    std::swap(error, m_error);
+    std::rethrow_exception(error);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void
+worker_pool::run(size_t workers, const task_type& task)
+{
+  if (workers == 0)
+  {
+    return;
+  }
+
+  start(workers - 1, task, 1);
+
+  try
+  {
+    task(0);
+  }
+  catch (...)
+  {
+    // The threads of the pool still refer to the task, and any exception
+    // they throw is superseded by this one.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_running == 0; });
+    m_error = std::exception_ptr();
+    throw;
+  }
+
+  wait();
+}
+
+// -----------------------------------------------------------------------------
+
+void
+worker_pool::work(size_t index)
+{
+  uint64_t seen = 0;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while (true)
+  {
+    m_wake.wait(lock, [this, seen]() { return m_stopping || m_round != seen; });
+
+    if (m_stopping)
+    {
+      return;
+    }
+
+    seen = m_round;
+
+    // Threads beyond the workers of the round sit it out.
+    if (index >= m_workers)
+    {
+      continue;
+    }
+
+    const size_t ordinal = m_first + index;
+
+    lock.unlock();
+
+    try
+    {
+      m_task(ordinal);
+    }
+    catch (...)
+    {
+      lock.lock();
+
+      if (!m_error)
+      {
+        m_error = std::current_exception();
+      }
+
+      lock.unlock();
+    }
+
+    lock.lock();
+
+    if (--m_running == 0)
+    {
+      m_idle.notify_all();
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+
+} /* end namespace threading */
+
+
+} /* end namespace sneaker */
@@ -0,0 +1,192 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `sneaker::algorithm::csr_graph` defined in
+ * sneaker/algorithm/csr_graph.h */
+
+#include "algorithm/csr_graph.h"
+
+#include "algorithm/tarjan.h"
+
+#include "testing/testing.h"
+
+#include <stdexcept>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+using sneaker::algorithm::csr_graph;
+
+// -----------------------------------------------------------------------------
+
+class csr_graph_unittest : public ::testing::Test {
+protected:
+  static std::vector<csr_graph::vertex_id> neighbors(const csr_graph& graph,
+    csr_graph::vertex_id vertex)
+  {
+    return std::vector<csr_graph::vertex_id>(graph.neighbors_begin(vertex),
+      graph.neighbors_end(vertex));
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(csr_graph_unittest, TestEmptyGraph)
+{
+  csr_graph graph;
+
+  ASSERT_EQ(0, graph.vertex_count());
+  ASSERT_EQ(0, graph.edge_count());
+  ASSERT_EQ(1, graph.offsets().size());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(csr_graph_unittest, TestFromEdges)
+{
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(2, 0));
+  edges.push_back(csr_graph::edge(0, 2));
+  edges.push_back(csr_graph::edge(0, 1));
+  edges.push_back(csr_graph::edge(2, 1));
+
+  const csr_graph graph = csr_graph::from_edges(4, edges);
+
+  ASSERT_EQ(4, graph.vertex_count());
+  ASSERT_EQ(4, graph.edge_count());
+
+  ASSERT_EQ(2, graph.degree(0));
+  ASSERT_EQ(0, graph.degree(1));
+  ASSERT_EQ(2, graph.degree(2));
+  ASSERT_EQ(0, graph.degree(3));
+
+  // The out-edges of each vertex keep their relative order.
+  std::vector<csr_graph::vertex_id> expected;
+  expected.push_back(2);
+  expected.push_back(1);
+  ASSERT_EQ(expected, neighbors(graph, 0));
+
+  expected.clear();
+  expected.push_back(0);
+  expected.push_back(1);
+  ASSERT_EQ(expected, neighbors(graph, 2));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(csr_graph_unittest, TestFromEdgesOutOfRange)
+{
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(0, 3));
+
+  ASSERT_THROW(csr_graph::from_edges(3, edges), std::out_of_range);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(csr_graph_unittest, TestConstructFromArrays)
+{
+  std::vector<size_t> offsets;
+  offsets.push_back(0);
+  offsets.push_back(1);
+  offsets.push_back(2);
+
+  std::vector<csr_graph::vertex_id> targets;
+  targets.push_back(1);
+  targets.push_back(0);
+
+  const csr_graph graph(offsets, targets);
+
+  ASSERT_EQ(2, graph.vertex_count());
+  ASSERT_EQ(1, neighbors(graph, 0)[0]);
+  ASSERT_EQ(0, neighbors(graph, 1)[0]);
+
+  offsets.back() = 3;
+  ASSERT_THROW(csr_graph(offsets, targets), std::invalid_argument);
+
+  offsets.back() = 2;
+  targets.back() = 2;
+  ASSERT_THROW(csr_graph(offsets, targets), std::invalid_argument);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(csr_graph_unittest, TestTranspose)
+{
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(0, 1));
+  edges.push_back(csr_graph::edge(0, 2));
+  edges.push_back(csr_graph::edge(1, 2));
+
+  const csr_graph graph = csr_graph::from_edges(3, edges).transpose();
+
+  ASSERT_EQ(3, graph.vertex_count());
+  ASSERT_EQ(3, graph.edge_count());
+
+  ASSERT_EQ(0, graph.degree(0));
+  ASSERT_EQ(0, neighbors(graph, 1)[0]);
+
+  std::vector<csr_graph::vertex_id> expected;
+  expected.push_back(0);
+  expected.push_back(1);
+  ASSERT_EQ(expected, neighbors(graph, 2));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(csr_graph_unittest, TestFromVertices)
+{
+  typedef sneaker::algorithm::tarjan<int>::vertex vertex;
+
+  vertex v1(1);
+  vertex v2(2);
+  vertex v3(3);
+
+  v1.dependencies().push_back(&v3);
+  v3.dependencies().push_back(&v2);
+  v3.dependencies().push_back(&v1);
+
+  // `v2` is only reachable through the dependencies of `v3`.
+  std::vector<vertex*> vertices;
+  vertices.push_back(&v1);
+  vertices.push_back(&v3);
+
+  std::vector<vertex*> mapping;
+  const csr_graph graph = csr_graph::from_vertices(vertices, &mapping);
+
+  ASSERT_EQ(3, graph.vertex_count());
+  ASSERT_EQ(3, graph.edge_count());
+
+  ASSERT_EQ(3, mapping.size());
+  ASSERT_EQ(&v1, mapping[0]);
+  ASSERT_EQ(&v3, mapping[1]);
+  ASSERT_EQ(&v2, mapping[2]);
+
+  ASSERT_EQ(1, neighbors(graph, 0)[0]);
+  ASSERT_EQ(2, neighbors(graph, 1)[0]);
+  ASSERT_EQ(0, neighbors(graph, 1)[1]);
+  ASSERT_EQ(0, graph.degree(2));
+}
+
+// -----------------------------------------------------------------------------
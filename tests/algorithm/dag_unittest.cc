@@ -0,0 +1,302 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for the algorithms defined in sneaker/algorithm/dag.h */
+
+#include "algorithm/dag.h"
+
+#include "algorithm/csr_graph.h"
+
+#include "testing/testing.h"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+using namespace sneaker::algorithm;
+
+// -----------------------------------------------------------------------------
+
+class dag_unittest : public ::testing::Test {
+protected:
+  static csr_graph make_graph(size_t vertex_count,
+    const std::vector<csr_graph::edge>& edges)
+  {
+    return csr_graph::from_edges(vertex_count, edges);
+  }
+
+  /**
+   * Computes reachability between all pairs of vertices.
+   */
+  static std::vector<std::vector<bool>> closure(const csr_graph& graph)
+  {
+    const size_t n = graph.vertex_count();
+    std::vector<std::vector<bool>> reaches(n, std::vector<bool>(n, false));
+
+    for (csr_graph::vertex_id source = 0; source < n; ++source)
+    {
+      std::vector<csr_graph::vertex_id> pending(1, source);
+
+      while (!pending.empty())
+      {
+        const csr_graph::vertex_id vertex = pending.back();
+        pending.pop_back();
+
+        for (auto itr = graph.neighbors_begin(vertex);
+          itr != graph.neighbors_end(vertex); ++itr)
+        {
+          if (!reaches[source][*itr])
+          {
+            reaches[source][*itr] = true;
+            pending.push_back(*itr);
+          }
+        }
+      }
+    }
+
+    return reaches;
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(dag_unittest, TestCondensation)
+{
+  /* Tests the following graph:
+   *
+   * (0) <-> (1) -> (2) <-> (3) -> (4)
+   *          |                     ^
+   *          |_____________________|
+   */
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(0, 1));
+  edges.push_back(csr_graph::edge(1, 0));
+  edges.push_back(csr_graph::edge(1, 2));
+  edges.push_back(csr_graph::edge(2, 3));
+  edges.push_back(csr_graph::edge(3, 2));
+  edges.push_back(csr_graph::edge(3, 4));
+  edges.push_back(csr_graph::edge(1, 4));
+
+  std::vector<csr_graph::vertex_id> labels;
+  const csr_graph dag = condensation(make_graph(5, edges), &labels);
+
+  ASSERT_EQ(3, dag.vertex_count());
+  ASSERT_EQ(3, dag.edge_count());
+
+  ASSERT_EQ(0, labels[0]);
+  ASSERT_EQ(0, labels[1]);
+  ASSERT_EQ(1, labels[2]);
+  ASSERT_EQ(1, labels[3]);
+  ASSERT_EQ(2, labels[4]);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(dag_unittest, TestCondensationIsTopologicallyNumbered)
+{
+  std::mt19937 engine(3);
+  std::uniform_int_distribution<csr_graph::vertex_id> distribution(0, 499);
+
+  std::vector<csr_graph::edge> edges;
+  for (size_t i = 0; i < 700; ++i)
+  {
+    edges.push_back(csr_graph::edge(distribution(engine),
+      distribution(engine)));
+  }
+
+  std::vector<csr_graph::vertex_id> labels;
+  const csr_graph dag = condensation(make_graph(500, edges), &labels);
+
+  for (const csr_graph::edge& e : edges)
+  {
+    ASSERT_LE(labels[e.first], labels[e.second]);
+  }
+
+  for (csr_graph::vertex_id c = 0; c < dag.vertex_count(); ++c)
+  {
+    for (auto itr = dag.neighbors_begin(c); itr != dag.neighbors_end(c); ++itr)
+    {
+      ASSERT_LT(c, *itr);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(dag_unittest, TestTopologicalSort)
+{
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(3, 1));
+  edges.push_back(csr_graph::edge(1, 0));
+  edges.push_back(csr_graph::edge(3, 2));
+  edges.push_back(csr_graph::edge(2, 0));
+
+  std::vector<csr_graph::vertex_id> order;
+  ASSERT_TRUE(topological_sort(make_graph(4, edges), &order));
+
+  ASSERT_EQ(4, order.size());
+  ASSERT_EQ(3, order.front());
+  ASSERT_EQ(0, order.back());
+
+  edges.push_back(csr_graph::edge(0, 3));
+  ASSERT_FALSE(topological_sort(make_graph(4, edges), &order));
+
+  std::vector<csr_graph::edge> self_loop(1, csr_graph::edge(0, 0));
+  ASSERT_FALSE(topological_sort(make_graph(1, self_loop), &order));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(dag_unittest, TestCriticalPathLength)
+{
+  /* Tests the following graph:
+   *
+   * (0) -> (1) -> (3)
+   *  |             ^
+   *  |---> (2) ----|
+   */
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(0, 1));
+  edges.push_back(csr_graph::edge(0, 2));
+  edges.push_back(csr_graph::edge(1, 3));
+  edges.push_back(csr_graph::edge(2, 3));
+
+  const csr_graph dag = make_graph(4, edges);
+
+  ASSERT_EQ(3, critical_path_length(dag, std::vector<uint64_t>()));
+
+  std::vector<uint64_t> weights;
+  weights.push_back(1);
+  weights.push_back(2);
+  weights.push_back(5);
+  weights.push_back(1);
+
+  std::vector<csr_graph::vertex_id> path;
+  ASSERT_EQ(7, critical_path_length(dag, weights, &path));
+
+  ASSERT_EQ(3, path.size());
+  ASSERT_EQ(0, path[0]);
+  ASSERT_EQ(2, path[1]);
+  ASSERT_EQ(3, path[2]);
+
+  ASSERT_EQ(0, critical_path_length(csr_graph(), std::vector<uint64_t>()));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(dag_unittest, TestCriticalPathLengthInvalidArguments)
+{
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(0, 1));
+  edges.push_back(csr_graph::edge(1, 0));
+
+  ASSERT_THROW(critical_path_length(make_graph(2, edges),
+    std::vector<uint64_t>()), std::invalid_argument);
+
+  ASSERT_THROW(critical_path_length(make_graph(3, std::vector<csr_graph::edge>()),
+    std::vector<uint64_t>(2, 1)), std::invalid_argument);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(dag_unittest, TestTransitiveReduction)
+{
+  /* Tests the following graph, where the edges (0, 2), (0, 3) and the
+   * duplicate (2, 3) are redundant:
+   *
+   * (0) -> (1) -> (2) -> (3)
+   */
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(0, 3));
+  edges.push_back(csr_graph::edge(0, 1));
+  edges.push_back(csr_graph::edge(0, 2));
+  edges.push_back(csr_graph::edge(1, 2));
+  edges.push_back(csr_graph::edge(2, 3));
+  edges.push_back(csr_graph::edge(2, 3));
+
+  const csr_graph reduction = transitive_reduction(make_graph(4, edges));
+
+  ASSERT_EQ(4, reduction.vertex_count());
+  ASSERT_EQ(3, reduction.edge_count());
+
+  for (csr_graph::vertex_id vertex = 0; vertex < 3; ++vertex)
+  {
+    ASSERT_EQ(1, reduction.degree(vertex));
+    ASSERT_EQ(vertex + 1, *reduction.neighbors_begin(vertex));
+  }
+
+  edges.push_back(csr_graph::edge(3, 0));
+  ASSERT_THROW(transitive_reduction(make_graph(4, edges)),
+    std::invalid_argument);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(dag_unittest, TestTransitiveReductionOfRandomDAGs)
+{
+  std::mt19937 engine(11);
+
+  for (size_t round = 0; round < 10; ++round)
+  {
+    const csr_graph::vertex_id n = 60;
+    std::uniform_int_distribution<csr_graph::vertex_id> distribution(0, n - 1);
+
+    std::vector<csr_graph::edge> edges;
+    for (size_t i = 0; i < 300; ++i)
+    {
+      csr_graph::vertex_id u = distribution(engine);
+      csr_graph::vertex_id v = distribution(engine);
+
+      if (u != v)
+      {
+        edges.push_back(u < v ? csr_graph::edge(u, v) : csr_graph::edge(v, u));
+      }
+    }
+
+    const csr_graph dag = make_graph(n, edges);
+    const csr_graph reduction = transitive_reduction(dag);
+
+    ASSERT_EQ(closure(dag), closure(reduction));
+
+    // Removing any edge of the reduction loses reachability.
+    const std::vector<std::vector<bool>> reaches = closure(reduction);
+
+    for (csr_graph::vertex_id u = 0; u < n; ++u)
+    {
+      for (auto itr = reduction.neighbors_begin(u);
+        itr != reduction.neighbors_end(u); ++itr)
+      {
+        for (auto other = reduction.neighbors_begin(u);
+          other != reduction.neighbors_end(u); ++other)
+        {
+          ASSERT_FALSE(other != itr && reaches[*other][*itr]);
+        }
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,242 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `sneaker::algorithm::incremental_scc` defined in
+ * sneaker/algorithm/incremental_scc.h */
+
+#include "algorithm/incremental_scc.h"
+
+#include "algorithm/csr_graph.h"
+#include "algorithm/iterative_tarjan.h"
+
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+using sneaker::algorithm::csr_graph;
+using sneaker::algorithm::incremental_scc;
+using sneaker::algorithm::iterative_tarjan;
+
+// -----------------------------------------------------------------------------
+
+class incremental_scc_unittest : public ::testing::Test {
+protected:
+  /**
+   * Asserts that the components and the order maintained incrementally
+   * agree with a decomposition of the same edges from scratch.
+   */
+  static void assert_consistent(const incremental_scc& graph,
+    const std::vector<csr_graph::edge>& edges)
+  {
+    std::vector<csr_graph::vertex_id> expected;
+    iterative_tarjan algo;
+    const size_t count = algo.label_components(
+      csr_graph::from_edges(graph.vertex_count(), edges), &expected);
+
+    ASSERT_EQ(count, graph.component_count());
+
+    std::vector<csr_graph::vertex_id> labels;
+    const csr_graph condensation = graph.condensation(&labels);
+
+    ASSERT_EQ(count, condensation.vertex_count());
+
+    for (const csr_graph::edge& e : edges)
+    {
+      ASSERT_EQ(expected[e.first] == expected[e.second],
+        graph.same_component(e.first, e.second));
+
+      // Every edge between components agrees with the topological order.
+      ASSERT_LE(labels[e.first], labels[e.second]);
+    }
+
+    for (csr_graph::vertex_id c = 0; c < condensation.vertex_count(); ++c)
+    {
+      for (auto itr = condensation.neighbors_begin(c);
+        itr != condensation.neighbors_end(c); ++itr)
+      {
+        ASSERT_LT(c, *itr);
+      }
+    }
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(incremental_scc_unittest, TestInitialization)
+{
+  incremental_scc graph(3);
+
+  ASSERT_EQ(3, graph.vertex_count());
+  ASSERT_EQ(3, graph.component_count());
+  ASSERT_EQ(3, graph.topological_order().size());
+  ASSERT_FALSE(graph.same_component(0, 1));
+  ASSERT_EQ(1, graph.members(2).size());
+
+  ASSERT_EQ(3, graph.add_vertex());
+  ASSERT_EQ(4, graph.component_count());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(incremental_scc_unittest, TestOutOfRange)
+{
+  incremental_scc graph(2);
+
+  ASSERT_THROW(graph.add_edge(0, 2), std::out_of_range);
+  ASSERT_THROW(graph.component(2), std::out_of_range);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(incremental_scc_unittest, TestCycleDetection)
+{
+  incremental_scc graph(4);
+
+  ASSERT_FALSE(graph.add_edge(0, 1));
+  ASSERT_FALSE(graph.add_edge(1, 2));
+  ASSERT_FALSE(graph.add_edge(2, 3));
+  ASSERT_EQ(4, graph.component_count());
+
+  ASSERT_TRUE(graph.add_edge(2, 0));
+  ASSERT_EQ(2, graph.component_count());
+  ASSERT_TRUE(graph.same_component(0, 2));
+  ASSERT_FALSE(graph.same_component(0, 3));
+
+  std::vector<csr_graph::vertex_id> members = graph.members(1);
+  std::sort(members.begin(), members.end());
+  ASSERT_EQ(3, members.size());
+  ASSERT_EQ(0, members[0]);
+  ASSERT_EQ(2, members[2]);
+
+  // Edges within a component, and self-loops, close no new cycle.
+  ASSERT_FALSE(graph.add_edge(1, 0));
+  ASSERT_FALSE(graph.add_edge(3, 3));
+  ASSERT_EQ(2, graph.component_count());
+
+  ASSERT_TRUE(graph.add_edge(3, 1));
+  ASSERT_EQ(1, graph.component_count());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(incremental_scc_unittest, TestTopologicalOrder)
+{
+  incremental_scc graph(4);
+
+  // Inserted against the initial order, which is that of the identifiers.
+  graph.add_edge(3, 2);
+  graph.add_edge(2, 1);
+  graph.add_edge(1, 0);
+
+  const std::vector<csr_graph::vertex_id> order = graph.topological_order();
+
+  ASSERT_EQ(4, order.size());
+  ASSERT_EQ(3, order[0]);
+  ASSERT_EQ(2, order[1]);
+  ASSERT_EQ(1, order[2]);
+  ASSERT_EQ(0, order[3]);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(incremental_scc_unittest, TestCondensation)
+{
+  /* Tests the following graph:
+   *
+   * (0) <-> (1) -> (2) <-> (3) -> (4)
+   *  |                             ^
+   *  |_____________________________|
+   */
+  incremental_scc graph(5);
+
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(3, 4));
+  edges.push_back(csr_graph::edge(1, 2));
+  edges.push_back(csr_graph::edge(2, 3));
+  edges.push_back(csr_graph::edge(3, 2));
+  edges.push_back(csr_graph::edge(0, 1));
+  edges.push_back(csr_graph::edge(1, 0));
+  edges.push_back(csr_graph::edge(0, 4));
+
+  for (const csr_graph::edge& e : edges)
+  {
+    graph.add_edge(e.first, e.second);
+  }
+
+  std::vector<csr_graph::vertex_id> labels;
+  const csr_graph condensation = graph.condensation(&labels);
+
+  ASSERT_EQ(3, condensation.vertex_count());
+  ASSERT_EQ(3, condensation.edge_count());
+
+  ASSERT_EQ(0, labels[0]);
+  ASSERT_EQ(0, labels[1]);
+  ASSERT_EQ(1, labels[2]);
+  ASSERT_EQ(1, labels[3]);
+  ASSERT_EQ(2, labels[4]);
+
+  assert_consistent(graph, edges);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(incremental_scc_unittest, TestRandomInsertionsAgainstTarjan)
+{
+  std::mt19937 engine(7);
+
+  for (size_t round = 0; round < 10; ++round)
+  {
+    const size_t vertex_count = 200 + round * 50;
+    std::uniform_int_distribution<csr_graph::vertex_id> distribution(0,
+      static_cast<csr_graph::vertex_id>(vertex_count - 1));
+
+    incremental_scc graph(vertex_count);
+    std::vector<csr_graph::edge> edges;
+
+    for (size_t i = 0; i < vertex_count * 2; ++i)
+    {
+      const csr_graph::edge e(distribution(engine), distribution(engine));
+
+      const size_t components = graph.component_count();
+      const bool cycle = graph.add_edge(e.first, e.second);
+      edges.push_back(e);
+
+      ASSERT_EQ(cycle, graph.component_count() < components);
+
+      if (i % 50 == 0)
+      {
+        assert_consistent(graph, edges);
+      }
+    }
+
+    assert_consistent(graph, edges);
+  }
+}
+
+// -----------------------------------------------------------------------------
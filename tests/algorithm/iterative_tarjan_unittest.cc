@@ -0,0 +1,240 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `sneaker::algorithm::iterative_tarjan` defined in
+ * sneaker/algorithm/iterative_tarjan.h */
+
+#include "algorithm/iterative_tarjan.h"
+
+#include "algorithm/csr_graph.h"
+
+#include "testing/testing.h"
+
+#include <random>
+#include <set>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+using sneaker::algorithm::csr_graph;
+using sneaker::algorithm::iterative_tarjan;
+
+// -----------------------------------------------------------------------------
+
+class iterative_tarjan_unittest : public ::testing::Test {
+protected:
+  typedef std::set<std::set<csr_graph::vertex_id>> partition_type;
+
+  static partition_type partition(const csr_graph& graph)
+  {
+    partition_type components;
+
+    iterative_tarjan algo;
+    algo.for_each_component(graph,
+      [&components](const std::vector<csr_graph::vertex_id>& component) {
+        components.insert(std::set<csr_graph::vertex_id>(component.begin(),
+          component.end()));
+      }
+    );
+
+    return components;
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(iterative_tarjan_unittest, TestEmptyGraph)
+{
+  std::vector<csr_graph::vertex_id> labels;
+
+  iterative_tarjan algo;
+  ASSERT_EQ(0, algo.label_components(csr_graph(), &labels));
+  ASSERT_TRUE(labels.empty());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(iterative_tarjan_unittest, TestLabelComponents)
+{
+  /* Tests the following graph:
+   *
+   * (0) <-> (1) -> (2) <-> (3)    (4)
+   */
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(0, 1));
+  edges.push_back(csr_graph::edge(1, 0));
+  edges.push_back(csr_graph::edge(1, 2));
+  edges.push_back(csr_graph::edge(2, 3));
+  edges.push_back(csr_graph::edge(3, 2));
+
+  const csr_graph graph = csr_graph::from_edges(5, edges);
+
+  std::vector<csr_graph::vertex_id> labels;
+
+  iterative_tarjan algo;
+  ASSERT_EQ(3, algo.label_components(graph, &labels));
+
+  ASSERT_EQ(5, labels.size());
+  ASSERT_EQ(labels[0], labels[1]);
+  ASSERT_EQ(labels[2], labels[3]);
+  ASSERT_NE(labels[0], labels[2]);
+
+  // Components are completed in reverse topological order.
+  ASSERT_LT(labels[2], labels[0]);
+  ASSERT_EQ(2, labels[4]);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(iterative_tarjan_unittest, TestSelfLoop)
+{
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(0, 0));
+  edges.push_back(csr_graph::edge(0, 1));
+
+  std::vector<csr_graph::vertex_id> labels;
+
+  iterative_tarjan algo;
+  ASSERT_EQ(2, algo.label_components(csr_graph::from_edges(2, edges), &labels));
+  ASSERT_EQ(0, labels[1]);
+  ASSERT_EQ(1, labels[0]);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(iterative_tarjan_unittest, TestDeepChain)
+{
+  // A chain deep enough to overflow the call stack with a recursive search.
+  const size_t N = 2000000;
+
+  std::vector<csr_graph::edge> edges;
+  edges.reserve(N - 1);
+
+  for (size_t i = 0; i + 1 < N; ++i)
+  {
+    edges.push_back(csr_graph::edge(static_cast<csr_graph::vertex_id>(i),
+      static_cast<csr_graph::vertex_id>(i + 1)));
+  }
+
+  const csr_graph graph = csr_graph::from_edges(N, edges);
+
+  std::vector<csr_graph::vertex_id> labels;
+
+  iterative_tarjan algo;
+  ASSERT_EQ(N, algo.label_components(graph, &labels));
+
+  // The end of the chain completes first.
+  ASSERT_EQ(0, labels[N - 1]);
+  ASSERT_EQ(N - 1, labels[0]);
+
+  ASSERT_EQ(N - 1, algo.index()[N - 1]);
+  ASSERT_EQ(N - 1, algo.lowlink()[N - 1]);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(iterative_tarjan_unittest, TestReusedInstance)
+{
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(0, 1));
+  edges.push_back(csr_graph::edge(1, 0));
+
+  const csr_graph graph = csr_graph::from_edges(2, edges);
+
+  std::vector<csr_graph::vertex_id> labels;
+
+  iterative_tarjan algo;
+  ASSERT_EQ(1, algo.label_components(graph, &labels));
+  ASSERT_EQ(3, algo.label_components(csr_graph::from_edges(3,
+    std::vector<csr_graph::edge>()), &labels));
+  ASSERT_EQ(1, algo.label_components(graph, &labels));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(iterative_tarjan_unittest, TestRandomGraphsAgainstReachability)
+{
+  std::mt19937 engine(42);
+
+  for (size_t round = 0; round < 20; ++round)
+  {
+    const size_t vertex_count = 50 + round * 10;
+    std::uniform_int_distribution<csr_graph::vertex_id> distribution(0,
+      static_cast<csr_graph::vertex_id>(vertex_count - 1));
+
+    std::vector<csr_graph::edge> edges;
+    for (size_t i = 0; i < vertex_count * 2; ++i)
+    {
+      edges.push_back(csr_graph::edge(distribution(engine),
+        distribution(engine)));
+    }
+
+    const csr_graph graph = csr_graph::from_edges(vertex_count, edges);
+
+    // Two vertices share a component iff each one reaches the other.
+    std::vector<std::vector<bool>> reaches(vertex_count,
+      std::vector<bool>(vertex_count, false));
+
+    for (csr_graph::vertex_id source = 0; source < vertex_count; ++source)
+    {
+      std::vector<csr_graph::vertex_id> pending(1, source);
+      reaches[source][source] = true;
+
+      while (!pending.empty())
+      {
+        const csr_graph::vertex_id vertex = pending.back();
+        pending.pop_back();
+
+        for (auto itr = graph.neighbors_begin(vertex);
+          itr != graph.neighbors_end(vertex); ++itr)
+        {
+          if (!reaches[source][*itr])
+          {
+            reaches[source][*itr] = true;
+            pending.push_back(*itr);
+          }
+        }
+      }
+    }
+
+    partition_type expected;
+    for (csr_graph::vertex_id u = 0; u < vertex_count; ++u)
+    {
+      std::set<csr_graph::vertex_id> component;
+      for (csr_graph::vertex_id v = 0; v < vertex_count; ++v)
+      {
+        if (reaches[u][v] && reaches[v][u])
+        {
+          component.insert(v);
+        }
+      }
+
+      expected.insert(component);
+    }
+
+    ASSERT_EQ(expected, partition(graph));
+  }
+}
+
+// -----------------------------------------------------------------------------
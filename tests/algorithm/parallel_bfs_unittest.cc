@@ -0,0 +1,181 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `sneaker::algorithm::parallel_bfs` defined in
+ * sneaker/algorithm/parallel_bfs.h */
+
+#include "algorithm/parallel_bfs.h"
+
+#include "algorithm/csr_graph.h"
+
+#include "testing/testing.h"
+
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+using sneaker::algorithm::csr_graph;
+using sneaker::algorithm::parallel_bfs;
+
+// -----------------------------------------------------------------------------
+
+class parallel_bfs_unittest : public ::testing::Test {
+protected:
+  static std::vector<csr_graph::vertex_id> sequential_bfs(
+    const csr_graph& graph, csr_graph::vertex_id source)
+  {
+    std::vector<csr_graph::vertex_id> distances(graph.vertex_count(),
+      parallel_bfs::UNREACHED);
+    distances[source] = 0;
+
+    std::deque<csr_graph::vertex_id> pending(1, source);
+
+    while (!pending.empty())
+    {
+      const csr_graph::vertex_id vertex = pending.front();
+      pending.pop_front();
+
+      for (auto itr = graph.neighbors_begin(vertex);
+        itr != graph.neighbors_end(vertex); ++itr)
+      {
+        if (distances[*itr] == parallel_bfs::UNREACHED)
+        {
+          distances[*itr] = distances[vertex] + 1;
+          pending.push_back(*itr);
+        }
+      }
+    }
+
+    return distances;
+  }
+
+  static csr_graph random_graph(size_t vertex_count, size_t edge_count,
+    uint32_t seed)
+  {
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<csr_graph::vertex_id> distribution(0,
+      static_cast<csr_graph::vertex_id>(vertex_count - 1));
+
+    std::vector<csr_graph::edge> edges;
+    for (size_t i = 0; i < edge_count; ++i)
+    {
+      const csr_graph::vertex_id source = distribution(engine);
+      edges.push_back(csr_graph::edge(source, distribution(engine)));
+    }
+
+    return csr_graph::from_edges(vertex_count, edges);
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_bfs_unittest, TestChain)
+{
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(0, 1));
+  edges.push_back(csr_graph::edge(1, 2));
+  edges.push_back(csr_graph::edge(3, 2));
+
+  const csr_graph graph = csr_graph::from_edges(4, edges);
+
+  std::vector<csr_graph::vertex_id> distances;
+
+  parallel_bfs bfs(2);
+  ASSERT_EQ(3, bfs.run(graph, graph.transpose(), 0, &distances));
+
+  ASSERT_EQ(0, distances[0]);
+  ASSERT_EQ(1, distances[1]);
+  ASSERT_EQ(2, distances[2]);
+  ASSERT_EQ(parallel_bfs::UNREACHED, distances[3]);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_bfs_unittest, TestInvalidArguments)
+{
+  const csr_graph graph = random_graph(10, 20, 1);
+
+  std::vector<csr_graph::vertex_id> distances;
+
+  parallel_bfs bfs(2);
+  ASSERT_THROW(bfs.run(graph, graph.transpose(), 10, &distances),
+    std::out_of_range);
+  ASSERT_THROW(bfs.run(graph, random_graph(11, 20, 1), 0, &distances),
+    std::invalid_argument);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_bfs_unittest, TestDenseGraphGoesBottomUp)
+{
+  const csr_graph graph = random_graph(20000, 320000, 2);
+  const csr_graph transpose = graph.transpose();
+
+  std::vector<csr_graph::vertex_id> distances;
+
+  parallel_bfs bfs(4);
+  bfs.run(graph, transpose, 0, &distances);
+
+  ASSERT_LT(0, bfs.bottom_up_levels());
+  ASSERT_EQ(sequential_bfs(graph, 0), distances);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_bfs_unittest, TestRandomGraphsAgainstSequentialSearch)
+{
+  const size_t THREAD_COUNTS[] = { 1, 3, 8 };
+
+  for (uint32_t seed = 0; seed < 6; ++seed)
+  {
+    const size_t vertex_count = 500 + seed * 2000;
+    const csr_graph graph =
+      random_graph(vertex_count, vertex_count * (1 + seed * 2), seed);
+    const csr_graph transpose = graph.transpose();
+
+    const std::vector<csr_graph::vertex_id> expected =
+      sequential_bfs(graph, seed);
+
+    size_t expected_reached = 0;
+    for (const csr_graph::vertex_id distance : expected)
+    {
+      expected_reached += distance != parallel_bfs::UNREACHED ? 1 : 0;
+    }
+
+    for (size_t thread_count : THREAD_COUNTS)
+    {
+      std::vector<csr_graph::vertex_id> distances;
+
+      parallel_bfs bfs(thread_count);
+      ASSERT_EQ(expected_reached,
+        bfs.run(graph, transpose, seed, &distances));
+      ASSERT_EQ(expected, distances);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,240 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `sneaker::algorithm::parallel_scc` defined in
+ * sneaker/algorithm/parallel_scc.h */
+
+#include "algorithm/parallel_scc.h"
+
+#include "algorithm/csr_graph.h"
+#include "algorithm/iterative_tarjan.h"
+
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+using sneaker::algorithm::csr_graph;
+using sneaker::algorithm::iterative_tarjan;
+using sneaker::algorithm::parallel_scc;
+
+// -----------------------------------------------------------------------------
+
+class parallel_scc_unittest : public ::testing::Test {
+protected:
+  /**
+   * Asserts that two labelings partition the vertices identically, up to
+   * the numbering of the components.
+   */
+  static void assert_same_partition(const std::vector<csr_graph::vertex_id>& expected,
+    const std::vector<csr_graph::vertex_id>& actual)
+  {
+    ASSERT_EQ(expected.size(), actual.size());
+
+    std::map<csr_graph::vertex_id, csr_graph::vertex_id> forward;
+    std::map<csr_graph::vertex_id, csr_graph::vertex_id> backward;
+
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+      auto result = forward.insert(std::make_pair(expected[i], actual[i]));
+      ASSERT_EQ(actual[i], result.first->second);
+
+      result = backward.insert(std::make_pair(actual[i], expected[i]));
+      ASSERT_EQ(expected[i], result.first->second);
+    }
+  }
+
+  static void assert_matches_tarjan(const csr_graph& graph, size_t thread_count)
+  {
+    std::vector<csr_graph::vertex_id> expected;
+    iterative_tarjan sequential;
+    const size_t expected_count = sequential.label_components(graph, &expected);
+
+    std::vector<csr_graph::vertex_id> actual;
+    parallel_scc algo(thread_count, 0);
+    ASSERT_EQ(expected_count, algo.label_components(graph, &actual));
+
+    assert_same_partition(expected, actual);
+  }
+
+  static csr_graph random_graph(size_t vertex_count, size_t edge_count,
+    bool skewed, uint32_t seed)
+  {
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<csr_graph::vertex_id> uniform(0,
+      static_cast<csr_graph::vertex_id>(vertex_count - 1));
+    std::exponential_distribution<double> exponential(8.0);
+
+    auto pick = [&]() -> csr_graph::vertex_id {
+      if (!skewed)
+      {
+        return uniform(engine);
+      }
+
+      const double position = std::min(exponential(engine), 1.0);
+      return static_cast<csr_graph::vertex_id>(
+        position * static_cast<double>(vertex_count - 1));
+    };
+
+    std::vector<csr_graph::edge> edges;
+    for (size_t i = 0; i < edge_count; ++i)
+    {
+      const csr_graph::vertex_id source = pick();
+      edges.push_back(csr_graph::edge(source, pick()));
+    }
+
+    return csr_graph::from_edges(vertex_count, edges);
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_scc_unittest, TestThreadCount)
+{
+  ASSERT_EQ(3, parallel_scc(3).thread_count());
+  ASSERT_LE(1, parallel_scc().thread_count());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_scc_unittest, TestEmptyGraph)
+{
+  std::vector<csr_graph::vertex_id> labels;
+
+  parallel_scc algo(4, 0);
+  ASSERT_EQ(0, algo.label_components(csr_graph(), &labels));
+  ASSERT_TRUE(labels.empty());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_scc_unittest, TestGetComponents)
+{
+  /* Tests the following graph:
+   *
+   * (0) -> (1) -> (2) -> (3)    (4) <-> (5)
+   *  ^             |             ^
+   *  |_____________|             |
+   *                             (6) <-> (6)
+   */
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(0, 1));
+  edges.push_back(csr_graph::edge(1, 2));
+  edges.push_back(csr_graph::edge(2, 0));
+  edges.push_back(csr_graph::edge(2, 3));
+  edges.push_back(csr_graph::edge(4, 5));
+  edges.push_back(csr_graph::edge(5, 4));
+  edges.push_back(csr_graph::edge(6, 6));
+  edges.push_back(csr_graph::edge(6, 4));
+
+  parallel_scc algo(4, 0);
+  auto components = algo.get_components<int>(csr_graph::from_edges(7, edges));
+
+  ASSERT_EQ(4, components.size());
+  ASSERT_EQ(2, components.independent_components().size());
+
+  auto cycles = components.cycles();
+  ASSERT_EQ(2, cycles.size());
+
+  for (auto& cycle : cycles)
+  {
+    std::sort(cycle.begin(), cycle.end());
+  }
+  std::sort(cycles.begin(), cycles.end());
+
+  std::vector<int> expected;
+  expected.push_back(0);
+  expected.push_back(1);
+  expected.push_back(2);
+  ASSERT_EQ(expected, cycles[0]);
+
+  expected.clear();
+  expected.push_back(4);
+  expected.push_back(5);
+  ASSERT_EQ(expected, cycles[1]);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_scc_unittest, TestSequentialThreshold)
+{
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(0, 1));
+  edges.push_back(csr_graph::edge(1, 0));
+
+  std::vector<csr_graph::vertex_id> labels;
+
+  parallel_scc algo(4);
+  ASSERT_EQ(2, algo.label_components(csr_graph::from_edges(3, edges), &labels));
+  ASSERT_EQ(labels[0], labels[1]);
+  ASSERT_NE(labels[0], labels[2]);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_scc_unittest, TestDeepCycleAndChain)
+{
+  const size_t N = 100000;
+
+  std::vector<csr_graph::edge> edges;
+  for (size_t i = 0; i + 1 < N; ++i)
+  {
+    edges.push_back(csr_graph::edge(static_cast<csr_graph::vertex_id>(i),
+      static_cast<csr_graph::vertex_id>(i + 1)));
+  }
+
+  assert_matches_tarjan(csr_graph::from_edges(N, edges), 4);
+
+  edges.push_back(csr_graph::edge(static_cast<csr_graph::vertex_id>(N - 1), 0));
+
+  assert_matches_tarjan(csr_graph::from_edges(N, edges), 4);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_scc_unittest, TestRandomGraphsAgainstTarjan)
+{
+  const size_t THREAD_COUNTS[] = { 1, 2, 4, 8 };
+
+  for (uint32_t seed = 0; seed < 8; ++seed)
+  {
+    const size_t vertex_count = 1000 + seed * 3000;
+
+    for (size_t thread_count : THREAD_COUNTS)
+    {
+      assert_matches_tarjan(
+        random_graph(vertex_count, vertex_count * 2, false, seed),
+        thread_count);
+      assert_matches_tarjan(
+        random_graph(vertex_count, vertex_count * 3, true, seed),
+        thread_count);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "testing/testing.h"
 
+#include <algorithm>
 #include <vector>
 
 
@@ -391,3 +392,71 @@ TEST_F(tarjan_unittest, TestOverlappingCycles)
 }
 
 // -----------------------------------------------------------------------------
+
+TEST_F(tarjan_unittest, TestDeepCycle)
+{
+  /* Tests a single cycle deep enough to overflow the call stack with a
+   * recursive search:
+   *
+   * (0) -> (1) -> ... -> (N - 1)
+   *  ^                     |
+   *  |_____________________|
+   */
+  const size_t N = 1000000;
+
+  std::vector<tarjan<int>::vertex> storage;
+  storage.reserve(N);
+
+  for (size_t i = 0; i < N; ++i) {
+    storage.push_back(tarjan<int>::vertex(static_cast<int>(i)));
+  }
+
+  for (size_t i = 0; i < N; ++i) {
+    storage[i].dependencies().push_back(&storage[(i + 1) % N]);
+  }
+
+  std::vector<tarjan<int>::vertex*> vertices;
+  vertices.push_back(&storage[0]);
+
+  detect_cycle_and_assert_results(vertices, 1, 0, 1);
+
+  ASSERT_EQ(0, storage[0].index());
+  ASSERT_EQ(static_cast<int>(N - 1), storage[N - 1].index());
+  ASSERT_EQ(0, storage[N - 1].lowlink());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(tarjan_unittest, TestComponentsOfCSRGraph)
+{
+  /* Tests the following graph:
+   *
+   * (0) -> (1) -> (2) -> (3)
+   *  ^             |
+   *  |_____________|
+   */
+  std::vector<csr_graph::edge> edges;
+  edges.push_back(csr_graph::edge(0, 1));
+  edges.push_back(csr_graph::edge(1, 2));
+  edges.push_back(csr_graph::edge(2, 0));
+  edges.push_back(csr_graph::edge(2, 3));
+
+  tarjan<int> algo;
+  auto components = algo.get_components(csr_graph::from_edges(4, edges));
+
+  ASSERT_EQ(2, components.size());
+
+  auto independent_components = components.independent_components();
+  ASSERT_EQ(1, independent_components.size());
+  ASSERT_EQ(std::vector<int>(1, 3), independent_components[0]);
+
+  auto cycles = components.cycles();
+  ASSERT_EQ(1, cycles.size());
+  std::sort(cycles[0].begin(), cycles[0].end());
+  ASSERT_EQ(3, cycles[0].size());
+  ASSERT_EQ(0, cycles[0][0]);
+  ASSERT_EQ(1, cycles[0][1]);
+  ASSERT_EQ(2, cycles[0][2]);
+}
+
+// -----------------------------------------------------------------------------
@@ -237,3 +237,25 @@ TEST_F(cache_interface_unittest, TestInsertOverNItems)
 }
 
 // -----------------------------------------------------------------------------
+
+TEST_F(cache_interface_unittest, TestErase)
+{
+  m_fixture.m_cache.insert("a", "apple");
+  m_fixture.m_cache.insert("b", "banana");
+
+  ASSERT_EQ(2, m_fixture.m_cache.size());
+  ASSERT_EQ(2, m_fixture.truth_map.size());
+
+  ASSERT_EQ(false, m_fixture.m_cache.erase("c"));
+  ASSERT_EQ(2, m_fixture.truth_map.size());
+
+  ASSERT_EQ(true, m_fixture.m_cache.erase("a"));
+
+  ASSERT_EQ(1, m_fixture.m_cache.size());
+  ASSERT_EQ(false, m_fixture.m_cache.find("a"));
+
+  check_item_destroyed("a");
+  check_item_created("b");
+}
+
+// -----------------------------------------------------------------------------
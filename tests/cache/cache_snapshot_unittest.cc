@@ -0,0 +1,300 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for definitions in sneaker/cache/cache_snapshot.h */
+
+#include "cache/cache_snapshot.h"
+
+#include "cache/cache_interface.h"
+#include "cache/lru_cache.h"
+#include "cache/sharded_cache.h"
+#include "cache/weighted_lru_cache.h"
+#include "io/input_stream.h"
+#include "io/output_stream.h"
+#include "io/tmp_file.h"
+
+#include "testing/testing.h"
+
+#include <cstdio>
+#include <ios>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+template<typename K, typename V>
+struct erasure_recorder
+{
+  explicit erasure_recorder(std::vector<K>* erased)
+    :
+    m_erased(erased)
+  {
+  }
+
+  void operator()(K key, const V& /* value */) const
+  {
+    if (m_erased)
+    {
+      m_erased->push_back(key);
+    }
+  }
+
+  std::vector<K>* m_erased;
+};
+
+/**
+ * Serializer that stores integers as their decimal representations, to
+ * exercise pluggable serializers.
+ */
+struct decimal_serializer
+{
+  static bool write(sneaker::io::stream_writer& writer, const int& value)
+  {
+    return sneaker::cache::snapshot_serializer<std::string>::write(
+      writer, std::to_string(value));
+  }
+
+  static bool read(sneaker::io::stream_reader& reader, int& value)
+  {
+    std::string str;
+    if (!sneaker::cache::snapshot_serializer<std::string>::read(reader, str))
+    {
+      return false;
+    }
+
+    value = std::stoi(str);
+    return true;
+  }
+};
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+class cache_snapshot_unittest : public ::testing::Test
+{
+protected:
+  typedef erasure_recorder<int, std::string> handler_type;
+
+  typedef sneaker::cache::cache_interface<
+    sneaker::cache::lru_cache<int, std::string, 4>,
+    handler_type, handler_type> cache_type;
+
+  cache_snapshot_unittest()
+    :
+    m_erased(),
+    m_cache(handler_type(NULL), handler_type(&m_erased))
+  {
+  }
+
+  std::string save(const cache_type& cache)
+  {
+    std::stringstream ss;
+    auto stream = sneaker::io::ostream_output_stream(ss, 8);
+    sneaker::cache::save_snapshot(cache, *stream);
+    return ss.str();
+  }
+
+  size_t load(cache_type& cache, const std::string& snapshot)
+  {
+    auto stream = sneaker::io::memory_input_stream(
+      reinterpret_cast<const uint8_t*>(snapshot.data()), snapshot.size());
+    return sneaker::cache::load_snapshot(cache, *stream);
+  }
+
+  std::vector<int> m_erased;
+  cache_type m_cache;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_snapshot_unittest, TestRoundTripPreservesRecency)
+{
+  m_cache.insert(1, "one");
+  m_cache.insert(2, "two");
+  m_cache.insert(3, "three");
+
+  std::string value;
+  ASSERT_EQ(true, m_cache.get(1, value));
+
+  const std::string snapshot = save(m_cache);
+
+  std::vector<int> erased;
+  cache_type cache(handler_type(NULL), handler_type(&erased));
+
+  ASSERT_EQ(3, load(cache, snapshot));
+  ASSERT_EQ(3, cache.size());
+
+  ASSERT_EQ(true, cache.get(3, value));
+  ASSERT_EQ("three", value);
+
+  // The least recently used entry at the time of the snapshot is evicted
+  // first.
+  cache.insert(4, "four");
+  cache.insert(5, "five");
+
+  ASSERT_EQ(std::vector<int>({2}), erased);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_snapshot_unittest, TestEmptyCache)
+{
+  const std::string snapshot = save(m_cache);
+
+  // Magic number, version and end marker.
+  ASSERT_EQ(6, snapshot.size());
+
+  ASSERT_EQ(0, load(m_cache, snapshot));
+  ASSERT_EQ(true, m_cache.empty());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_snapshot_unittest, TestInvalidSnapshot)
+{
+  ASSERT_THROW(load(m_cache, ""), std::ios_base::failure);
+  ASSERT_THROW(load(m_cache, "SNKD\x01"), std::ios_base::failure);
+  ASSERT_THROW(load(m_cache, std::string("SNKC\x02\x00", 6)),
+    std::ios_base::failure);
+
+  m_cache.insert(1, "one");
+  m_cache.insert(2, "two");
+
+  std::string snapshot = save(m_cache);
+  m_cache.clear();
+
+  // Truncated in the middle of the second entry.
+  snapshot.resize(snapshot.size() - 3);
+
+  ASSERT_THROW(load(m_cache, snapshot), std::ios_base::failure);
+  ASSERT_EQ(1, m_cache.size());
+  ASSERT_EQ(true, m_cache.find(1));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_snapshot_unittest, TestCorruptedStringLength)
+{
+  const int key = 1;
+  const std::string entry = std::string("SNKC\x01\x01", 6) +
+    std::string(reinterpret_cast<const char*>(&key), sizeof(key));
+
+  // Lengths of 2^62 and 2^64 - 1 bytes, followed by a few bytes of value.
+  const std::string lengths[] = {
+    std::string("\x80\x80\x80\x80\x80\x80\x80\x80\x40", 9),
+    std::string("\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01", 10),
+    std::string("\xff\xff\xff\xff\xff\xff\xff\xff\xff\x7f", 10),
+    std::string("\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01", 11),
+    std::string("\x80\x80\x04", 3)
+  };
+
+  for (const std::string& length : lengths)
+  {
+    const std::string snapshot = entry + length + "abc";
+
+    ASSERT_THROW(load(m_cache, snapshot), std::ios_base::failure);
+    ASSERT_EQ(true, m_cache.empty());
+
+    auto stream = sneaker::io::memory_input_stream(
+      reinterpret_cast<const uint8_t*>(length.data()), length.size());
+    sneaker::io::stream_reader reader(stream.get());
+
+    std::string value;
+    ASSERT_EQ(false,
+      sneaker::cache::snapshot_serializer<std::string>::read(reader, value));
+    ASSERT_GE(64 * 1024, value.size());
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_snapshot_unittest, TestPluggableSerializers)
+{
+  typedef sneaker::cache::cache_interface<
+    sneaker::cache::weighted_lru_cache<int, int>,
+    erasure_recorder<int, int>, erasure_recorder<int, int>> int_cache_type;
+
+  int_cache_type cache(erasure_recorder<int, int>(NULL),
+    erasure_recorder<int, int>(NULL), 10);
+
+  cache.insert(1, 100);
+  cache.insert(2, -200);
+
+  std::stringstream ss;
+  auto output = sneaker::io::ostream_output_stream(ss, 16);
+
+  ASSERT_EQ(2, (sneaker::cache::save_snapshot<int_cache_type,
+    decimal_serializer, decimal_serializer>(cache, *output)));
+
+  ASSERT_NE(std::string::npos, ss.str().find("-200"));
+
+  int_cache_type restored(erasure_recorder<int, int>(NULL),
+    erasure_recorder<int, int>(NULL), 10);
+
+  const std::string snapshot = ss.str();
+  auto input = sneaker::io::memory_input_stream(
+    reinterpret_cast<const uint8_t*>(snapshot.data()), snapshot.size());
+
+  ASSERT_EQ(2, (sneaker::cache::load_snapshot<int_cache_type,
+    decimal_serializer, decimal_serializer>(restored, *input)));
+
+  int value = 0;
+  ASSERT_EQ(true, restored.get(2, value));
+  ASSERT_EQ(-200, value);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_snapshot_unittest, TestSnapshotFile)
+{
+  typedef sneaker::cache::sharded_cache<
+    sneaker::cache::lru_cache<int, std::string, 64>,
+    handler_type, handler_type, 4> sharded_cache_type;
+
+  sharded_cache_type cache(handler_type(NULL), handler_type(NULL));
+
+  for (int i = 0; i < 100; ++i)
+  {
+    cache.insert(i, std::string(static_cast<size_t>(i), 'x'));
+  }
+
+  const char* path = sneaker::io::get_tmp_file_path();
+
+  ASSERT_EQ(100, sneaker::cache::save_snapshot_file(cache, path, 128));
+
+  sharded_cache_type restored(handler_type(NULL), handler_type(NULL));
+
+  ASSERT_EQ(100, sneaker::cache::load_snapshot_file(restored, path));
+  ASSERT_EQ(100, restored.size());
+
+  std::string value;
+  ASSERT_EQ(true, restored.get(99, value));
+  ASSERT_EQ(std::string(99, 'x'), value);
+
+  remove(path);
+}
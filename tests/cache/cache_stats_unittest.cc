@@ -0,0 +1,318 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `cache_stats` and `cache_stats_recorder` in
+ * sneaker/cache/cache_stats.h */
+
+#include "cache/cache_interface.h"
+#include "cache/cache_stats.h"
+#include "cache/expiring_cache.h"
+#include "cache/lru_cache.h"
+#include "cache/sharded_cache.h"
+
+#include "json/json.h"
+#include "testing/testing.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+struct noop_handler
+{
+  void operator()(int, const int&) const
+  {
+  }
+};
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+class cache_stats_unittest : public ::testing::Test
+{
+protected:
+  sneaker::cache::cache_stats_recorder m_recorder;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_stats_unittest, TestInitialization)
+{
+  const sneaker::cache::cache_stats stats = m_recorder.snapshot();
+
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(0, stats.misses);
+  ASSERT_EQ(0, stats.requests());
+  ASSERT_EQ(1.0, stats.hit_ratio());
+  ASSERT_EQ(0, stats.insertions);
+  ASSERT_EQ(0, stats.evictions);
+  ASSERT_EQ(0, stats.expirations);
+  ASSERT_EQ(0, stats.removals);
+  ASSERT_EQ(0, stats.loads());
+  ASSERT_EQ(0, stats.size);
+
+  for (size_t i = 0; i < sneaker::cache::cache_stats::LOAD_LATENCY_BUCKETS; ++i)
+  {
+    ASSERT_EQ(0, stats.load_latencies[i]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_stats_unittest, TestRecord)
+{
+  m_recorder.record_hit();
+  m_recorder.record_hit();
+  m_recorder.record_hit();
+  m_recorder.record_miss();
+  m_recorder.record_insertion();
+  m_recorder.record_eviction();
+  m_recorder.record_expiration();
+  m_recorder.record_removal();
+  m_recorder.record_size_change(5);
+  m_recorder.record_size_change(-2);
+
+  const sneaker::cache::cache_stats stats = m_recorder.snapshot();
+
+  ASSERT_EQ(3, stats.hits);
+  ASSERT_EQ(1, stats.misses);
+  ASSERT_EQ(4, stats.requests());
+  ASSERT_DOUBLE_EQ(0.75, stats.hit_ratio());
+  ASSERT_EQ(1, stats.insertions);
+  ASSERT_EQ(1, stats.evictions);
+  ASSERT_EQ(1, stats.expirations);
+  ASSERT_EQ(1, stats.removals);
+  ASSERT_EQ(3, stats.size);
+
+  m_recorder.reset();
+
+  ASSERT_EQ(0, m_recorder.snapshot().hits);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_stats_unittest, TestLoadLatencies)
+{
+  // Less than 1 microsecond.
+  m_recorder.record_load_success(999);
+  // Within [1, 2) microseconds.
+  m_recorder.record_load_success(1500);
+  // Within [512, 1024) microseconds.
+  m_recorder.record_load_failure(1000000);
+  // Beyond the last bucket.
+  m_recorder.record_load_failure(3600ULL * 1000000000ULL);
+
+  const sneaker::cache::cache_stats stats = m_recorder.snapshot();
+
+  ASSERT_EQ(2, stats.load_successes);
+  ASSERT_EQ(2, stats.load_failures);
+  ASSERT_EQ(4, stats.loads());
+
+  ASSERT_EQ(1, stats.load_latencies[0]);
+  ASSERT_EQ(1, stats.load_latencies[1]);
+  ASSERT_EQ(1, stats.load_latencies[10]);
+  ASSERT_EQ(1,
+    stats.load_latencies[sneaker::cache::cache_stats::LOAD_LATENCY_BUCKETS - 1]);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_stats_unittest, TestRecordFromMultipleThreads)
+{
+  const int THREADS = 8;
+  const int OPS = 10000;
+
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < THREADS; ++t)
+  {
+    threads.push_back(std::thread([this]() {
+      for (int i = 0; i < OPS; ++i)
+      {
+        m_recorder.record_hit();
+        m_recorder.record_size_change(1);
+      }
+    }));
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  const sneaker::cache::cache_stats stats = m_recorder.snapshot();
+
+  ASSERT_EQ(THREADS * OPS, stats.hits);
+  ASSERT_EQ(THREADS * OPS, stats.size);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_stats_unittest, TestToJSON)
+{
+  m_recorder.record_hit();
+  m_recorder.record_miss();
+  m_recorder.record_eviction();
+  m_recorder.record_load_success(1500);
+  m_recorder.record_size_change(7);
+
+  const sneaker::json::JSON json = m_recorder.snapshot().to_json();
+
+  ASSERT_EQ(1, json["hits"].int_value());
+  ASSERT_EQ(1, json["misses"].int_value());
+  ASSERT_DOUBLE_EQ(0.5, json["hit_ratio"].number_value());
+  ASSERT_EQ(0, json["insertions"].int_value());
+  ASSERT_EQ(1, json["evictions"]["size"].int_value());
+  ASSERT_EQ(0, json["evictions"]["expired"].int_value());
+  ASSERT_EQ(0, json["evictions"]["explicit"].int_value());
+  ASSERT_EQ(1, json["loads"]["successes"].int_value());
+  ASSERT_EQ(0, json["loads"]["failures"].int_value());
+  ASSERT_EQ(7, json["size"].int_value());
+
+  const sneaker::json::JSON::array& latencies =
+    json["loads"]["latencies"].array_items();
+
+  ASSERT_EQ(sneaker::cache::cache_stats::LOAD_LATENCY_BUCKETS, latencies.size());
+  ASSERT_EQ(1, latencies[0]["upper_bound_us"].int_value());
+  ASSERT_EQ(0, latencies[0]["count"].int_value());
+  ASSERT_EQ(2, latencies[1]["upper_bound_us"].int_value());
+  ASSERT_EQ(1, latencies[1]["count"].int_value());
+  ASSERT_EQ(true, latencies.back()["upper_bound_us"].is_null());
+
+  // Converts implicitly.
+  const sneaker::json::JSON implicit = m_recorder.snapshot();
+  ASSERT_EQ(json, implicit);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_stats_unittest, TestWithCacheInterface)
+{
+  sneaker::cache::cache_interface<sneaker::cache::lru_cache<int, int, 2>,
+    noop_handler, noop_handler> cache((noop_handler()), (noop_handler()));
+
+  // Not recorded before attaching the recorder.
+  cache.insert(100, 100);
+  cache.erase(100);
+
+  cache.set_stats_recorder(&m_recorder);
+
+  int value = 0;
+  cache.insert(1, 1);
+  cache.insert(2, 2);
+  cache.get(1, value);
+  cache.get(3, value);
+  cache.insert(3, 3);
+  cache.erase(1);
+
+  sneaker::cache::cache_stats stats = m_recorder.snapshot();
+
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(1, stats.misses);
+  ASSERT_EQ(3, stats.insertions);
+  ASSERT_EQ(1, stats.evictions);
+  ASSERT_EQ(1, stats.removals);
+  ASSERT_EQ(0, stats.expirations);
+  ASSERT_EQ(static_cast<int64_t>(cache.size()), stats.size);
+
+  cache.clear();
+
+  ASSERT_EQ(0, m_recorder.snapshot().size);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_stats_unittest, TestExpirations)
+{
+  sneaker::cache::cache_interface<
+    sneaker::cache::expiring_cache<sneaker::cache::lru_cache<int, int, 4>>,
+    noop_handler, noop_handler> cache((noop_handler()), (noop_handler()),
+      std::chrono::milliseconds(1));
+
+  cache.set_stats_recorder(&m_recorder);
+
+  cache.insert(1, 1);
+  cache.insert(2, 2);
+  cache.insert(3, 3);
+
+  usleep(5 * 1000);
+
+  int value = 0;
+  ASSERT_EQ(false, cache.get(1, value));
+  ASSERT_EQ(2, cache.expire(10));
+
+  const sneaker::cache::cache_stats stats = m_recorder.snapshot();
+
+  ASSERT_EQ(1, stats.misses);
+  ASSERT_EQ(3, stats.expirations);
+  ASSERT_EQ(0, stats.size);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_stats_unittest, TestWithShardedCache)
+{
+  sneaker::cache::sharded_cache<sneaker::cache::lru_cache<int, int, 16>,
+    noop_handler, noop_handler, 4> cache((noop_handler()), (noop_handler()));
+
+  cache.set_stats_recorder(&m_recorder);
+
+  for (int i = 0; i < 32; ++i)
+  {
+    cache.insert(i, i);
+  }
+
+  for (int i = 0; i < 64; ++i)
+  {
+    int value = 0;
+    cache.get(i, value);
+  }
+
+  const sneaker::cache::cache_stats stats = m_recorder.snapshot();
+
+  ASSERT_EQ(32, stats.insertions);
+  ASSERT_EQ(32, stats.hits);
+  ASSERT_EQ(32, stats.misses);
+  ASSERT_EQ(32, stats.size);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(cache_stats_unittest, TestHeapAllocatedRecorderIsAligned)
+{
+  std::unique_ptr<sneaker::cache::cache_stats_recorder> recorder(
+    new sneaker::cache::cache_stats_recorder());
+
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(recorder.get()) % 64);
+
+  recorder->record_hit();
+  ASSERT_EQ(1, recorder->snapshot().hits);
+}
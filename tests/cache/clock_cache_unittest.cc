@@ -0,0 +1,204 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `clock_cache` in sneaker/cache/clock_cache.h */
+
+#include "cache/cache_interface.h"
+#include "cache/clock_cache.h"
+
+#include "testing/testing.h"
+
+#include <string>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t N = 3;
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+class clock_cache_unittest : public ::testing::Test
+{
+protected:
+  sneaker::cache::clock_cache<std::string, size_t, N> m_cache;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(clock_cache_unittest, TestInitialization)
+{
+  ASSERT_EQ(true, m_cache.empty());
+  ASSERT_EQ(false, m_cache.full());
+  ASSERT_EQ(0, m_cache.size());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(clock_cache_unittest, TestInsertAndGet)
+{
+  m_cache.insert("apple", 5);
+  m_cache.insert("orange", 6);
+
+  ASSERT_EQ(false, m_cache.empty());
+  ASSERT_EQ(false, m_cache.full());
+  ASSERT_EQ(2, m_cache.size());
+
+  size_t value = 0;
+  ASSERT_EQ(true, m_cache.get("apple", value));
+  ASSERT_EQ(5, value);
+
+  ASSERT_EQ(true, m_cache.get("orange", value));
+  ASSERT_EQ(6, value);
+
+  ASSERT_EQ(false, m_cache.get("banana", value));
+
+  m_cache.insert("banana", 6);
+
+  ASSERT_EQ(true, m_cache.full());
+  ASSERT_EQ(3, m_cache.size());
+
+  m_cache.clear();
+
+  ASSERT_EQ(true, m_cache.empty());
+  ASSERT_EQ(false, m_cache.full());
+  ASSERT_EQ(false, m_cache.find("apple"));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(clock_cache_unittest, TestEvictionWithoutReferences)
+{
+  m_cache.insert("apple", 5);
+  m_cache.insert("orange", 6);
+  m_cache.insert("banana", 6);
+
+  std::string* key_ptr = NULL;
+  size_t* value_ptr = NULL;
+
+  m_cache.next_erasure_pair(&key_ptr, &value_ptr);
+  ASSERT_NE(nullptr, key_ptr);
+  ASSERT_NE(nullptr, value_ptr);
+
+  ASSERT_EQ("apple", *key_ptr);
+  ASSERT_EQ(5, *value_ptr);
+
+  m_cache.insert("watermelon", 10);
+
+  ASSERT_EQ(3, m_cache.size());
+  ASSERT_EQ(false, m_cache.find("apple"));
+  ASSERT_EQ(true, m_cache.find("watermelon"));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(clock_cache_unittest, TestReferencedEntriesGetSecondChance)
+{
+  m_cache.insert("apple", 5);
+  m_cache.insert("orange", 6);
+  m_cache.insert("banana", 6);
+
+  size_t value = 0;
+  ASSERT_EQ(true, m_cache.get("apple", value));
+
+  std::string* key_ptr = NULL;
+  size_t* value_ptr = NULL;
+
+  m_cache.next_erasure_pair(&key_ptr, &value_ptr);
+  ASSERT_NE(nullptr, key_ptr);
+  ASSERT_EQ("orange", *key_ptr);
+
+  m_cache.insert("watermelon", 10);
+
+  ASSERT_EQ(true, m_cache.find("apple"));
+  ASSERT_EQ(false, m_cache.find("orange"));
+  ASSERT_EQ(true, m_cache.find("banana"));
+  ASSERT_EQ(true, m_cache.find("watermelon"));
+
+  // The second chance of "apple" has been consumed by the previous sweep.
+  m_cache.insert("grape", 5);
+  m_cache.insert("kiwi", 4);
+
+  ASSERT_EQ(false, m_cache.find("banana"));
+  ASSERT_EQ(false, m_cache.find("apple"));
+  ASSERT_EQ(true, m_cache.find("watermelon"));
+  ASSERT_EQ(true, m_cache.find("grape"));
+  ASSERT_EQ(true, m_cache.find("kiwi"));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(clock_cache_unittest, TestInsertAndErase)
+{
+  m_cache.insert("apple", 5);
+
+  ASSERT_EQ(false, m_cache.erase("grape"));
+  ASSERT_EQ(1, m_cache.size());
+
+  ASSERT_EQ(true, m_cache.erase("apple"));
+  ASSERT_EQ(true, m_cache.empty());
+  ASSERT_EQ(false, m_cache.find("apple"));
+
+  // Erased slots are reused.
+  m_cache.insert("apple", 5);
+  m_cache.insert("orange", 6);
+  m_cache.insert("banana", 6);
+
+  ASSERT_EQ(true, m_cache.full());
+
+  size_t value = 0;
+  ASSERT_EQ(true, m_cache.get("apple", value));
+  ASSERT_EQ(5, value);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(clock_cache_unittest, TestWithCacheInterface)
+{
+  struct handler
+  {
+    void operator()(std::string, const size_t&) const
+    {
+    }
+  };
+
+  sneaker::cache::cache_interface<
+    sneaker::cache::clock_cache<std::string, size_t, N>, handler, handler>
+      cache((handler()), (handler()));
+
+  cache.insert("apple", 5);
+  cache.insert("orange", 6);
+  cache.insert("banana", 6);
+  cache.insert("watermelon", 10);
+
+  ASSERT_EQ(N, cache.size());
+  ASSERT_EQ(false, cache.find("apple"));
+
+  ASSERT_EQ(true, cache.erase("watermelon"));
+  ASSERT_EQ(N - 1, cache.size());
+}
+
+// -----------------------------------------------------------------------------
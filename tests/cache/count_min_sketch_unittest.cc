@@ -0,0 +1,132 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `count_min_sketch` in sneaker/cache/count_min_sketch.h */
+
+#include "cache/count_min_sketch.h"
+
+#include "testing/testing.h"
+
+
+// -----------------------------------------------------------------------------
+
+class count_min_sketch_unittest : public ::testing::Test
+{
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(count_min_sketch_unittest, TestInitialization)
+{
+  sneaker::cache::count_min_sketch<int> sketch(100);
+
+  ASSERT_EQ(0, sketch.frequency(1));
+  ASSERT_EQ(0, sketch.frequency(2));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(count_min_sketch_unittest, TestIncrement)
+{
+  sneaker::cache::count_min_sketch<int> sketch(100);
+
+  sketch.increment(1);
+  sketch.increment(1);
+  sketch.increment(1);
+  sketch.increment(2);
+
+  ASSERT_LE(3, sketch.frequency(1));
+  ASSERT_LE(1, sketch.frequency(2));
+  ASSERT_GT(sketch.frequency(1), sketch.frequency(2));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(count_min_sketch_unittest, TestCountersSaturate)
+{
+  sneaker::cache::count_min_sketch<int> sketch(100);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    sketch.increment(1);
+  }
+
+  ASSERT_EQ(15, sketch.frequency(1));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(count_min_sketch_unittest, TestAging)
+{
+  // Counters are halved every 10 increments.
+  sneaker::cache::count_min_sketch<int> sketch(1);
+
+  for (int i = 0; i < 9; ++i)
+  {
+    sketch.increment(1);
+  }
+
+  ASSERT_EQ(9, sketch.frequency(1));
+
+  sketch.increment(1);
+
+  // The first occurrence, recorded by the doorkeeper, is forgotten with it.
+  ASSERT_EQ(4, sketch.frequency(1));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(count_min_sketch_unittest, TestDoorkeeperHoldsFirstOccurrences)
+{
+  sneaker::cache::count_min_sketch<int> sketch(100);
+
+  for (int i = 0; i < 50; ++i)
+  {
+    sketch.increment(i);
+  }
+
+  // Elements seen once only set bits of the doorkeeper, and none of the
+  // counters, so they cannot raise the estimates of one another.
+  for (int i = 0; i < 50; ++i)
+  {
+    ASSERT_EQ(1, sketch.frequency(i));
+  }
+
+  sketch.increment(0);
+
+  ASSERT_EQ(2, sketch.frequency(0));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(count_min_sketch_unittest, TestClear)
+{
+  sneaker::cache::count_min_sketch<int> sketch(100);
+
+  sketch.increment(1);
+  sketch.clear();
+
+  ASSERT_EQ(0, sketch.frequency(1));
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,318 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `expiring_cache` in sneaker/cache/expiring_cache.h and
+ * `cache_reaper` in sneaker/cache/cache_reaper.h */
+
+#include "cache/cache_interface.h"
+#include "cache/cache_reaper.h"
+#include "cache/expiring_cache.h"
+#include "cache/lru_cache.h"
+#include "cache/sharded_cache.h"
+
+#include "testing/testing.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <unistd.h>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/**
+ * Clock whose time only moves when told to.
+ */
+struct manual_clock
+{
+  typedef std::chrono::milliseconds duration;
+  typedef duration::rep rep;
+  typedef duration::period period;
+  typedef std::chrono::time_point<manual_clock> time_point;
+
+  static const bool is_steady = true;
+
+  static time_point now()
+  {
+    return time_point(duration(current));
+  }
+
+  static void advance(int64_t ms)
+  {
+    current += ms;
+  }
+
+  static int64_t current;
+};
+
+int64_t manual_clock::current = 0;
+
+// -----------------------------------------------------------------------------
+
+struct erasure_recorder
+{
+  explicit erasure_recorder(std::vector<int>* erased)
+    :
+    m_erased(erased)
+  {
+  }
+
+  void operator()(int key, const int& /* value */) const
+  {
+    if (m_erased)
+    {
+      m_erased->push_back(key);
+    }
+  }
+
+  std::vector<int>* m_erased;
+};
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+class expiring_cache_unittest : public ::testing::Test
+{
+protected:
+  typedef sneaker::cache::expiring_cache<
+    sneaker::cache::lru_cache<int, int, 4>, manual_clock> cache_scheme_type;
+
+  typedef sneaker::cache::cache_interface<
+    cache_scheme_type, erasure_recorder, erasure_recorder> cache_type;
+
+  expiring_cache_unittest()
+    :
+    m_erased(),
+    m_cache(erasure_recorder(NULL), erasure_recorder(&m_erased),
+      std::chrono::milliseconds(100))
+  {
+  }
+
+  std::vector<int> m_erased;
+  cache_type m_cache;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(expiring_cache_unittest, TestSchemeExpiry)
+{
+  cache_scheme_type cache(std::chrono::milliseconds(0));
+
+  ASSERT_EQ(0, cache.default_ttl().count());
+
+  cache.insert(1, 10);
+  cache.insert(2, 20, std::chrono::milliseconds(5));
+
+  ASSERT_EQ(false, cache.expired(1));
+  ASSERT_EQ(false, cache.expired(2));
+
+  manual_clock::advance(4);
+  ASSERT_EQ(false, cache.expired(2));
+
+  int key = 0;
+  ASSERT_EQ(false, cache.next_expired_key(key));
+
+  manual_clock::advance(1);
+  ASSERT_EQ(true, cache.expired(2));
+
+  ASSERT_EQ(true, cache.next_expired_key(key));
+  ASSERT_EQ(2, key);
+  ASSERT_EQ(false, cache.next_expired_key(key));
+
+  // The scheme does not erase expired entries by itself.
+  ASSERT_EQ(true, cache.find(2));
+  ASSERT_EQ(2, cache.size());
+
+  manual_clock::advance(1000000);
+  ASSERT_EQ(false, cache.expired(1));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(expiring_cache_unittest, TestGetExpiredEntry)
+{
+  m_cache.insert(1, 10);
+  m_cache.insert(2, 20, std::chrono::milliseconds(500));
+
+  manual_clock::advance(99);
+
+  int value = 0;
+  ASSERT_EQ(true, m_cache.get(1, value));
+  ASSERT_EQ(10, value);
+  ASSERT_EQ(true, m_erased.empty());
+
+  manual_clock::advance(1);
+
+  ASSERT_EQ(false, m_cache.find(1));
+  ASSERT_EQ(false, m_cache.get(1, value));
+  ASSERT_EQ(std::vector<int>({1}), m_erased);
+  ASSERT_EQ(1, m_cache.size());
+
+  ASSERT_EQ(true, m_cache.get(2, value));
+  ASSERT_EQ(20, value);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(expiring_cache_unittest, TestInsertOverExpiredEntry)
+{
+  m_cache.insert(1, 10);
+
+  manual_clock::advance(100);
+
+  m_cache.insert(1, 11);
+
+  ASSERT_EQ(std::vector<int>({1}), m_erased);
+
+  int value = 0;
+  ASSERT_EQ(true, m_cache.get(1, value));
+  ASSERT_EQ(11, value);
+
+  // The new entry has a fresh TTL.
+  manual_clock::advance(99);
+  ASSERT_EQ(true, m_cache.find(1));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(expiring_cache_unittest, TestExpireInBatches)
+{
+  for (int i = 0; i < 4; ++i)
+  {
+    m_cache.insert(i, i, std::chrono::milliseconds(10 * (i + 1)));
+  }
+
+  manual_clock::advance(30);
+
+  ASSERT_EQ(2, m_cache.expire(2));
+  ASSERT_EQ(std::vector<int>({0, 1}), m_erased);
+
+  ASSERT_EQ(1, m_cache.expire(2));
+  ASSERT_EQ(std::vector<int>({0, 1, 2}), m_erased);
+
+  ASSERT_EQ(0, m_cache.expire(2));
+  ASSERT_EQ(1, m_cache.size());
+  ASSERT_EQ(true, m_cache.find(3));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(expiring_cache_unittest, TestEraseCancelsExpiry)
+{
+  m_cache.insert(1, 10);
+
+  ASSERT_EQ(true, m_cache.erase(1));
+  ASSERT_EQ(std::vector<int>({1}), m_erased);
+
+  manual_clock::advance(100);
+
+  ASSERT_EQ(0, m_cache.expire(10));
+  ASSERT_EQ(std::vector<int>({1}), m_erased);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(expiring_cache_unittest, TestEvictionCancelsExpiry)
+{
+  for (int i = 0; i < 5; ++i)
+  {
+    m_cache.insert(i, i);
+  }
+
+  ASSERT_EQ(std::vector<int>({0}), m_erased);
+
+  manual_clock::advance(100);
+
+  ASSERT_EQ(4, m_cache.expire(10));
+  ASSERT_EQ(std::vector<int>({0, 1, 2, 3, 4}), m_erased);
+  ASSERT_EQ(true, m_cache.empty());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(cache_reaper_unittest, TestReapExpiredEntries)
+{
+  struct insert_handler
+  {
+    void operator()(int, const int&) const
+    {
+    }
+  };
+
+  struct erase_handler
+  {
+    void operator()(int, const int&) const
+    {
+      ++erased();
+    }
+
+    static std::atomic<int>& erased()
+    {
+      static std::atomic<int> count(0);
+      return count;
+    }
+  };
+
+  erase_handler::erased() = 0;
+
+  typedef sneaker::cache::sharded_cache<
+    sneaker::cache::expiring_cache<sneaker::cache::lru_cache<int, int, 64>>,
+    insert_handler, erase_handler, 4> cache_type;
+
+  cache_type cache((insert_handler()), (erase_handler()), std::hash<int>(),
+    std::chrono::milliseconds(10));
+
+  for (int i = 0; i < 50; ++i)
+  {
+    cache.insert(i, i);
+  }
+
+  cache.insert(100, 100, std::chrono::hours(1));
+
+  ASSERT_EQ(51, cache.size());
+
+  {
+    sneaker::cache::cache_reaper<cache_type> reaper(cache, 20, 8);
+
+    ASSERT_EQ(20, reaper.interval());
+    ASSERT_EQ(8, reaper.batch_size());
+
+    ASSERT_EQ(true, reaper.start());
+
+    for (int i = 0; i < 100 && reaper.reaped() < 50; ++i)
+    {
+      usleep(20 * 1000);
+    }
+
+    ASSERT_EQ(50, reaper.reaped());
+  }
+
+  ASSERT_EQ(50, erase_handler::erased().load());
+  ASSERT_EQ(1, cache.size());
+  ASSERT_EQ(true, cache.find(100));
+}
@@ -0,0 +1,306 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `loading_cache` in sneaker/cache/loading_cache.h */
+
+#include "cache/loading_cache.h"
+
+#include "cache/cache_interface.h"
+#include "cache/cache_stats.h"
+#include "cache/expiring_cache.h"
+#include "cache/lru_cache.h"
+#include "cache/sharded_cache.h"
+
+#include "testing/testing.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/**
+ * Clock whose time only moves when told to.
+ */
+struct manual_clock
+{
+  typedef std::chrono::milliseconds duration;
+  typedef duration::rep rep;
+  typedef duration::period period;
+  typedef std::chrono::time_point<manual_clock> time_point;
+
+  static const bool is_steady = true;
+
+  static time_point now()
+  {
+    return time_point(duration(current.load()));
+  }
+
+  static void advance(int64_t ms)
+  {
+    current += ms;
+  }
+
+  static std::atomic<int64_t> current;
+};
+
+std::atomic<int64_t> manual_clock::current(0);
+
+// -----------------------------------------------------------------------------
+
+struct noop_handler
+{
+  void operator()(int /* key */, const int& /* value */) const
+  {
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Loads ten times the key plus the number of previous loads, and fails for
+ * negative keys.
+ */
+struct counting_loader
+{
+  explicit counting_loader(std::atomic<int>* loads, int delay_ms=0)
+    :
+    m_loads(loads),
+    m_delay_ms(delay_ms)
+  {
+  }
+
+  bool operator()(const int& key, int& value) const
+  {
+    if (m_delay_ms)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(m_delay_ms));
+    }
+
+    const int loads = (*m_loads)++;
+
+    if (key == 0)
+    {
+      throw std::runtime_error("Failed to load");
+    }
+
+    if (key < 0)
+    {
+      return false;
+    }
+
+    value = key * 10 + loads;
+    return true;
+  }
+
+  std::atomic<int>* m_loads;
+  int m_delay_ms;
+};
+
+// -----------------------------------------------------------------------------
+
+bool wait_for_loads(const std::atomic<int>& loads, int expected)
+{
+  for (int i = 0; i < 1000 && loads.load() < expected; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  return loads.load() >= expected;
+}
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+class loading_cache_unittest : public ::testing::Test
+{
+protected:
+  typedef sneaker::cache::sharded_cache<
+    sneaker::cache::lru_cache<int, int, 16>,
+    noop_handler, noop_handler, 4> cache_type;
+
+  typedef sneaker::cache::loading_cache<cache_type, counting_loader>
+    loading_cache_type;
+
+  loading_cache_unittest()
+    :
+    m_loads(0),
+    m_cache(noop_handler(), noop_handler())
+  {
+  }
+
+  std::atomic<int> m_loads;
+  cache_type m_cache;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(loading_cache_unittest, TestLoadOnMiss)
+{
+  loading_cache_type cache(m_cache, counting_loader(&m_loads));
+
+  int value = 0;
+  ASSERT_EQ(true, cache.get(1, value));
+  ASSERT_EQ(10, value);
+  ASSERT_EQ(1, m_loads.load());
+  ASSERT_EQ(true, m_cache.find(1));
+
+  // Served from the cache without loading again.
+  ASSERT_EQ(true, cache.get(1, value));
+  ASSERT_EQ(10, value);
+  ASSERT_EQ(1, m_loads.load());
+
+  ASSERT_EQ(0, cache.in_flight());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(loading_cache_unittest, TestFailedLoadIsNotCached)
+{
+  loading_cache_type cache(m_cache, counting_loader(&m_loads));
+
+  int value = 0;
+  ASSERT_EQ(false, cache.get(-1, value));
+  ASSERT_EQ(false, m_cache.find(-1));
+
+  ASSERT_EQ(false, cache.get(-1, value));
+  ASSERT_EQ(2, m_loads.load());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(loading_cache_unittest, TestLoaderException)
+{
+  loading_cache_type cache(m_cache, counting_loader(&m_loads));
+
+  int value = 0;
+  ASSERT_THROW(cache.get(0, value), std::runtime_error);
+  ASSERT_EQ(false, m_cache.find(0));
+  ASSERT_EQ(0, cache.in_flight());
+
+  // The failed load does not prevent subsequent ones.
+  ASSERT_THROW(cache.get(0, value), std::runtime_error);
+  ASSERT_EQ(2, m_loads.load());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(loading_cache_unittest, TestConcurrentMissesAreCoalesced)
+{
+  loading_cache_type cache(m_cache, counting_loader(&m_loads, 50));
+
+  const size_t THREADS = 8;
+  std::vector<int> values(THREADS, 0);
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < THREADS; ++i)
+  {
+    threads.push_back(std::thread([&cache, &values, i]() {
+      cache.get(7, values[i]);
+    }));
+  }
+
+  for (size_t i = 0; i < THREADS; ++i)
+  {
+    threads[i].join();
+  }
+
+  ASSERT_EQ(1, m_loads.load());
+  ASSERT_EQ(std::vector<int>(THREADS, 70), values);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(loading_cache_unittest, TestLoadStatistics)
+{
+  sneaker::cache::cache_stats_recorder recorder;
+
+  loading_cache_type cache(m_cache, counting_loader(&m_loads));
+  cache.set_stats_recorder(&recorder);
+
+  int value = 0;
+  cache.get(1, value);
+  cache.get(1, value);
+  cache.get(-1, value);
+  ASSERT_THROW(cache.get(0, value), std::runtime_error);
+
+  const sneaker::cache::cache_stats stats = recorder.snapshot();
+
+  ASSERT_EQ(1, stats.load_successes);
+  ASSERT_EQ(2, stats.load_failures);
+  ASSERT_EQ(3, stats.loads());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(loading_cache_unittest, TestRefreshAhead)
+{
+  typedef sneaker::cache::sharded_cache<
+    sneaker::cache::expiring_cache<
+      sneaker::cache::lru_cache<int, int, 16>, manual_clock>,
+    noop_handler, noop_handler, 4> expiring_cache_type;
+
+  expiring_cache_type expiring_cache(noop_handler(), noop_handler(),
+    std::hash<int>(), std::chrono::milliseconds(100));
+
+  sneaker::cache::loading_cache<expiring_cache_type, counting_loader> cache(
+    expiring_cache, counting_loader(&m_loads), std::chrono::milliseconds(20));
+
+  int value = 0;
+  ASSERT_EQ(true, cache.get(1, value));
+  ASSERT_EQ(10, value);
+
+  // Outside of the refresh-ahead window.
+  manual_clock::advance(79);
+  ASSERT_EQ(true, cache.get(1, value));
+  ASSERT_EQ(10, value);
+  ASSERT_EQ(1, m_loads.load());
+
+  // Within the window, the current value is served while it is refreshed.
+  manual_clock::advance(1);
+  ASSERT_EQ(true, cache.get(1, value));
+  ASSERT_EQ(10, value);
+  ASSERT_EQ(true, wait_for_loads(m_loads, 2));
+
+  while (cache.in_flight())
+  {
+    std::this_thread::yield();
+  }
+
+  ASSERT_EQ(true, expiring_cache.get(1, value));
+  ASSERT_EQ(11, value);
+
+  // The refreshed value has a fresh TTL.
+  manual_clock::advance(79);
+  ASSERT_EQ(true, cache.get(1, value));
+  ASSERT_EQ(11, value);
+  ASSERT_EQ(2, m_loads.load());
+}
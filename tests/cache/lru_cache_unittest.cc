@@ -168,3 +168,25 @@ TEST_F(lru_cache_unittest, TestInsertAndErase)
 }
 
 // -----------------------------------------------------------------------------
+
+TEST_F(lru_cache_unittest, TestPeekDoesNotUpdateOrderOfEviction)
+{
+  m_cache.insert("apple", 5);
+  m_cache.insert("orange", 6);
+  m_cache.insert("banana", 6);
+
+  const size_t* val = m_cache.peek("apple");
+  ASSERT_NE(nullptr, val);
+  ASSERT_EQ(5, *val);
+
+  ASSERT_EQ(nullptr, m_cache.peek("grape"));
+
+  std::string* key_ptr = NULL;
+  size_t* val_ptr = NULL;
+
+  m_cache.next_erasure_pair(&key_ptr, &val_ptr);
+  ASSERT_NE(nullptr, key_ptr);
+  ASSERT_EQ("apple", *key_ptr);
+}
+
+// -----------------------------------------------------------------------------
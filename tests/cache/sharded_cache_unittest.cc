@@ -0,0 +1,203 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `sharded_cache` in sneaker/cache/sharded_cache.h */
+
+#include "cache/sharded_cache.h"
+#include "cache/lru_cache.h"
+
+#include "testing/testing.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t N = 2;
+
+const size_t S = 4;
+
+std::atomic<size_t> insert_count(0);
+
+std::atomic<size_t> erase_count(0);
+
+struct insert_handler
+{
+  void operator()(int, const int&) const
+  {
+    ++insert_count;
+  }
+};
+
+struct erase_handler
+{
+  void operator()(int, const int&) const
+  {
+    ++erase_count;
+  }
+};
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+class sharded_cache_unittest : public ::testing::Test
+{
+protected:
+  typedef sneaker::cache::sharded_cache<
+    sneaker::cache::lru_cache<int, int, N>,
+    insert_handler, erase_handler, S> cache_type;
+
+  sharded_cache_unittest()
+    :
+    m_cache(insert_handler(), erase_handler())
+  {
+  }
+
+  virtual void SetUp()
+  {
+    insert_count = 0;
+    erase_count = 0;
+  }
+
+  cache_type m_cache;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(sharded_cache_unittest, TestInitialization)
+{
+  ASSERT_EQ(true, m_cache.empty());
+  ASSERT_EQ(false, m_cache.full());
+  ASSERT_EQ(0, m_cache.size());
+  ASSERT_EQ(S, m_cache.shard_count());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(sharded_cache_unittest, TestInsertAndGet)
+{
+  m_cache.insert(1, 100);
+  m_cache.insert(2, 200);
+
+  ASSERT_EQ(false, m_cache.empty());
+  ASSERT_EQ(2, m_cache.size());
+  ASSERT_EQ(2, insert_count.load());
+
+  ASSERT_EQ(true, m_cache.find(1));
+  ASSERT_EQ(true, m_cache.find(2));
+  ASSERT_EQ(false, m_cache.find(3));
+
+  int value = 0;
+  ASSERT_EQ(true, m_cache.get(2, value));
+  ASSERT_EQ(200, value);
+
+  ASSERT_EQ(false, m_cache.get(3, value));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(sharded_cache_unittest, TestEvictionIsBoundedByShardCapacity)
+{
+  const int M = 1000;
+
+  for (int i = 0; i < M; ++i)
+  {
+    m_cache.insert(i, i * 2);
+  }
+
+  ASSERT_EQ(true, m_cache.full());
+  ASSERT_EQ(N * S, m_cache.size());
+
+  ASSERT_EQ(static_cast<size_t>(M), insert_count.load());
+  ASSERT_EQ(M - N * S, erase_count.load());
+
+  // The most recently inserted key always survives.
+  int value = 0;
+  ASSERT_EQ(true, m_cache.get(M - 1, value));
+  ASSERT_EQ((M - 1) * 2, value);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(sharded_cache_unittest, TestEraseAndClear)
+{
+  m_cache.insert(1, 100);
+  m_cache.insert(2, 200);
+
+  ASSERT_EQ(false, m_cache.erase(3));
+  ASSERT_EQ(0, erase_count.load());
+
+  ASSERT_EQ(true, m_cache.erase(1));
+  ASSERT_EQ(1, erase_count.load());
+  ASSERT_EQ(false, m_cache.find(1));
+  ASSERT_EQ(1, m_cache.size());
+
+  m_cache.clear();
+
+  ASSERT_EQ(true, m_cache.empty());
+  ASSERT_EQ(false, m_cache.find(2));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(sharded_cache_unittest, TestConcurrentAccess)
+{
+  const int THREADS = 4;
+  const int ITERATIONS = 2000;
+
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < THREADS; ++t)
+  {
+    threads.push_back(std::thread([this, t]() {
+      for (int i = 0; i < ITERATIONS; ++i)
+      {
+        const int key = t * 64 + i % 64;
+        int value = 0;
+        if (!m_cache.get(key, value))
+        {
+          m_cache.insert(key, key);
+        }
+        else
+        {
+          ASSERT_EQ(key, value);
+        }
+      }
+    }));
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  ASSERT_LE(m_cache.size(), N * S);
+  ASSERT_EQ(insert_count.load() - erase_count.load(), m_cache.size());
+}
+
+// -----------------------------------------------------------------------------
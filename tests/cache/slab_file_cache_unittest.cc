@@ -0,0 +1,264 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `slab_file_cache` in sneaker/cache/slab_file_cache.h */
+
+#include "cache/cache_interface.h"
+#include "cache/slab_file_cache.h"
+
+#include "testing/testing.h"
+
+#include <cstring>
+#include <ios>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+struct erasure_recorder
+{
+  explicit erasure_recorder(
+    std::vector<std::pair<int, std::string>>* erased)
+    :
+    m_erased(erased)
+  {
+  }
+
+  void operator()(int key, const std::string& value) const
+  {
+    if (m_erased)
+    {
+      m_erased->push_back(std::make_pair(key, value));
+    }
+  }
+
+  std::vector<std::pair<int, std::string>>* m_erased;
+};
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+class slab_file_cache_unittest : public ::testing::Test
+{
+protected:
+  typedef sneaker::cache::slab_file_cache<int, std::string> cache_scheme_type;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(slab_file_cache_unittest, TestInitialization)
+{
+  cache_scheme_type cache(1024, 64);
+
+  ASSERT_EQ(true, cache.empty());
+  ASSERT_EQ(false, cache.full());
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(1024, cache.capacity());
+  ASSERT_EQ(0, cache.weight());
+  ASSERT_EQ(0, cache.dead_bytes());
+  ASSERT_EQ(64, cache.file_size());
+  ASSERT_EQ(0, access(cache.file_path(), F_OK));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(slab_file_cache_unittest, TestInsertAndGet)
+{
+  cache_scheme_type cache(1024, 64);
+
+  cache.insert(1, "one");
+  cache.insert(2, std::string(100, 'b'));
+  cache.insert(3, "");
+
+  ASSERT_EQ(3, cache.size());
+  ASSERT_EQ(103, cache.weight());
+
+  // The file grows to fit values that do not fit in it.
+  ASSERT_LE(103, cache.file_size());
+
+  std::string value;
+  ASSERT_EQ(true, cache.get(1, value));
+  ASSERT_EQ("one", value);
+  ASSERT_EQ(true, cache.get(2, value));
+  ASSERT_EQ(std::string(100, 'b'), value);
+  ASSERT_EQ(true, cache.get(3, value));
+  ASSERT_EQ("", value);
+  ASSERT_EQ(false, cache.get(4, value));
+
+  // Inserting an existing key does not replace its value.
+  cache.insert(1, "uno");
+  ASSERT_EQ(true, cache.get(1, value));
+  ASSERT_EQ("one", value);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(slab_file_cache_unittest, TestEraseAndCompact)
+{
+  cache_scheme_type cache(1024, 64);
+
+  cache.insert(1, std::string(10, 'a'));
+  cache.insert(2, std::string(10, 'b'));
+  cache.insert(3, std::string(10, 'c'));
+
+  ASSERT_EQ(true, cache.erase(1));
+  ASSERT_EQ(false, cache.erase(1));
+  ASSERT_EQ(10, cache.dead_bytes());
+
+  // The bytes of the last appended value are reclaimed right away.
+  ASSERT_EQ(true, cache.erase(3));
+  ASSERT_EQ(10, cache.dead_bytes());
+  ASSERT_EQ(10, cache.weight());
+
+  cache.compact();
+
+  ASSERT_EQ(0, cache.dead_bytes());
+
+  std::string value;
+  ASSERT_EQ(true, cache.get(2, value));
+  ASSERT_EQ(std::string(10, 'b'), value);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(slab_file_cache_unittest, TestCompactsInsteadOfGrowing)
+{
+  cache_scheme_type cache(1024, 64);
+
+  for (int i = 0; i < 4; ++i)
+  {
+    cache.insert(i, std::string(16, static_cast<char>('a' + i)));
+  }
+
+  ASSERT_EQ(64, cache.file_size());
+
+  cache.erase(0);
+  cache.erase(1);
+
+  // Half of the used bytes are dead, so the file is compacted.
+  cache.insert(4, std::string(16, 'e'));
+
+  ASSERT_EQ(64, cache.file_size());
+  ASSERT_EQ(0, cache.dead_bytes());
+  ASSERT_EQ(48, cache.weight());
+
+  for (int i = 2; i < 5; ++i)
+  {
+    std::string value;
+    ASSERT_EQ(true, cache.get(i, value));
+    ASSERT_EQ(std::string(16, static_cast<char>('a' + i)), value);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(slab_file_cache_unittest, TestEvictsThroughCacheInterface)
+{
+  typedef sneaker::cache::cache_interface<
+    cache_scheme_type, erasure_recorder, erasure_recorder> cache_type;
+
+  std::vector<std::pair<int, std::string>> erased;
+  cache_type cache(erasure_recorder(NULL), erasure_recorder(&erased), 30, 16);
+
+  cache.insert(1, std::string(10, 'a'));
+  cache.insert(2, std::string(10, 'b'));
+
+  std::string value;
+  ASSERT_EQ(true, cache.get(1, value));
+
+  cache.insert(3, std::string(10, 'c'));
+  ASSERT_EQ(true, cache.full());
+
+  cache.insert(4, std::string(10, 'd'));
+
+  ASSERT_EQ(1, erased.size());
+  ASSERT_EQ(2, erased[0].first);
+  ASSERT_EQ(std::string(10, 'b'), erased[0].second);
+  ASSERT_EQ(30, cache.weight());
+
+  cache.resize(20);
+  cache.evict(8);
+
+  ASSERT_EQ(1, cache.size());
+  ASSERT_EQ(true, cache.get(4, value));
+  ASSERT_EQ(std::string(10, 'd'), value);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(slab_file_cache_unittest, TestFileIsRemoved)
+{
+  std::string path;
+
+  {
+    sneaker::cache::slab_file_cache<int, int> cache(16);
+    cache.insert(1, 100);
+
+    int value = 0;
+    ASSERT_EQ(true, cache.get(1, value));
+    ASSERT_EQ(100, value);
+
+    path = cache.file_path();
+    ASSERT_EQ(0, access(path.c_str(), F_OK));
+  }
+
+  ASSERT_NE(0, access(path.c_str(), F_OK));
+}
+
+TEST_F(slab_file_cache_unittest, TestFailedReserveKeepsMapping)
+{
+  sneaker::cache::slab_file file(64);
+  memset(file.data(), 'a', file.size());
+
+  // Too large to be extended, and too large to be mapped, respectively.
+  const size_t sizes[] = {
+    std::numeric_limits<size_t>::max(),
+    static_cast<size_t>(1) << 52
+  };
+
+  for (size_t size : sizes)
+  {
+    ASSERT_THROW(file.reserve(size), std::ios_base::failure);
+
+    ASSERT_NE(nullptr, file.data());
+    ASSERT_EQ(64, file.size());
+    ASSERT_EQ(std::string(64, 'a'),
+      std::string(reinterpret_cast<const char*>(file.data()), file.size()));
+  }
+
+  file.reserve(100);
+
+  ASSERT_EQ(128, file.size());
+  ASSERT_EQ(std::string(64, 'a'),
+    std::string(reinterpret_cast<const char*>(file.data()), 64));
+}
+
+// -----------------------------------------------------------------------------
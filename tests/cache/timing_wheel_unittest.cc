@@ -0,0 +1,236 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `timing_wheel` in sneaker/cache/timing_wheel.h */
+
+#include "cache/timing_wheel.h"
+
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+class timing_wheel_unittest : public ::testing::Test
+{
+protected:
+  typedef sneaker::cache::timing_wheel<int> wheel_type;
+
+  std::vector<int> consume_expired()
+  {
+    std::vector<int> res;
+    int value = 0;
+    while (m_wheel.next_expired(&value))
+    {
+      res.push_back(value);
+    }
+    return res;
+  }
+
+  wheel_type m_wheel;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(timing_wheel_unittest, TestInitialization)
+{
+  ASSERT_EQ(true, m_wheel.empty());
+  ASSERT_EQ(0, m_wheel.size());
+  ASSERT_EQ(0, m_wheel.now());
+
+  int value = 0;
+  ASSERT_EQ(false, m_wheel.next_expired(&value));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(timing_wheel_unittest, TestExpiresAtTick)
+{
+  m_wheel.schedule(1, 10);
+  m_wheel.schedule(2, 20);
+
+  ASSERT_EQ(2, m_wheel.size());
+
+  m_wheel.advance(9);
+  ASSERT_EQ(true, consume_expired().empty());
+
+  m_wheel.advance(10);
+  ASSERT_EQ(std::vector<int>({1}), consume_expired());
+  ASSERT_EQ(1, m_wheel.size());
+
+  m_wheel.advance(100);
+  ASSERT_EQ(std::vector<int>({2}), consume_expired());
+  ASSERT_EQ(true, m_wheel.empty());
+  ASSERT_EQ(100, m_wheel.now());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(timing_wheel_unittest, TestScheduleInThePast)
+{
+  m_wheel.advance(50);
+  m_wheel.schedule(1, 50);
+  m_wheel.schedule(2, 3);
+
+  ASSERT_EQ(std::vector<int>({1, 2}), consume_expired());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(timing_wheel_unittest, TestCascading)
+{
+  // Expiries spanning multiple levels of the wheel.
+  const std::vector<wheel_type::tick_type> expiries = {
+    63, 64, 65, 4095, 4096, 4097, 300000, 16777216, 16777300 };
+
+  for (size_t i = 0; i < expiries.size(); ++i)
+  {
+    m_wheel.schedule(static_cast<int>(i), expiries[i]);
+  }
+
+  for (size_t i = 0; i < expiries.size(); ++i)
+  {
+    m_wheel.advance(expiries[i] - 1);
+    ASSERT_EQ(true, consume_expired().empty());
+
+    m_wheel.advance(expiries[i]);
+    ASSERT_EQ(std::vector<int>({static_cast<int>(i)}), consume_expired());
+  }
+
+  ASSERT_EQ(true, m_wheel.empty());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(timing_wheel_unittest, TestScheduleRelativeToCurrentTick)
+{
+  m_wheel.advance(1000);
+
+  m_wheel.schedule(1, 1030);
+  m_wheel.schedule(2, 1100);
+  m_wheel.schedule(3, 9000);
+
+  m_wheel.advance(1029);
+  ASSERT_EQ(true, consume_expired().empty());
+
+  m_wheel.advance(1100);
+  ASSERT_EQ(std::vector<int>({1, 2}), consume_expired());
+
+  m_wheel.advance(8999);
+  ASSERT_EQ(true, consume_expired().empty());
+
+  m_wheel.advance(9000);
+  ASSERT_EQ(std::vector<int>({3}), consume_expired());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(timing_wheel_unittest, TestBeyondRange)
+{
+  const wheel_type::tick_type expiry =
+    (static_cast<wheel_type::tick_type>(1) << 36) + 5;
+
+  m_wheel.schedule(1, expiry);
+
+  m_wheel.advance(expiry - 1);
+  ASSERT_EQ(true, consume_expired().empty());
+
+  m_wheel.advance(expiry);
+  ASSERT_EQ(std::vector<int>({1}), consume_expired());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(timing_wheel_unittest, TestCancel)
+{
+  const wheel_type::handle_type handle1 = m_wheel.schedule(1, 10);
+  m_wheel.schedule(2, 10);
+  const wheel_type::handle_type handle3 = m_wheel.schedule(3, 5000);
+
+  ASSERT_EQ(10, m_wheel.expiry(handle1));
+
+  m_wheel.cancel(handle1);
+  m_wheel.cancel(handle3);
+
+  ASSERT_EQ(1, m_wheel.size());
+
+  m_wheel.advance(10000);
+  ASSERT_EQ(std::vector<int>({2}), consume_expired());
+
+  // Expired timers can be cancelled before being consumed.
+  const wheel_type::handle_type handle4 = m_wheel.schedule(4, 10001);
+  m_wheel.advance(10001);
+  m_wheel.cancel(handle4);
+
+  ASSERT_EQ(true, m_wheel.empty());
+  ASSERT_EQ(true, consume_expired().empty());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(timing_wheel_unittest, TestManyTimers)
+{
+  const int COUNT = 10000;
+
+  for (int i = 0; i < COUNT; ++i)
+  {
+    m_wheel.schedule(i, static_cast<wheel_type::tick_type>((i * 7919) % 100000));
+  }
+
+  std::vector<int> expired;
+
+  for (wheel_type::tick_type tick = 0; tick <= 100000; tick += 1000)
+  {
+    m_wheel.advance(tick);
+
+    int value = 0;
+    while (m_wheel.next_expired(&value))
+    {
+      // Never expired early, nor later than the tick advanced to.
+      const wheel_type::tick_type expiry = (value * 7919) % 100000;
+      ASSERT_LE(expiry, tick);
+      ASSERT_GT(expiry + 1000, tick);
+      expired.push_back(value);
+    }
+  }
+
+  ASSERT_EQ(COUNT, expired.size());
+  ASSERT_EQ(true, m_wheel.empty());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(timing_wheel_unittest, TestClear)
+{
+  m_wheel.schedule(1, 10);
+  m_wheel.schedule(2, 0);
+
+  m_wheel.clear();
+
+  ASSERT_EQ(true, m_wheel.empty());
+
+  m_wheel.advance(100);
+  ASSERT_EQ(true, consume_expired().empty());
+}
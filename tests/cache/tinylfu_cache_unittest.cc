@@ -0,0 +1,203 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `tinylfu_cache` in sneaker/cache/tinylfu_cache.h */
+
+#include "cache/cache_interface.h"
+#include "cache/tinylfu_cache.h"
+
+#include "testing/testing.h"
+
+#include <string>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const size_t N = 10;
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+class tinylfu_cache_unittest : public ::testing::Test
+{
+protected:
+  sneaker::cache::tinylfu_cache<int, int, N> m_cache;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(tinylfu_cache_unittest, TestInitialization)
+{
+  ASSERT_EQ(true, m_cache.empty());
+  ASSERT_EQ(false, m_cache.full());
+  ASSERT_EQ(0, m_cache.size());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(tinylfu_cache_unittest, TestInsertAndGet)
+{
+  for (int i = 0; i < static_cast<int>(N); ++i)
+  {
+    m_cache.insert(i, i * 10);
+  }
+
+  ASSERT_EQ(false, m_cache.empty());
+  ASSERT_EQ(true, m_cache.full());
+  ASSERT_EQ(N, m_cache.size());
+
+  for (int i = 0; i < static_cast<int>(N); ++i)
+  {
+    int value = 0;
+    ASSERT_EQ(true, m_cache.get(i, value));
+    ASSERT_EQ(i * 10, value);
+  }
+
+  int value = 0;
+  ASSERT_EQ(false, m_cache.get(100, value));
+
+  m_cache.clear();
+
+  ASSERT_EQ(true, m_cache.empty());
+  ASSERT_EQ(false, m_cache.find(0));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(tinylfu_cache_unittest, TestNextErasurePairIsEvicted)
+{
+  for (int i = 0; i < 100; ++i)
+  {
+    int value = 0;
+
+    if (m_cache.full())
+    {
+      int* key_ptr = NULL;
+      int* value_ptr = NULL;
+      m_cache.next_erasure_pair(&key_ptr, &value_ptr);
+      ASSERT_NE(nullptr, key_ptr);
+      ASSERT_NE(nullptr, value_ptr);
+
+      const int victim = *key_ptr;
+      ASSERT_EQ(victim * 10, *value_ptr);
+
+      m_cache.insert(i, i * 10);
+
+      ASSERT_EQ(false, m_cache.find(victim));
+      ASSERT_EQ(N, m_cache.size());
+    }
+    else
+    {
+      m_cache.insert(i, i * 10);
+    }
+
+    // Make some of the keys popular.
+    m_cache.get(i % 7, value);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(tinylfu_cache_unittest, TestScanResistance)
+{
+  const int HOT_KEYS = 50;
+
+  sneaker::cache::tinylfu_cache<int, int, 100> cache;
+
+  // Access a set of hot keys repeatedly.
+  for (int round = 0; round < 5; ++round)
+  {
+    for (int key = 0; key < HOT_KEYS; ++key)
+    {
+      int value = 0;
+      if (!cache.get(key, value))
+      {
+        cache.insert(key, key);
+      }
+    }
+  }
+
+  // Scan through a number of keys that are accessed only once.
+  for (int key = 1000; key < 1300; ++key)
+  {
+    int value = 0;
+    if (!cache.get(key, value))
+    {
+      cache.insert(key, key);
+    }
+  }
+
+  ASSERT_EQ(true, cache.full());
+
+  for (int key = 0; key < HOT_KEYS; ++key)
+  {
+    ASSERT_EQ(true, cache.find(key));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(tinylfu_cache_unittest, TestInsertAndErase)
+{
+  m_cache.insert(1, 10);
+  m_cache.insert(2, 20);
+
+  ASSERT_EQ(false, m_cache.erase(3));
+  ASSERT_EQ(2, m_cache.size());
+
+  ASSERT_EQ(true, m_cache.erase(1));
+  ASSERT_EQ(1, m_cache.size());
+  ASSERT_EQ(false, m_cache.find(1));
+  ASSERT_EQ(true, m_cache.find(2));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(tinylfu_cache_unittest, TestWithCacheInterface)
+{
+  struct handler
+  {
+    void operator()(std::string, const int&) const
+    {
+    }
+  };
+
+  sneaker::cache::cache_interface<
+    sneaker::cache::tinylfu_cache<std::string, int, 2>, handler, handler>
+      cache((handler()), (handler()));
+
+  cache.insert("apple", 5);
+  cache.insert("orange", 6);
+  cache.insert("banana", 6);
+
+  ASSERT_EQ(2, cache.size());
+  ASSERT_EQ(true, cache.find("banana"));
+
+  ASSERT_EQ(true, cache.erase("banana"));
+  ASSERT_EQ(1, cache.size());
+}
+
+// -----------------------------------------------------------------------------
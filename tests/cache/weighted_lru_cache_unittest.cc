@@ -0,0 +1,304 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `weighted_lru_cache` in sneaker/cache/weighted_lru_cache.h */
+
+#include "cache/cache_interface.h"
+#include "cache/weighted_lru_cache.h"
+
+#include "testing/testing.h"
+
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+struct string_weigher
+{
+  size_t operator()(int /* key */, const std::string& value) const
+  {
+    return value.size();
+  }
+};
+
+struct erasure_recorder
+{
+  explicit erasure_recorder(std::vector<int>* erased)
+    :
+    m_erased(erased)
+  {
+  }
+
+  void operator()(int key, const std::string& /* value */) const
+  {
+    if (m_erased)
+    {
+      m_erased->push_back(key);
+    }
+  }
+
+  std::vector<int>* m_erased;
+};
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+class weighted_lru_cache_unittest : public ::testing::Test
+{
+protected:
+  typedef sneaker::cache::weighted_lru_cache<int, std::string, string_weigher>
+    cache_scheme_type;
+
+  typedef sneaker::cache::cache_interface<
+    cache_scheme_type, erasure_recorder, erasure_recorder> cache_type;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(weighted_lru_cache_unittest, TestInitialization)
+{
+  cache_scheme_type cache(100);
+
+  ASSERT_EQ(true, cache.empty());
+  ASSERT_EQ(false, cache.full());
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(100, cache.capacity());
+  ASSERT_EQ(0, cache.weight());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(weighted_lru_cache_unittest, TestUnitWeights)
+{
+  sneaker::cache::weighted_lru_cache<int, int> cache(3);
+
+  cache.insert(1, 10);
+  cache.insert(2, 20);
+  cache.insert(3, 30);
+
+  ASSERT_EQ(true, cache.full());
+  ASSERT_EQ(3, cache.weight());
+
+  int value = 0;
+  ASSERT_EQ(true, cache.get(1, value));
+  ASSERT_EQ(10, value);
+
+  int* key_ptr = NULL;
+  int* value_ptr = NULL;
+  cache.next_erasure_pair(&key_ptr, &value_ptr);
+  ASSERT_NE(nullptr, key_ptr);
+  ASSERT_EQ(2, *key_ptr);
+  ASSERT_EQ(20, *value_ptr);
+
+  // Insertions do not evict by themselves.
+  cache.insert(4, 40);
+
+  ASSERT_EQ(4, cache.size());
+  ASSERT_EQ(4, cache.weight());
+
+  ASSERT_EQ(true, cache.erase(*key_ptr));
+
+  ASSERT_EQ(3, cache.size());
+  ASSERT_EQ(false, cache.find(2));
+  ASSERT_EQ(true, cache.find(1));
+  ASSERT_EQ(true, cache.find(4));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(weighted_lru_cache_unittest, TestWeights)
+{
+  cache_scheme_type cache(10);
+
+  cache.insert(1, "abc");
+  cache.insert(2, "defg");
+
+  ASSERT_EQ(false, cache.full());
+  ASSERT_EQ(7, cache.weight());
+
+  cache.insert(3, "hij");
+
+  ASSERT_EQ(true, cache.full());
+  ASSERT_EQ(10, cache.weight());
+
+  ASSERT_EQ(true, cache.erase(2));
+  ASSERT_EQ(false, cache.erase(2));
+  ASSERT_EQ(6, cache.weight());
+  ASSERT_EQ(false, cache.full());
+
+  cache.clear();
+
+  ASSERT_EQ(true, cache.empty());
+  ASSERT_EQ(0, cache.weight());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(weighted_lru_cache_unittest, TestEvictsByWeightThroughCacheInterface)
+{
+  std::vector<int> erased;
+  const erasure_recorder on_insert(NULL);
+  const erasure_recorder on_erase(&erased);
+
+  cache_type cache(on_insert, on_erase, 10);
+
+  cache.insert(1, "aaaa");
+  cache.insert(2, "bbbb");
+  cache.insert(3, "cc");
+
+  ASSERT_EQ(10, cache.weight());
+  ASSERT_EQ(true, erased.empty());
+
+  // Makes key 1 the most recently used.
+  std::string value;
+  ASSERT_EQ(true, cache.get(1, value));
+
+  cache.insert(4, "dddd");
+
+  // Only the least recently used entry is evicted to make room.
+  ASSERT_EQ(1, erased.size());
+  ASSERT_EQ(2, erased[0]);
+  ASSERT_EQ(10, cache.weight());
+
+  cache.insert(5, "e");
+
+  ASSERT_EQ(2, erased.size());
+  ASSERT_EQ(3, erased[1]);
+  ASSERT_EQ(9, cache.weight());
+  ASSERT_EQ(true, cache.find(1));
+  ASSERT_EQ(true, cache.find(4));
+  ASSERT_EQ(true, cache.find(5));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(weighted_lru_cache_unittest, TestInsertHeavierThanRemainingRoom)
+{
+  std::vector<int> erased;
+  const erasure_recorder on_insert(NULL);
+  const erasure_recorder on_erase(&erased);
+
+  cache_type cache(on_insert, on_erase, 10);
+
+  cache.insert(1, "aaa");
+  cache.insert(2, "bbb");
+  cache.insert(3, "cc");
+
+  ASSERT_EQ(false, cache.full());
+  ASSERT_EQ(8, cache.weight());
+
+  // The cache is not full, but the entry only fits once the two least
+  // recently used entries are evicted, so it never exceeds the capacity.
+  cache.insert(4, "dddddddd");
+
+  ASSERT_EQ(2, erased.size());
+  ASSERT_EQ(1, erased[0]);
+  ASSERT_EQ(2, erased[1]);
+  ASSERT_EQ(10, cache.weight());
+  ASSERT_EQ(true, cache.find(3));
+  ASSERT_EQ(true, cache.find(4));
+
+  // Entries heavier than the whole capacity are rejected without evicting.
+  cache.insert(5, "eeeeeeeeeee");
+
+  ASSERT_EQ(2, erased.size());
+  ASSERT_EQ(false, cache.find(5));
+  ASSERT_EQ(10, cache.weight());
+  ASSERT_EQ(2, cache.size());
+
+  // Entries as heavy as the capacity replace every other entry.
+  cache.insert(6, "ffffffffff");
+
+  ASSERT_EQ(4, erased.size());
+  ASSERT_EQ(1, cache.size());
+  ASSERT_EQ(10, cache.weight());
+  ASSERT_EQ(true, cache.find(6));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(weighted_lru_cache_unittest, TestResize)
+{
+  std::vector<int> erased;
+  const erasure_recorder on_insert(NULL);
+  const erasure_recorder on_erase(&erased);
+
+  cache_type cache(on_insert, on_erase, 1000);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    cache.insert(i, "0123456789");
+  }
+
+  ASSERT_EQ(100, cache.size());
+  ASSERT_EQ(true, cache.full());
+  ASSERT_EQ(true, erased.empty());
+
+  // Shrinking does not evict anything by itself.
+  cache.resize(100);
+
+  ASSERT_EQ(100, cache.capacity());
+  ASSERT_EQ(100, cache.size());
+  ASSERT_EQ(true, erased.empty());
+
+  // Evictions happen in bounded batches, oldest entries first.
+  ASSERT_EQ(5, cache.evict(5));
+  ASSERT_EQ(95, cache.size());
+  ASSERT_EQ(5, erased.size());
+
+  for (int i = 0; i < 5; ++i)
+  {
+    ASSERT_EQ(i, erased[i]);
+  }
+
+  // Each insertion evicts at most a bounded number of entries.
+  cache.insert(100, "0123456789");
+
+  ASSERT_EQ(5 + cache_type::MAX_EVICTIONS_PER_INSERT, erased.size());
+  ASSERT_EQ(96 - cache_type::MAX_EVICTIONS_PER_INSERT, cache.size());
+
+  while (cache.evict(8))
+  {
+  }
+
+  ASSERT_EQ(false, cache.full());
+  ASSERT_EQ(90, cache.weight());
+  ASSERT_EQ(true, cache.find(100));
+
+  // Growing makes room without evicting.
+  cache.resize(200);
+
+  const size_t erased_count = erased.size();
+
+  for (int i = 200; i < 210; ++i)
+  {
+    cache.insert(i, "0123456789");
+  }
+
+  ASSERT_EQ(erased_count, erased.size());
+  ASSERT_EQ(19, cache.size());
+}
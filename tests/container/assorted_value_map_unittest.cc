@@ -32,6 +32,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <functional>
 #include <memory>
 #include <stdexcept>
+#include <string>
 
 
 // -----------------------------------------------------------------------------
@@ -369,3 +370,70 @@ TEST_F(assorted_value_map_unittest, TestFind)
 }
 
 // -----------------------------------------------------------------------------
+
+TEST_F(assorted_value_map_unittest, TestEmplace)
+{
+  typedef sneaker::container::assorted_value_map<std::string, int, std::string> map_type;
+  map_type map;
+
+  std::pair<map_type::iterator, bool> result =
+    map.emplace("Apple", 100, "aaa");
+
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ("Apple", result.first->first);
+  ASSERT_EQ(100, boost::get<0>(result.first->second));
+  ASSERT_EQ("aaa", boost::get<1>(result.first->second));
+
+  // Emplacing an existing key does not overwrite its values.
+  result = map.emplace("Apple", 200, "b");
+
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(1, map.size());
+  ASSERT_EQ(100, (map.get<int, 0>("Apple")));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(assorted_value_map_unittest, TestTryEmplace)
+{
+  typedef sneaker::container::assorted_value_map<std::string, int, std::string> map_type;
+  map_type map;
+
+  std::string key("Banana");
+
+  std::pair<map_type::iterator, bool> result =
+    map.try_emplace(key, 100, "yellow");
+
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ("Banana", key);
+  ASSERT_EQ("yellow", (map.get<std::string, 1>(key)));
+
+  result = map.try_emplace(std::string("Banana"), 200, "green");
+
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(100, boost::get<0>(result.first->second));
+
+  result = map.try_emplace(std::string("Cherry"), 300, "red");
+
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(2, map.size());
+  ASSERT_EQ("Cherry", result.first->first);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(assorted_value_map_unittest, TestGetReturnsReference)
+{
+  typedef sneaker::container::assorted_value_map<int, int, std::string> map_type;
+  map_type map;
+
+  map.insert(1, 100, "one");
+
+  map.get<std::string, 1>(1) += " hundred";
+  ++map.get<int, 0>(1);
+
+  ASSERT_EQ(101, (map.get<int, 0>(1)));
+  ASSERT_EQ("one hundred", (map.get<std::string, 1>(1)));
+}
+
+// -----------------------------------------------------------------------------
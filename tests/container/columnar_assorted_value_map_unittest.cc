@@ -0,0 +1,256 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for
+ * `sneaker::container::columnar_assorted_value_map<K, ValueTypes ...>`
+ * defined in sneaker/container/columnar_assorted_value_map.h
+ */
+
+#include "container/columnar_assorted_value_map.h"
+
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+class columnar_assorted_value_map_unittest : public ::testing::Test {
+protected:
+  typedef sneaker::container::columnar_assorted_value_map<
+    int, double, std::string, bool> map_type;
+
+  map_type m_map;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(columnar_assorted_value_map_unittest, TestInitialization)
+{
+  ASSERT_TRUE(m_map.empty());
+  ASSERT_EQ(0, m_map.size());
+  ASSERT_EQ(map_type::npos, m_map.index_of(1));
+  ASSERT_EQ(0, m_map.column<0>().size());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(columnar_assorted_value_map_unittest, TestPutAndGet)
+{
+  m_map.insert(3, 3.5, "three", true);
+  m_map.insert(1, 1.5, "one", false);
+  m_map.insert(2, 2.5, "two", true);
+
+  // Inserting an existing key does not overwrite its values.
+  m_map.insert(1, 0.0, "uno", true);
+
+  ASSERT_EQ(3, m_map.size());
+  ASSERT_EQ(std::vector<int>({1, 2, 3}), m_map.keys());
+
+  ASSERT_EQ(1.5, (m_map.get<double, 0>(1)));
+  ASSERT_EQ("two", (m_map.get<std::string, 1>(2)));
+  ASSERT_EQ(true, (m_map.get<bool, 2>(3)));
+
+  // Values are accessed by reference, including `bool` ones.
+  m_map.get<bool, 2>(1) = true;
+  m_map.get<std::string, 1>(1) += "!";
+
+  const map_type::mapped_type values = m_map.at(1);
+  ASSERT_EQ(1.5, boost::get<0>(values));
+  ASSERT_EQ("one!", boost::get<1>(values));
+  ASSERT_EQ(true, boost::get<2>(values));
+
+  ASSERT_THROW(m_map.at(4), std::out_of_range);
+  ASSERT_THROW((m_map.get<double, 0>(4)), std::out_of_range);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(columnar_assorted_value_map_unittest, TestColumns)
+{
+  m_map.insert(20, 2.0, "b", false);
+  m_map.insert(10, 1.0, "a", true);
+  m_map.insert(30, 3.0, "c", true);
+
+  const map_type::column_type<0>& column = m_map.column<0>();
+
+  ASSERT_EQ(3, column.size());
+  ASSERT_EQ(1.0, column[0]);
+  ASSERT_EQ(3.0, column[2]);
+  ASSERT_EQ(2.0, column[m_map.index_of(20)]);
+
+  ASSERT_EQ(6.0,
+    std::accumulate(m_map.column_begin<0>(), m_map.column_end<0>(), 0.0));
+
+  for (auto itr = m_map.column_begin<1>(); itr != m_map.column_end<1>(); ++itr)
+  {
+    *itr += *itr;
+  }
+
+  ASSERT_EQ("bb", (m_map.get<std::string, 1>(20)));
+  ASSERT_EQ(2,
+    std::count(m_map.column_begin<2>(), m_map.column_end<2>(), true));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(columnar_assorted_value_map_unittest, TestBuildFrom)
+{
+  std::vector<map_type::value_type> pairs;
+  pairs.push_back(
+    map_type::value_type(4, map_type::mapped_type(4.0, "four", true)));
+  pairs.push_back(
+    map_type::value_type(2, map_type::mapped_type(2.0, "two", false)));
+  pairs.push_back(
+    map_type::value_type(4, map_type::mapped_type(0.0, "cuatro", false)));
+
+  m_map.insert(9, 9.0, "nine", true);
+  m_map.build_from(pairs.begin(), pairs.end());
+
+  ASSERT_EQ(std::vector<int>({2, 4}), m_map.keys());
+  ASSERT_EQ(2, m_map.column<1>().size());
+  ASSERT_EQ("four", (m_map.get<std::string, 1>(4)));
+  ASSERT_EQ(map_type::npos, m_map.index_of(9));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(columnar_assorted_value_map_unittest, TestEraseAndClear)
+{
+  m_map.insert(1, 1.0, "a", true);
+  m_map.insert(2, 2.0, "b", false);
+  m_map.insert(3, 3.0, "c", true);
+
+  ASSERT_EQ(1, m_map.erase(2));
+  ASSERT_EQ(0, m_map.erase(2));
+
+  ASSERT_EQ(std::vector<int>({1, 3}), m_map.keys());
+  ASSERT_EQ(2, m_map.column<2>().size());
+  ASSERT_EQ("c", m_map.column<1>()[1]);
+
+  map_type other = m_map;
+  m_map.clear();
+
+  ASSERT_TRUE(m_map.empty());
+  ASSERT_EQ(0, m_map.column<1>().size());
+
+  m_map.swap(other);
+
+  ASSERT_EQ(2, m_map.size());
+  ASSERT_TRUE(other.empty());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(columnar_assorted_value_map_unittest, TestWithNoValueType)
+{
+  sneaker::container::columnar_assorted_value_map<int> map;
+
+  map.insert(2);
+  map.insert(1);
+  map.insert(2);
+
+  ASSERT_EQ(std::vector<int>({1, 2}), map.keys());
+  ASSERT_EQ(1, map.erase(1));
+  ASSERT_EQ(1, map.size());
+}
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+struct counted_value
+{
+  static size_t copies;
+
+  /**
+   * The number of copies after which copying throws, or 0 if it never does.
+   */
+  static size_t throw_after;
+
+  counted_value()
+  {
+    // Do nothing here.
+  }
+
+  counted_value(const counted_value&)
+  {
+    ++copies;
+
+    if (throw_after && copies >= throw_after)
+    {
+      throw std::runtime_error("copy");
+    }
+  }
+
+  counted_value& operator=(const counted_value&) = default;
+};
+
+size_t counted_value::copies = 0;
+size_t counted_value::throw_after = 0;
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+TEST_F(columnar_assorted_value_map_unittest, TestThrowingInsertKeepsColumnsAligned)
+{
+  typedef sneaker::container::columnar_assorted_value_map<
+    int, double, counted_value> throwing_map_type;
+
+  // Counts the copies made by an insertion, the last of which is the one into
+  // the last column.
+  {
+    throwing_map_type map;
+    counted_value::copies = 0;
+    map.insert(1, 1.0, counted_value());
+  }
+
+  const size_t copies = counted_value::copies;
+
+  throwing_map_type map;
+  counted_value::copies = 0;
+  counted_value::throw_after = copies;
+
+  ASSERT_THROW(map.insert(1, 1.0, counted_value()), std::runtime_error);
+
+  counted_value::throw_after = 0;
+
+  ASSERT_TRUE(map.empty());
+  ASSERT_TRUE(map.keys().empty());
+  ASSERT_EQ(0, map.column<0>().size());
+  ASSERT_EQ(0, map.column<1>().size());
+
+  map.insert(1, 1.0, counted_value());
+
+  ASSERT_EQ(1, map.size());
+  ASSERT_EQ(1, map.column<0>().size());
+  ASSERT_EQ(1, map.column<1>().size());
+  ASSERT_EQ(1.0, (map.get<double, 0>(1)));
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,372 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `sneaker::container::concurrent_reservation_map` defined in
+ * sneaker/container/concurrent_reservation_map.h */
+
+#include "container/concurrent_reservation_map.h"
+
+#include "testing/testing.h"
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+class concurrent_reservation_map_unittest : public ::testing::Test {
+protected:
+  typedef sneaker::container::concurrent_reservation_map<std::string>
+    map_type;
+
+  concurrent_reservation_map_unittest()
+    :
+    m_map(8)
+  {
+  }
+
+  map_type m_map;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(concurrent_reservation_map_unittest, TestInitialization)
+{
+  ASSERT_EQ(8, m_map.capacity());
+  ASSERT_EQ(0, m_map.size());
+  ASSERT_EQ(0, m_map.reservations());
+
+  std::string value;
+  ASSERT_FALSE(m_map.member(0));
+  ASSERT_FALSE(m_map.get(0, &value));
+  ASSERT_FALSE(m_map.wait_get(0, &value));
+  ASSERT_FALSE(m_map.put(0, "value"));
+  ASSERT_FALSE(m_map.unreserve(0));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(concurrent_reservation_map_unittest, TestPutAndGet)
+{
+  const map_type::token_t id = m_map.reserve();
+
+  ASSERT_TRUE(m_map.member(id));
+  ASSERT_EQ(1, m_map.reservations());
+
+  std::string value;
+  ASSERT_FALSE(m_map.get(id, &value));
+
+  ASSERT_TRUE(m_map.put(id, "one"));
+  ASSERT_EQ(1, m_map.size());
+
+  // A value is only put once per reservation.
+  ASSERT_FALSE(m_map.put(id, "uno"));
+
+  ASSERT_TRUE(m_map.get(id, &value));
+  ASSERT_EQ("one", value);
+
+  ASSERT_TRUE(m_map.wait_get(id, &value));
+  ASSERT_EQ("one", value);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(concurrent_reservation_map_unittest, TestUnreserveInvalidatesToken)
+{
+  const map_type::token_t id = m_map.reserve();
+  m_map.put(id, "one");
+
+  ASSERT_TRUE(m_map.unreserve(id));
+  ASSERT_FALSE(m_map.unreserve(id));
+
+  ASSERT_FALSE(m_map.member(id));
+  ASSERT_EQ(0, m_map.size());
+  ASSERT_EQ(0, m_map.reservations());
+
+  // The slot is reused under a new generation, which the stale token cannot
+  // access.
+  const map_type::token_t other_id = m_map.reserve();
+  ASSERT_EQ(static_cast<uint32_t>(id), static_cast<uint32_t>(other_id));
+  ASSERT_NE(id, other_id);
+
+  ASSERT_FALSE(m_map.put(id, "stale"));
+  ASSERT_TRUE(m_map.put(other_id, "two"));
+
+  std::string value;
+  ASSERT_FALSE(m_map.get(id, &value));
+  ASSERT_TRUE(m_map.get(other_id, &value));
+  ASSERT_EQ("two", value);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(concurrent_reservation_map_unittest, TestReserveBeyondCapacityFails)
+{
+  for (size_t i = 0; i < m_map.capacity(); ++i)
+  {
+    m_map.reserve();
+  }
+
+  ASSERT_THROW(m_map.reserve(), std::length_error);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(concurrent_reservation_map_unittest, TestWaitGetBlocksUntilPut)
+{
+  const map_type::token_t id = m_map.reserve();
+
+  std::thread producer([this, id]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    m_map.put(id, "result");
+  });
+
+  std::string value;
+  ASSERT_TRUE(m_map.wait_get(id, &value));
+  ASSERT_EQ("result", value);
+
+  producer.join();
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(concurrent_reservation_map_unittest, TestWaitGetReturnsOnUnreserve)
+{
+  const map_type::token_t id = m_map.reserve();
+
+  std::thread canceller([this, id]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    m_map.unreserve(id);
+  });
+
+  std::string value;
+  ASSERT_FALSE(m_map.wait_get(id, &value));
+
+  canceller.join();
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(concurrent_reservation_map_unittest, TestUnreserveWhileCopying)
+{
+  const size_t THREADS = 4;
+
+  for (size_t i = 0; i < 200; ++i)
+  {
+    const map_type::token_t id = m_map.reserve();
+    ASSERT_TRUE(m_map.put(id, std::string(256, 'x')));
+
+    std::atomic<size_t> mismatches(0);
+    std::vector<std::thread> readers;
+
+    for (size_t t = 0; t < THREADS; ++t)
+    {
+      readers.push_back(std::thread([this, id, &mismatches]() {
+        std::string value;
+        while (m_map.get(id, &value))
+        {
+          if (value.size() != 256)
+          {
+            ++mismatches;
+          }
+        }
+      }));
+    }
+
+    ASSERT_TRUE(m_map.unreserve(id));
+
+    for (auto& reader : readers)
+    {
+      reader.join();
+    }
+
+    ASSERT_EQ(0, mismatches.load());
+  }
+
+  ASSERT_EQ(0, m_map.size());
+}
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+struct throwing_value
+{
+  static bool throw_on_move;
+
+  throwing_value()
+  {
+    // Do nothing here.
+  }
+
+  throwing_value(const throwing_value&)
+  {
+    // Do nothing here.
+  }
+
+  throwing_value(throwing_value&&)
+  {
+    if (throw_on_move)
+    {
+      throw std::runtime_error("move");
+    }
+  }
+
+  throwing_value& operator=(const throwing_value&) = default;
+};
+
+bool throwing_value::throw_on_move = false;
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+TEST_F(concurrent_reservation_map_unittest, TestThrowingPutLeavesTokenEmpty)
+{
+  sneaker::container::concurrent_reservation_map<throwing_value> map(4);
+
+  const uint64_t id = map.reserve();
+
+  throwing_value::throw_on_move = true;
+  ASSERT_THROW(map.put(id, throwing_value()), std::runtime_error);
+  throwing_value::throw_on_move = false;
+
+  throwing_value value;
+  ASSERT_FALSE(map.get(id, &value));
+  ASSERT_EQ(0, map.size());
+
+  ASSERT_TRUE(map.put(id, throwing_value()));
+  ASSERT_TRUE(map.get(id, &value));
+  ASSERT_EQ(1, map.size());
+
+  ASSERT_TRUE(map.unreserve(id));
+  ASSERT_EQ(0, map.size());
+  ASSERT_EQ(0, map.reservations());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(concurrent_reservation_map_unittest, TestWaitGetWithTimeout)
+{
+  const map_type::token_t id = m_map.reserve();
+
+  std::string value;
+  ASSERT_FALSE(m_map.wait_get(id, &value, std::chrono::milliseconds(10)));
+
+  m_map.put(id, "late");
+  ASSERT_TRUE(m_map.wait_get(id, &value, std::chrono::milliseconds(10)));
+  ASSERT_EQ("late", value);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(concurrent_reservation_map_unittest, TestConcurrentProducersAndConsumers)
+{
+  const size_t THREADS = 4;
+  const size_t ITERATIONS = 2000;
+
+  sneaker::container::concurrent_reservation_map<uint64_t> map(64);
+  std::atomic<size_t> mismatches(0);
+
+  std::vector<std::thread> threads;
+
+  for (size_t t = 0; t < THREADS; ++t)
+  {
+    threads.push_back(std::thread([&map, &mismatches, t]() {
+      for (uint64_t i = 0; i < ITERATIONS; ++i)
+      {
+        const uint64_t id = map.reserve();
+        const uint64_t expected = t * ITERATIONS + i;
+
+        std::thread worker([&map, id, expected]() {
+          map.put(id, expected);
+        });
+
+        uint64_t value = 0;
+        if (!map.wait_get(id, &value) || value != expected)
+        {
+          ++mismatches;
+        }
+
+        worker.join();
+        map.unreserve(id);
+      }
+    }));
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  ASSERT_EQ(0, mismatches.load());
+  ASSERT_EQ(0, map.size());
+  ASSERT_EQ(0, map.reservations());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(concurrent_reservation_map_unittest, TestConcurrentReservationsAreUnique)
+{
+  const size_t THREADS = 4;
+  const size_t PER_THREAD = 256;
+
+  sneaker::container::concurrent_reservation_map<int> map(THREADS * PER_THREAD);
+
+  std::vector<std::vector<uint64_t>> tokens(THREADS);
+  std::vector<std::thread> threads;
+
+  for (size_t t = 0; t < THREADS; ++t)
+  {
+    threads.push_back(std::thread([&map, &tokens, t]() {
+      for (size_t i = 0; i < PER_THREAD; ++i)
+      {
+        tokens[t].push_back(map.reserve());
+      }
+    }));
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  std::set<uint32_t> indices;
+  for (const auto& thread_tokens : tokens)
+  {
+    for (const uint64_t token : thread_tokens)
+    {
+      indices.insert(static_cast<uint32_t>(token));
+    }
+  }
+
+  ASSERT_EQ(THREADS * PER_THREAD, indices.size());
+  ASSERT_EQ(THREADS * PER_THREAD, map.reservations());
+}
+
+// -----------------------------------------------------------------------------
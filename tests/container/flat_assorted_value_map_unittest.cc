@@ -0,0 +1,335 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `sneaker::container::flat_assorted_value_map<K, ValueTypes ...>`
+ * defined in sneaker/container/flat_assorted_value_map.h
+ */
+
+#include "container/flat_assorted_value_map.h"
+
+#include "testing/testing.h"
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+class flat_assorted_value_map_unittest : public ::testing::Test {
+protected:
+  typedef sneaker::container::flat_assorted_value_map<int, std::string, bool>
+    map_type;
+
+  map_type m_map;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_assorted_value_map_unittest, TestInitialization)
+{
+  ASSERT_TRUE(m_map.empty());
+  ASSERT_EQ(0, m_map.size());
+  ASSERT_EQ(m_map.end(), m_map.find(1));
+  ASSERT_EQ(m_map.end(), m_map.lower_bound(1));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_assorted_value_map_unittest, TestPutAndGet)
+{
+  m_map.insert(3, "three", true);
+  m_map.insert(1, "one", false);
+  m_map.insert(2, "two", true);
+
+  // Inserting an existing key does not overwrite its values.
+  m_map.insert(1, "uno", true);
+
+  ASSERT_FALSE(m_map.empty());
+  ASSERT_EQ(3, m_map.size());
+
+  ASSERT_EQ("one", (m_map.get<std::string, 0>(1)));
+  ASSERT_EQ(false, (m_map.get<bool, 1>(1)));
+  ASSERT_EQ("two", (m_map.get<std::string, 0>(2)));
+  ASSERT_EQ("three", boost::get<0>(m_map.at(3)));
+
+  const map_type& map = m_map;
+  const std::string& value = map.get<std::string, 0>(3);
+  ASSERT_EQ("three", value);
+
+  ASSERT_THROW(m_map.at(4), std::out_of_range);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_assorted_value_map_unittest, TestOrderedIteration)
+{
+  m_map.insert(5, "five", true);
+  m_map.insert(1, "one", false);
+  m_map.insert(3, "three", true);
+
+  std::vector<int> keys;
+  for (auto itr = m_map.begin(); itr != m_map.end(); ++itr)
+  {
+    keys.push_back(itr->first);
+  }
+
+  ASSERT_EQ(std::vector<int>({1, 3, 5}), keys);
+  ASSERT_EQ(5, m_map.rbegin()->first);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_assorted_value_map_unittest, TestBuildFrom)
+{
+  std::vector<map_type::value_type> pairs;
+  pairs.push_back(map_type::value_type(4, map_type::mapped_type("four", true)));
+  pairs.push_back(map_type::value_type(2, map_type::mapped_type("two", true)));
+  pairs.push_back(map_type::value_type(4, map_type::mapped_type("cuatro", false)));
+  pairs.push_back(map_type::value_type(1, map_type::mapped_type("one", false)));
+
+  m_map.insert(9, "nine", true);
+  m_map.build_from(pairs.begin(), pairs.end());
+
+  ASSERT_EQ(3, m_map.size());
+  ASSERT_EQ(m_map.end(), m_map.find(9));
+
+  // The first of the pairs with the same key is kept.
+  ASSERT_EQ("four", (m_map.get<std::string, 0>(4)));
+
+  ASSERT_EQ(1, m_map.begin()->first);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_assorted_value_map_unittest, TestBounds)
+{
+  for (int i = 0; i < 10; ++i)
+  {
+    m_map.insert(i * 10, std::to_string(i), i % 2 == 0);
+  }
+
+  ASSERT_EQ(30, m_map.lower_bound(30)->first);
+  ASSERT_EQ(40, m_map.lower_bound(31)->first);
+  ASSERT_EQ(40, m_map.upper_bound(30)->first);
+  ASSERT_EQ(0, m_map.lower_bound(-5)->first);
+  ASSERT_EQ(m_map.end(), m_map.lower_bound(91));
+  ASSERT_EQ(m_map.end(), m_map.upper_bound(90));
+
+  size_t count = 0;
+  for (auto itr = m_map.lower_bound(25); itr != m_map.upper_bound(60); ++itr)
+  {
+    ++count;
+  }
+
+  ASSERT_EQ(4, count);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_assorted_value_map_unittest, TestSearchMatchesStdMap)
+{
+  // Covers complete and partial levels of the search layout.
+  for (int n = 0; n < 70; ++n)
+  {
+    sneaker::container::flat_assorted_value_map<int, int> map;
+    std::map<int, int> expected;
+
+    for (int i = 0; i < n; ++i)
+    {
+      map.insert(i * 2, i);
+      expected[i * 2] = i;
+    }
+
+    // Searches the pairs, and then the layout built from them.
+    for (int pass = 0; pass < 2; ++pass)
+    {
+      for (int key = -1; key <= n * 2; ++key)
+      {
+        auto lower = expected.lower_bound(key);
+        auto upper = expected.upper_bound(key);
+
+        ASSERT_EQ(std::distance(expected.begin(), lower),
+          std::distance(map.begin(), map.lower_bound(key)));
+        ASSERT_EQ(std::distance(expected.begin(), upper),
+          std::distance(map.begin(), map.upper_bound(key)));
+        ASSERT_EQ(expected.count(key) != 0, map.find(key) != map.end());
+      }
+
+      map.build_layout();
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_assorted_value_map_unittest, TestErase)
+{
+  m_map.insert(1, "one", false);
+  m_map.insert(2, "two", true);
+  m_map.insert(3, "three", true);
+  m_map.insert(4, "four", true);
+
+  ASSERT_EQ(1, m_map.erase(2));
+  ASSERT_EQ(0, m_map.erase(2));
+  ASSERT_EQ(m_map.end(), m_map.find(2));
+
+  m_map.erase(m_map.find(1));
+  ASSERT_EQ(2, m_map.size());
+  ASSERT_EQ("three", (m_map.get<std::string, 0>(3)));
+
+  m_map.erase(m_map.begin(), m_map.end());
+  ASSERT_TRUE(m_map.empty());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_assorted_value_map_unittest, TestSubscriptOperator)
+{
+  m_map.insert(2, "two", true);
+
+  boost::get<0>(m_map[2]) = "deux";
+  ASSERT_EQ("deux", (m_map.get<std::string, 0>(2)));
+
+  boost::get<0>(m_map[1]) = "un";
+  ASSERT_EQ(2, m_map.size());
+  ASSERT_EQ(1, m_map.begin()->first);
+  ASSERT_EQ("un", (m_map.get<std::string, 0>(1)));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_assorted_value_map_unittest, TestCopyAndSwap)
+{
+  m_map.insert(1, "one", false);
+
+  map_type other = m_map;
+  other.insert(2, "two", true);
+
+  ASSERT_EQ(1, m_map.size());
+  ASSERT_EQ(2, other.size());
+
+  m_map.swap(other);
+
+  ASSERT_EQ(2, m_map.size());
+  ASSERT_NE(m_map.end(), m_map.find(2));
+  ASSERT_EQ(other.end(), other.find(2));
+
+  m_map.clear();
+  ASSERT_TRUE(m_map.empty());
+  ASSERT_EQ(m_map.end(), m_map.find(1));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_assorted_value_map_unittest, TestEmplace)
+{
+  std::pair<map_type::iterator, bool> result = m_map.emplace(2, "bbb", true);
+
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(2, result.first->first);
+  ASSERT_EQ("bbb", boost::get<0>(result.first->second));
+
+  result = m_map.emplace(1, "one", false);
+
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(1, result.first->first);
+  ASSERT_EQ(m_map.begin(), result.first);
+
+  // Emplacing an existing key does not overwrite its values.
+  result = m_map.emplace(2, "two", false);
+
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(2, m_map.size());
+  ASSERT_EQ("bbb", (m_map.get<std::string, 0>(2)));
+  ASSERT_EQ(result.first, m_map.find(2));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_assorted_value_map_unittest, TestTryEmplace)
+{
+  for (int i = 10; i > 0; --i)
+  {
+    ASSERT_TRUE(m_map.try_emplace(i, std::to_string(i), i % 2 == 0).second);
+  }
+
+  ASSERT_FALSE(m_map.try_emplace(5, "five", false).second);
+  ASSERT_EQ(10, m_map.size());
+
+  int expected = 1;
+  for (auto itr = m_map.begin(); itr != m_map.end(); ++itr, ++expected)
+  {
+    ASSERT_EQ(expected, itr->first);
+    ASSERT_EQ(std::to_string(expected), boost::get<0>(itr->second));
+    ASSERT_EQ(m_map.find(expected), itr);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_assorted_value_map_unittest, TestGetReturnsReference)
+{
+  m_map.insert(1, "one", false);
+
+  m_map.get<std::string, 0>(1) += " hundred";
+  m_map.get<bool, 1>(1) = true;
+
+  ASSERT_EQ("one hundred", (m_map.get<std::string, 0>(1)));
+  ASSERT_EQ(true, (m_map.get<bool, 1>(1)));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_assorted_value_map_unittest, TestHeterogeneousLookup)
+{
+  typedef sneaker::container::flat_assorted_value_map<std::string, int>
+    string_map_type;
+  string_map_type map;
+
+  map.insert("banana", 2);
+  map.insert("apple", 1);
+  map.insert("cherry", 3);
+
+  const char* key = "banana";
+
+  ASSERT_NE(map.end(), map.find(key));
+  ASSERT_EQ("banana", map.find(key)->first);
+  ASSERT_EQ(map.end(), map.find("durian"));
+
+  ASSERT_EQ(2, (map.get<int, 0>(key)));
+  ASSERT_EQ(3, boost::get<0>(map.at("cherry")));
+  ASSERT_THROW(map.at("durian"), std::out_of_range);
+
+  ASSERT_EQ("banana", map.lower_bound("b")->first);
+  ASSERT_EQ("cherry", map.upper_bound("banana")->first);
+  ASSERT_EQ(map.end(), map.lower_bound("d"));
+
+  const string_map_type& const_map = map;
+  ASSERT_EQ(const_map.begin(), const_map.find("apple"));
+  ASSERT_EQ(1, (const_map.get<int, 0>("apple")));
+  ASSERT_EQ(const_map.end(), const_map.upper_bound("cherry"));
+}
+
+// -----------------------------------------------------------------------------
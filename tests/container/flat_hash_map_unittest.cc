@@ -0,0 +1,357 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `sneaker::container::flat_hash_map` defined in
+ * sneaker/container/flat_hash_map.h */
+
+#include "container/flat_hash_map.h"
+
+#include "testing/testing.h"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+
+// -----------------------------------------------------------------------------
+
+class flat_hash_map_unittest : public ::testing::Test {
+protected:
+  typedef sneaker::container::flat_hash_map<int, std::string> map_type;
+
+  /**
+   * A view of the characters of a string key.
+   */
+  struct key_view
+  {
+    const char* data;
+    size_t size;
+
+    friend bool operator==(const std::string& lhs, const key_view& rhs)
+    {
+      return lhs.size() == rhs.size &&
+        memcmp(lhs.data(), rhs.data, rhs.size) == 0;
+    }
+  };
+
+  /**
+   * FNV-1a hash of the characters of a string.
+   */
+  struct bytes_hash
+  {
+    static size_t hash(const char* data, size_t size)
+    {
+      uint64_t hash = 0xcbf29ce484222325ULL;
+
+      for (size_t i = 0; i < size; ++i)
+      {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ULL;
+      }
+
+      return static_cast<size_t>(hash);
+    }
+
+    size_t operator()(const std::string& key) const
+    {
+      return hash(key.data(), key.size());
+    }
+  };
+
+  map_type m_map;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_hash_map_unittest, TestInitialization)
+{
+  ASSERT_TRUE(m_map.empty());
+  ASSERT_EQ(0, m_map.size());
+  ASSERT_EQ(0, m_map.capacity());
+  ASSERT_EQ(m_map.end(), m_map.begin());
+  ASSERT_EQ(m_map.end(), m_map.find(1));
+  ASSERT_EQ(0, m_map.erase(1));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_hash_map_unittest, TestInsertAndFind)
+{
+  ASSERT_TRUE(m_map.insert(map_type::value_type(1, "one")).second);
+  ASSERT_TRUE(m_map.insert(map_type::value_type(2, "two")).second);
+
+  std::pair<map_type::iterator, bool> result =
+    m_map.insert(map_type::value_type(1, "uno"));
+
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ("one", result.first->second);
+  ASSERT_EQ(2, m_map.size());
+
+  ASSERT_EQ("two", m_map.find(2)->second);
+  ASSERT_EQ("one", m_map.at(1));
+  ASSERT_EQ(1, m_map.count(1));
+  ASSERT_EQ(0, m_map.count(3));
+  ASSERT_THROW(m_map.at(3), std::out_of_range);
+
+  m_map[3] = "three";
+  ASSERT_EQ("three", m_map.at(3));
+  ASSERT_EQ(3, m_map.size());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_hash_map_unittest, TestEmplace)
+{
+  std::pair<map_type::iterator, bool> result = m_map.emplace(
+    std::piecewise_construct, std::forward_as_tuple(1),
+    std::forward_as_tuple(3, 'a'));
+
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ("aaa", result.first->second);
+
+  result = m_map.emplace(1, "b");
+
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ("aaa", m_map.at(1));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_hash_map_unittest, TestGrowth)
+{
+  const int COUNT = 10000;
+
+  for (int i = 0; i < COUNT; ++i)
+  {
+    ASSERT_TRUE(
+      m_map.insert(map_type::value_type(i, std::to_string(i))).second);
+  }
+
+  ASSERT_EQ(COUNT, m_map.size());
+  ASSERT_LE(m_map.load_factor(), m_map.max_load_factor());
+
+  for (int i = 0; i < COUNT; ++i)
+  {
+    ASSERT_EQ(std::to_string(i), m_map.at(i));
+  }
+
+  size_t count = 0;
+  for (auto itr = m_map.begin(); itr != m_map.end(); ++itr)
+  {
+    ASSERT_EQ(std::to_string(itr->first), itr->second);
+    ++count;
+  }
+
+  ASSERT_EQ(COUNT, count);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_hash_map_unittest, TestErase)
+{
+  for (int i = 0; i < 100; ++i)
+  {
+    m_map[i] = std::to_string(i);
+  }
+
+  for (int i = 0; i < 100; i += 2)
+  {
+    ASSERT_EQ(1, m_map.erase(i));
+  }
+
+  ASSERT_EQ(0, m_map.erase(0));
+  ASSERT_EQ(50, m_map.size());
+
+  for (int i = 0; i < 100; ++i)
+  {
+    ASSERT_EQ(i % 2 == 1, m_map.find(i) != m_map.end());
+  }
+
+  map_type::iterator itr = m_map.find(1);
+  itr = m_map.erase(itr);
+  ASSERT_EQ(49, m_map.size());
+
+  m_map.erase(m_map.begin(), m_map.end());
+  ASSERT_TRUE(m_map.empty());
+  ASSERT_EQ(m_map.end(), m_map.begin());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_hash_map_unittest, TestChurnReusesDeletedSlots)
+{
+  m_map.reserve(1000);
+
+  const size_t capacity = m_map.capacity();
+  ASSERT_LE(1000, capacity);
+
+  // Inserting and erasing keys without ever exceeding the reserved size does
+  // not grow the table, even as deleted slots accumulate.
+  for (int i = 0; i < 100000; ++i)
+  {
+    m_map[i] = "value";
+    if (i >= 500)
+    {
+      ASSERT_EQ(1, m_map.erase(i - 500));
+    }
+  }
+
+  ASSERT_EQ(500, m_map.size());
+  ASSERT_EQ(capacity, m_map.capacity());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_hash_map_unittest, TestMatchesStdUnorderedMap)
+{
+  sneaker::container::flat_hash_map<uint64_t, uint64_t> map;
+  std::unordered_map<uint64_t, uint64_t> expected;
+
+  std::mt19937_64 engine(1);
+  std::uniform_int_distribution<uint64_t> distribution(0, 2000);
+
+  for (size_t i = 0; i < 50000; ++i)
+  {
+    const uint64_t key = distribution(engine);
+
+    switch (i % 3)
+    {
+      case 0:
+        map[key] = i;
+        expected[key] = i;
+        break;
+      case 1:
+        ASSERT_EQ(expected.erase(key), map.erase(key));
+        break;
+      default:
+        ASSERT_EQ(expected.count(key), map.count(key));
+        break;
+    }
+  }
+
+  ASSERT_EQ(expected.size(), map.size());
+
+  for (const auto& pair : map)
+  {
+    ASSERT_EQ(expected.at(pair.first), pair.second);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_hash_map_unittest, TestCopyMoveAndSwap)
+{
+  for (int i = 0; i < 100; ++i)
+  {
+    m_map[i] = std::to_string(i);
+  }
+  m_map.erase(50);
+
+  map_type copy(m_map);
+  ASSERT_EQ(99, copy.size());
+  ASSERT_EQ("42", copy.at(42));
+  ASSERT_EQ(copy.end(), copy.find(50));
+
+  map_type moved(std::move(copy));
+  ASSERT_EQ(99, moved.size());
+  ASSERT_TRUE(copy.empty());
+
+  map_type other;
+  other[1000] = "thousand";
+  other.swap(moved);
+
+  ASSERT_EQ(1, moved.size());
+  ASSERT_EQ(99, other.size());
+
+  moved = other;
+  ASSERT_EQ(99, moved.size());
+  ASSERT_EQ("99", moved.at(99));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_hash_map_unittest, TestClearAndRehash)
+{
+  for (int i = 0; i < 100; ++i)
+  {
+    m_map[i] = std::to_string(i);
+  }
+
+  const size_t capacity = m_map.capacity();
+
+  m_map.clear();
+  ASSERT_TRUE(m_map.empty());
+  ASSERT_EQ(capacity, m_map.capacity());
+  ASSERT_EQ(m_map.end(), m_map.find(1));
+
+  m_map[1] = "one";
+  m_map.rehash(0);
+  ASSERT_LT(m_map.capacity(), capacity);
+  ASSERT_EQ("one", m_map.at(1));
+
+  m_map.erase(1);
+  m_map.rehash(0);
+  ASSERT_EQ(0, m_map.capacity());
+  ASSERT_TRUE(m_map.empty());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(flat_hash_map_unittest, TestHeterogeneousFind)
+{
+  typedef sneaker::container::flat_hash_map<std::string, int, bytes_hash>
+    string_map_type;
+  string_map_type map;
+
+  ASSERT_EQ(map.end(), map.find("apple", bytes_hash::hash("apple", 5)));
+
+  for (int i = 0; i < 100; ++i)
+  {
+    map[std::to_string(i)] = i;
+  }
+
+  const char* line = "17,42,100";
+
+  for (size_t begin = 0, end = 2; begin < 6; begin += 3, end += 3)
+  {
+    const key_view key = { line + begin, end - begin };
+    const string_map_type::iterator itr =
+      map.find(key, bytes_hash::hash(key.data, key.size));
+
+    ASSERT_NE(map.end(), itr);
+    ASSERT_EQ(std::string(key.data, key.size), itr->first);
+  }
+
+  const key_view missing = { line + 6, 3 };
+  ASSERT_EQ(map.end(),
+    map.find(missing, bytes_hash::hash(missing.data, missing.size)));
+
+  const string_map_type& const_map = map;
+  const key_view key = { line, 1 };
+  ASSERT_EQ(1, const_map.find(key, bytes_hash::hash(key.data, key.size))->second);
+}
+
+// -----------------------------------------------------------------------------
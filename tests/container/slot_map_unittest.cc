@@ -0,0 +1,281 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `sneaker::container::slot_map` defined in
+ * sneaker/container/slot_map.h */
+
+#include "container/slot_map.h"
+
+#include "testing/testing.h"
+
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+class slot_map_unittest : public ::testing::Test {
+protected:
+  typedef sneaker::container::slot_map<std::string> map_type;
+
+  map_type m_map;
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(slot_map_unittest, TestInitialization)
+{
+  ASSERT_EQ(0, m_map.size());
+  ASSERT_EQ(0, m_map.reservations());
+
+  ASSERT_FALSE(m_map.member(0));
+  ASSERT_FALSE(m_map.get(0, NULL));
+  ASSERT_FALSE(m_map.unreserve(0));
+  ASSERT_EQ(NULL, m_map.find(0));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(slot_map_unittest, TestReserveAndPut)
+{
+  const map_type::token_t id_1 = m_map.reserve();
+  const map_type::token_t id_2 = m_map.reserve();
+
+  ASSERT_NE(id_1, id_2);
+  ASSERT_TRUE(m_map.member(id_1));
+  ASSERT_TRUE(m_map.member(id_2));
+  ASSERT_EQ(2, m_map.reservations());
+  ASSERT_EQ(0, m_map.size());
+
+  // Reserved tokens have no value until one is put.
+  std::string value;
+  ASSERT_FALSE(m_map.get(id_1, &value));
+  ASSERT_EQ(NULL, m_map.find(id_1));
+
+  ASSERT_TRUE(m_map.put(id_1, "one"));
+  ASSERT_TRUE(m_map.put(id_2, "two"));
+  ASSERT_EQ(2, m_map.size());
+
+  ASSERT_TRUE(m_map.get(id_1, &value));
+  ASSERT_EQ("one", value);
+  ASSERT_EQ("two", *m_map.find(id_2));
+
+  ASSERT_TRUE(m_map.put(id_1, "uno"));
+  ASSERT_EQ(2, m_map.size());
+  ASSERT_EQ("uno", *m_map.find(id_1));
+
+  *m_map.find(id_2) = "dos";
+  ASSERT_EQ("dos", *m_map.find(id_2));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(slot_map_unittest, TestUnreserveInvalidatesToken)
+{
+  const map_type::token_t id_1 = m_map.reserve();
+  const map_type::token_t id_2 = m_map.reserve();
+
+  m_map.put(id_1, "one");
+  m_map.put(id_2, "two");
+
+  ASSERT_TRUE(m_map.unreserve(id_1));
+  ASSERT_FALSE(m_map.unreserve(id_1));
+
+  ASSERT_FALSE(m_map.member(id_1));
+  ASSERT_FALSE(m_map.put(id_1, "one"));
+  ASSERT_EQ(NULL, m_map.find(id_1));
+  ASSERT_EQ(1, m_map.size());
+  ASSERT_EQ(1, m_map.reservations());
+
+  // The value moved within the dense array is still found through its token.
+  ASSERT_EQ("two", *m_map.find(id_2));
+
+  // The slot is reused, under a new generation.
+  const map_type::token_t id_3 = m_map.reserve();
+  ASSERT_NE(id_1, id_3);
+  ASSERT_EQ(static_cast<uint32_t>(id_1), static_cast<uint32_t>(id_3));
+  ASSERT_FALSE(m_map.member(id_1));
+  ASSERT_TRUE(m_map.member(id_3));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(slot_map_unittest, TestClear)
+{
+  std::vector<map_type::token_t> tokens;
+  for (int i = 0; i < 10; ++i)
+  {
+    tokens.push_back(m_map.reserve());
+    m_map.put(tokens.back(), std::to_string(i));
+  }
+
+  m_map.unreserve(tokens[3]);
+  m_map.clear();
+
+  ASSERT_EQ(0, m_map.size());
+  ASSERT_EQ(0, m_map.reservations());
+
+  for (const map_type::token_t token : tokens)
+  {
+    ASSERT_FALSE(m_map.member(token));
+  }
+
+  const map_type::token_t id = m_map.reserve();
+  ASSERT_TRUE(m_map.put(id, "value"));
+  ASSERT_EQ("value", *m_map.find(id));
+}
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+struct throwing_value
+{
+  static bool throw_on_move;
+
+  throwing_value()
+  {
+    // Do nothing here.
+  }
+
+  throwing_value(const throwing_value&)
+  {
+    // Do nothing here.
+  }
+
+  throwing_value(throwing_value&&)
+  {
+    if (throw_on_move)
+    {
+      throw std::runtime_error("move");
+    }
+  }
+
+  throwing_value& operator=(const throwing_value&) = default;
+};
+
+bool throwing_value::throw_on_move = false;
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+TEST_F(slot_map_unittest, TestThrowingPutLeavesTokenReserved)
+{
+  sneaker::container::slot_map<throwing_value> map;
+
+  const uint64_t id = map.reserve();
+
+  throwing_value::throw_on_move = true;
+  ASSERT_THROW(map.put(id, throwing_value()), std::runtime_error);
+  throwing_value::throw_on_move = false;
+
+  ASSERT_TRUE(map.member(id));
+  ASSERT_EQ(NULL, map.find(id));
+  ASSERT_EQ(0, map.size());
+
+  ASSERT_TRUE(map.put(id, throwing_value()));
+  ASSERT_NE(nullptr, map.find(id));
+  ASSERT_EQ(1, map.size());
+
+  ASSERT_TRUE(map.unreserve(id));
+  ASSERT_EQ(0, map.size());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(slot_map_unittest, TestForEach)
+{
+  std::map<map_type::token_t, std::string> expected;
+
+  for (int i = 0; i < 10; ++i)
+  {
+    const map_type::token_t id = m_map.reserve();
+    if (i % 3)
+    {
+      m_map.put(id, std::to_string(i));
+      expected[id] = std::to_string(i);
+    }
+  }
+
+  std::map<map_type::token_t, std::string> visited;
+  m_map.for_each(
+    [&visited](map_type::token_t id, const std::string& value) {
+      visited[id] = value;
+    }
+  );
+
+  ASSERT_EQ(expected, visited);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(slot_map_unittest, TestChurnMatchesStdMap)
+{
+  sneaker::container::slot_map<uint64_t> map(64);
+  std::map<uint64_t, uint64_t> expected;
+  std::vector<uint64_t> tokens;
+
+  std::mt19937_64 engine(1);
+
+  for (uint64_t i = 0; i < 20000; ++i)
+  {
+    if (tokens.empty() || engine() % 3)
+    {
+      const uint64_t id = map.reserve();
+      ASSERT_EQ(0, expected.count(id));
+
+      tokens.push_back(id);
+      if (i % 2)
+      {
+        map.put(id, i);
+        expected[id] = i;
+      }
+    }
+    else
+    {
+      const size_t pos = engine() % tokens.size();
+      ASSERT_TRUE(map.unreserve(tokens[pos]));
+      ASSERT_FALSE(map.member(tokens[pos]));
+
+      expected.erase(tokens[pos]);
+      tokens[pos] = tokens.back();
+      tokens.pop_back();
+    }
+  }
+
+  ASSERT_EQ(expected.size(), map.size());
+  ASSERT_EQ(tokens.size(), map.reservations());
+
+  for (const auto& pair : expected)
+  {
+    uint64_t value = 0;
+    ASSERT_TRUE(map.get(pair.first, &value));
+    ASSERT_EQ(pair.second, value);
+  }
+}
+
+// -----------------------------------------------------------------------------
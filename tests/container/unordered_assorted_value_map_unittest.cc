@@ -31,6 +31,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <functional>
 #include <memory>
 #include <stdexcept>
+#include <string>
 
 
 // -----------------------------------------------------------------------------
@@ -372,3 +373,146 @@ TEST_F(unordered_assorted_value_map_unittest, TestFind)
 }
 
 // -----------------------------------------------------------------------------
+
+TEST_F(unordered_assorted_value_map_unittest, TestEmplace)
+{
+  typedef sneaker::container::unordered_assorted_value_map<std::string, int, std::string> map_type;
+  map_type map;
+
+  std::pair<map_type::iterator, bool> result =
+    map.emplace("Apple", 100, "aaa");
+
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ("Apple", result.first->first);
+  ASSERT_EQ(100, boost::get<0>(result.first->second));
+  ASSERT_EQ("aaa", boost::get<1>(result.first->second));
+
+  // Emplacing an existing key does not overwrite its values.
+  result = map.emplace("Apple", 200, "b");
+
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(1, map.size());
+  ASSERT_EQ(100, (map.get<int, 0>("Apple")));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(unordered_assorted_value_map_unittest, TestTryEmplace)
+{
+  typedef sneaker::container::unordered_assorted_value_map<std::string, int, std::string> map_type;
+  map_type map;
+
+  std::string key("Banana");
+
+  std::pair<map_type::iterator, bool> result =
+    map.try_emplace(key, 100, "yellow");
+
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ("Banana", key);
+  ASSERT_EQ("yellow", (map.get<std::string, 1>(key)));
+
+  result = map.try_emplace(std::string("Banana"), 200, "green");
+
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(100, boost::get<0>(result.first->second));
+
+  result = map.try_emplace(std::string("Cherry"), 300, "red");
+
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(2, map.size());
+  ASSERT_EQ("Cherry", result.first->first);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(unordered_assorted_value_map_unittest, TestGetReturnsReference)
+{
+  typedef sneaker::container::unordered_assorted_value_map<int, int, std::string> map_type;
+  map_type map;
+
+  map.insert(1, 100, "one");
+
+  map.get<std::string, 1>(1) += " hundred";
+  ++map.get<int, 0>(1);
+
+  ASSERT_EQ(101, (map.get<int, 0>(1)));
+  ASSERT_EQ("one hundred", (map.get<std::string, 1>(1)));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(unordered_assorted_value_map_unittest, TestFlatCore)
+{
+  typedef sneaker::container::flat_unordered_assorted_value_map<std::string,
+    int, std::string> map_type;
+  map_type map;
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    map.insert(std::to_string(i), i, "value");
+  }
+
+  ASSERT_EQ(1000, map.size());
+  ASSERT_EQ(42, (map.get<int, 0>("42")));
+  ASSERT_EQ("value", (map.get<std::string, 1>("999")));
+  ASSERT_THROW(map.at("1000"), std::out_of_range);
+
+  ASSERT_FALSE(map.try_emplace("42", 0, "other").second);
+  ASSERT_TRUE(map.emplace("1000", 1000, "value").second);
+
+  ASSERT_EQ(1, map.erase("0"));
+  ASSERT_EQ(map.end(), map.find("0"));
+  ASSERT_EQ(1000, map.size());
+
+  map_type copy(map);
+  map.clear();
+
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(1000, copy.size());
+  ASSERT_EQ(1000, (copy.get<int, 0>("1000")));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(unordered_assorted_value_map_unittest, TestCreateWithFlatCore)
+{
+  typedef sneaker::container::flat_unordered_assorted_value_map<int, bool>
+    map_type;
+
+  map_type map = map_type::create<64, std::hash<int>, std::equal_to<int>,
+    std::allocator<map_type::value_type>>();
+
+  ASSERT_TRUE(map.empty());
+  ASSERT_GE(map.max_load_factor(), map.load_factor());
+
+  map.insert(1, true);
+  ASSERT_EQ(true, (map.get<bool, 0>(1)));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(unordered_assorted_value_map_unittest, TestHeterogeneousLookupWithHash)
+{
+  typedef sneaker::container::flat_unordered_assorted_value_map<std::string,
+    int> map_type;
+  map_type map;
+
+  map.insert("banana", 2);
+  map.insert("apple", 1);
+
+  const char* key = "banana";
+  const map_type::size_type hash = map.hash_function()("banana");
+
+  ASSERT_EQ("banana", map.find(key, hash)->first);
+  ASSERT_EQ(2, (map.get<int, 0>(key, hash)));
+  ASSERT_EQ(2, boost::get<0>(map.at(key, hash)));
+  ASSERT_THROW(map.at("cherry", map.hash_function()("cherry")),
+    std::out_of_range);
+
+  const map_type& const_map = map;
+  ASSERT_EQ(const_map.end(),
+    const_map.find("cherry", const_map.hash_function()("cherry")));
+  ASSERT_EQ(2, (const_map.get<int, 0>(key, hash)));
+}
+
+// -----------------------------------------------------------------------------
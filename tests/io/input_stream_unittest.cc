@@ -28,6 +28,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "testing/testing.h"
 
 #include <fstream>
+#include <ios>
 #include <string>
 #include <sstream>
 
@@ -150,6 +151,32 @@ TEST_F(input_stream_unittest, Test_memory_input_stream)
 
 // -----------------------------------------------------------------------------
 
+TEST_F(input_stream_unittest, Test_mmap_input_stream)
+{
+  auto input_stream = sneaker::io::mmap_input_stream(FILEPATH);
+
+  ASSERT_NE(nullptr, input_stream);
+
+  const uint8_t* data = NULL;
+  size_t len = 0;
+
+  bool res = input_stream->next(&data, &len);
+
+  ASSERT_EQ(true, res);
+  ASSERT_EQ(strlen(DATA), len);
+  ASSERT_EQ(DATA, std::string(data, data+len));
+  ASSERT_EQ(strlen(DATA), input_stream->bytes_read());
+
+  res = input_stream->next(&data, &len);
+
+  ASSERT_EQ(false, res);
+
+  ASSERT_THROW(sneaker::io::mmap_input_stream("nonexistent.txt"),
+    std::ios_base::failure);
+}
+
+// -----------------------------------------------------------------------------
+
 class stream_reader_unittest : public input_stream_unittest {};
 
 // -----------------------------------------------------------------------------
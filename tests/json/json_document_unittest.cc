@@ -0,0 +1,495 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit tests for definitions defined in sneaker/json/json_document.h */
+
+#include "json/json_document.h"
+
+#include "json/json.h"
+#include "testing/testing.h"
+
+#include <cstring>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+using namespace sneaker::json;
+
+// -----------------------------------------------------------------------------
+
+class json_document_unittest : public ::testing::Test {
+protected:
+  /**
+   * Generates a random document with nested containers, duplicate keys and
+   * strings with escape sequences.
+   */
+  std::string generate_document(std::mt19937& engine, uint32_t depth) const
+  {
+    std::uniform_int_distribution<uint32_t> kinds(0, depth < 4 ? 7 : 5);
+    std::uniform_int_distribution<uint32_t> sizes(0, 6);
+
+    switch (kinds(engine)) {
+      case 0:
+        return "null";
+      case 1:
+        return (engine() % 2) ? "true" : "false";
+      case 2:
+        return std::to_string(static_cast<int64_t>(engine()) - 0x7fffffff);
+      case 3:
+        {
+          std::ostringstream stream;
+          stream.precision(17);
+          stream << std::uniform_real_distribution<double>(-1e6, 1e6)(engine);
+          return stream.str();
+        }
+      case 4:
+      case 5:
+        return generate_string(engine);
+      case 6:
+        {
+          std::string out = "[";
+          const uint32_t size = sizes(engine);
+          for (uint32_t i = 0; i < size; ++i) {
+            out += (i ? ", " : "") + generate_document(engine, depth + 1);
+          }
+          return out + "]";
+        }
+      default:
+        {
+          std::string out = "{";
+          const uint32_t size = sizes(engine);
+          for (uint32_t i = 0; i < size; ++i) {
+            out += (i ? ", " : "") + generate_string(engine) + ": " +
+              generate_document(engine, depth + 1);
+          }
+          return out + "}";
+        }
+    }
+  }
+
+  std::string generate_string(std::mt19937& engine) const
+  {
+    static const char* const PIECES[] = {
+      "a", "b", "key", "\\n", "\\\"", "\\\\", "\\/", "\\t", "\\u00e9",
+      "\\ud83d\\udca9", "\\u0000", "\xe3\x81\x82", " "
+    };
+
+    const size_t count = sizeof(PIECES) / sizeof(PIECES[0]);
+
+    std::string out = "\"";
+    const uint32_t size = engine() % 5;
+    for (uint32_t i = 0; i < size; ++i) {
+      out += PIECES[engine() % count];
+    }
+
+    return out + "\"";
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestDefaultDocument)
+{
+  json_document document;
+
+  ASSERT_TRUE(document.root().is_null());
+  ASSERT_EQ(1, document.value_count());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestParseValues)
+{
+  const std::string str = "{"
+    "\"k1\": \"v1\","
+    "\"k2\": -42,"
+    "\"k3\": [\"a\", 123, true, false, null, 1.5e3]"
+  "}";
+
+  json_document document = parse_document(str);
+  json_view root = document.root();
+
+  ASSERT_TRUE(root.is_object());
+  ASSERT_EQ(3, root.size());
+
+  ASSERT_TRUE(root["k1"].is_string());
+  ASSERT_EQ("v1", root["k1"].string_value());
+  ASSERT_EQ(-42, root["k2"].int_value());
+  ASSERT_EQ(-42, root["k2"].number_value());
+
+  json_view items = root["k3"];
+
+  ASSERT_TRUE(items.is_array());
+  ASSERT_EQ(6, items.size());
+  ASSERT_EQ("a", items[0].string_value());
+  ASSERT_EQ(123, items[1].number_value());
+  ASSERT_EQ(true, items[2].bool_value());
+  ASSERT_EQ(false, items[3].bool_value());
+  ASSERT_TRUE(items[3].is_bool());
+  ASSERT_TRUE(items[4].is_null());
+  ASSERT_DOUBLE_EQ(1500.0, items[5].number_value());
+  ASSERT_EQ(1500, items[5].int_value());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestMissingValuesAreNull)
+{
+  json_document document = parse_document("{\"k\": [1, 2], \"s\": \"v\"}");
+  json_view root = document.root();
+
+  ASSERT_TRUE(root["missing"].is_null());
+  ASSERT_TRUE(root["k"][2].is_null());
+  ASSERT_TRUE(root["k"]["k"].is_null());
+  ASSERT_TRUE(root[0].is_null());
+  ASSERT_TRUE(root["missing"]["k"][0].is_null());
+
+  ASSERT_EQ(0, root["s"].size());
+  ASSERT_EQ(0, root["s"].number_value());
+  ASSERT_EQ(false, root["s"].bool_value());
+  ASSERT_EQ(std::string(), root["k"].string_value());
+  ASSERT_EQ(NULL, root["k"].string_data());
+  ASSERT_TRUE(root["s"].array_items().empty());
+  ASSERT_TRUE(root["k"].object_items().empty());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestObjectItemsAreSortedByKey)
+{
+  json_document document = parse_document(
+    "{\"b\": 2, \"c\": 3, \"a\": 1, \"ab\": 4, \"\": 0}");
+
+  std::vector<std::string> keys;
+  std::vector<int64_t> values;
+
+  for (const json_view::member member : document.root().object_items()) {
+    keys.push_back(member.first.string_value());
+    values.push_back(member.second.int_value());
+  }
+
+  ASSERT_EQ((std::vector<std::string> { "", "a", "ab", "b", "c" }), keys);
+  ASSERT_EQ((std::vector<int64_t> { 0, 1, 4, 2, 3 }), values);
+
+  auto itr = document.root().object_items().begin();
+  ASSERT_EQ(0, itr->first.string_size());
+  ++itr;
+  ASSERT_EQ("a", itr->first.string_value());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestDuplicateKeysKeepLastValue)
+{
+  const std::string str = "{\"k\": 1, \"j\": 2, \"k\": 3, \"k\": 4, \"j\": 5}";
+
+  json_document document = parse_document(str);
+  json_view root = document.root();
+
+  ASSERT_EQ(2, root.size());
+  ASSERT_EQ(4, root["k"].int_value());
+  ASSERT_EQ(5, root["j"].int_value());
+  ASSERT_EQ(parse(str), root.to_json());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestFindWithoutString)
+{
+  json_document document = parse_document("{\"key\": \"value\", \"k\\u0000\": 1}");
+  json_view root = document.root();
+
+  ASSERT_EQ("value", root.find("key", 3).string_value());
+  ASSERT_TRUE(root.find("ke", 2).is_null());
+  ASSERT_EQ(1, root.find("k\0", 2).int_value());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestArrayItems)
+{
+  json_document document = parse_document("[1, [2, 3], {\"k\": 4}, []]");
+
+  std::vector<JSON::Type> types;
+  for (const json_view item : document.root().array_items()) {
+    types.push_back(item.type());
+  }
+
+  ASSERT_EQ((std::vector<JSON::Type> {
+    JSON::NUMBER, JSON::ARRAY, JSON::OBJECT, JSON::ARRAY }), types);
+
+  ASSERT_EQ(4, document.root().array_items().size());
+  ASSERT_EQ(3, document.root()[1][1].int_value());
+  ASSERT_EQ(4, document.root()[2]["k"].int_value());
+  ASSERT_EQ(0, document.root()[3].size());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestParseUnicodeEscape)
+{
+  const std::string str =
+    R"([ "blah\ud83d\udca9blah\ud83dblah\udca9blah\u0000blah\u1234" ])";
+
+  const char utf8[] = "blah" "\xf0\x9f\x92\xa9" "blah" "\xed\xa0\xbd" "blah"
+                      "\xed\xb2\xa9" "blah" "\0" "blah" "\xe1\x88\xb4";
+
+  json_document document = parse_document(str);
+
+  ASSERT_EQ((sizeof utf8) - 1, document.root()[0].string_size());
+  ASSERT_EQ(0, memcmp(document.root()[0].string_data(), utf8, sizeof(utf8) - 1));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestUnescapedStringsAreAdjacent)
+{
+  json_document document = parse_document("[\"a\\nb\", \"c\\\"d\", \"\\\\\"]");
+  json_view root = document.root();
+
+  ASSERT_EQ("a\nb", root[0].string_value());
+  ASSERT_EQ("c\"d", root[1].string_value());
+  ASSERT_EQ("\\", root[2].string_value());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestIntegerLimits)
+{
+  std::stringstream ss;
+  ss << "[" << std::numeric_limits<int64_t>::max() << ", "
+     << std::numeric_limits<int64_t>::min() << ", 12345678901234567890]";
+
+  json_document document = parse_document(ss.str());
+  json_view root = document.root();
+
+  ASSERT_EQ(std::numeric_limits<int64_t>::max(), root[0].int_value());
+  ASSERT_EQ(std::numeric_limits<int64_t>::min(), root[1].int_value());
+  ASSERT_EQ(parse(ss.str()), root.to_json());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestViewsSurviveMove)
+{
+  json_document document = parse_document("{\"k\": [\"v\"]}");
+  json_view value = document.root()["k"][0];
+
+  json_document moved(std::move(document));
+
+  ASSERT_EQ("v", value.string_value());
+  ASSERT_EQ("v", moved.root()["k"][0].string_value());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestParityWithParse)
+{
+  std::mt19937 engine(7);
+
+  for (size_t i = 0; i < 500; ++i) {
+    const std::string str = "[" + generate_document(engine, 0) + "]";
+
+    const JSON expected = parse(str);
+    json_document document = parse_document(str);
+    json_document indexed_document = parse_indexed_document(str);
+
+    ASSERT_EQ(expected, document.root().to_json()) << str;
+    ASSERT_EQ(expected.dump(), document.root().to_json().dump()) << str;
+    ASSERT_EQ(expected.dump(), indexed_document.root().to_json().dump()) << str;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestParityOnMutatedDocuments)
+{
+  const char CHARACTERS[] = "{}[]:,\" \\0123456789.eE+-tfnrulsa";
+
+  std::mt19937 engine(13);
+
+  for (size_t i = 0; i < 3000; ++i) {
+    std::string str = "[" + generate_document(engine, 0) + "]";
+
+    const size_t mutations = 1 + engine() % 3;
+    for (size_t j = 0; j < mutations && !str.empty(); ++j) {
+      const size_t position = engine() % str.size();
+      const char ch = CHARACTERS[engine() % (sizeof(CHARACTERS) - 1)];
+
+      switch (engine() % 3) {
+        case 0:
+          str.erase(position, 1);
+          break;
+        case 1:
+          str.insert(position, 1, ch);
+          break;
+        default:
+          str[position] = ch;
+          break;
+      }
+    }
+
+    std::string expected;
+    try {
+      expected = parse(str).dump();
+    } catch (const invalid_json_error&) {
+      expected = "invalid";
+    }
+
+    std::string actual;
+    try {
+      actual = parse_document(str).root().to_json().dump();
+    } catch (const invalid_json_error&) {
+      actual = "invalid";
+    }
+
+    std::string indexed_actual;
+    try {
+      indexed_actual = parse_indexed_document(str).root().to_json().dump();
+    } catch (const invalid_json_error&) {
+      indexed_actual = "invalid";
+    }
+
+    ASSERT_EQ(expected, actual) << str;
+    ASSERT_EQ(expected, indexed_actual) << str;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestIndexedParseAcrossBlocks)
+{
+  // Shifts strings with escape sequences across the boundaries of the blocks
+  // classified by the first stage.
+  for (size_t padding = 0; padding < 140; ++padding) {
+    const std::string str = "{\"" + std::string(padding, 'k') + "\": [" +
+      std::string(padding, ' ') + "\"\\\\\\\"x\\u00e9\", -1.5e-3, true, null, " +
+      "{\"\\n\": [123456789]}]}";
+
+    const JSON expected = parse(str);
+
+    ASSERT_EQ(expected.dump(), parse_indexed_document(str).root().to_json().dump())
+      << str;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestInvalidDocuments)
+{
+  const std::vector<std::string> invalid_documents {
+    "This is an invalid JSON.",
+    "[TRUE]",
+    "{}{}{}",
+    "[{]]",
+    "{\"hello\" \"world\"}",
+    "{[1,2,3]}    ",
+    "",
+    "   ",
+    "\"string\"",
+    "42",
+    "[01]",
+    "[1.]",
+    "[1e]",
+    "[-]",
+    "[\"abc]",
+    "[\"\\x\"]",
+    "[\"\\u12\"]",
+    "[\"\t\"]",
+    "[1, 2",
+    "{\"k\": 1,}",
+    "[nul]",
+    "[tru",
+    "[truex]",
+    "[1x]",
+    "[1 2]",
+    "[\"a\" \"b\"]",
+    "{\"a\" 1}",
+    "[\"a\"1]",
+    "[1.5.3]",
+    "[--1]",
+    "[\x01]",
+    "[1]]",
+    "{\"k\": }",
+  };
+
+  for (const auto& str : invalid_documents) {
+    std::string expected;
+    try {
+      parse(str);
+    } catch (const invalid_json_error& err) {
+      expected = err.what();
+    }
+
+    ASSERT_FALSE(expected.empty()) << str;
+
+    std::string actual;
+    try {
+      parse_document(str);
+    } catch (const invalid_json_error& err) {
+      actual = err.what();
+    }
+
+    ASSERT_EQ(expected, actual) << str;
+
+    ASSERT_THROW(
+      {
+        parse_indexed_document(str);
+      },
+      invalid_json_error
+    ) << str;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_document_unittest, TestMaximumDepth)
+{
+  const std::string shallow = std::string(200, '[') + std::string(200, ']');
+  const std::string deep = std::string(202, '[') + std::string(202, ']');
+
+  ASSERT_EQ(parse(shallow), parse_document(shallow).root().to_json());
+
+  ASSERT_THROW(
+    {
+      parse_document(deep);
+    },
+    invalid_json_error
+  );
+
+  ASSERT_EQ(parse(shallow), parse_indexed_document(shallow).root().to_json());
+
+  ASSERT_THROW(
+    {
+      parse_indexed_document(deep);
+    },
+    invalid_json_error
+  );
+}
+
+// -----------------------------------------------------------------------------
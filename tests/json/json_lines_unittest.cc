@@ -0,0 +1,410 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit tests for definitions defined in sneaker/json/json_lines.h */
+
+#include "json/json_lines.h"
+
+#include "io/input_stream.h"
+#include "json/json.h"
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+using namespace sneaker::json;
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Yields the input in chunks of cycling sizes out of a single buffer, which
+ * is overwritten on every read like the buffers of file streams are.
+ */
+class varying_chunk_stream : public sneaker::io::input_stream
+{
+public:
+  varying_chunk_stream(const std::string& str,
+    const std::vector<size_t>& chunk_sizes)
+    :
+    m_str(str),
+    m_chunk_sizes(chunk_sizes),
+    m_offset(0),
+    m_chunk(0),
+    m_buffer()
+  {
+    // Do nothing here.
+  }
+
+  virtual bool next(const uint8_t** data, size_t* len)
+  {
+    if (m_offset == m_str.size()) {
+      return false;
+    }
+
+    const size_t chunk_size = m_chunk_sizes[m_chunk++ % m_chunk_sizes.size()];
+    const size_t size = std::min(chunk_size, m_str.size() - m_offset);
+
+    m_buffer.assign(m_str, m_offset, size);
+    m_offset += size;
+
+    *data = reinterpret_cast<const uint8_t*>(m_buffer.data());
+    *len = size;
+
+    return true;
+  }
+
+  virtual void skip(size_t len)
+  {
+    m_offset += std::min(len, m_str.size() - m_offset);
+  }
+
+  virtual size_t bytes_read() const
+  {
+    return m_offset;
+  }
+
+private:
+  const std::string& m_str;
+  std::vector<size_t> m_chunk_sizes;
+  size_t m_offset;
+  size_t m_chunk;
+  std::string m_buffer;
+};
+
+// -----------------------------------------------------------------------------
+
+class json_lines_unittest : public ::testing::Test {
+protected:
+  typedef std::vector<std::pair<size_t, std::string>> line_list;
+
+  /**
+   * Generates records, every tenth of which is invalid.
+   */
+  std::string generate_lines(size_t count) const
+  {
+    std::string str;
+
+    for (size_t i = 0; i < count; ++i) {
+      if (i % 10 == 9) {
+        str += "{\"id\": " + std::to_string(i) + ",\n";
+      } else {
+        str += "{\"id\": " + std::to_string(i) + ", \"tags\": [\"t" +
+          std::string(i % 50, 'x') + "\"]}\n";
+      }
+    }
+
+    return str;
+  }
+
+  /**
+   * Reads the input with the specified reader from a stream of chunks of the
+   * specified size, and gets the dumps of its records and the messages of
+   * its errors by line number.
+   */
+  json_lines_reader::summary read(const json_lines_reader& reader,
+    const std::string& str, size_t chunk_size, line_list* records,
+    line_list* errors) const
+  {
+    std::istringstream input(str);
+    std::unique_ptr<sneaker::io::input_stream> stream =
+      sneaker::io::istream_input_stream(input, chunk_size);
+
+    std::mutex mutex;
+
+    const json_lines_reader::summary summary = reader.read(stream.get(),
+      [&](size_t line_number, JSON& record) {
+        std::lock_guard<std::mutex> lock(mutex);
+        records->push_back(std::make_pair(line_number, record.dump()));
+      },
+      [&](size_t line_number, const std::string& message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        errors->push_back(std::make_pair(line_number, message));
+      }
+    );
+
+    return summary;
+  }
+
+  /**
+   * Parses the lines of the input one by one.
+   */
+  void read_serially(const std::string& str, line_list* records,
+    line_list* errors) const
+  {
+    std::istringstream input(str);
+    std::string line;
+
+    for (size_t line_number = 1; std::getline(input, line); ++line_number) {
+      if (line.find_first_not_of(" \t\r") == std::string::npos) {
+        continue;
+      }
+
+      try {
+        records->push_back(std::make_pair(line_number, parse(line).dump()));
+      } catch (const invalid_json_error& err) {
+        errors->push_back(std::make_pair(line_number, err.what()));
+      }
+    }
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_lines_unittest, TestDefaultThreadCount)
+{
+  json_lines_reader reader;
+
+  ASSERT_LT(0, reader.thread_count());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_lines_unittest, TestOrderedDelivery)
+{
+  const std::string str = generate_lines(2000);
+
+  line_list expected_records;
+  line_list expected_errors;
+  read_serially(str, &expected_records, &expected_errors);
+
+  for (size_t block_size : { 1, 100, 4096, 1 << 20 }) {
+    for (size_t chunk_size : { 7, 1000, 1 << 20 }) {
+      const json_lines_reader reader(4, json_lines_reader::delivery::ORDERED,
+        block_size);
+
+      line_list records;
+      line_list errors;
+      const json_lines_reader::summary summary =
+        read(reader, str, chunk_size, &records, &errors);
+
+      ASSERT_EQ(expected_records, records);
+      ASSERT_EQ(expected_errors, errors);
+
+      ASSERT_EQ(2000, summary.line_count);
+      ASSERT_EQ(1800, summary.record_count);
+      ASSERT_EQ(200, summary.error_count);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_lines_unittest, TestVaryingChunkSizes)
+{
+  const std::string str = generate_lines(2000);
+
+  line_list expected_records;
+  line_list expected_errors;
+  read_serially(str, &expected_records, &expected_errors);
+
+  // Partial lines gathered from small chunks are completed from the chunks
+  // parsed in place that follow them.
+  const std::vector<size_t> chunk_sizes { 7, 5000, 13, 1, 20000, 300 };
+
+  for (auto order : { json_lines_reader::delivery::ORDERED,
+    json_lines_reader::delivery::UNORDERED })
+  {
+    const json_lines_reader reader(3, order, 1024);
+
+    varying_chunk_stream stream(str, chunk_sizes);
+
+    std::mutex mutex;
+    line_list records;
+    line_list errors;
+
+    const json_lines_reader::summary summary = reader.read(&stream,
+      [&](size_t line_number, JSON& record) {
+        std::lock_guard<std::mutex> lock(mutex);
+        records.push_back(std::make_pair(line_number, record.dump()));
+      },
+      [&](size_t line_number, const std::string& message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        errors.push_back(std::make_pair(line_number, message));
+      }
+    );
+
+    std::sort(records.begin(), records.end());
+    std::sort(errors.begin(), errors.end());
+
+    ASSERT_EQ(expected_records, records);
+    ASSERT_EQ(expected_errors, errors);
+
+    ASSERT_EQ(2000, summary.line_count);
+    ASSERT_EQ(1800, summary.record_count);
+    ASSERT_EQ(200, summary.error_count);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_lines_unittest, TestUnorderedDelivery)
+{
+  const std::string str = generate_lines(2000);
+
+  line_list expected_records;
+  line_list expected_errors;
+  read_serially(str, &expected_records, &expected_errors);
+
+  const json_lines_reader reader(4, json_lines_reader::delivery::UNORDERED,
+    4096);
+
+  line_list records;
+  line_list errors;
+  const json_lines_reader::summary summary =
+    read(reader, str, 1000, &records, &errors);
+
+  std::sort(records.begin(), records.end());
+  std::sort(errors.begin(), errors.end());
+
+  ASSERT_EQ(expected_records, records);
+  ASSERT_EQ(expected_errors, errors);
+
+  ASSERT_EQ(1800, summary.record_count);
+  ASSERT_EQ(200, summary.error_count);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_lines_unittest, TestThrowingCallback)
+{
+  const std::string str = generate_lines(20000);
+
+  const json_lines_reader reader(3, json_lines_reader::delivery::ORDERED,
+    4096);
+
+  std::istringstream input(str);
+  std::unique_ptr<sneaker::io::input_stream> stream =
+    sneaker::io::istream_input_stream(input, 1000);
+
+  // The threads still parsing stop rather than wait for the records to be
+  // delivered.
+  ASSERT_THROW(
+    {
+      reader.read(stream.get(),
+        [](size_t line_number, JSON&) {
+          if (line_number == 1001) {
+            throw std::runtime_error("stop");
+          }
+        },
+        [](size_t, const std::string&) {}
+      );
+    },
+    std::runtime_error
+  );
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_lines_unittest, TestBlankLinesAndCarriageReturns)
+{
+  const std::string str = "\n{\"a\": 1}\r\n  \n\t\r\n[2, 3]\r\n{\"b\": x}\n[4]";
+
+  const json_lines_reader reader(2, json_lines_reader::delivery::ORDERED, 8);
+
+  line_list records;
+  line_list errors;
+  const json_lines_reader::summary summary =
+    read(reader, str, 3, &records, &errors);
+
+  ASSERT_EQ(
+    (line_list {
+      { 2, parse("{\"a\": 1}").dump() },
+      { 5, parse("[2, 3]").dump() },
+      { 7, parse("[4]").dump() }
+    }),
+    records
+  );
+
+  ASSERT_EQ(1, errors.size());
+  ASSERT_EQ(6, errors[0].first);
+
+  ASSERT_EQ(7, summary.line_count);
+  ASSERT_EQ(3, summary.record_count);
+  ASSERT_EQ(1, summary.error_count);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_lines_unittest, TestEmptyInput)
+{
+  const json_lines_reader reader(2);
+
+  line_list records;
+  line_list errors;
+  const json_lines_reader::summary summary =
+    read(reader, "", 16, &records, &errors);
+
+  ASSERT_TRUE(records.empty());
+  ASSERT_TRUE(errors.empty());
+  ASSERT_EQ(0, summary.line_count);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_lines_unittest, TestReadFile)
+{
+  const char* const FILEPATH = "tmp_json_lines.jsonl";
+
+  const std::string str = generate_lines(500);
+
+  {
+    std::ofstream file(FILEPATH);
+    file << str;
+  }
+
+  line_list expected_records;
+  line_list expected_errors;
+  read_serially(str, &expected_records, &expected_errors);
+
+  const json_lines_reader reader(3, json_lines_reader::delivery::ORDERED,
+    1024);
+
+  line_list records;
+  line_list errors;
+  reader.read_file(FILEPATH,
+    [&](size_t line_number, JSON& record) {
+      records.push_back(std::make_pair(line_number, record.dump()));
+    },
+    [&](size_t line_number, const std::string& message) {
+      errors.push_back(std::make_pair(line_number, message));
+    }
+  );
+
+  remove(FILEPATH);
+
+  ASSERT_EQ(expected_records, records);
+  ASSERT_EQ(expected_errors, errors);
+}
+
+// -----------------------------------------------------------------------------
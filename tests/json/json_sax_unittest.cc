@@ -0,0 +1,637 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit tests for definitions defined in sneaker/json/json_sax.h */
+
+#include "json/json_sax.h"
+
+#include "io/input_stream.h"
+#include "json/json.h"
+#include "testing/testing.h"
+
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+using namespace sneaker::json;
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/**
+ * Builds a `JSON` out of the events it receives, for every top-level value.
+ */
+class dom_handler : public json_sax_handler
+{
+public:
+  virtual void start_object()
+  {
+    m_frames.push_back(frame());
+    m_frames.back().is_object = true;
+  }
+
+  virtual void end_object()
+  {
+    JSON::object members = std::move(m_frames.back().members);
+    m_frames.pop_back();
+    add(JSON(std::move(members)));
+  }
+
+  virtual void start_array()
+  {
+    m_frames.push_back(frame());
+    m_frames.back().is_object = false;
+  }
+
+  virtual void end_array()
+  {
+    JSON::array items = std::move(m_frames.back().items);
+    m_frames.pop_back();
+    add(JSON(std::move(items)));
+  }
+
+  virtual void key(const char* data, size_t size)
+  {
+    m_frames.back().key.assign(data, size);
+  }
+
+  virtual void string_value(const char* data, size_t size)
+  {
+    add(JSON(std::string(data, size)));
+  }
+
+  virtual void int_value(int64_t value)
+  {
+    add(JSON::from_int64(value));
+  }
+
+  virtual void number_value(double value)
+  {
+    add(JSON(value));
+  }
+
+  virtual void bool_value(bool value)
+  {
+    add(JSON(value));
+  }
+
+  virtual void null_value()
+  {
+    add(JSON());
+  }
+
+  std::vector<JSON> values;
+
+private:
+  struct frame
+  {
+    bool is_object;
+    JSON::array items;
+    JSON::object members;
+    std::string key;
+  };
+
+  void add(JSON&& value)
+  {
+    if (m_frames.empty()) {
+      values.push_back(std::move(value));
+    } else if (m_frames.back().is_object) {
+      m_frames.back().members[m_frames.back().key] = std::move(value);
+    } else {
+      m_frames.back().items.push_back(std::move(value));
+    }
+  }
+
+  std::vector<frame> m_frames;
+};
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Records the events it receives as text.
+ */
+class event_handler : public json_sax_handler
+{
+public:
+  virtual void start_object() { events += "{ "; }
+  virtual void end_object() { events += "} "; }
+  virtual void start_array() { events += "[ "; }
+  virtual void end_array() { events += "] "; }
+
+  virtual void key(const char* data, size_t size)
+  {
+    events += "key:" + std::string(data, size) + " ";
+  }
+
+  virtual void string_value(const char* data, size_t size)
+  {
+    events += "string:" + std::string(data, size) + " ";
+  }
+
+  virtual void int_value(int64_t value)
+  {
+    events += "int:" + std::to_string(value) + " ";
+  }
+
+  virtual void number_value(double value)
+  {
+    events += "number:" + std::to_string(value) + " ";
+  }
+
+  virtual void bool_value(bool value)
+  {
+    events += value ? "true " : "false ";
+  }
+
+  virtual void null_value() { events += "null "; }
+
+  std::string events;
+};
+
+} /* anonymous namespace */
+
+// -----------------------------------------------------------------------------
+
+class json_sax_unittest : public ::testing::Test {
+protected:
+  /**
+   * Parses the input in chunks of the specified size, and gets the values
+   * built out of the events.
+   */
+  std::vector<JSON> parse_in_chunks(const std::string& str, size_t chunk_size,
+    bool multiple_values=false) const
+  {
+    dom_handler handler;
+    json_sax_parser parser(&handler, multiple_values);
+
+    for (size_t i = 0; i < str.size(); i += chunk_size) {
+      // Copies every chunk, so that bytes kept across chunks are detected.
+      const std::string chunk = str.substr(i, chunk_size);
+      parser.feed(chunk.data(), chunk.size());
+    }
+
+    parser.finish();
+
+    return handler.values;
+  }
+
+  /**
+   * Generates a random document with nested containers, duplicate keys and
+   * strings with escape sequences.
+   */
+  std::string generate_document(std::mt19937& engine, uint32_t depth) const
+  {
+    std::uniform_int_distribution<uint32_t> kinds(0, depth < 4 ? 7 : 5);
+    std::uniform_int_distribution<uint32_t> sizes(0, 6);
+
+    switch (kinds(engine)) {
+      case 0:
+        return "null";
+      case 1:
+        return (engine() % 2) ? "true" : "false";
+      case 2:
+        return std::to_string(static_cast<int64_t>(engine()) - 0x7fffffff);
+      case 3:
+        {
+          std::ostringstream stream;
+          stream.precision(17);
+          stream << std::uniform_real_distribution<double>(-1e6, 1e6)(engine);
+          return stream.str();
+        }
+      case 4:
+      case 5:
+        return generate_string(engine);
+      case 6:
+        {
+          std::string out = "[";
+          const uint32_t size = sizes(engine);
+          for (uint32_t i = 0; i < size; ++i) {
+            out += (i ? ", " : "") + generate_document(engine, depth + 1);
+          }
+          return out + "]";
+        }
+      default:
+        {
+          std::string out = "{";
+          const uint32_t size = sizes(engine);
+          for (uint32_t i = 0; i < size; ++i) {
+            out += (i ? ", " : "") + generate_string(engine) + ": " +
+              generate_document(engine, depth + 1);
+          }
+          return out + "}";
+        }
+    }
+  }
+
+  std::string generate_string(std::mt19937& engine) const
+  {
+    static const char* const PIECES[] = {
+      "a", "b", "key", "\\n", "\\\"", "\\\\", "\\/", "\\t", "\\u00e9",
+      "\\ud83d\\udca9", "\\ud83d", "\\u0000", "\xe3\x81\x82", " "
+    };
+
+    const size_t count = sizeof(PIECES) / sizeof(PIECES[0]);
+
+    std::string out = "\"";
+    const uint32_t size = engine() % 5;
+    for (uint32_t i = 0; i < size; ++i) {
+      out += PIECES[engine() % count];
+    }
+
+    return out + "\"";
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_sax_unittest, TestEvents)
+{
+  event_handler handler;
+  json_sax_parser parser(&handler);
+
+  const std::string str =
+    "{\"k1\": [1, -2.5, true, false, null], \"k2\": {\"a\\nb\": \"v\"}}";
+
+  parser.feed(str.data(), str.size());
+  parser.finish();
+
+  ASSERT_EQ(
+    "{ key:k1 [ int:1 number:-2.500000 true false null ] "
+    "key:k2 { key:a\nb string:v } } ",
+    handler.events
+  );
+
+  ASSERT_EQ(str.size(), parser.bytes_parsed());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_sax_unittest, TestDefaultHandlerIgnoresEvents)
+{
+  json_sax_handler handler;
+  json_sax_parser parser(&handler);
+
+  const std::string str = "[1, \"a\", {\"b\": null}]";
+
+  parser.feed(str.data(), str.size());
+  parser.finish();
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_sax_unittest, TestParityWithParse)
+{
+  std::mt19937 engine(17);
+
+  for (size_t i = 0; i < 300; ++i) {
+    const std::string str = "[" + generate_document(engine, 0) + "]";
+    const JSON expected = parse(str);
+
+    for (size_t chunk_size : { 1, 2, 3, 7, 64, 4096 }) {
+      const std::vector<JSON> values = parse_in_chunks(str, chunk_size);
+
+      ASSERT_EQ(1, values.size());
+      ASSERT_EQ(expected.dump(), values[0].dump()) << str;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_sax_unittest, TestParityOnMutatedDocuments)
+{
+  const char CHARACTERS[] = "{}[]:,\" \\0123456789.eE+-tfnrulsa";
+
+  std::mt19937 engine(19);
+
+  for (size_t i = 0; i < 3000; ++i) {
+    std::string str = "[" + generate_document(engine, 0) + "]";
+
+    const size_t mutations = 1 + engine() % 3;
+    for (size_t j = 0; j < mutations && !str.empty(); ++j) {
+      const size_t position = engine() % str.size();
+      const char ch = CHARACTERS[engine() % (sizeof(CHARACTERS) - 1)];
+
+      switch (engine() % 3) {
+        case 0:
+          str.erase(position, 1);
+          break;
+        case 1:
+          str.insert(position, 1, ch);
+          break;
+        default:
+          str[position] = ch;
+          break;
+      }
+    }
+
+    std::string expected;
+    try {
+      expected = parse(str).dump();
+    } catch (const invalid_json_error&) {
+      expected = "invalid";
+    }
+
+    for (size_t chunk_size : { 1, 5, 4096 }) {
+      std::string actual;
+      try {
+        actual = parse_in_chunks(str, chunk_size)[0].dump();
+      } catch (const invalid_json_error&) {
+        actual = "invalid";
+      }
+
+      ASSERT_EQ(expected, actual) << str;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_sax_unittest, TestStringsAcrossChunks)
+{
+  const std::string str =
+    "[\"abc\\u00e9\\ud83d\\udca9\\ud83dx\\\"\\\\\\/\\b\\f\\n\\r\\t\xe3\x81\x82"
+    "def\", \"\", {\"key\\n\": \"value\"}]";
+
+  const JSON expected = parse(str);
+
+  for (size_t chunk_size = 1; chunk_size <= str.size(); ++chunk_size) {
+    const std::vector<JSON> values = parse_in_chunks(str, chunk_size);
+
+    ASSERT_EQ(1, values.size());
+    ASSERT_EQ(expected, values[0]) << chunk_size;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_sax_unittest, TestStringsInPlace)
+{
+  class pointer_handler : public json_sax_handler
+  {
+  public:
+    virtual void string_value(const char* data, size_t)
+    {
+      pointers.push_back(data);
+    }
+
+    std::vector<const char*> pointers;
+  };
+
+  pointer_handler handler;
+  json_sax_parser parser(&handler);
+
+  const std::string str = "[\"abc\", \"d\\ne\", \"fgh\"]";
+
+  parser.feed(str.data(), 18);
+  parser.feed(str.data() + 18, str.size() - 18);
+  parser.finish();
+
+  ASSERT_EQ(3, handler.pointers.size());
+
+  // The first string is reported in place, and the others are copied since
+  // they contain an escape sequence or straddle both chunks.
+  ASSERT_EQ(str.data() + 2, handler.pointers[0]);
+  ASSERT_NE(str.data() + 9, handler.pointers[1]);
+  ASSERT_NE(str.data() + 17, handler.pointers[2]);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_sax_unittest, TestNumbersAcrossChunks)
+{
+  const std::string str =
+    "[0, -0, 12345, -9876543210, 1.5e-3, -0.25E+2, 1e5, 123456789012345678, "
+    "1234567890123456789, -123456789012345678]";
+
+  const JSON expected = parse(str);
+
+  for (size_t chunk_size = 1; chunk_size <= str.size(); ++chunk_size) {
+    const std::vector<JSON> values = parse_in_chunks(str, chunk_size);
+
+    ASSERT_EQ(1, values.size());
+    ASSERT_EQ(expected.dump(), values[0].dump()) << chunk_size;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_sax_unittest, TestMultipleValues)
+{
+  const std::string str =
+    "{\"id\": 1}\n{\"id\": 2, \"tags\": [\"a\"]}\n\n[3]\n  {}";
+
+  for (size_t chunk_size : { 1, 4, 4096 }) {
+    const std::vector<JSON> values = parse_in_chunks(str, chunk_size, true);
+
+    ASSERT_EQ(4, values.size());
+    ASSERT_EQ(parse("{\"id\": 1}"), values[0]);
+    ASSERT_EQ(parse("{\"id\": 2, \"tags\": [\"a\"]}"), values[1]);
+    ASSERT_EQ(parse("[3]"), values[2]);
+    ASSERT_EQ(parse("{}"), values[3]);
+  }
+
+  ASSERT_TRUE(parse_in_chunks("", 1, true).empty());
+  ASSERT_TRUE(parse_in_chunks(" \n ", 1, true).empty());
+
+  ASSERT_THROW(
+    {
+      parse_in_chunks("{}\n{", 1, true);
+    },
+    invalid_json_error
+  );
+
+  ASSERT_THROW(
+    {
+      parse_in_chunks("{}\n42", 1, true);
+    },
+    invalid_json_error
+  );
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_sax_unittest, TestParseFromInputStream)
+{
+  std::mt19937 engine(23);
+
+  const std::string str = "[" + generate_document(engine, 0) + ", " +
+    generate_document(engine, 0) + "]";
+
+  {
+    dom_handler handler;
+    std::unique_ptr<sneaker::io::input_stream> stream =
+      sneaker::io::memory_input_stream(
+        reinterpret_cast<const uint8_t*>(str.data()), str.size());
+
+    parse_sax(stream.get(), &handler);
+
+    ASSERT_EQ(1, handler.values.size());
+    ASSERT_EQ(parse(str), handler.values[0]);
+  }
+
+  {
+    dom_handler handler;
+    std::istringstream input(str + "\n" + str);
+    std::unique_ptr<sneaker::io::input_stream> stream =
+      sneaker::io::istream_input_stream(input, 3);
+
+    parse_sax(stream.get(), &handler, true);
+
+    ASSERT_EQ(2, handler.values.size());
+    ASSERT_EQ(parse(str), handler.values[0]);
+    ASSERT_EQ(parse(str), handler.values[1]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_sax_unittest, TestInvalidDocuments)
+{
+  const std::vector<std::string> invalid_documents {
+    "This is an invalid JSON.",
+    "[TRUE]",
+    "{}{}{}",
+    "[{]]",
+    "{\"hello\" \"world\"}",
+    "{[1,2,3]}    ",
+    "[01]",
+    "[1.5.3]",
+    "[--1]",
+    "[\"\\x\"]",
+    "[\"\t\"]",
+    "{\"k\": 1,}",
+    "[1x]",
+    "[1 2]",
+    "{\"a\" 1}",
+    "[\x01]",
+    "[1]]",
+    "{\"k\": }",
+  };
+
+  for (const auto& str : invalid_documents) {
+    std::string expected;
+    try {
+      parse(str);
+    } catch (const invalid_json_error& err) {
+      expected = err.what();
+    }
+
+    ASSERT_FALSE(expected.empty()) << str;
+
+    for (size_t chunk_size : { 1, 4096 }) {
+      std::string actual;
+      try {
+        parse_in_chunks(str, chunk_size);
+      } catch (const invalid_json_error& err) {
+        actual = err.what();
+      }
+
+      ASSERT_EQ(expected, actual) << str;
+    }
+  }
+
+  // Inputs that end early, or do not start with a container, are rejected
+  // as soon as that is known.
+  const std::vector<std::string> truncated_documents {
+    "", "   ", "\"string\"", "42", "[1.]", "[1e]", "[-]", "[\"abc]",
+    "[\"\\u12\"]", "[1, 2", "[nul]", "[tru", "[truex]",
+  };
+
+  for (const auto& str : truncated_documents) {
+    ASSERT_THROW(
+      {
+        parse(str);
+      },
+      invalid_json_error
+    ) << str;
+
+    ASSERT_THROW(
+      {
+        parse_in_chunks(str, 1);
+      },
+      invalid_json_error
+    ) << str;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_sax_unittest, TestErrorsPersistUntilReset)
+{
+  json_sax_handler handler;
+  json_sax_parser parser(&handler);
+
+  ASSERT_THROW(
+    {
+      parser.feed("[1,,", 4);
+    },
+    invalid_json_error
+  );
+
+  ASSERT_THROW(
+    {
+      parser.feed("2]", 2);
+    },
+    invalid_json_error
+  );
+
+  ASSERT_THROW(
+    {
+      parser.finish();
+    },
+    invalid_json_error
+  );
+
+  parser.reset();
+
+  parser.feed("[1, 2]", 6);
+  parser.finish();
+
+  ASSERT_EQ(6, parser.bytes_parsed());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_sax_unittest, TestMaximumDepth)
+{
+  const std::string shallow = std::string(200, '[') + std::string(200, ']');
+  const std::string deep = std::string(202, '[') + std::string(202, ']');
+
+  ASSERT_EQ(parse(shallow), parse_in_chunks(shallow, 7)[0]);
+
+  ASSERT_THROW(
+    {
+      parse_in_chunks(deep, 7);
+    },
+    invalid_json_error
+  );
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,238 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit tests for definitions defined in sneaker/json/json_structural_index.h */
+
+#include "json/json_structural_index.h"
+
+#include "json/json.h"
+#include "testing/testing.h"
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+using namespace sneaker::json;
+
+// -----------------------------------------------------------------------------
+
+class json_structural_index_unittest : public ::testing::Test {
+protected:
+  /**
+   * Indexes the input with both classifications, and checks that they
+   * agree.
+   */
+  std::vector<uint32_t> index(const std::string& str)
+  {
+    json_structural_index simd_index;
+    simd_index.build(str.data(), str.size(), true);
+
+    json_structural_index scalar_index;
+    scalar_index.build(str.data(), str.size(), false);
+
+    EXPECT_EQ(scalar_index.positions(), simd_index.positions());
+
+    return simd_index.positions();
+  }
+
+  /**
+   * Finds the positions of the input the slow way, character by character.
+   * Backslashes escape quotes outside of strings too, which only matters to
+   * invalid documents.
+   */
+  std::vector<uint32_t> reference_index(const std::string& str) const
+  {
+    std::vector<uint32_t> positions;
+
+    bool in_string = false;
+    bool in_scalar = false;
+
+    for (size_t i = 0; i < str.size(); ++i) {
+      const char ch = str[i];
+
+      if (in_string) {
+        if (ch == '\\') {
+          ++i;
+        } else if (ch == '"') {
+          positions.push_back(static_cast<uint32_t>(i));
+          in_string = false;
+        }
+        continue;
+      }
+
+      if (ch == '\\') {
+        if (!in_scalar) {
+          positions.push_back(static_cast<uint32_t>(i));
+          in_scalar = true;
+        }
+        if (i + 1 < str.size() && (str[i + 1] == '"' || str[i + 1] == '\\')) {
+          ++i;
+        }
+      } else if (ch == '"') {
+        positions.push_back(static_cast<uint32_t>(i));
+        in_string = true;
+        in_scalar = false;
+      } else if (std::string("{}[]:,").find(ch) != std::string::npos) {
+        positions.push_back(static_cast<uint32_t>(i));
+        in_scalar = false;
+      } else if (std::string(" \t\r\n").find(ch) != std::string::npos) {
+        in_scalar = false;
+      } else if (!in_scalar) {
+        positions.push_back(static_cast<uint32_t>(i));
+        in_scalar = true;
+      }
+    }
+
+    return positions;
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_structural_index_unittest, TestEmptyInput)
+{
+  ASSERT_TRUE(index("").empty());
+  ASSERT_TRUE(index("   \n\t").empty());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_structural_index_unittest, TestPositions)
+{
+  const std::string str = "{\"k\": [1, true, -2.5e3, \"a,b\"]}";
+
+  ASSERT_EQ((std::vector<uint32_t> { 0, 1, 3, 4, 6, 7, 8, 10, 14, 16, 22, 24,
+    28, 29, 30 }), index(str));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_structural_index_unittest, TestEscapedQuotes)
+{
+  const std::string str = "[\"a\\\"b\", \"\\\\\", \"\\\\\\\"\"]";
+
+  ASSERT_EQ(reference_index(str), index(str));
+  ASSERT_EQ(10, index(str).size());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_structural_index_unittest, TestStateAcrossBlocks)
+{
+  // Places runs of backslashes, and strings, across the boundaries of blocks.
+  for (size_t padding = 0; padding < 130; ++padding) {
+    for (size_t backslashes = 1; backslashes <= 4; ++backslashes) {
+      const std::string escapes = std::string(backslashes, '\\') +
+        ((backslashes % 2) ? "\"" : "");
+
+      const std::string str = "[" + std::string(padding, ' ') + "\"" +
+        std::string(padding, 'x') + escapes + "\", 12345, " +
+        std::string(padding, ' ') + "\"" + std::string(padding, '{') + "\"]";
+
+      ASSERT_EQ(reference_index(str), index(str)) << str;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_structural_index_unittest, TestRandomInputs)
+{
+  const char CHARACTERS[] = "{}[]:,  \"\\ab1-";
+
+  std::mt19937 engine(11);
+
+  for (size_t i = 0; i < 2000; ++i) {
+    std::string str(engine() % 300, ' ');
+    for (auto& ch : str) {
+      ch = CHARACTERS[engine() % (sizeof(CHARACTERS) - 1)];
+    }
+
+    const std::vector<uint32_t> expected = reference_index(str);
+
+    json_structural_index simd_index;
+    json_structural_index scalar_index;
+
+    try {
+      simd_index.build(str.data(), str.size(), true);
+    } catch (const invalid_json_error&) {
+      ASSERT_THROW(
+        {
+          scalar_index.build(str.data(), str.size(), false);
+        },
+        invalid_json_error
+      );
+      continue;
+    }
+
+    scalar_index.build(str.data(), str.size(), false);
+
+    ASSERT_EQ(expected, simd_index.positions()) << str;
+    ASSERT_EQ(expected, scalar_index.positions()) << str;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_structural_index_unittest, TestUnterminatedString)
+{
+  json_structural_index structural_index;
+
+  ASSERT_THROW(
+    {
+      structural_index.build("[\"abc]", 6);
+    },
+    invalid_json_error
+  );
+
+  ASSERT_THROW(
+    {
+      structural_index.build("[\"abc\\\"]", 8);
+    },
+    invalid_json_error
+  );
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_structural_index_unittest, TestControlCharacterInString)
+{
+  json_structural_index structural_index;
+
+  try {
+    structural_index.build("[\"a\tb\"]", 7);
+    FAIL();
+  } catch (const invalid_json_error& err) {
+    ASSERT_EQ(std::string("Unescaped (9) in string"), err.what());
+  }
+
+  // Control characters outside of strings are left to the second stage.
+  structural_index.build("[\x01]", 3);
+  ASSERT_EQ(3, structural_index.positions().size());
+}
+
+// -----------------------------------------------------------------------------
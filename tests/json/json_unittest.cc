@@ -32,8 +32,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <limits>
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -180,6 +182,31 @@ TEST_F(json_parse_unittest, TestMinInteger)
 
 // -----------------------------------------------------------------------------
 
+TEST_F(json_parse_unittest, TestParseRange)
+{
+  // The range is followed by characters that would change the result if it
+  // were read past its end.
+  const std::string str = "{\"k1\": [1.5e2, -42]}\n{\"k2\": 7}";
+  const size_t size = str.find('\n');
+
+  auto json = sneaker::json::parse(str.data(), size);
+
+  ASSERT_EQ(sneaker::json::parse(str.substr(0, size)), json);
+  ASSERT_EQ(150, json["k1"][0].number_value());
+  ASSERT_EQ(-42, json["k1"][1].int_value());
+
+  // Numbers that end the range are not continued past it.
+  const std::string numbers = "[12]34";
+  ASSERT_THROW(
+    {
+      sneaker::json::parse(numbers.data(), 3);
+    },
+    sneaker::json::invalid_json_error
+  );
+}
+
+// -----------------------------------------------------------------------------
+
 class json_parse_failure_unittest : public json_parse_unittest {
 protected:
   void parse_and_assert_error(const std::string& invalid_json, const std::string& expected_err) {
@@ -192,12 +219,29 @@ protected:
     );
 
     std::string err;
-    sneaker::json::json_parser parser { invalid_json, 0, err, false };
+    sneaker::json::json_parser parser { invalid_json, 0, err, false, nullptr };
 
     parser.parse_json();
 
     ASSERT_EQ(true, parser.failed);
     ASSERT_EQ(expected_err, parser.err);
+
+    // Parsing a range that is not null-terminated fails the same way.
+    const std::string padded = invalid_json + "1]}\"";
+    try {
+      sneaker::json::parse(padded.data(), invalid_json.size());
+      FAIL();
+    } catch (const sneaker::json::invalid_json_error& exc) {
+      ASSERT_EQ(expected_err, exc.what());
+    }
+
+    // Parsing into views of a shared input fails the same way.
+    try {
+      sneaker::json::parse(std::make_shared<const std::string>(invalid_json));
+      FAIL();
+    } catch (const sneaker::json::invalid_json_error& exc) {
+      ASSERT_EQ(expected_err, exc.what());
+    }
   }
 };
 
@@ -342,6 +386,150 @@ TEST_F(json_parse_failure_unittest, TestParseJsonWithInvalidEscapedString)
 
 // -----------------------------------------------------------------------------
 
+class json_shared_parse_unittest : public json_unittest {
+protected:
+  std::shared_ptr<const std::string> share(const std::string& str) const {
+    return std::make_shared<const std::string>(str);
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_shared_parse_unittest, TestStringView)
+{
+  const std::string str("ab\0c", 4);
+
+  const string_view view(str);
+
+  ASSERT_EQ(str.data(), view.data());
+  ASSERT_EQ(4, view.size());
+  ASSERT_FALSE(view.empty());
+  ASSERT_EQ('c', view[3]);
+  ASSERT_EQ(str, view.to_string());
+
+  ASSERT_TRUE(string_view().empty());
+  ASSERT_TRUE(string_view("ab", 2) < view);
+  ASSERT_TRUE(view < string_view("ac", 2));
+  ASSERT_TRUE(view != string_view("ab", 2));
+  ASSERT_TRUE(view == string_view(std::string(str)));
+  ASSERT_EQ(0, view.compare(str));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_shared_parse_unittest, TestParseMatchesCopyingParse)
+{
+  const std::string str =
+    "{\"k1\": \"v1\", \"k2\": [\"\", \"a\\\"b\", \"\\u00e9\\n\", 42, -1.5, true, "
+    "null, {\"k3\": \"\\ud83d\\ude00\"}], \"k4\": \"caf\xc3\xa9\"}";
+
+  const JSON expected = parse(str);
+  const JSON actual = parse(share(str));
+
+  ASSERT_EQ(expected.dump(), actual.dump());
+  ASSERT_TRUE(expected == actual);
+  ASSERT_TRUE(actual == expected);
+  ASSERT_FALSE(expected < actual);
+  ASSERT_FALSE(actual < expected);
+
+  ASSERT_EQ("a\"b", actual["k2"][1].string_value());
+  ASSERT_EQ("\xc3\xa9\n", actual["k2"][2].string_value());
+  ASSERT_EQ("\xf0\x9f\x98\x80", actual["k2"][7]["k3"].string_value());
+  ASSERT_EQ("caf\xc3\xa9", actual["k4"].string_value());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_shared_parse_unittest, TestUnescapedStringsAreNotCopied)
+{
+  const auto source = share("[\"abc\", \"de\\tf\", \"\"]");
+  const char* begin = source->data();
+  const char* end = begin + source->size();
+
+  const JSON json = parse(source);
+
+  const string_view abc = json[0].string_view_value();
+  ASSERT_EQ("abc", abc.to_string());
+  ASSERT_TRUE(abc.data() >= begin && abc.data() < end);
+  ASSERT_EQ(abc.data(), json[0].string_view_value().data());
+
+  const string_view def = json[1].string_view_value();
+  ASSERT_EQ("de\tf", def.to_string());
+  ASSERT_FALSE(def.data() >= begin && def.data() < end);
+  ASSERT_EQ(def.data(), json[1].string_view_value().data());
+
+  ASSERT_TRUE(json[2].string_view_value().empty());
+  ASSERT_EQ("", json[2].string_value());
+
+  ASSERT_TRUE(JSON(1).string_view_value().empty());
+  ASSERT_EQ("xyz", JSON("xyz").string_view_value().to_string());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_shared_parse_unittest, TestComparisonsWithOwnedStrings)
+{
+  const JSON json = parse(share("[\"b\", \"\\u0062\", \"a\\u0062\"]"));
+
+  ASSERT_TRUE(json[0] == JSON("b"));
+  ASSERT_TRUE(JSON("b") == json[0]);
+  ASSERT_TRUE(json[1] == JSON("b"));
+  ASSERT_TRUE(json[0] == json[1]);
+  ASSERT_TRUE(json[2] < json[0]);
+  ASSERT_TRUE(JSON("a") < json[2]);
+  ASSERT_TRUE(json[0] < JSON("c"));
+  ASSERT_TRUE(json[0] != JSON(1));
+
+  std::set<JSON> set { json[0], json[1], json[2], JSON("b"), JSON("ab") };
+  ASSERT_EQ(2, set.size());
+  ASSERT_EQ("ab", set.begin()->string_value());
+
+  std::map<JSON, int> map { { json[2], 1 } };
+  ASSERT_EQ(1, map[JSON("ab")]);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_shared_parse_unittest, TestValuesOutliveSource)
+{
+  JSON json;
+
+  {
+    auto source = share("{\"key\": [\"value\", \"esc\\/aped\"]}");
+    json = parse(source);
+  }
+
+  ASSERT_EQ("value", json["key"][0].string_value());
+  ASSERT_EQ("esc/aped", json["key"][1].string_view_value().to_string());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_shared_parse_unittest, TestConcurrentAccess)
+{
+  const JSON json = parse(share("[\"a\\nb\", \"cd\"]"));
+
+  std::vector<std::thread> threads;
+  std::vector<std::string> values(8);
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    threads.emplace_back([&json, &values, i]() {
+      values[i] = (i % 2 ? json[0].string_value() :
+        json[0].string_view_value().to_string()) + json[1].string_value();
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& value : values) {
+    ASSERT_EQ("a\nbcd", value);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 class json_serialization_unittest : public json_unittest {
 public:
   class Point {
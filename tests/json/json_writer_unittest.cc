@@ -0,0 +1,368 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit tests for definitions defined in sneaker/json/json_writer.h */
+
+#include "json/json_writer.h"
+
+#include "io/output_stream.h"
+#include "json/json.h"
+#include "testing/testing.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+using namespace sneaker::json;
+
+// -----------------------------------------------------------------------------
+
+class json_writer_unittest : public ::testing::Test {
+protected:
+  /**
+   * An output stream of a fixed number of buffers of the specified size.
+   */
+  class limited_output_stream : public sneaker::io::output_stream
+  {
+  public:
+    limited_output_stream(size_t buffer_count, size_t buffer_size)
+      :
+      m_buffers(buffer_count, std::vector<uint8_t>(buffer_size)),
+      m_used(0),
+      m_backed_up(0)
+    {
+    }
+
+    virtual bool next(uint8_t** data, size_t* len)
+    {
+      if (m_used == m_buffers.size()) {
+        return false;
+      }
+
+      *data = m_buffers[m_used].data();
+      *len = m_buffers[m_used].size();
+      ++m_used;
+      m_backed_up = 0;
+
+      return true;
+    }
+
+    virtual size_t bytes_written() const
+    {
+      return 0;
+    }
+
+    virtual void backup(size_t len)
+    {
+      m_backed_up += len;
+    }
+
+    virtual void flush()
+    {
+    }
+
+    std::string contents() const
+    {
+      std::string str;
+      for (size_t i = 0; i < m_used; ++i) {
+        const size_t size = m_buffers[i].size() -
+          (i + 1 == m_used ? m_backed_up : 0);
+        str.append(reinterpret_cast<const char*>(m_buffers[i].data()), size);
+      }
+      return str;
+    }
+
+  private:
+    std::vector<std::vector<uint8_t>> m_buffers;
+    size_t m_used;
+    size_t m_backed_up;
+  };
+
+  std::string write_to_stream(const json_writer& writer, const JSON& json,
+    size_t buffer_size) const
+  {
+    std::ostringstream out;
+    std::unique_ptr<sneaker::io::output_stream> stream =
+      sneaker::io::ostream_output_stream(out, buffer_size);
+
+    EXPECT_TRUE(writer.write(json, stream.get()));
+    stream->flush();
+
+    return out.str();
+  }
+
+  const std::string DOCUMENT =
+    "{\"b\": [1, 2, \"x\"], \"a\": null, \"c\": {\"d\": true, \"e\": {}}, "
+    "\"f\": [], \"g\": false}";
+};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_writer_unittest, TestCompactLayout)
+{
+  const json_writer writer;
+
+  ASSERT_EQ(json_writer::style::COMPACT, writer.layout());
+
+  ASSERT_EQ(
+    "{\"a\":null,\"b\":[1,2,\"x\"],\"c\":{\"d\":true,\"e\":{}},\"f\":[],"
+    "\"g\":false}",
+    writer.write(parse(DOCUMENT))
+  );
+
+  ASSERT_EQ("[]", writer.write(JSON::array {}));
+  ASSERT_EQ("\"abc\"", writer.write(JSON("abc")));
+  ASSERT_EQ("null", writer.write(JSON()));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_writer_unittest, TestPrettyLayout)
+{
+  ASSERT_EQ(
+    "{\n"
+    "  \"a\": null,\n"
+    "  \"b\": [\n"
+    "    1,\n"
+    "    2,\n"
+    "    \"x\"\n"
+    "  ],\n"
+    "  \"c\": {\n"
+    "    \"d\": true,\n"
+    "    \"e\": {}\n"
+    "  },\n"
+    "  \"f\": [],\n"
+    "  \"g\": false\n"
+    "}",
+    json_writer(json_writer::style::PRETTY).write(parse(DOCUMENT))
+  );
+
+  // Indentation deeper than a single run of spaces.
+  JSON json = JSON::array { 1 };
+  for (size_t i = 0; i < 20; ++i) {
+    json = JSON::array { json };
+  }
+
+  const std::string str = json_writer(json_writer::style::PRETTY, 3).write(json);
+  ASSERT_NE(std::string::npos, str.find("\n" + std::string(63, ' ') + "1\n"));
+  ASSERT_EQ(parse(str), json);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_writer_unittest, TestStringEscaping)
+{
+  const json_writer writer;
+
+  std::vector<std::string> strs = {
+    "", "\"", "\\", "a\"b\\c/d", "\b\f\n\r\t",
+    "\xe2\x80\xa8", "\xe2\x80\xa9", "\xe2\x80\xaa", "\xe2\x80", "\xe2",
+    "caf\xc3\xa9 \xf0\x9f\x98\x80"
+  };
+
+  for (int ch = 0; ch < 256; ++ch) {
+    strs.push_back(std::string(1, static_cast<char>(ch)));
+  }
+
+  // Characters to escape at every position around the SIMD block size.
+  for (size_t i = 0; i < 40; ++i) {
+    for (const char* special : { "\"", "\x01", "\x7f", "\xe2\x80\xa8" }) {
+      std::string str(40, 'a');
+      str.insert(i, special);
+      strs.push_back(str);
+    }
+  }
+
+  for (const std::string& str : strs) {
+    ASSERT_EQ(JSON(str).dump(), writer.write(JSON(str))) << str;
+    ASSERT_EQ(str, parse("[" + writer.write(JSON(str)) + "]")[0].string_value());
+  }
+
+  ASSERT_EQ(
+    "{\"k\\ney\":\"\\u0000\\u001f\"}",
+    writer.write(JSON::object { { "k\ney", std::string("\0\x1f", 2) } })
+  );
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_writer_unittest, TestNumbers)
+{
+  const json_writer writer;
+
+  ASSERT_EQ("0", writer.write(JSON(0)));
+  ASSERT_EQ("-1", writer.write(JSON(-1)));
+  ASSERT_EQ("1234567890", writer.write(JSON(1234567890)));
+  ASSERT_EQ("9223372036854775807",
+    writer.write(JSON::from_int64(std::numeric_limits<int64_t>::max())));
+  ASSERT_EQ("9223372036854775296",
+    writer.write(JSON::from_int64(9223372036854775296)));
+  ASSERT_EQ("-9223372036854775808",
+    writer.write(JSON::from_int64(std::numeric_limits<int64_t>::min())));
+
+  ASSERT_EQ("0.1", writer.write(JSON(0.1)));
+  ASSERT_EQ("-2.5", writer.write(JSON(-2.5)));
+  ASSERT_EQ("3", writer.write(JSON(3.0)));
+  ASSERT_EQ("-0", writer.write(JSON(-0.0)));
+  ASSERT_EQ("1000000000000000", writer.write(JSON(1e15)));
+  ASSERT_EQ("1e+300", writer.write(JSON(1e300)));
+  ASSERT_EQ("1.5e-7", writer.write(JSON(1.5e-7)));
+  ASSERT_EQ("0.000001", writer.write(JSON(1e-6)));
+  ASSERT_EQ("123.456", writer.write(JSON(123.456)));
+  ASSERT_EQ("5e-324", writer.write(JSON(5e-324)));
+  ASSERT_EQ("2.2250738585072014e-308",
+    writer.write(JSON(std::numeric_limits<double>::min())));
+  ASSERT_EQ("1.7976931348623157e+308",
+    writer.write(JSON(std::numeric_limits<double>::max())));
+  ASSERT_EQ("100000000000000000000", writer.write(JSON(1e20)));
+  ASSERT_EQ("1e+21", writer.write(JSON(1e21)));
+  ASSERT_EQ("-1.5e-7", writer.write(JSON(-1.5e-7)));
+  ASSERT_EQ("0.30000000000000004", writer.write(JSON(0.1 + 0.2)));
+
+  ASSERT_EQ("null",
+    writer.write(JSON(std::numeric_limits<double>::infinity())));
+  ASSERT_EQ("null",
+    writer.write(JSON(-std::numeric_limits<double>::infinity())));
+  ASSERT_EQ("null",
+    writer.write(JSON(std::numeric_limits<double>::quiet_NaN())));
+
+  std::mt19937_64 random(42);
+
+  for (size_t i = 0; i < 10000; ++i) {
+    const uint64_t bits = random();
+    double value;
+    memcpy(&value, &bits, sizeof value);
+
+    if (!std::isfinite(value)) {
+      continue;
+    }
+
+    const std::string str = writer.write(JSON(value));
+    const double read = strtod(str.c_str(), NULL);
+
+    ASSERT_EQ(0, memcmp(&value, &read, sizeof value)) << str;
+  }
+
+  // Short decimals are written with their own digits.
+  for (int i = 1; i < 100000; ++i) {
+    char expected[32];
+    snprintf(expected, sizeof expected, "%.15g", i / 1000.0);
+
+    ASSERT_EQ(expected, writer.write(JSON(i / 1000.0)));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_writer_unittest, TestEstimateSize)
+{
+  const JSON json = parse(DOCUMENT);
+
+  for (json_writer::style layout :
+    { json_writer::style::COMPACT, json_writer::style::PRETTY })
+  {
+    const json_writer writer(layout, 4);
+
+    ASSERT_EQ(writer.write(json).size(), writer.estimate_size(json));
+  }
+
+  const json_writer writer;
+
+  ASSERT_EQ(5, writer.estimate_size(JSON(-1234)));
+  ASSERT_EQ(1, writer.estimate_size(JSON(0)));
+  ASSERT_LT(writer.write(JSON(0.5)).size(), writer.estimate_size(JSON(0.5)));
+  ASSERT_GT(writer.write(JSON("\n")).size(), writer.estimate_size(JSON("\n")));
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_writer_unittest, TestAppendToString)
+{
+  const json_writer writer;
+
+  std::string str = "prefix ";
+  writer.write(JSON::array { "\n\n\n\n\n\n\n\n", 1.5, 2.25 }, &str);
+
+  ASSERT_EQ("prefix [\"\\n\\n\\n\\n\\n\\n\\n\\n\",1.5,2.25]", str);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_writer_unittest, TestWriteToOutputStream)
+{
+  const JSON json = parse(
+    "[{\"key\": \"a string that is longer than the buffers of the stream\"}, "
+    "[1.5, -3, null, true], \"\\u2028\\n\"]");
+
+  for (json_writer::style layout :
+    { json_writer::style::COMPACT, json_writer::style::PRETTY })
+  {
+    const json_writer writer(layout);
+    const std::string expected = writer.write(json);
+
+    for (size_t buffer_size : { 1, 7, 16, 4096 }) {
+      ASSERT_EQ(expected, write_to_stream(writer, json, buffer_size));
+    }
+  }
+
+  // Values written one after another continue from where the last ended.
+  std::ostringstream out;
+  std::unique_ptr<sneaker::io::output_stream> stream =
+    sneaker::io::ostream_output_stream(out, 64);
+
+  const json_writer writer;
+  ASSERT_TRUE(writer.write(JSON::array { 1 }, stream.get()));
+  ASSERT_TRUE(writer.write(JSON::array { 2 }, stream.get()));
+  stream->flush();
+
+  ASSERT_EQ("[1][2]", out.str());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(json_writer_unittest, TestOutputStreamRunsOut)
+{
+  const json_writer writer;
+  const JSON json = JSON::array { "abcdefghij", "klmnopqrst" };
+
+  limited_output_stream enough(4, 8);
+  ASSERT_TRUE(writer.write(json, &enough));
+  ASSERT_EQ(writer.write(json), enough.contents());
+
+  limited_output_stream short_of_space(2, 8);
+  ASSERT_FALSE(writer.write(json, &short_of_space));
+  ASSERT_EQ(writer.write(json).substr(0, 16), short_of_space.contents());
+}
+
+// -----------------------------------------------------------------------------
@@ -149,3 +149,27 @@ TEST_F(fixed_time_interval_daemon_service_unittest, TestRunDaemonAsynchronouslyI
 }
 
 // -----------------------------------------------------------------------------
+
+TEST_F(fixed_time_interval_daemon_service_unittest, TestRunDaemonWithHandlerArgument)
+{
+  /* Tests that the handler of a daemon is invoked with the argument given to
+   * the daemon.
+   */
+  struct handler
+  {
+    static void handle(void* arg) {
+      ++*static_cast<size_t*>(arg);
+    }
+  };
+
+  size_t count = 0;
+
+  fixed_time_interval_daemon_service daemon_service(
+    20, &handler::handle, &count, true, 5);
+
+  const bool res = daemon_service.start();
+  ASSERT_EQ(true, res);
+  ASSERT_EQ(5, count);
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,133 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `sneaker::threading::parallel_for` defined in
+ * sneaker/threading/parallel_for.h */
+
+#include "threading/parallel_for.h"
+#include "threading/worker_pool.h"
+
+#include "testing/testing.h"
+
+#include <atomic>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+
+using sneaker::threading::parallel_for;
+
+// -----------------------------------------------------------------------------
+
+class parallel_for_unittest : public ::testing::Test {};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_for_unittest, TestEmptyRange)
+{
+  size_t calls = 0;
+
+  parallel_for(4, 0, 16, [&calls](size_t, size_t) {
+    ++calls;
+  });
+
+  ASSERT_EQ(0, calls);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_for_unittest, TestEveryItemOnce)
+{
+  const size_t COUNT = 100000;
+
+  std::vector<std::atomic<int>> visits(COUNT);
+  for (auto& visit : visits)
+  {
+    visit.store(0);
+  }
+
+  std::vector<size_t> per_thread(4, 0);
+
+  parallel_for(4, COUNT, 100, [&visits, &per_thread](size_t item,
+    size_t thread) {
+    visits[item].fetch_add(1);
+    ++per_thread[thread];
+  });
+
+  for (const auto& visit : visits)
+  {
+    ASSERT_EQ(1, visit.load());
+  }
+
+  size_t total = 0;
+  for (const size_t count : per_thread)
+  {
+    total += count;
+  }
+
+  ASSERT_EQ(COUNT, total);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_for_unittest, TestZeroGrain)
+{
+  std::atomic<size_t> sum(0);
+
+  parallel_for(2, 10, 0, [&sum](size_t item, size_t) {
+    sum.fetch_add(item);
+  });
+
+  ASSERT_EQ(45, sum.load());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(parallel_for_unittest, TestWithWorkerPool)
+{
+  sneaker::threading::worker_pool pool(3);
+
+  for (size_t round = 0; round < 10; ++round)
+  {
+    std::atomic<size_t> sum(0);
+    std::vector<size_t> per_thread(4, 0);
+
+    parallel_for(pool, 1000, 10, [&sum, &per_thread](size_t item,
+      size_t thread) {
+      sum.fetch_add(item);
+      ++per_thread[thread];
+    });
+
+    ASSERT_EQ(499500, sum.load());
+
+    size_t total = 0;
+    for (const size_t count : per_thread)
+    {
+      total += count;
+    }
+
+    ASSERT_EQ(1000, total);
+  }
+}
+
+// -----------------------------------------------------------------------------
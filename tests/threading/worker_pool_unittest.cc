@@ -0,0 +1,164 @@
+/*******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2016 Yanzheng Li
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*******************************************************************************/
+
+/* Unit test for `sneaker::threading::worker_pool` defined in
+ * sneaker/threading/worker_pool.h */
+
+#include "threading/worker_pool.h"
+
+#include "testing/testing.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+using sneaker::threading::worker_pool;
+
+// -----------------------------------------------------------------------------
+
+class worker_pool_unittest : public ::testing::Test {};
+
+// -----------------------------------------------------------------------------
+
+TEST_F(worker_pool_unittest, TestRunInvokesEveryOrdinalOnce)
+{
+  worker_pool pool(3);
+
+  ASSERT_EQ(3, pool.thread_count());
+
+  for (size_t round = 0; round < 100; ++round)
+  {
+    std::vector<std::atomic<int>> calls(4);
+    for (auto& call : calls)
+    {
+      call.store(0);
+    }
+
+    pool.run(4, [&calls](size_t thread) {
+      calls[thread].fetch_add(1);
+    });
+
+    for (const auto& call : calls)
+    {
+      ASSERT_EQ(1, call.load());
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(worker_pool_unittest, TestRunOnFewerThreads)
+{
+  worker_pool pool(3);
+
+  std::atomic<size_t> sum(0);
+
+  pool.run(2, [&sum](size_t thread) {
+    sum.fetch_add(thread + 1);
+  });
+
+  ASSERT_EQ(3, sum.load());
+
+  pool.run(1, [&sum](size_t thread) {
+    sum.fetch_add(thread + 1);
+  });
+
+  ASSERT_EQ(4, sum.load());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(worker_pool_unittest, TestStartOverlapsWithCaller)
+{
+  worker_pool pool(2);
+
+  std::atomic<bool> released(false);
+  std::atomic<size_t> done(0);
+
+  pool.start(2, [&released, &done](size_t) {
+    while (!released.load())
+    {
+      std::this_thread::yield();
+    }
+    done.fetch_add(1);
+  });
+
+  // The workers wait for the calling thread, which is not blocked.
+  ASSERT_EQ(0, done.load());
+  released.store(true);
+
+  pool.wait();
+
+  ASSERT_EQ(2, done.load());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(worker_pool_unittest, TestStartWithFirstOrdinal)
+{
+  worker_pool pool(2);
+
+  std::vector<std::atomic<int>> calls(4);
+  for (auto& call : calls)
+  {
+    call.store(0);
+  }
+
+  pool.start(2, [&calls](size_t thread) {
+    calls[thread].fetch_add(1);
+  }, 2);
+  pool.wait();
+
+  ASSERT_EQ(0, calls[0].load());
+  ASSERT_EQ(0, calls[1].load());
+  ASSERT_EQ(1, calls[2].load());
+  ASSERT_EQ(1, calls[3].load());
+}
+
+// -----------------------------------------------------------------------------
+
+TEST_F(worker_pool_unittest, TestExceptionIsRethrown)
+{
+  worker_pool pool(2);
+
+  ASSERT_THROW(
+    pool.run(3, [](size_t thread) {
+      if (thread == 2)
+      {
+        throw std::runtime_error("task");
+      }
+    }),
+    std::runtime_error);
+
+  // The pool remains usable.
+  std::atomic<size_t> calls(0);
+  pool.run(3, [&calls](size_t) {
+    calls.fetch_add(1);
+  });
+
+  ASSERT_EQ(3, calls.load());
+}
+
+// -----------------------------------------------------------------------------